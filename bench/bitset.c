@@ -0,0 +1,152 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/bitset.h"
+
+#include <stdlib.h>
+
+// 32 million flags, as a bitset of 4 MiB and as an array of `bool` of 32 MiB.
+// The bulk benchmarks take one pass over every flag per iteration, and rank
+// and select answer one query at a random position per iteration.
+#define LENGTH ((size_t)1 << 25)
+
+typedef struct Data {
+    NSL_BitSet dense;
+    NSL_BitSet other;
+    NSL_BitSet sparse;
+    bool      *dense_bools;
+    bool      *other_bools;
+    bool      *sparse_bools;
+    uint64_t   random;
+} Data;
+
+uint64_t next_random(Data *data) {
+    data->random ^= data->random << 13;
+    data->random ^= data->random >> 7;
+    data->random ^= data->random << 17;
+    return data->random;
+}
+
+void bench_bool_and(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        for (size_t j = 0; j < LENGTH; j++) {
+            data->dense_bools[j] &= data->other_bools[j];
+        }
+        nsl_bench_do_not_optimize(data->dense_bools[i % LENGTH]);
+    }
+}
+
+void bench_bitset_and(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        nsl_bitset_and(&data->dense, &data->other);
+        nsl_bench_do_not_optimize(data->dense.words[0]);
+    }
+}
+
+void bench_bool_count(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t count = 0;
+        for (size_t j = 0; j < LENGTH; j++) {
+            count += data->other_bools[j];
+        }
+        nsl_bench_do_not_optimize(count);
+    }
+}
+
+void bench_bitset_count(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        nsl_bench_do_not_optimize(nsl_bitset_count(&data->other));
+    }
+}
+
+void bench_bool_next(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t sum = 0;
+        for (size_t j = 0; j < LENGTH; j++) {
+            if (data->sparse_bools[j]) { sum += j; }
+        }
+        nsl_bench_do_not_optimize(sum);
+    }
+}
+
+void bench_bitset_next(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t sum = 0;
+        for (size_t j = nsl_bitset_next(&data->sparse, 0); j < LENGTH;
+             j = nsl_bitset_next(&data->sparse, j + 1)) {
+            sum += j;
+        }
+        nsl_bench_do_not_optimize(sum);
+    }
+}
+
+void bench_bitset_rank(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t index = (size_t)(next_random(data) % LENGTH);
+        nsl_bench_do_not_optimize(nsl_bitset_rank(&data->other, index));
+    }
+}
+
+void bench_bitset_select(NSL_Bench *bench) {
+    Data  *data  = bench->arg;
+    size_t count = nsl_bitset_rank(&data->other, LENGTH);
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t rank = (size_t)(next_random(data) % count);
+        nsl_bench_do_not_optimize(nsl_bitset_select(&data->other, rank));
+    }
+}
+
+// Fills `set` and `bools` with the same random bits, each set with a chance
+// of `percent` in 100.
+void randomize(NSL_BitSet *set, bool *bools, int percent) {
+    nsl_bitset_init(set, LENGTH);
+    for (size_t i = 0; i < LENGTH; i++) {
+        bools[i] = rand() % 100 < percent;
+        if (bools[i]) { nsl_bitset_set(set, i); }
+    }
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    Data data = {
+        .dense_bools  = malloc(LENGTH),
+        .other_bools  = malloc(LENGTH),
+        .sparse_bools = malloc(LENGTH),
+        .random       = 1,
+    };
+    srand(1);
+    // `and` keeps clearing bits of the dense set, which costs the same
+    randomize(&data.dense, data.dense_bools, 50);
+    randomize(&data.other, data.other_bools, 50);
+    randomize(&data.sparse, data.sparse_bools, 1);
+    nsl_bitset_build_index(&data.other);
+
+    NSL_BenchResult results[8];
+    size_t          count = 0;
+    count += nsl_bench_run(&config, "bool/and", bench_bool_and, &data, &results[count]);
+    count += nsl_bench_run(&config, "bitset/and", bench_bitset_and, &data, &results[count]);
+    count += nsl_bench_run(&config, "bool/count", bench_bool_count, &data, &results[count]);
+    count += nsl_bench_run(&config, "bitset/count", bench_bitset_count, &data, &results[count]);
+    count += nsl_bench_run(&config, "bool/next", bench_bool_next, &data, &results[count]);
+    count += nsl_bench_run(&config, "bitset/next", bench_bitset_next, &data, &results[count]);
+    count += nsl_bench_run(&config, "bitset/rank", bench_bitset_rank, &data, &results[count]);
+    count += nsl_bench_run(&config, "bitset/select", bench_bitset_select, &data, &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    nsl_bitset_free(&data.dense);
+    nsl_bitset_free(&data.other);
+    nsl_bitset_free(&data.sparse);
+    free(data.dense_bools);
+    free(data.other_bools);
+    free(data.sparse_bools);
+}
@@ -0,0 +1,341 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#if defined(NSL_MEMTRACK_ENABLE)
+#    include "nonstdlib/memtrack.h"
+#    define VARIANT "memtrack/"
+#else
+#    define VARIANT ""
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+// Each container is measured against a naive baseline over working sets that
+// fit in L1, L2 and L3, and one that is far larger than any last level cache.
+// New containers from the road map are added as another group below, and
+// every time is per element or operation so that the sizes can be compared.
+static const size_t SIZES[] = {16 << 10, 256 << 10, 4 << 20, 64 << 20};
+
+#define SIZE_COUNT (sizeof(SIZES) / sizeof(*SIZES))
+
+// The `Array` from the generics ADR. It grows by doubling through the
+// allocation hooks.
+#define Array(type) struct { type *items; size_t length; size_t capacity; }
+
+#define array_push(arr, item)                                                                      \
+    do {                                                                                           \
+        if ((arr)->length == (arr)->capacity) {                                                    \
+            (arr)->capacity = (arr)->capacity == 0 ? 16 : 2 * (arr)->capacity;                     \
+            (arr)->items = nsl_realloc((arr)->items, (arr)->capacity * sizeof(*(arr)->items));     \
+            if ((arr)->items == nullptr) { abort(); }                                              \
+        }                                                                                          \
+        (arr)->items[(arr)->length++] = (item);                                                    \
+    } while (0)
+
+typedef struct Node Node;
+struct Node {
+    Node    *next;
+    uint64_t value;
+};
+
+// Lookups go to random keys so that every level of the structure is touched.
+#define QUERY_COUNT 4096
+
+typedef struct Data {
+    size_t count;
+
+    Array(uint64_t) array;
+    size_t array_cursor;
+
+    // A circular list linked in a random order, as a list is after some churn.
+    Node *list;
+    Node *list_cursor;
+
+    // Open addressing with linear probing at a load factor of one half. Zero
+    // marks an empty slot.
+    uint64_t *table;
+    size_t    table_mask;
+    uint64_t  queries[QUERY_COUNT];
+
+    // Blocks of mixed sizes that are freed and allocated again in a random
+    // order. Each set is only touched through its own allocator.
+    void  **hooked;
+    void  **blocks;
+    size_t *sizes;
+    size_t *order;
+    size_t  block_count;
+    size_t  block_cursor;
+} Data;
+
+static uint64_t random_state = 1;
+
+// splitmix64, since `rand` gives too few bits for the larger sizes.
+uint64_t random_u64(void) {
+    uint64_t z = (random_state += 0x9e3779b97f4a7c15);
+    z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z          = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+// Returns a random permutation of `[0, count)`.
+size_t *shuffled(size_t count) {
+    size_t *order = malloc(count * sizeof(*order));
+    if (order == nullptr) { abort(); }
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    for (size_t i = count - 1; i > 0; i--) {
+        size_t j  = random_u64() % (i + 1);
+        size_t t  = order[i];
+        order[i]  = order[j];
+        order[j]  = t;
+    }
+    return order;
+}
+
+size_t table_slot(const Data *data, uint64_t key) {
+    return (size_t)(key * 0x9e3779b97f4a7c15 >> 17) & data->table_mask;
+}
+
+int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Builds every structure so that the array holds `bytes` worth of elements.
+void setup(Data *data, size_t bytes) {
+    *data       = (Data){.count = bytes / sizeof(uint64_t)};
+    size_t n    = data->count;
+    size_t *ord = shuffled(n);
+
+    Node *nodes = malloc(n * sizeof(*nodes));
+    if (nodes == nullptr) { abort(); }
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = random_u64() | 1;
+        array_push(&data->array, key);
+        nodes[ord[i]] = (Node){&nodes[ord[(i + 1) % n]], key};
+    }
+    data->list        = nodes;
+    data->list_cursor = nodes;
+    qsort(data->array.items, n, sizeof(uint64_t), compare_u64);
+
+    size_t capacity = 1;
+    while (capacity < 2 * n) {
+        capacity *= 2;
+    }
+    data->table      = calloc(capacity, sizeof(uint64_t));
+    data->table_mask = capacity - 1;
+    if (data->table == nullptr) { abort(); }
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key  = data->array.items[i];
+        size_t   slot = table_slot(data, key);
+        while (data->table[slot] != 0) {
+            slot = (slot + 1) & data->table_mask;
+        }
+        data->table[slot] = key;
+    }
+    for (size_t i = 0; i < QUERY_COUNT; i++) {
+        data->queries[i] = data->array.items[random_u64() % n];
+    }
+    free(ord);
+
+    // The blocks average about 128 bytes, so they cover the same working set.
+    data->block_count = bytes / 128;
+    data->hooked      = malloc(data->block_count * sizeof(void *));
+    data->blocks      = malloc(data->block_count * sizeof(void *));
+    data->sizes       = malloc(data->block_count * sizeof(size_t));
+    if (data->hooked == nullptr || data->blocks == nullptr || data->sizes == nullptr) { abort(); }
+    for (size_t i = 0; i < data->block_count; i++) {
+        data->sizes[i]  = (size_t)16 << (random_u64() % 4);
+        data->hooked[i] = nsl_malloc(data->sizes[i]);
+        data->blocks[i] = malloc(data->sizes[i]);
+        if (data->hooked[i] == nullptr || data->blocks[i] == nullptr) { abort(); }
+    }
+    data->order = shuffled(data->block_count);
+}
+
+void teardown(Data *data) {
+    nsl_free(data->array.items);
+    free(data->list);
+    free(data->table);
+    for (size_t i = 0; i < data->block_count; i++) {
+        nsl_free(data->hooked[i]);
+        free(data->blocks[i]);
+    }
+    free(data->hooked);
+    free(data->blocks);
+    free(data->sizes);
+    free(data->order);
+}
+
+// Pushes one element per iteration, starting over once `count` are stored so
+// that the growth is measured at every size.
+void bench_array_push(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    Array(uint64_t) array = {};
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (array.length == data->count) {
+            nsl_bench_pause(bench);
+            nsl_free(array.items);
+            array.items    = nullptr;
+            array.length   = 0;
+            array.capacity = 0;
+            nsl_bench_resume(bench);
+        }
+        array_push(&array, i);
+    }
+    nsl_bench_do_not_optimize(array.items);
+    nsl_bench_pause(bench);
+    nsl_free(array.items);
+    nsl_bench_resume(bench);
+}
+
+void bench_list_push(NSL_Bench *bench) {
+    Data  *data   = bench->arg;
+    Node  *head   = nullptr;
+    size_t length = 0;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (length == data->count) {
+            nsl_bench_pause(bench);
+            while (head != nullptr) {
+                Node *next = head->next;
+                nsl_free(head);
+                head = next;
+            }
+            length = 0;
+            nsl_bench_resume(bench);
+        }
+        Node *node = nsl_malloc(sizeof(*node));
+        if (node == nullptr) { abort(); }
+        *node = (Node){head, i};
+        head  = node;
+        length++;
+    }
+    nsl_bench_do_not_optimize(head);
+    nsl_bench_pause(bench);
+    while (head != nullptr) {
+        Node *next = head->next;
+        nsl_free(head);
+        head = next;
+    }
+    nsl_bench_resume(bench);
+}
+
+// Sums one element per iteration, continuing where the last sample stopped.
+void bench_array_sum(NSL_Bench *bench) {
+    Data    *data   = bench->arg;
+    size_t   cursor = data->array_cursor;
+    uint64_t sum    = 0;
+    for (uint64_t done = 0; done < bench->iterations;) {
+        size_t chunk = data->count - cursor;
+        if (chunk > bench->iterations - done) { chunk = (size_t)(bench->iterations - done); }
+        for (size_t i = 0; i < chunk; i++) {
+            sum += data->array.items[cursor + i];
+        }
+        done   += chunk;
+        cursor  = (cursor + chunk) % data->count;
+    }
+    nsl_bench_do_not_optimize(sum);
+    data->array_cursor = cursor;
+}
+
+void bench_list_sum(NSL_Bench *bench) {
+    Data    *data = bench->arg;
+    Node    *node = data->list_cursor;
+    uint64_t sum  = 0;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        sum  += node->value;
+        node  = node->next;
+    }
+    nsl_bench_do_not_optimize(sum);
+    data->list_cursor = node;
+}
+
+void bench_array_find(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        uint64_t  key   = data->queries[i % QUERY_COUNT];
+        uint64_t *found =
+            bsearch(&key, data->array.items, data->count, sizeof(uint64_t), compare_u64);
+        nsl_bench_do_not_optimize(found);
+    }
+}
+
+void bench_table_find(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        uint64_t key  = data->queries[i % QUERY_COUNT];
+        size_t   slot = table_slot(data, key);
+        while (data->table[slot] != key && data->table[slot] != 0) {
+            slot = (slot + 1) & data->table_mask;
+        }
+        nsl_bench_do_not_optimize(slot);
+    }
+}
+
+// Frees one block and allocates it again per iteration, through the hooks or
+// straight to libc. The hooks are libc unless `NSL_MEMTRACK_ENABLE` is defined.
+void bench_hook_churn(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t index        = data->order[data->block_cursor++ % data->block_count];
+        nsl_free(data->hooked[index]);
+        data->hooked[index] = nsl_malloc(data->sizes[index]);
+        if (data->hooked[index] == nullptr) { abort(); }
+        *(char *)data->hooked[index] = 1;
+    }
+}
+
+void bench_libc_churn(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t index        = data->order[data->block_cursor++ % data->block_count];
+        free(data->blocks[index]);
+        data->blocks[index] = malloc(data->sizes[index]);
+        if (data->blocks[index] == nullptr) { abort(); }
+        *(char *)data->blocks[index] = 1;
+    }
+}
+
+typedef struct Benchmark {
+    const char  *name;
+    NSL_BenchFn *fn;
+} Benchmark;
+
+// Every container is listed next to its baseline.
+static const Benchmark BENCHMARKS[] = {
+    {"array/push",        bench_array_push},
+    {"list/push",         bench_list_push},
+    {"array/sum",         bench_array_sum},
+    {"list/sum",          bench_list_sum},
+    {"array/bsearch",     bench_array_find},
+    {"linear_probe/find", bench_table_find},
+    {"nsl_malloc/churn",  bench_hook_churn},
+    {"malloc/churn",      bench_libc_churn},
+};
+
+#define BENCHMARK_COUNT (sizeof(BENCHMARKS) / sizeof(*BENCHMARKS))
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    static NSL_BenchResult results[SIZE_COUNT * BENCHMARK_COUNT];
+    static char            names[SIZE_COUNT * BENCHMARK_COUNT][64];
+    size_t                 count = 0;
+    for (size_t i = 0; i < SIZE_COUNT; i++) {
+        static Data data;
+        setup(&data, SIZES[i]);
+        for (size_t j = 0; j < BENCHMARK_COUNT; j++) {
+            char *name = names[i * BENCHMARK_COUNT + j];
+            snprintf(
+                name, sizeof(names[0]), VARIANT "%s/%zuKiB", BENCHMARKS[j].name, SIZES[i] >> 10);
+            count += nsl_bench_run(&config, name, BENCHMARKS[j].fn, &data, &results[count]);
+        }
+        teardown(&data);
+    }
+    nsl_bench_write(stdout, config.format, results, count);
+}
@@ -0,0 +1,132 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/heap.h"
+
+#include <stdlib.h>
+
+// A million random keys, held in binary and 4-ary heaps. `hold` pops the
+// first key and pushes a larger one per iteration, which keeps the heap at
+// the same size, `decrease` lowers the key of a random id per iteration, as
+// Dijkstra's algorithm does, and `heapify` builds the whole heap per
+// iteration, against pushing the keys one by one.
+#define COUNT ((size_t)1 << 20)
+
+#define less(a, b) ((a) < (b))
+
+NSL_HEAP_DEFINE(BinaryHeap, binary_heap, uint64_t, less, 2)
+NSL_HEAP_DEFINE(QuaternaryHeap, quaternary_heap, uint64_t, less, 4)
+NSL_INDEXED_HEAP_DEFINE(BinaryIndexed, binary_indexed, uint64_t, less, 2)
+NSL_INDEXED_HEAP_DEFINE(QuaternaryIndexed, quaternary_indexed, uint64_t, less, 4)
+
+typedef struct Data {
+    uint64_t         *keys;
+    BinaryHeap        binary;
+    QuaternaryHeap    quaternary;
+    BinaryIndexed     binary_indexed;
+    QuaternaryIndexed quaternary_indexed;
+    uint64_t          random;
+} Data;
+
+uint64_t next_random(Data *data) {
+    data->random ^= data->random << 13;
+    data->random ^= data->random >> 7;
+    data->random ^= data->random << 17;
+    return data->random;
+}
+
+#define BENCH_HOLD(name, prefix)                                                                   \
+    void NSL_CAT(bench_hold_, name)(NSL_Bench * bench) {                                           \
+        Data *data = bench->arg;                                                                   \
+        for (uint64_t i = 0; i < bench->iterations; i++) {                                         \
+            uint64_t first = NSL_CAT(prefix, _pop)(&data->name);                                   \
+            NSL_CAT(prefix, _push)(&data->name, first + next_random(data) % (COUNT * COUNT));      \
+        }                                                                                          \
+    }
+
+#define BENCH_DECREASE(name, prefix)                                                               \
+    void NSL_CAT(bench_decrease_, name)(NSL_Bench * bench) {                                       \
+        Data *data = bench->arg;                                                                   \
+        for (uint64_t i = 0; i < bench->iterations; i++) {                                         \
+            size_t id = (size_t)(next_random(data) % COUNT);                                       \
+            if (data->keys[id] == 0) { continue; }                                                 \
+            data->keys[id] -= next_random(data) % data->keys[id] / 16 + 1;                         \
+            NSL_CAT(prefix, _update)(&data->name, id, data->keys[id]);                             \
+        }                                                                                          \
+    }
+
+#define BENCH_BUILD(name, prefix)                                                                  \
+    void NSL_CAT(bench_push_all_, name)(NSL_Bench * bench) {                                       \
+        Data *data = bench->arg;                                                                   \
+        for (uint64_t i = 0; i < bench->iterations; i++) {                                         \
+            data->name.count = 0;                                                                  \
+            for (size_t j = 0; j < COUNT; j++) {                                                   \
+                NSL_CAT(prefix, _push)(&data->name, data->keys[j]);                                \
+            }                                                                                      \
+            nsl_bench_do_not_optimize(NSL_CAT(prefix, _peek)(&data->name));                        \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void NSL_CAT(bench_heapify_, name)(NSL_Bench * bench) {                                        \
+        Data *data = bench->arg;                                                                   \
+        for (uint64_t i = 0; i < bench->iterations; i++) {                                         \
+            data->name.count = 0;                                                                  \
+            NSL_CAT(prefix, _heapify)(&data->name, data->keys, COUNT);                             \
+            nsl_bench_do_not_optimize(NSL_CAT(prefix, _peek)(&data->name));                        \
+        }                                                                                          \
+    }
+
+BENCH_HOLD(binary, binary_heap)
+BENCH_HOLD(quaternary, quaternary_heap)
+BENCH_DECREASE(binary_indexed, binary_indexed)
+BENCH_DECREASE(quaternary_indexed, quaternary_indexed)
+BENCH_BUILD(binary, binary_heap)
+BENCH_BUILD(quaternary, quaternary_heap)
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    static Data data = {.random = 1};
+    data.keys        = malloc(COUNT * sizeof(uint64_t));
+    binary_heap_init(&data.binary);
+    quaternary_heap_init(&data.quaternary);
+    binary_indexed_init(&data.binary_indexed);
+    quaternary_indexed_init(&data.quaternary_indexed);
+    for (size_t i = 0; i < COUNT; i++) {
+        data.keys[i] = next_random(&data) % (COUNT * COUNT);
+    }
+
+    NSL_BenchResult results[8];
+    size_t          count = 0;
+    count += nsl_bench_run(
+        &config, "binary/push-all", bench_push_all_binary, &data, &results[count]);
+    count += nsl_bench_run(&config, "binary/heapify", bench_heapify_binary, &data, &results[count]);
+    count += nsl_bench_run(
+        &config, "4-ary/push-all", bench_push_all_quaternary, &data, &results[count]);
+    count += nsl_bench_run(
+        &config, "4-ary/heapify", bench_heapify_quaternary, &data, &results[count]);
+    count += nsl_bench_run(&config, "binary/hold", bench_hold_binary, &data, &results[count]);
+    count += nsl_bench_run(&config, "4-ary/hold", bench_hold_quaternary, &data, &results[count]);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        binary_indexed_push(&data.binary_indexed, i, data.keys[i]);
+        quaternary_indexed_push(&data.quaternary_indexed, i, data.keys[i]);
+    }
+    count += nsl_bench_run(
+        &config, "binary/decrease", bench_decrease_binary_indexed, &data, &results[count]);
+    // the keys were lowered by the binary heap, so the 4-ary heap starts from them
+    for (size_t i = 0; i < COUNT; i++) {
+        quaternary_indexed_update(&data.quaternary_indexed, i, data.keys[i]);
+    }
+    count += nsl_bench_run(
+        &config, "4-ary/decrease", bench_decrease_quaternary_indexed, &data, &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    binary_heap_free(&data.binary);
+    quaternary_heap_free(&data.quaternary);
+    binary_indexed_free(&data.binary_indexed);
+    quaternary_indexed_free(&data.quaternary_indexed);
+    free(data.keys);
+}
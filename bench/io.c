@@ -0,0 +1,125 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/io.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Many small files, as in a source tree or a cache of thumbnails. Each
+// iteration reads one whole file, so the times are per file, and the files
+// are read in order so that every one is touched before any is read again.
+#define FILE_COUNT 10000
+#define FILE_SIZE  512
+
+// The number of files that are opened, read and closed per batch of requests.
+#define BATCH 256
+
+typedef struct Data {
+    char          dir[32];
+    char          paths[FILE_COUNT][48];
+    char         *buffers;
+    size_t        cursor;
+    NSL_Io        io;
+    bool          fixed;
+    NSL_IoRequest requests[BATCH];
+    int           fds[BATCH];
+} Data;
+
+void bench_read(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t  file   = data->cursor++ % FILE_COUNT;
+        int     fd     = open(data->paths[file], O_RDONLY | O_CLOEXEC);
+        ssize_t length = read(fd, data->buffers, FILE_SIZE);
+        close(fd);
+        nsl_bench_do_not_optimize(length);
+    }
+}
+
+// Waits for a batch of requests, none of which may fail, or the times would
+// be of the errors.
+void wait_all(Data *data, size_t count) {
+    nsl_io_wait_all(&data->io);
+    for (size_t i = 0; i < count; i++) {
+        if (data->requests[i].result < 0) { abort(); }
+    }
+}
+
+// Opens, reads and closes a batch of files with three batches of requests.
+void bench_io(NSL_Bench *bench) {
+    Data   *data = bench->arg;
+    NSL_Io *io   = &data->io;
+    for (uint64_t done = 0; done < bench->iterations;) {
+        size_t count = BATCH;
+        if (count > bench->iterations - done) { count = (size_t)(bench->iterations - done); }
+        size_t first = data->cursor;
+        for (size_t i = 0; i < count; i++) {
+            nsl_io_open(io, &data->requests[i], data->paths[(first + i) % FILE_COUNT], O_RDONLY);
+        }
+        wait_all(data, count);
+        for (size_t i = 0; i < count; i++) {
+            data->fds[i] = (int)data->requests[i].result;
+            char *buffer = data->buffers + i * FILE_SIZE;
+            if (data->fixed) {
+                nsl_io_read_fixed(io, &data->requests[i], data->fds[i], 0, buffer, FILE_SIZE, 0);
+            } else {
+                nsl_io_read(io, &data->requests[i], data->fds[i], buffer, FILE_SIZE, 0);
+            }
+        }
+        wait_all(data, count);
+        for (size_t i = 0; i < count; i++) {
+            nsl_io_close(io, &data->requests[i], data->fds[i]);
+        }
+        wait_all(data, count);
+        data->cursor += count;
+        done         += count;
+    }
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    static Data data;
+    strcpy(data.dir, "/tmp/nsl-bench-io-XXXXXX");
+    if (mkdtemp(data.dir) == nullptr) { return 1; }
+    data.buffers = malloc(BATCH * FILE_SIZE);
+    if (data.buffers == nullptr) { abort(); }
+    memset(data.buffers, 'x', BATCH * FILE_SIZE);
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        snprintf(data.paths[i], sizeof(data.paths[i]), "%s/%zu", data.dir, i);
+        int fd = open(data.paths[i], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || write(fd, data.buffers, FILE_SIZE) != FILE_SIZE) { return 1; }
+        close(fd);
+    }
+
+    NSL_BenchResult results[3];
+    size_t          count  = 0;
+    struct iovec    buffer = {data.buffers, BATCH * FILE_SIZE};
+    count += nsl_bench_run(&config, "read/10k_files", bench_read, &data, &results[count]);
+
+    if (nsl_io_init(&data.io, &(NSL_IoConfig){.entries = BATCH}) && data.io.uring) {
+        data.fixed = nsl_io_register_buffers(&data.io, &buffer, 1);
+        if (!data.fixed) {
+            fprintf(stderr, "could not register buffers, reading into unregistered ones\n");
+        }
+        count += nsl_bench_run(&config, "io_uring/10k_files", bench_io, &data, &results[count]);
+        nsl_io_free(&data.io);
+    }
+    if (nsl_io_init(&data.io, &(NSL_IoConfig){.entries = BATCH, .fallback = true})) {
+        data.fixed = true;
+        count += nsl_bench_run(&config, "io_fallback/10k_files", bench_io, &data, &results[count]);
+        nsl_io_free(&data.io);
+    }
+    nsl_bench_write(stdout, config.format, results, count);
+
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        unlink(data.paths[i]);
+    }
+    rmdir(data.dir);
+    free(data.buffers);
+}
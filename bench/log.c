@@ -0,0 +1,68 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Each iteration logs one message with an integer, a double and a string, as
+// a server would for each request. The cost is what the thread that logs
+// pays: the flusher writes to /dev/null, and is made to drain the buffer while
+// the timer is paused, so that no message is dropped for lack of room.
+#define BUFFER_SIZE (1 << 22)
+
+// The number of messages logged between two flushes, which fit in the buffer
+// whether or not they are formatted.
+#define FLUSH_EVERY 16384
+
+static const char *const PEERS[] = {"10.0.0.1", "192.168.100.200", "localhost", "::1"};
+
+void bench_formatted(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (i % FLUSH_EVERY == FLUSH_EVERY - 1) {
+            nsl_bench_pause(bench);
+            nsl_log_flush();
+            nsl_bench_resume(bench);
+        }
+        nsl_log(NSL_LOG_LEVEL_INFO,
+                "request %d took %.3f ms from %s",
+                (int)i,
+                (double)(i % 1000) / 7.0,
+                PEERS[i % 4]);
+    }
+}
+
+void bench_deferred(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (i % FLUSH_EVERY == FLUSH_EVERY - 1) {
+            nsl_bench_pause(bench);
+            nsl_log_flush();
+            nsl_bench_resume(bench);
+        }
+        nsl_log_deferred(NSL_LOG_LEVEL_INFO,
+                         "request %d took %.3f ms from %s",
+                         (int)i,
+                         (double)(i % 1000) / 7.0,
+                         PEERS[i % 4]);
+    }
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    int dev_null = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (dev_null < 0) { return 1; }
+    NSL_LogConfig log = {.sink = NSL_LOG_SINK_FD, .fd = dev_null, .buffer_size = BUFFER_SIZE};
+    if (!nsl_log_start(&log)) { return 1; }
+
+    NSL_BenchResult results[2];
+    size_t          count = 0;
+    count += nsl_bench_run(&config, "log/formatted", bench_formatted, nullptr, &results[count]);
+    count += nsl_bench_run(&config, "log/deferred", bench_deferred, nullptr, &results[count]);
+    nsl_log_stop();
+    close(dev_null);
+    nsl_bench_write(stdout, config.format, results, count);
+}
@@ -0,0 +1,102 @@
+#define _DEFAULT_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/mmap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// A log file of lines between 40 and 200 bytes long. Each iteration reads one
+// line, starting over at the end of the file, so the times are per line.
+#define FILE_SIZE ((size_t)256 << 20)
+
+typedef struct Data {
+    char        *path;
+    FILE        *stream;
+    char        *line;
+    size_t       capacity;
+    NSL_MmapFile file;
+} Data;
+
+void bench_getline(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        ssize_t length = getline(&data->line, &data->capacity, data->stream);
+        if (length < 0) {
+            rewind(data->stream);
+            length = getline(&data->line, &data->capacity, data->stream);
+        }
+        nsl_bench_do_not_optimize(length);
+    }
+}
+
+void bench_mmap(NSL_Bench *bench) {
+    Data          *data = bench->arg;
+    NSL_StringView line;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (!nsl_mmap_next_line(&data->file, &line)) {
+            nsl_mmap_seek(&data->file, 0);
+            nsl_mmap_next_line(&data->file, &line);
+        }
+        nsl_bench_do_not_optimize(line.length);
+    }
+}
+
+// Runs `bench_mmap` on the file mapped with `config`.
+size_t run_mmap(const NSL_BenchConfig *bench_config,
+                const char            *name,
+                Data                  *data,
+                NSL_MmapConfig         config,
+                NSL_BenchResult       *result) {
+    if (!nsl_mmap_open(&data->file, data->path, &config)) { return 0; }
+    size_t count = nsl_bench_run(bench_config, name, bench_mmap, data, result);
+    nsl_mmap_close(&data->file);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    char path[] = "/tmp/nsl-bench-mmap-XXXXXX";
+    int  fd     = mkstemp(path);
+    if (fd < 0) { return 1; }
+    FILE *stream = fdopen(fd, "w+");
+    char  line[256];
+    srand(1);
+    for (size_t size = 0; size < FILE_SIZE;) {
+        int length  = 40 + rand() % 160;
+        int written = snprintf(line, sizeof(line), "%zu INFO request took %dus ", size, length);
+        memset(line + written, 'x', (size_t)(length - written));
+        line[length] = '\n';
+        fwrite(line, 1, (size_t)length + 1, stream);
+        size += (size_t)length + 1;
+    }
+    fflush(stream);
+
+    Data data = {.path = path, .stream = stream};
+    rewind(stream);
+
+    NSL_BenchResult results[4];
+    size_t          count = 0;
+    count += nsl_bench_run(&config, "getline/lines", bench_getline, &data, &results[count]);
+    count += run_mmap(&config, "mmap/lines", &data, (NSL_MmapConfig){}, &results[count]);
+    count += run_mmap(&config,
+                      "mmap_window/lines",
+                      &data,
+                      (NSL_MmapConfig){.window = 16 << 20, .advice = NSL_MMAP_SEQUENTIAL},
+                      &results[count]);
+    count += run_mmap(&config,
+                      "mmap_hugepage/lines",
+                      &data,
+                      (NSL_MmapConfig){.window = 16 << 20, .advice = NSL_MMAP_HUGEPAGE},
+                      &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    fclose(stream);
+    free(data.line);
+    unlink(path);
+}
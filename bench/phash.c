@@ -0,0 +1,108 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/phash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// A keyword set the size of a small protocol or language.
+static const char *const KEYWORDS[] = {
+    "ACL",       "BIND",     "CHECKIN",   "CHECKOUT",  "CONNECT",   "COPY",      "DELETE",
+    "GET",       "HEAD",     "LABEL",     "LINK",      "LOCK",      "MERGE",     "MKACTIVITY",
+    "MKCOL",     "MKWORKSPACE", "MOVE",   "OPTIONS",   "ORDERPATCH", "PATCH",    "POST",
+    "PRI",       "PROPFIND", "PROPPATCH", "PUT",       "REBIND",    "REPORT",    "SEARCH",
+    "TRACE",     "UNBIND",   "UNCHECKOUT", "UNLINK",   "UNLOCK",    "UPDATE",    "VERSION-CONTROL",
+    "auto",      "break",    "case",      "char",      "const",     "continue",  "default",
+    "do",        "double",   "else",      "enum",      "extern",    "float",     "for",
+    "goto",      "if",       "inline",    "int",       "long",      "register",  "restrict",
+    "return",    "short",    "signed",    "sizeof",    "static",    "struct",    "switch",
+    "typedef",   "union",    "unsigned",  "void",      "volatile",  "while",     "alignas",
+    "alignof",   "bool",     "constexpr", "false",     "nullptr",   "static_assert", "thread_local",
+    "true",      "typeof",   "typeof_unqual",
+};
+
+#define KEYWORD_COUNT (sizeof(KEYWORDS) / sizeof(*KEYWORDS))
+
+// Lookups alternate between keywords and identifiers that are not keywords, so
+// that both outcomes are measured.
+#define QUERY_COUNT 1024
+
+typedef struct Query {
+    const char *key;
+    size_t      length;
+} Query;
+
+typedef struct Data {
+    NSL_PerfectHash phash;
+    const char     *sorted[KEYWORD_COUNT];
+    Query           queries[QUERY_COUNT];
+    char            misses[QUERY_COUNT / 2][16];
+} Data;
+
+int compare_strings(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+void bench_phash(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        Query *query = &data->queries[i % QUERY_COUNT];
+        size_t index = nsl_phash_find(&data->phash, query->key, query->length);
+        nsl_bench_do_not_optimize(index);
+    }
+}
+
+void bench_linear(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        Query *query = &data->queries[i % QUERY_COUNT];
+        size_t index = 0;
+        while (index < KEYWORD_COUNT && strcmp(KEYWORDS[index], query->key) != 0) {
+            index++;
+        }
+        nsl_bench_do_not_optimize(index);
+    }
+}
+
+void bench_bsearch(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        Query       *query = &data->queries[i % QUERY_COUNT];
+        const char **found =
+            bsearch(&query->key, data->sorted, KEYWORD_COUNT, sizeof(char *), compare_strings);
+        nsl_bench_do_not_optimize(found);
+    }
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    static Data data;
+    if (!nsl_phash_build(&data.phash, KEYWORDS, KEYWORD_COUNT)) { return 1; }
+    memcpy(data.sorted, KEYWORDS, sizeof(KEYWORDS));
+    qsort(data.sorted, KEYWORD_COUNT, sizeof(char *), compare_strings);
+
+    srand(1);
+    for (size_t i = 0; i < QUERY_COUNT; i++) {
+        const char *key = KEYWORDS[(size_t)rand() % KEYWORD_COUNT];
+        if (i % 2 == 1) {
+            // Misses share a prefix with a keyword, so comparisons are not
+            // decided by the first character alone.
+            snprintf(data.misses[i / 2], sizeof(data.misses[i / 2]), "%.8s_%zu", key, i);
+            key = data.misses[i / 2];
+        }
+        data.queries[i] = (Query){key, strlen(key)};
+    }
+
+    NSL_BenchResult results[3];
+    size_t          count = 0;
+    count += nsl_bench_run(&config, "phash/find", bench_phash, &data, &results[count]);
+    count += nsl_bench_run(&config, "phash/linear_strcmp", bench_linear, &data, &results[count]);
+    count += nsl_bench_run(&config, "phash/bsearch", bench_bsearch, &data, &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    nsl_phash_free(&data.phash);
+}
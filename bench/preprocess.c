@@ -0,0 +1,135 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// The command used to preprocess the generated inputs. The makefile passes its
+// own compiler.
+#ifndef BENCH_CPP
+#    define BENCH_CPP "gcc -std=c23 -I. -E -P"
+#endif
+
+// Number of times each input is preprocessed. The fastest run is reported.
+#define RUNS 5
+
+// Number of times the macro call is repeated within one input, so that the
+// expansion cost is not hidden by the cost of starting the compiler.
+#define REPEAT 20
+
+typedef struct Result {
+    double ms;
+    long   tokens;
+} Result;
+
+// Counts the tokens in the preprocessed output. This is not a complete C
+// lexer, but it is close enough to catch expansions that grow unexpectedly.
+long count_tokens(FILE *f) {
+    long tokens = 0;
+    int  c      = fgetc(f);
+    while (c != EOF) {
+        if (isspace(c)) {
+            c = fgetc(f);
+        } else if (isalnum(c) || c == '_') {
+            while (c != EOF && (isalnum(c) || c == '_')) {
+                c = fgetc(f);
+            }
+            tokens++;
+        } else if (c == '"' || c == '\'') {
+            int quote = c;
+            for (c = fgetc(f); c != EOF && c != quote; c = fgetc(f)) {
+                if (c == '\\') { c = fgetc(f); }
+            }
+            c = fgetc(f);
+            tokens++;
+        } else {
+            c = fgetc(f);
+            tokens++;
+        }
+    }
+    return tokens;
+}
+
+// Writes an input to the preprocessor that calls `call` with `nargs` arguments
+// `REPEAT` times. If `call` is null, only the headers are included.
+void write_input(FILE *cpp, const char *call, int nargs) {
+    fprintf(cpp, "#include \"nonstdlib/common.h\"\n#define F(...) (__VA_ARGS__)\n");
+    for (int r = 0; call != nullptr && r < REPEAT; r++) {
+        fprintf(cpp, "%s", call);
+        for (int i = 0; i < nargs; i++) {
+            fprintf(cpp, "%sA%d", i == 0 ? "" : ", ", i);
+        }
+        fprintf(cpp, ")\n");
+    }
+}
+
+// Preprocesses the generated input `RUNS` times and returns the fastest time
+// along with the number of tokens in the output.
+Result preprocess(const char *call, int nargs) {
+    Result result = {.ms = -1.0, .tokens = 0};
+    char   path[] = "/tmp/nsl-bench-preprocess-XXXXXX";
+    int    fd     = mkstemp(path);
+    assert(fd != -1);
+    close(fd);
+
+    char cmd[256];
+    snprintf(cmd, sizeof(cmd), "%s -x c - -o %s", BENCH_CPP, path);
+    for (int run = 0; run < RUNS; run++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        FILE *cpp = popen(cmd, "w");
+        assert(cpp != nullptr);
+        write_input(cpp, call, nargs);
+        if (pclose(cpp) != 0) {
+            fprintf(stderr, "failed to preprocess %s...) with %d args\n", call ? call : "", nargs);
+            exit(1);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double ms = (double)(end.tv_sec - start.tv_sec) * 1e3
+                  + (double)(end.tv_nsec - start.tv_nsec) / 1e6;
+        if (result.ms < 0 || ms < result.ms) { result.ms = ms; }
+    }
+
+    FILE *out = fopen(path, "r");
+    assert(out != nullptr);
+    result.tokens = count_tokens(out);
+    fclose(out);
+    remove(path);
+    return result;
+}
+
+typedef struct Case {
+    const char *call;     // Macro call up to the first argument.
+    int         nargs[8]; // Argument counts to measure, terminated by 0.
+} Case;
+
+int main() {
+    Case cases[] = {
+        {"NSL_NCAT_SEP(_, ", {1, 8, 32, 127, 128, 512, 1024}},
+        {"NSL_ARG_REVERSE(", {1, 8, 32, 127, 128, 512, 1024}},
+        {"NSL_FORALL_REST(F, ", {1, 8, 32, 64, 127, 128, 200}},
+        {"NSL_SHOULD_STRIP_PREFIX(", {1, 2, 4, 8}},
+        {"NSL_SHOULD_INCLUDE_IMPLEMENTATION(", {1, 2, 4, 8}},
+    };
+
+    // The cost of starting the preprocessor and including the headers, which
+    // is subtracted from every other measurement.
+    Result baseline = preprocess(nullptr, 0);
+    printf("baseline: %.2fms, %ld tokens\n\n", baseline.ms, baseline.tokens);
+    printf("%-38s %6s %10s %12s\n", "macro", "args", "ms/call", "tokens/call");
+
+    for (unsigned long i = 0; i < sizeof(cases) / sizeof(*cases); i++) {
+        for (int j = 0; cases[i].nargs[j] != 0; j++) {
+            Result result = preprocess(cases[i].call, cases[i].nargs[j]);
+            printf("%-34s...) %6d %10.3f %12ld\n",
+                   cases[i].call,
+                   cases[i].nargs[j],
+                   (result.ms - baseline.ms) / REPEAT,
+                   (result.tokens - baseline.tokens) / REPEAT);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#define _DEFAULT_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/pretty.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// A dump of a large array of points, one point per iteration, against
+// formatting the same lines with `nsl_stream_writef`. The array never fits on
+// a line, so every point is laid out on its own line as it is printed.
+typedef struct Point {
+    int x, y;
+} Point;
+
+void pretty_point(NSL_Pretty *printer, Point point) {
+    nsl_pretty_begin(printer);
+    nsl_pretty(printer, "{x = ");
+    nsl_pretty(printer, point.x);
+    nsl_pretty(printer, ",");
+    nsl_pretty_line(printer);
+    nsl_pretty(printer, "y = ");
+    nsl_pretty(printer, point.y);
+    nsl_pretty(printer, "}");
+    nsl_pretty_end(printer);
+}
+
+#undef NSL_PRETTY_USER_TYPES
+#define NSL_PRETTY_USER_TYPES Point: pretty_point,
+
+typedef struct Data {
+    NSL_StreamWriter out;
+    NSL_Pretty       printer;
+} Data;
+
+void bench_writef(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        Point point = {(int)i, -(int)i};
+        nsl_stream_writef(&data->out, "    {x = %d, y = %d},\n", point.x, point.y);
+    }
+}
+
+void bench_pretty(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        Point point = {(int)i, -(int)i};
+        nsl_pretty(&data->printer, point);
+        nsl_pretty(&data->printer, ",");
+        nsl_pretty_line(&data->printer);
+    }
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    static Data data;
+    int         dev_null = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    nsl_stream_writer_init(&data.out, dev_null, 0);
+    nsl_pretty_init(&data.printer, &data.out, 80);
+    nsl_pretty_begin(&data.printer);
+    nsl_pretty(&data.printer, "[");
+    nsl_pretty_indent(&data.printer, 4);
+    nsl_pretty_line(&data.printer);
+
+    NSL_BenchResult results[2];
+    size_t          count = 0;
+    count += nsl_bench_run(&config, "writef/point", bench_writef, &data, &results[count]);
+    count += nsl_bench_run(&config, "pretty/point", bench_pretty, &data, &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    nsl_pretty(&data.printer, "]");
+    nsl_pretty_end(&data.printer);
+    nsl_pretty_free(&data.printer);
+    nsl_stream_writer_free(&data.out);
+    close(dev_null);
+}
@@ -0,0 +1,125 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/serialize.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// A cache entry as it would be written to a snapshot. Each iteration writes or
+// reads one entry, against the same entry as a line of text, which is what a
+// JSON encoder does for the numbers.
+NSL_SERIALIZE_DEFINE(Entry,
+                     entry,
+                     NSL_SERIALIZE_BYTES(key),
+                     NSL_SERIALIZE_U64(hits),
+                     NSL_SERIALIZE_I64(delta),
+                     NSL_SERIALIZE_F64(score))
+
+#define ENTRY_COUNT 4096
+
+typedef struct Data {
+    Entry            entries[ENTRY_COUNT];
+    char             keys[ENTRY_COUNT][16];
+    NSL_StreamWriter out;
+    char            *binary;
+    size_t           binary_length;
+    char            *text;
+    size_t           text_length;
+    size_t           position;
+} Data;
+
+void bench_write_binary(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        entry_serialize(&data->out, &data->entries[i % ENTRY_COUNT]);
+    }
+}
+
+void bench_write_text(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        const Entry *entry = &data->entries[i % ENTRY_COUNT];
+        nsl_stream_writef(&data->out,
+                          NSL_SV_FMT " %llu %lld %.17g\n",
+                          NSL_SV_ARG(entry->key),
+                          (unsigned long long)entry->hits,
+                          (long long)entry->delta,
+                          entry->score);
+    }
+}
+
+void bench_read_binary(NSL_Bench *bench) {
+    Data            *data = bench->arg;
+    NSL_Deserializer in   = {.input = {data->binary, data->binary_length}};
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (in.position == in.input.length) { in.position = 0; }
+        Entry entry = {};
+        entry_deserialize(&in, &entry);
+        nsl_bench_do_not_optimize(entry.score);
+    }
+}
+
+void bench_read_text(NSL_Bench *bench) {
+    Data *data = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        if (data->position == data->text_length) { data->position = 0; }
+        char *line     = data->text + data->position;
+        char *end      = strchr(line, ' ');
+        Entry entry    = {.key = {line, (size_t)(end - line)}};
+        entry.hits     = strtoull(end, &end, 10);
+        entry.delta    = strtoll(end, &end, 10);
+        entry.score    = strtod(end, &end);
+        data->position = (size_t)(end - data->text) + 1;
+        nsl_bench_do_not_optimize(entry.score);
+    }
+}
+
+// Writes every entry in the format of `fn` to `*buffer`.
+void capture(Data *data, NSL_BenchFn *fn, char **buffer, size_t *length) {
+    FILE *file = tmpfile();
+    nsl_stream_writer_init(&data->out, fileno(file), 0);
+    fn(&(NSL_Bench){.iterations = ENTRY_COUNT, .arg = data});
+    nsl_stream_writer_free(&data->out);
+    *length = (size_t)lseek(fileno(file), 0, SEEK_END);
+    *buffer = calloc(*length + 1, 1);
+    if (pread(fileno(file), *buffer, *length, 0) != (ssize_t)*length) { abort(); }
+    fclose(file);
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    static Data data;
+    srand(1);
+    for (size_t i = 0; i < ENTRY_COUNT; i++) {
+        int length      = snprintf(data.keys[i], sizeof(data.keys[i]), "user:%d", rand());
+        data.entries[i] = (Entry){
+            .key   = {data.keys[i], (size_t)length},
+            .hits  = (uint64_t)rand() % 100000,
+            .delta = rand() % 2000 - 1000,
+            .score = rand() / (double)RAND_MAX,
+        };
+    }
+    capture(&data, bench_write_binary, &data.binary, &data.binary_length);
+    capture(&data, bench_write_text, &data.text, &data.text_length);
+
+    NSL_BenchResult results[4];
+    size_t          count = 0;
+    nsl_stream_writer_init(&data.out, open("/dev/null", O_WRONLY | O_CLOEXEC), 0);
+    count += nsl_bench_run(&config, "binary/write", bench_write_binary, &data, &results[count]);
+    count += nsl_bench_run(&config, "text/write", bench_write_text, &data, &results[count]);
+    int dev_null = data.out.fd;
+    nsl_stream_writer_free(&data.out);
+    close(dev_null);
+    count += nsl_bench_run(&config, "binary/read", bench_read_binary, &data, &results[count]);
+    count += nsl_bench_run(&config, "text/read", bench_read_text, &data, &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    free(data.binary);
+    free(data.text);
+}
@@ -0,0 +1,127 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+#include "nonstdlib/heap.h"
+#include "nonstdlib/timer.h"
+
+#include <stdlib.h>
+
+// Ten million pending timeouts, one per connection, with deadlines spread
+// evenly over the next ten million ticks, in the timer wheel and in a 4-ary
+// heap that keeps the position of each connection. `restart` moves the
+// timeout of a random connection, as when it receives data, `start-cancel`
+// adds and cancels one more, and `tick` moves time forward by one tick,
+// which expires one timeout on average and restarts it.
+#define COUNT ((size_t)10000000)
+#define SPAN  ((uint64_t)10000000)
+
+#define less(a, b) ((a) < (b))
+
+NSL_INDEXED_HEAP_DEFINE(Deadlines, deadlines, uint64_t, less)
+
+typedef struct Connection {
+    NSL_Timer timeout;
+} Connection;
+
+typedef struct Data {
+    Connection    *connections;
+    Connection     extra;
+    NSL_TimerWheel wheel;
+    Deadlines      heap;
+    uint64_t       heap_now;
+    uint64_t       random;
+} Data;
+
+static Data data;
+
+uint64_t next_random(void) {
+    data.random ^= data.random << 13;
+    data.random ^= data.random >> 7;
+    data.random ^= data.random << 17;
+    return data.random;
+}
+
+void restart(NSL_Timer *timer) {
+    nsl_timer_start(&data.wheel, timer, data.wheel.now + SPAN, restart);
+}
+
+void bench_wheel_restart(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        Connection *connection = &data.connections[next_random() % COUNT];
+        uint64_t    deadline   = data.wheel.now + 1 + next_random() % SPAN;
+        nsl_timer_start(&data.wheel, &connection->timeout, deadline, restart);
+    }
+}
+
+void bench_heap_restart(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        size_t   id       = (size_t)(next_random() % COUNT);
+        uint64_t deadline = data.heap_now + 1 + next_random() % SPAN;
+        deadlines_update(&data.heap, id, deadline);
+    }
+}
+
+void bench_wheel_start_cancel(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        uint64_t deadline = data.wheel.now + 1 + next_random() % SPAN;
+        nsl_timer_start(&data.wheel, &data.extra.timeout, deadline, restart);
+        nsl_timer_cancel(&data.wheel, &data.extra.timeout);
+    }
+}
+
+void bench_heap_start_cancel(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        uint64_t deadline = data.heap_now + 1 + next_random() % SPAN;
+        deadlines_push(&data.heap, COUNT, deadline);
+        deadlines_remove(&data.heap, COUNT);
+    }
+}
+
+void bench_wheel_tick(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        nsl_timer_wheel_advance(&data.wheel, data.wheel.now + 1);
+    }
+}
+
+void bench_heap_tick(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        data.heap_now++;
+        while (deadlines_peek(&data.heap) <= data.heap_now) {
+            size_t id;
+            deadlines_pop(&data.heap, &id);
+            deadlines_push(&data.heap, id, data.heap_now + SPAN);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    NSL_BenchConfig config = {};
+    if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+
+    data.connections = calloc(COUNT, sizeof(Connection));
+    data.random      = 1;
+    nsl_timer_wheel_init(&data.wheel, 0);
+    deadlines_init(&data.heap);
+    for (size_t i = 0; i < COUNT; i++) {
+        uint64_t deadline = 1 + next_random() % SPAN;
+        nsl_timer_start(&data.wheel, &data.connections[i].timeout, deadline, restart);
+        deadlines_push(&data.heap, i, deadline);
+    }
+
+    NSL_BenchResult results[6];
+    size_t          count = 0;
+    count += nsl_bench_run(&config, "wheel/restart", bench_wheel_restart, &data, &results[count]);
+    count += nsl_bench_run(&config, "heap/restart", bench_heap_restart, &data, &results[count]);
+    count += nsl_bench_run(
+        &config, "wheel/start-cancel", bench_wheel_start_cancel, &data, &results[count]);
+    count += nsl_bench_run(
+        &config, "heap/start-cancel", bench_heap_start_cancel, &data, &results[count]);
+    count += nsl_bench_run(&config, "wheel/tick", bench_wheel_tick, &data, &results[count]);
+    count += nsl_bench_run(&config, "heap/tick", bench_heap_tick, &data, &results[count]);
+    nsl_bench_write(stdout, config.format, results, count);
+
+    deadlines_free(&data.heap);
+    nsl_timer_wheel_free(&data.wheel);
+    free(data.connections);
+}
@@ -0,0 +1,621 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * A command line argument parser that is generated at compile time. The
+ * options of a program are listed once in `NSL_ARGS_DEFINE`, which generates a
+ * struct with a field for each option, the help text as a single string
+ * literal, and the functions that match options with a `switch` over the
+ * short names and the index of the option. Parsing is a single pass over
+ * `argv` that never allocates: string values point into `argv`, and the
+ * positional arguments are moved to the front of `argv` in place.
+ *
+ * Options can be given as `-j 4`, `-j4`, `--jobs 4` or `--jobs=4`, and flags
+ * with short names can be combined as in `-vq`. Everything after `--` is
+ * positional, as is a lone `-`. `-h` and `--help` are recognized unless an
+ * option uses those names.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/args.h"
+ *
+ * NSL_ARGS_DEFINE(Args,
+ *                 args,
+ *                 NSL_ARGS_FLAG(verbose, v, "verbose", "Print each step."),
+ *                 NSL_ARGS_INT(jobs, j, "jobs", 4, "The number of jobs."),
+ *                 NSL_ARGS_DOUBLE(scale, , "scale", 1.0, "The scale of the output."),
+ *                 NSL_ARGS_STRING(output, o, "output", "a.out", "Where the output is written."))
+ *
+ * int main(int argc, char **argv) {
+ *     Args args;
+ *     switch (args_parse(&args, argc, argv)) {
+ *     case NSL_ARGS_OK: break;
+ *     case NSL_ARGS_HELP: args_help(stdout, argv[0]); return 0;
+ *     case NSL_ARGS_ERROR: args_help(stderr, argv[0]); return 1;
+ *     }
+ *
+ *     for (int i = 0; i < args.argc; i++) {
+ *         // args.argv[i] is a positional argument
+ *     }
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_ARGS_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_ARGS_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_ARGS_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ */
+
+#ifndef NSL_ARGS_H_
+#define NSL_ARGS_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_ARGS_VERSION_MAJOR 0
+#define NSL_ARGS_VERSION_MINOR 1
+#define NSL_ARGS_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_ARGS_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_ARGS_DEF
+#    define NSL_ARGS_DEF
+#endif  // NSL_ARGS_DEF
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * The outcome of parsing the command line.
+ */
+typedef enum NSL_ArgsResult {
+    //! Every argument was understood.
+    NSL_ARGS_OK,
+    //! `-h` or `--help` was given. The remaining arguments were not parsed.
+    NSL_ARGS_HELP,
+    //! An argument was not understood. An error has been printed using
+    //! `nsl_eprintf`.
+    NSL_ARGS_ERROR,
+} NSL_ArgsResult;
+
+/*!
+ * Declares an option that is either given or not, as a `bool` field that
+ * defaults to `false`.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ * - `short_name`: A letter or digit for the short form (e.g. `v` for `-v`), or
+ *   nothing if there is none.
+ * - `long_name`: A string literal for the long form (e.g. `"verbose"` for
+ *   `--verbose`).
+ * - `help`: A string literal describing the option.
+ */
+#define NSL_ARGS_FLAG(name, short_name, long_name, help)                                           \
+    (flag, name, short_name, long_name, false, help)
+
+/*!
+ * Declares an option that takes an integer, as an `int64_t` field. Values may
+ * be decimal, hexadecimal with `0x` or octal with `0`.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ * - `short_name`: A letter or digit for the short form, or nothing.
+ * - `long_name`: A string literal for the long form.
+ * - `default_value`: The value of the field if the option is not given.
+ * - `help`: A string literal describing the option.
+ */
+#define NSL_ARGS_INT(name, short_name, long_name, default_value, help)                             \
+    (int, name, short_name, long_name, default_value, help)
+
+/*!
+ * Declares an option that takes a number, as a `double` field.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ * - `short_name`: A letter or digit for the short form, or nothing.
+ * - `long_name`: A string literal for the long form.
+ * - `default_value`: The value of the field if the option is not given.
+ * - `help`: A string literal describing the option.
+ */
+#define NSL_ARGS_DOUBLE(name, short_name, long_name, default_value, help)                          \
+    (double, name, short_name, long_name, default_value, help)
+
+/*!
+ * Declares an option that takes a string, as a `const char *` field that
+ * points into `argv`.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ * - `short_name`: A letter or digit for the short form, or nothing.
+ * - `long_name`: A string literal for the long form.
+ * - `default_value`: The value of the field if the option is not given, which
+ *   may be `nullptr`.
+ * - `help`: A string literal describing the option.
+ */
+#define NSL_ARGS_STRING(name, short_name, long_name, default_value, help)                          \
+    (string, name, short_name, long_name, default_value, help)
+
+/*!
+ * Defines the arguments of a program. This generates:
+ *
+ * - `type`, a struct with a field for each option, and the fields `int argc`
+ *   and `char **argv` for the positional arguments.
+ * - `NSL_ArgsResult prefix_parse(type *args, int argc, char **argv)`, which
+ *   sets every field of `args` and moves the positional arguments to the
+ *   front of `argv`, after the name of the program.
+ * - `void prefix_help(FILE *file, const char *program)`, which writes the
+ *   usage and the description of every option.
+ *
+ * The functions are `static`, so this is meant to be used in the file that
+ * holds `main`.
+ *
+ * # Parameters
+ * - `type`: The name of the generated struct.
+ * - `prefix`: The prefix of the generated functions.
+ * - `...`: The options, each declared with `NSL_ARGS_FLAG`, `NSL_ARGS_INT`,
+ *   `NSL_ARGS_DOUBLE` or `NSL_ARGS_STRING`.
+ *
+ * # Requires
+ * - There is at least one option and at most 256.
+ * - The short and long names are unique.
+ */
+#define NSL_ARGS_DEFINE(type, prefix, ...)                                                         \
+    typedef struct type {                                                                          \
+        NSL_NSEP(;, NSL_FOREACH(NSL__ARGS_FIELD, __VA_ARGS__));                                    \
+        int    argc;                                                                               \
+        char **argv;                                                                               \
+    } type;                                                                                        \
+                                                                                                   \
+    [[maybe_unused]] static int NSL_CAT(prefix, _find_short)(char c) {                             \
+        switch (c) {                                                                               \
+            NSL_NSEP(, NSL_FOREACH_I(NSL__ARGS_SHORT_CASE, __VA_ARGS__))                           \
+        default: return -1;                                                                        \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static int NSL_CAT(prefix, _find_long)(const char *text, size_t length) {     \
+        NSL_NSEP(, NSL_FOREACH_I(NSL__ARGS_LONG_CASE, __VA_ARGS__))                                \
+        return -1;                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static bool NSL_CAT(prefix, _set)(void *opaque, int index,                    \
+                                                       const char *value) {                        \
+        type *args = opaque;                                                                       \
+        switch (index) {                                                                           \
+            NSL_NSEP(, NSL_FOREACH_I(NSL__ARGS_SET_CASE, __VA_ARGS__))                             \
+        default: return false;                                                                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static NSL_ArgsResult NSL_CAT(prefix, _parse)(type *args, int argc,           \
+                                                                   char **argv) {                  \
+        static const bool takes_value[] = {NSL_FOREACH(NSL__ARGS_TAKES_VALUE, __VA_ARGS__)};       \
+        static const NSL__ArgsSpec spec = {                                                        \
+            NSL_CAT(prefix, _find_short),                                                          \
+            NSL_CAT(prefix, _find_long),                                                           \
+            NSL_CAT(prefix, _set),                                                                 \
+            takes_value,                                                                           \
+        };                                                                                         \
+        *args      = (type){NSL_FOREACH(NSL__ARGS_DEFAULT, __VA_ARGS__)};                          \
+        args->argv = argv + (argc > 0);                                                            \
+        return nsl__args_parse(&spec, args, argc, argv, &args->argc);                              \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _help)(FILE *file, const char *program) {         \
+        fprintf(file,                                                                              \
+                "usage: %s [options] [arguments]\n\noptions:\n%s",                                 \
+                program,                                                                           \
+                NSL_NSEP(, NSL_FOREACH(NSL__ARGS_HELP, __VA_ARGS__))                               \
+                "  -h, --help\n        Print this help.\n");                                       \
+    }
+
+// The generated functions that the parsing loop calls.
+typedef struct NSL__ArgsSpec {
+    int (*find_short)(char c);
+    int (*find_long)(const char *text, size_t length);
+    bool (*set)(void *args, int index, const char *value);
+    const bool *takes_value;
+} NSL__ArgsSpec;
+
+NSL_ARGS_DEF NSL_ArgsResult
+nsl__args_parse(const NSL__ArgsSpec *spec, void *args, int argc, char **argv, int *positional);
+NSL_ARGS_DEF bool nsl__args_set_flag(bool *field, const char *value);
+NSL_ARGS_DEF bool nsl__args_set_int(int64_t *field, const char *value);
+NSL_ARGS_DEF bool nsl__args_set_double(double *field, const char *value);
+NSL_ARGS_DEF bool nsl__args_set_string(const char **field, const char *value);
+
+// Each option is a tuple of its kind, name, short name, long name, default
+// and help. `NSL__ARGS_APPLY` unpacks the tuple into the arguments of a macro.
+#define NSL__ARGS_APPLY(macro, ...)       macro(__VA_ARGS__)
+#define NSL__ARGS_UNPACK(...)             __VA_ARGS__
+#define NSL__ARGS_STR(x)                  NSL__ARGS_STR_(x)
+#define NSL__ARGS_STR_(x)                 #x
+
+#define NSL__ARGS_FIELD(option)           NSL__ARGS_APPLY(NSL__ARGS_FIELD_, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_FIELD_(kind, name, s, l, d, h) NSL_CAT(NSL__ARGS_TYPE_, kind) name
+#define NSL__ARGS_TYPE_flag               bool
+#define NSL__ARGS_TYPE_int                int64_t
+#define NSL__ARGS_TYPE_double             double
+#define NSL__ARGS_TYPE_string             const char *
+
+#define NSL__ARGS_DEFAULT(option)                                                                  \
+    NSL__ARGS_APPLY(NSL__ARGS_DEFAULT_, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_DEFAULT_(kind, name, s, l, d, h) .name = d
+
+#define NSL__ARGS_TAKES_VALUE(option)                                                              \
+    NSL__ARGS_APPLY(NSL__ARGS_TAKES_VALUE_, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_TAKES_VALUE_(kind, name, s, l, d, h) NSL_CAT(NSL__ARGS_TAKES_VALUE_, kind)
+#define NSL__ARGS_TAKES_VALUE_flag        false
+#define NSL__ARGS_TAKES_VALUE_int         true
+#define NSL__ARGS_TAKES_VALUE_double      true
+#define NSL__ARGS_TAKES_VALUE_string      true
+
+#define NSL__ARGS_SHORT_CASE(i, option)                                                            \
+    NSL__ARGS_APPLY(NSL__ARGS_SHORT_CASE_, i, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_SHORT_CASE_(i, kind, name, s, l, d, h) NSL_CAT(NSL__ARGS_SHORT_, s)(i)
+
+#define NSL__ARGS_LONG_CASE(i, option)                                                             \
+    NSL__ARGS_APPLY(NSL__ARGS_LONG_CASE_, i, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_LONG_CASE_(i, kind, name, s, l, d, h)                                            \
+    if (length == sizeof(l) - 1 && memcmp(text, l, length) == 0) { return i; }
+
+#define NSL__ARGS_SET_CASE(i, option)                                                              \
+    NSL__ARGS_APPLY(NSL__ARGS_SET_CASE_, i, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_SET_CASE_(i, kind, name, s, l, d, h)                                             \
+    case i: return NSL_CAT(nsl__args_set_, kind)(&args->name, value);
+
+#define NSL__ARGS_HELP(option)            NSL__ARGS_APPLY(NSL__ARGS_HELP_, NSL__ARGS_UNPACK option)
+#define NSL__ARGS_HELP_(kind, name, s, l, d, h)                                                    \
+    "  " NSL_CAT(NSL__ARGS_SHORT_HELP_, s)() "--" l NSL_CAT(NSL__ARGS_VALUE_, kind) "\n        " h \
+        NSL_CAT(NSL__ARGS_HELP_DEFAULT_, kind)(d) "\n"
+#define NSL__ARGS_VALUE_flag              ""
+#define NSL__ARGS_VALUE_int               "=INT"
+#define NSL__ARGS_VALUE_double            "=NUMBER"
+#define NSL__ARGS_VALUE_string            "=STRING"
+#define NSL__ARGS_HELP_DEFAULT_flag(d)    ""
+#define NSL__ARGS_HELP_DEFAULT_int(d)     " (default: " NSL__ARGS_STR(d) ")"
+#define NSL__ARGS_HELP_DEFAULT_double(d)  " (default: " NSL__ARGS_STR(d) ")"
+#define NSL__ARGS_HELP_DEFAULT_string(d)  " (default: " NSL__ARGS_STR(d) ")"
+
+// The case of the short name switch, and the start of the help line, for each
+// letter and digit. An option without a short name has neither.
+// clang-format off
+#define NSL__ARGS_SHORT_(i)
+#define NSL__ARGS_SHORT_a(i) case 'a': return i;
+#define NSL__ARGS_SHORT_b(i) case 'b': return i;
+#define NSL__ARGS_SHORT_c(i) case 'c': return i;
+#define NSL__ARGS_SHORT_d(i) case 'd': return i;
+#define NSL__ARGS_SHORT_e(i) case 'e': return i;
+#define NSL__ARGS_SHORT_f(i) case 'f': return i;
+#define NSL__ARGS_SHORT_g(i) case 'g': return i;
+#define NSL__ARGS_SHORT_h(i) case 'h': return i;
+#define NSL__ARGS_SHORT_i(i) case 'i': return i;
+#define NSL__ARGS_SHORT_j(i) case 'j': return i;
+#define NSL__ARGS_SHORT_k(i) case 'k': return i;
+#define NSL__ARGS_SHORT_l(i) case 'l': return i;
+#define NSL__ARGS_SHORT_m(i) case 'm': return i;
+#define NSL__ARGS_SHORT_n(i) case 'n': return i;
+#define NSL__ARGS_SHORT_o(i) case 'o': return i;
+#define NSL__ARGS_SHORT_p(i) case 'p': return i;
+#define NSL__ARGS_SHORT_q(i) case 'q': return i;
+#define NSL__ARGS_SHORT_r(i) case 'r': return i;
+#define NSL__ARGS_SHORT_s(i) case 's': return i;
+#define NSL__ARGS_SHORT_t(i) case 't': return i;
+#define NSL__ARGS_SHORT_u(i) case 'u': return i;
+#define NSL__ARGS_SHORT_v(i) case 'v': return i;
+#define NSL__ARGS_SHORT_w(i) case 'w': return i;
+#define NSL__ARGS_SHORT_x(i) case 'x': return i;
+#define NSL__ARGS_SHORT_y(i) case 'y': return i;
+#define NSL__ARGS_SHORT_z(i) case 'z': return i;
+#define NSL__ARGS_SHORT_A(i) case 'A': return i;
+#define NSL__ARGS_SHORT_B(i) case 'B': return i;
+#define NSL__ARGS_SHORT_C(i) case 'C': return i;
+#define NSL__ARGS_SHORT_D(i) case 'D': return i;
+#define NSL__ARGS_SHORT_E(i) case 'E': return i;
+#define NSL__ARGS_SHORT_F(i) case 'F': return i;
+#define NSL__ARGS_SHORT_G(i) case 'G': return i;
+#define NSL__ARGS_SHORT_H(i) case 'H': return i;
+#define NSL__ARGS_SHORT_I(i) case 'I': return i;
+#define NSL__ARGS_SHORT_J(i) case 'J': return i;
+#define NSL__ARGS_SHORT_K(i) case 'K': return i;
+#define NSL__ARGS_SHORT_L(i) case 'L': return i;
+#define NSL__ARGS_SHORT_M(i) case 'M': return i;
+#define NSL__ARGS_SHORT_N(i) case 'N': return i;
+#define NSL__ARGS_SHORT_O(i) case 'O': return i;
+#define NSL__ARGS_SHORT_P(i) case 'P': return i;
+#define NSL__ARGS_SHORT_Q(i) case 'Q': return i;
+#define NSL__ARGS_SHORT_R(i) case 'R': return i;
+#define NSL__ARGS_SHORT_S(i) case 'S': return i;
+#define NSL__ARGS_SHORT_T(i) case 'T': return i;
+#define NSL__ARGS_SHORT_U(i) case 'U': return i;
+#define NSL__ARGS_SHORT_V(i) case 'V': return i;
+#define NSL__ARGS_SHORT_W(i) case 'W': return i;
+#define NSL__ARGS_SHORT_X(i) case 'X': return i;
+#define NSL__ARGS_SHORT_Y(i) case 'Y': return i;
+#define NSL__ARGS_SHORT_Z(i) case 'Z': return i;
+#define NSL__ARGS_SHORT_0(i) case '0': return i;
+#define NSL__ARGS_SHORT_1(i) case '1': return i;
+#define NSL__ARGS_SHORT_2(i) case '2': return i;
+#define NSL__ARGS_SHORT_3(i) case '3': return i;
+#define NSL__ARGS_SHORT_4(i) case '4': return i;
+#define NSL__ARGS_SHORT_5(i) case '5': return i;
+#define NSL__ARGS_SHORT_6(i) case '6': return i;
+#define NSL__ARGS_SHORT_7(i) case '7': return i;
+#define NSL__ARGS_SHORT_8(i) case '8': return i;
+#define NSL__ARGS_SHORT_9(i) case '9': return i;
+#define NSL__ARGS_SHORT_HELP_() "    "
+#define NSL__ARGS_SHORT_HELP_a() "-a, "
+#define NSL__ARGS_SHORT_HELP_b() "-b, "
+#define NSL__ARGS_SHORT_HELP_c() "-c, "
+#define NSL__ARGS_SHORT_HELP_d() "-d, "
+#define NSL__ARGS_SHORT_HELP_e() "-e, "
+#define NSL__ARGS_SHORT_HELP_f() "-f, "
+#define NSL__ARGS_SHORT_HELP_g() "-g, "
+#define NSL__ARGS_SHORT_HELP_h() "-h, "
+#define NSL__ARGS_SHORT_HELP_i() "-i, "
+#define NSL__ARGS_SHORT_HELP_j() "-j, "
+#define NSL__ARGS_SHORT_HELP_k() "-k, "
+#define NSL__ARGS_SHORT_HELP_l() "-l, "
+#define NSL__ARGS_SHORT_HELP_m() "-m, "
+#define NSL__ARGS_SHORT_HELP_n() "-n, "
+#define NSL__ARGS_SHORT_HELP_o() "-o, "
+#define NSL__ARGS_SHORT_HELP_p() "-p, "
+#define NSL__ARGS_SHORT_HELP_q() "-q, "
+#define NSL__ARGS_SHORT_HELP_r() "-r, "
+#define NSL__ARGS_SHORT_HELP_s() "-s, "
+#define NSL__ARGS_SHORT_HELP_t() "-t, "
+#define NSL__ARGS_SHORT_HELP_u() "-u, "
+#define NSL__ARGS_SHORT_HELP_v() "-v, "
+#define NSL__ARGS_SHORT_HELP_w() "-w, "
+#define NSL__ARGS_SHORT_HELP_x() "-x, "
+#define NSL__ARGS_SHORT_HELP_y() "-y, "
+#define NSL__ARGS_SHORT_HELP_z() "-z, "
+#define NSL__ARGS_SHORT_HELP_A() "-A, "
+#define NSL__ARGS_SHORT_HELP_B() "-B, "
+#define NSL__ARGS_SHORT_HELP_C() "-C, "
+#define NSL__ARGS_SHORT_HELP_D() "-D, "
+#define NSL__ARGS_SHORT_HELP_E() "-E, "
+#define NSL__ARGS_SHORT_HELP_F() "-F, "
+#define NSL__ARGS_SHORT_HELP_G() "-G, "
+#define NSL__ARGS_SHORT_HELP_H() "-H, "
+#define NSL__ARGS_SHORT_HELP_I() "-I, "
+#define NSL__ARGS_SHORT_HELP_J() "-J, "
+#define NSL__ARGS_SHORT_HELP_K() "-K, "
+#define NSL__ARGS_SHORT_HELP_L() "-L, "
+#define NSL__ARGS_SHORT_HELP_M() "-M, "
+#define NSL__ARGS_SHORT_HELP_N() "-N, "
+#define NSL__ARGS_SHORT_HELP_O() "-O, "
+#define NSL__ARGS_SHORT_HELP_P() "-P, "
+#define NSL__ARGS_SHORT_HELP_Q() "-Q, "
+#define NSL__ARGS_SHORT_HELP_R() "-R, "
+#define NSL__ARGS_SHORT_HELP_S() "-S, "
+#define NSL__ARGS_SHORT_HELP_T() "-T, "
+#define NSL__ARGS_SHORT_HELP_U() "-U, "
+#define NSL__ARGS_SHORT_HELP_V() "-V, "
+#define NSL__ARGS_SHORT_HELP_W() "-W, "
+#define NSL__ARGS_SHORT_HELP_X() "-X, "
+#define NSL__ARGS_SHORT_HELP_Y() "-Y, "
+#define NSL__ARGS_SHORT_HELP_Z() "-Z, "
+#define NSL__ARGS_SHORT_HELP_0() "-0, "
+#define NSL__ARGS_SHORT_HELP_1() "-1, "
+#define NSL__ARGS_SHORT_HELP_2() "-2, "
+#define NSL__ARGS_SHORT_HELP_3() "-3, "
+#define NSL__ARGS_SHORT_HELP_4() "-4, "
+#define NSL__ARGS_SHORT_HELP_5() "-5, "
+#define NSL__ARGS_SHORT_HELP_6() "-6, "
+#define NSL__ARGS_SHORT_HELP_7() "-7, "
+#define NSL__ARGS_SHORT_HELP_8() "-8, "
+#define NSL__ARGS_SHORT_HELP_9() "-9, "
+// clang-format on
+
+#endif  // NSL_ARGS_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(ARGS)
+#    ifndef NSL_ARGS_IMPLEMENTATION_GUARD_
+#        define NSL_ARGS_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <stdlib.h>
+
+NSL_ARGS_DEF bool nsl__args_set_flag(bool *field, const char *value) {
+    *field = true;
+    return value == nullptr;
+}
+
+NSL_ARGS_DEF bool nsl__args_set_int(int64_t *field, const char *value) {
+    char *end = nullptr;
+    errno     = 0;
+    long long result = strtoll(value, &end, 0);
+    if (end == value || *end != '\0' || errno == ERANGE) { return false; }
+    *field = result;
+    return true;
+}
+
+NSL_ARGS_DEF bool nsl__args_set_double(double *field, const char *value) {
+    char *end = nullptr;
+    errno     = 0;
+    double result = strtod(value, &end);
+    if (end == value || *end != '\0' || errno == ERANGE) { return false; }
+    *field = result;
+    return true;
+}
+
+NSL_ARGS_DEF bool nsl__args_set_string(const char **field, const char *value) {
+    *field = value;
+    return true;
+}
+
+NSL_ARGS_DEF NSL_ArgsResult
+nsl__args_parse(const NSL__ArgsSpec *spec, void *args, int argc, char **argv, int *positional) {
+    const char *program = argc > 0 ? argv[0] : "";
+    int         count   = 0;
+    bool        options = true;
+    for (int i = 1; i < argc; i++) {
+        char *arg = argv[i];
+        if (!options || arg[0] != '-' || arg[1] == '\0') {
+            // Positional arguments are only ever moved backwards, into slots
+            // that have already been read.
+            argv[1 + count++] = arg;
+            continue;
+        }
+
+        if (arg[1] == '-') {
+            if (arg[2] == '\0') {
+                options = false;
+                continue;
+            }
+            const char *name   = arg + 2;
+            const char *equals = strchr(name, '=');
+            size_t      length = equals == nullptr ? strlen(name) : (size_t)(equals - name);
+            int         index  = spec->find_long(name, length);
+            if (index < 0 && length == 4 && memcmp(name, "help", 4) == 0) { return NSL_ARGS_HELP; }
+            if (index < 0) {
+                nsl_eprintf("%s: unknown option '%.*s'\n", program, (int)(length + 2), arg);
+                return NSL_ARGS_ERROR;
+            }
+            const char *value = equals == nullptr ? nullptr : equals + 1;
+            if (spec->takes_value[index] && value == nullptr) {
+                if (i + 1 == argc) {
+                    nsl_eprintf("%s: option '%s' needs a value\n", program, arg);
+                    return NSL_ARGS_ERROR;
+                }
+                value = argv[++i];
+            }
+            if (!spec->set(args, index, value)) {
+                if (value == nullptr) { value = ""; }
+                nsl_eprintf("%s: invalid value '%s' for option '%.*s'\n",
+                            program,
+                            value,
+                            (int)(length + 2),
+                            arg);
+                return NSL_ARGS_ERROR;
+            }
+            continue;
+        }
+
+        // A cluster of short options, where the first that takes a value
+        // takes the rest of the cluster or the next argument.
+        for (const char *c = arg + 1; *c != '\0'; c++) {
+            int index = spec->find_short(*c);
+            if (index < 0 && *c == 'h') { return NSL_ARGS_HELP; }
+            if (index < 0) {
+                nsl_eprintf("%s: unknown option '-%c'\n", program, *c);
+                return NSL_ARGS_ERROR;
+            }
+            const char *value = nullptr;
+            if (spec->takes_value[index]) {
+                if (c[1] != '\0') {
+                    value = c + 1;
+                } else if (i + 1 < argc) {
+                    value = argv[++i];
+                } else {
+                    nsl_eprintf("%s: option '-%c' needs a value\n", program, *c);
+                    return NSL_ARGS_ERROR;
+                }
+            }
+            if (!spec->set(args, index, value)) {
+                nsl_eprintf("%s: invalid value '%s' for option '-%c'\n", program, value, *c);
+                return NSL_ARGS_ERROR;
+            }
+            if (value != nullptr) { break; }
+        }
+    }
+    *positional = count;
+    return NSL_ARGS_OK;
+}
+
+#    endif  // NSL_ARGS_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(ARGS)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(ARGS)
+#    ifndef NSL_ARGS_STRIP_PREFIX_GUARD_
+#        define NSL_ARGS_STRIP_PREFIX_GUARD_
+
+#        define ArgsResult  NSL_ArgsResult
+#        define ARGS_OK     NSL_ARGS_OK
+#        define ARGS_HELP   NSL_ARGS_HELP
+#        define ARGS_ERROR  NSL_ARGS_ERROR
+#        define ARGS_FLAG   NSL_ARGS_FLAG
+#        define ARGS_INT    NSL_ARGS_INT
+#        define ARGS_DOUBLE NSL_ARGS_DOUBLE
+#        define ARGS_STRING NSL_ARGS_STRING
+#        define ARGS_DEFINE NSL_ARGS_DEFINE
+
+#    endif  // NSL_ARGS_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(ARGS)
@@ -0,0 +1,619 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * A microbenchmark harness. Each benchmark is a function that runs the code
+ * being measured `bench->iterations` times. `nsl_bench_run` warms it up,
+ * scales the number of iterations until each sample takes long enough to be
+ * measured accurately, and then takes a number of samples. The median, 99th
+ * percentile, mean, standard deviation and minimum time per iteration are
+ * reported, along with the number of cycles per iteration.
+ *
+ * `nsl_bench_do_not_optimize` and `nsl_bench_clobber_memory` prevent the
+ * compiler from removing the code being measured. `nsl_bench_pause` and
+ * `nsl_bench_resume` exclude setup from the measurement.
+ *
+ * Results can be written as a table for reading, or as CSV or JSON for
+ * tracking over time with `nsl_bench_write`. `nsl_bench_parse_args` reads the
+ * common options from the command line, so that every benchmark program
+ * accepts the same ones.
+ *
+ * Benchmarks should be built with optimizations and without sanitizers. `make
+ * bench` builds and runs the benchmarks in `bench/` this way.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _GNU_SOURCE
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/bench.h"
+ *
+ * void bench_sum(NSL_Bench *bench) {
+ *     int *values = bench->arg;
+ *     for (uint64_t i = 0; i < bench->iterations; i++) {
+ *         int sum = 0;
+ *         for (int j = 0; j < 1000; j++) {
+ *             sum += values[j];
+ *         }
+ *         nsl_bench_do_not_optimize(sum);
+ *     }
+ * }
+ *
+ * int main(int argc, char **argv) {
+ *     NSL_BenchConfig config = {};
+ *     if (!nsl_bench_parse_args(&config, argc, argv)) { return 1; }
+ *
+ *     static int      values[1000];
+ *     NSL_BenchResult results[1];
+ *     size_t          count = 0;
+ *     count += nsl_bench_run(&config, "sum", bench_sum, values, &results[count]);
+ *     nsl_bench_write(stdout, config.format, results, count);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_BENCH_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_BENCH_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_BENCH_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_BENCH_MAX_SAMPLES`: The maximum number of samples taken for each
+ *   benchmark.
+ */
+
+#ifndef NSL_BENCH_H_
+#define NSL_BENCH_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_BENCH_VERSION_MAJOR 0
+#define NSL_BENCH_VERSION_MINOR 1
+#define NSL_BENCH_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_BENCH_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_BENCH_DEF
+#    define NSL_BENCH_DEF
+#endif  // NSL_BENCH_DEF
+
+/*!
+ * `NSL_BENCH_MAX_SAMPLES` is the maximum number of samples taken for each
+ * benchmark. Larger values given to `nsl_bench_run` are clamped to it.
+ */
+#ifndef NSL_BENCH_MAX_SAMPLES
+#    define NSL_BENCH_MAX_SAMPLES 1000
+#endif  // NSL_BENCH_MAX_SAMPLES
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * How results are written by `nsl_bench_write`.
+ */
+typedef enum NSL_BenchFormat {
+    //! An aligned table for reading.
+    NSL_BENCH_FORMAT_TABLE,
+    //! Comma separated values with a header row.
+    NSL_BENCH_FORMAT_CSV,
+    //! An array of JSON objects.
+    NSL_BENCH_FORMAT_JSON,
+} NSL_BenchFormat;
+
+/*!
+ * How benchmarks are run. Fields that are zero use their defaults.
+ */
+typedef struct NSL_BenchConfig {
+    //! The total time spent taking samples, in milliseconds. Defaults to 500.
+    double min_time_ms;
+    //! The time spent running the benchmark before sampling, in milliseconds.
+    //! Defaults to 100.
+    double warmup_ms;
+    //! The number of samples to take. Defaults to 30.
+    size_t samples;
+    //! Whether the benchmarking thread is pinned to `cpu`.
+    bool pin;
+    //! The CPU that the benchmarking thread is pinned to if `pin` is set.
+    int cpu;
+    //! How results are written.
+    NSL_BenchFormat format;
+    //! If not `nullptr`, only benchmarks whose name contains it are run.
+    const char *filter;
+} NSL_BenchConfig;
+
+/*!
+ * The state of a running benchmark, which is passed to the benchmark function.
+ */
+typedef struct NSL_Bench {
+    //! The number of times the code being measured should run.
+    uint64_t iterations;
+    //! The argument given to `nsl_bench_run`.
+    void *arg;
+    //! Private: when the current measurement started or was resumed.
+    uint64_t start_ns;
+    //! Private: the time measured so far, excluding pauses.
+    uint64_t elapsed_ns;
+    //! Private: the cycles counted so far, excluding pauses.
+    uint64_t cycles;
+    //! Private: the cycle counter when the measurement started or was resumed.
+    uint64_t start_cycles;
+} NSL_Bench;
+
+/*!
+ * A benchmark function. It should run the code being measured
+ * `bench->iterations` times.
+ */
+typedef void NSL_BenchFn(NSL_Bench *bench);
+
+/*!
+ * The result of running a benchmark. Times are per iteration.
+ */
+typedef struct NSL_BenchResult {
+    //! The name given to `nsl_bench_run`.
+    const char *name;
+    //! The number of iterations in each sample.
+    uint64_t iterations;
+    //! The number of samples taken.
+    size_t samples;
+    //! The median time in nanoseconds.
+    double median_ns;
+    //! The 99th percentile time in nanoseconds.
+    double p99_ns;
+    //! The mean time in nanoseconds.
+    double mean_ns;
+    //! The standard deviation of the time in nanoseconds.
+    double stddev_ns;
+    //! The minimum time in nanoseconds.
+    double min_ns;
+    //! The median number of cycles. On x86-64 these are cycles of the time
+    //! stamp counter, which runs at a constant rate regardless of the clock
+    //! speed of the core. Elsewhere, this is 0.
+    double cycles;
+} NSL_BenchResult;
+
+/*!
+ * Prevents the compiler from optimizing away the computation of `value`, by
+ * making it appear to be read by code the compiler cannot see.
+ *
+ * # Parameters
+ * - `value`: The value to keep.
+ */
+#define nsl_bench_do_not_optimize(value) __asm__ volatile("" : : "r,m"(value) : "memory")
+
+/*!
+ * Prevents the compiler from optimizing away writes to memory, or from moving
+ * reads and writes across this point, by making all memory appear to be read
+ * and written by code the compiler cannot see.
+ */
+#define nsl_bench_clobber_memory() __asm__ volatile("" : : : "memory")
+
+/*!
+ * Runs a benchmark and measures it.
+ *
+ * # Parameters
+ * - `config`: How the benchmark is run, or `nullptr` to use the defaults.
+ * - `name`: The name of the benchmark.
+ * - `fn`: The benchmark function.
+ * - `arg`: Passed to `fn` as `bench->arg`.
+ * - `result`: Where the result is written.
+ *
+ * # Modifies
+ * - `result`: Set to the result of the benchmark, if it was run.
+ *
+ * # Returns
+ * `true` if the benchmark was run, or `false` if it did not match
+ * `config->filter`.
+ */
+NSL_BENCH_DEF bool nsl_bench_run(const NSL_BenchConfig *config,
+                                 const char            *name,
+                                 NSL_BenchFn           *fn,
+                                 void                  *arg,
+                                 NSL_BenchResult       *result);
+
+/*!
+ * Stops measuring the current iteration, so that setup can be excluded.
+ *
+ * # Parameters
+ * - `bench`: The running benchmark.
+ *
+ * # Requires
+ * - The benchmark is not already paused.
+ */
+NSL_BENCH_DEF void nsl_bench_pause(NSL_Bench *bench);
+
+/*!
+ * Starts measuring again after `nsl_bench_pause`.
+ *
+ * # Parameters
+ * - `bench`: The running benchmark.
+ *
+ * # Requires
+ * - The benchmark is paused.
+ */
+NSL_BENCH_DEF void nsl_bench_resume(NSL_Bench *bench);
+
+/*!
+ * Writes results in the given format.
+ *
+ * # Parameters
+ * - `file`: Where the results are written.
+ * - `format`: How the results are written.
+ * - `results`: The results to write.
+ * - `count`: The number of results.
+ */
+// Writes a name as a quoted CSV field or JSON string. CSV doubles quotes, and
+// JSON escapes quotes, backslashes and control characters.
+static void nsl__bench_write_name(FILE *file, NSL_BenchFormat format, const char *name) {
+    fputc('"', file);
+    for (const char *c = name; *c != '\0'; c++) {
+        unsigned char byte = (unsigned char)*c;
+        if (format == NSL_BENCH_FORMAT_CSV) {
+            if (byte == '"') { fputc('"', file); }
+            fputc(byte, file);
+        } else if (byte == '"' || byte == '\\') {
+            fprintf(file, "\\%c", byte);
+        } else if (byte < 0x20) {
+            fprintf(file, "\\u%04x", byte);
+        } else {
+            fputc(byte, file);
+        }
+    }
+    fputc('"', file);
+}
+
+NSL_BENCH_DEF void nsl_bench_write(FILE                  *file,
+                                   NSL_BenchFormat        format,
+                                   const NSL_BenchResult *results,
+                                   size_t                 count);
+
+/*!
+ * Reads the common benchmark options from the command line. The options are
+ * `--csv`, `--json`, `--cpu=N`, `--samples=N`, `--min-time=MS`, `--warmup=MS`
+ * and `--filter=TEXT`. An error is printed using `nsl_eprintf` for anything
+ * else.
+ *
+ * # Parameters
+ * - `config`: The configuration to update.
+ * - `argc`: The number of arguments.
+ * - `argv`: The arguments, starting with the name of the program.
+ *
+ * # Modifies
+ * - `config`: Updated with the options that were given.
+ *
+ * # Returns
+ * `true` if every option was understood, `false` otherwise.
+ */
+NSL_BENCH_DEF bool nsl_bench_parse_args(NSL_BenchConfig *config, int argc, char **argv);
+
+#endif  // NSL_BENCH_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(BENCH)
+#    ifndef NSL_BENCH_IMPLEMENTATION_GUARD_
+#        define NSL_BENCH_IMPLEMENTATION_GUARD_
+
+#        include <math.h>
+#        include <sched.h>
+#        include <stdlib.h>
+#        include <string.h>
+#        include <time.h>
+
+static uint64_t nsl__bench_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t nsl__bench_cycles(void) {
+#        if defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#        else
+    return 0;
+#        endif
+}
+
+NSL_BENCH_DEF void nsl_bench_pause(NSL_Bench *bench) {
+    uint64_t cycles     = nsl__bench_cycles();
+    bench->elapsed_ns  += nsl__bench_now() - bench->start_ns;
+    bench->cycles      += cycles - bench->start_cycles;
+}
+
+NSL_BENCH_DEF void nsl_bench_resume(NSL_Bench *bench) {
+    bench->start_ns     = nsl__bench_now();
+    bench->start_cycles = nsl__bench_cycles();
+}
+
+// Runs `iterations` iterations of the benchmark and returns the measured time
+// and cycles.
+static NSL_Bench nsl__bench_sample(NSL_BenchFn *fn, void *arg, uint64_t iterations) {
+    NSL_Bench bench = {.iterations = iterations, .arg = arg};
+    nsl_bench_resume(&bench);
+    fn(&bench);
+    nsl_bench_pause(&bench);
+    return bench;
+}
+
+// Pins the current thread to `cpu`. This needs `_GNU_SOURCE` to be defined
+// before any header is included, and is skipped otherwise.
+static void nsl__bench_pin(int cpu) {
+#        if defined(CPU_SET)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        nsl_eprintf("[BENCH] could not pin to cpu %d\n", cpu);
+    }
+#        else
+    nsl_eprintf("[BENCH] pinning to cpu %d needs _GNU_SOURCE\n", cpu);
+#        endif
+}
+
+static int nsl__bench_compare(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+NSL_BENCH_DEF bool nsl_bench_run(const NSL_BenchConfig *config,
+                                 const char            *name,
+                                 NSL_BenchFn           *fn,
+                                 void                  *arg,
+                                 NSL_BenchResult       *result) {
+    NSL_BenchConfig c = config == nullptr ? (NSL_BenchConfig){} : *config;
+    if (c.filter != nullptr && strstr(name, c.filter) == nullptr) { return false; }
+    if (c.min_time_ms <= 0) { c.min_time_ms = 500; }
+    if (c.warmup_ms <= 0) { c.warmup_ms = 100; }
+    if (c.samples == 0) { c.samples = 30; }
+    if (c.samples > NSL_BENCH_MAX_SAMPLES) { c.samples = NSL_BENCH_MAX_SAMPLES; }
+    if (c.pin) { nsl__bench_pin(c.cpu); }
+
+    // Warm up the caches and branch predictors, doubling the iterations until
+    // the warmup time has passed.
+    uint64_t iterations = 1;
+    uint64_t warmup_end = nsl__bench_now() + (uint64_t)(c.warmup_ms * 1e6);
+    while (nsl__bench_now() < warmup_end) {
+        nsl__bench_sample(fn, arg, iterations);
+        if (iterations < (1ull << 40)) { iterations *= 2; }
+    }
+
+    // Scale the iterations so that one sample takes its share of the total
+    // time, growing by at most 10 times per step in case the first samples
+    // were unusually fast.
+    double   target = c.min_time_ms * 1e6 / (double)c.samples;
+    for (iterations = 1;;) {
+        uint64_t elapsed = nsl__bench_sample(fn, arg, iterations).elapsed_ns;
+        if ((double)elapsed >= target || iterations >= (1ull << 40)) { break; }
+        double scale = elapsed == 0 ? 10.0 : 1.2 * target / (double)elapsed;
+        iterations   = (uint64_t)((double)iterations * (scale > 10.0 ? 10.0 : scale)) + 1;
+    }
+
+    static double times[NSL_BENCH_MAX_SAMPLES];
+    static double cycles[NSL_BENCH_MAX_SAMPLES];
+    double        sum = 0.0;
+    for (size_t i = 0; i < c.samples; i++) {
+        NSL_Bench bench = nsl__bench_sample(fn, arg, iterations);
+        times[i]        = (double)bench.elapsed_ns / (double)iterations;
+        cycles[i]       = (double)bench.cycles / (double)iterations;
+        sum            += times[i];
+    }
+
+    double mean     = sum / (double)c.samples;
+    double variance = 0.0;
+    for (size_t i = 0; i < c.samples; i++) {
+        variance += (times[i] - mean) * (times[i] - mean);
+    }
+    qsort(times, c.samples, sizeof(*times), nsl__bench_compare);
+    qsort(cycles, c.samples, sizeof(*cycles), nsl__bench_compare);
+
+    // The 99th percentile uses the nearest rank, so with fewer than 100
+    // samples it is the maximum.
+    size_t p99 = (size_t)ceil(0.99 * (double)c.samples) - 1;
+    *result    = (NSL_BenchResult){
+        .name       = name,
+        .iterations = iterations,
+        .samples    = c.samples,
+        .median_ns  = times[c.samples / 2],
+        .p99_ns     = times[p99],
+        .mean_ns    = mean,
+        .stddev_ns  = c.samples > 1 ? sqrt(variance / (double)(c.samples - 1)) : 0.0,
+        .min_ns     = times[0],
+        .cycles     = cycles[c.samples / 2],
+    };
+    return true;
+}
+
+NSL_BENCH_DEF void nsl_bench_write(FILE                  *file,
+                                   NSL_BenchFormat        format,
+                                   const NSL_BenchResult *results,
+                                   size_t                 count) {
+    switch (format) {
+    case NSL_BENCH_FORMAT_TABLE:
+        fprintf(file,
+                "%-32s %12s %12s %12s %12s %12s %10s\n",
+                "name",
+                "median ns",
+                "p99 ns",
+                "mean ns",
+                "stddev ns",
+                "min ns",
+                "cycles");
+        for (size_t i = 0; i < count; i++) {
+            const NSL_BenchResult *r = &results[i];
+            fprintf(file,
+                    "%-32s %12.2f %12.2f %12.2f %12.2f %12.2f %10.1f\n",
+                    r->name,
+                    r->median_ns,
+                    r->p99_ns,
+                    r->mean_ns,
+                    r->stddev_ns,
+                    r->min_ns,
+                    r->cycles);
+        }
+        break;
+    case NSL_BENCH_FORMAT_CSV:
+        fprintf(file, "name,iterations,samples,median_ns,p99_ns,mean_ns,stddev_ns,min_ns,cycles\n");
+        for (size_t i = 0; i < count; i++) {
+            const NSL_BenchResult *r = &results[i];
+            nsl__bench_write_name(file, format, r->name);
+            fprintf(file,
+                    ",%llu,%zu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                    (unsigned long long)r->iterations,
+                    r->samples,
+                    r->median_ns,
+                    r->p99_ns,
+                    r->mean_ns,
+                    r->stddev_ns,
+                    r->min_ns,
+                    r->cycles);
+        }
+        break;
+    case NSL_BENCH_FORMAT_JSON:
+        fprintf(file, "[");
+        for (size_t i = 0; i < count; i++) {
+            const NSL_BenchResult *r = &results[i];
+            fprintf(file, "%s\n  {\"name\": ", i == 0 ? "" : ",");
+            nsl__bench_write_name(file, format, r->name);
+            fprintf(file,
+                    ", \"iterations\": %llu, \"samples\": %zu, "
+                    "\"median_ns\": %.3f, \"p99_ns\": %.3f, \"mean_ns\": %.3f, "
+                    "\"stddev_ns\": %.3f, \"min_ns\": %.3f, \"cycles\": %.3f}",
+                    (unsigned long long)r->iterations,
+                    r->samples,
+                    r->median_ns,
+                    r->p99_ns,
+                    r->mean_ns,
+                    r->stddev_ns,
+                    r->min_ns,
+                    r->cycles);
+        }
+        fprintf(file, "\n]\n");
+        break;
+    }
+}
+
+NSL_BENCH_DEF bool nsl_bench_parse_args(NSL_BenchConfig *config, int argc, char **argv) {
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        char       *end = nullptr;
+        if (strcmp(arg, "--csv") == 0) {
+            config->format = NSL_BENCH_FORMAT_CSV;
+        } else if (strcmp(arg, "--json") == 0) {
+            config->format = NSL_BENCH_FORMAT_JSON;
+        } else if (strncmp(arg, "--cpu=", 6) == 0) {
+            config->pin = true;
+            config->cpu = (int)strtol(arg + 6, &end, 10);
+        } else if (strncmp(arg, "--samples=", 10) == 0) {
+            config->samples = (size_t)strtoull(arg + 10, &end, 10);
+        } else if (strncmp(arg, "--min-time=", 11) == 0) {
+            config->min_time_ms = strtod(arg + 11, &end);
+        } else if (strncmp(arg, "--warmup=", 9) == 0) {
+            config->warmup_ms = strtod(arg + 9, &end);
+        } else if (strncmp(arg, "--filter=", 9) == 0) {
+            config->filter = arg + 9;
+        } else {
+            end = (char *)arg;
+        }
+        if (end != nullptr && *end != '\0') {
+            nsl_eprintf("[BENCH] unknown or invalid option: %s\n", arg);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+#    endif  // NSL_BENCH_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(BENCH)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(BENCH)
+#    ifndef NSL_BENCH_STRIP_PREFIX_GUARD_
+#        define NSL_BENCH_STRIP_PREFIX_GUARD_
+
+#        define BenchFormat           NSL_BenchFormat
+#        define BENCH_FORMAT_TABLE    NSL_BENCH_FORMAT_TABLE
+#        define BENCH_FORMAT_CSV      NSL_BENCH_FORMAT_CSV
+#        define BENCH_FORMAT_JSON     NSL_BENCH_FORMAT_JSON
+#        define BenchConfig           NSL_BenchConfig
+#        define Bench                 NSL_Bench
+#        define BenchFn               NSL_BenchFn
+#        define BenchResult           NSL_BenchResult
+#        define bench_do_not_optimize nsl_bench_do_not_optimize
+#        define bench_clobber_memory  nsl_bench_clobber_memory
+#        define bench_run             nsl_bench_run
+#        define bench_pause           nsl_bench_pause
+#        define bench_resume          nsl_bench_resume
+#        define bench_write           nsl_bench_write
+#        define bench_parse_args      nsl_bench_parse_args
+
+#    endif  // NSL_BENCH_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(BENCH)
@@ -0,0 +1,657 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * Packed arrays of bits, for large sets of flags or of small integers. Each
+ * bit takes one bit of memory, eight times less than an array of `bool`, and
+ * whole sets are combined 256 bits at a time with AVX2, or 64 at a time with
+ * plain integer operations where AVX2 is not enabled (e.g. without
+ * `-mavx2` or `-march=native`).
+ *
+ * Single bits are read and written with the inline functions
+ * `nsl_bitset_get`, `nsl_bitset_set` and `nsl_bitset_clear`. Whole sets are
+ * combined in place with `nsl_bitset_and`, `nsl_bitset_or`, `nsl_bitset_xor`
+ * and `nsl_bitset_andnot`. `nsl_bitset_count` counts the set bits, and
+ * `nsl_bitset_next` skips to the next one with `ctz`, so iterating over a
+ * sparse set costs one instruction per 64 clear bits.
+ *
+ * For succinct data structures, `nsl_bitset_build_index` adds an index of the
+ * number of set bits before every 512 bits, about 12.5% of the size of the
+ * set. With it, `nsl_bitset_rank` counts the set bits before a position and
+ * `nsl_bitset_select` finds the position of the nth set bit, both in constant
+ * time within a cache line or two of the bits. The index is not updated when
+ * the set changes, and has to be built again before it is used.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/bitset.h"
+ *
+ * int main() {
+ *     NSL_BitSet primes;
+ *     nsl_bitset_init(&primes, 1000);
+ *     nsl_bitset_fill(&primes, true);
+ *     nsl_bitset_clear(&primes, 0);
+ *     nsl_bitset_clear(&primes, 1);
+ *     for (size_t i = 2; i * i < primes.length; i++) {
+ *         if (!nsl_bitset_get(&primes, i)) { continue; }
+ *         for (size_t j = i * i; j < primes.length; j += i) {
+ *             nsl_bitset_clear(&primes, j);
+ *         }
+ *     }
+ *
+ *     for (size_t i = nsl_bitset_next(&primes, 0); i < primes.length;
+ *          i = nsl_bitset_next(&primes, i + 1)) {
+ *         printf("%zu\n", i);
+ *     }
+ *
+ *     nsl_bitset_build_index(&primes);
+ *     // 25 primes below 100, and the 100th prime is 541
+ *     printf("%zu %zu\n", nsl_bitset_rank(&primes, 100), nsl_bitset_select(&primes, 99));
+ *     nsl_bitset_free(&primes);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_BITSET_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_BITSET_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_BITSET_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ */
+
+#ifndef NSL_BITSET_H_
+#define NSL_BITSET_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_BITSET_VERSION_MAJOR 0
+#define NSL_BITSET_VERSION_MINOR 1
+#define NSL_BITSET_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_BITSET_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_BITSET_DEF
+#    define NSL_BITSET_DEF
+#endif  // NSL_BITSET_DEF
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * A fixed number of bits.
+ */
+typedef struct NSL_BitSet {
+    //! The bits, 64 to a word, starting from the lowest bit of the first
+    //! word. The bits of the last word past `length` are always 0.
+    uint64_t *words;
+    //! The number of bits.
+    size_t length;
+    //! Private: The number of set bits before every 512 bits, and after the
+    //! last of them, or `nullptr` if there is no index.
+    uint64_t *ranks;
+    //! Private: The block of 512 bits that holds every 4096th set bit.
+    size_t *samples;
+    size_t  sample_count;
+} NSL_BitSet;
+
+/*!
+ * Initializes a set with every bit clear.
+ *
+ * # Parameters
+ * - `set`: The set to initialize.
+ * - `length`: The number of bits.
+ *
+ * # Modifies
+ * - `set`: It is initialized.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_BITSET_DEF void nsl_bitset_init(NSL_BitSet *set, size_t length);
+
+/*!
+ * Frees a set.
+ *
+ * # Parameters
+ * - `set`: The set to free.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Modifies
+ * - `set`: It is no longer initialized.
+ */
+NSL_BITSET_DEF void nsl_bitset_free(NSL_BitSet *set);
+
+/*!
+ * Changes the number of bits in a set. Bits that are added are clear.
+ *
+ * # Parameters
+ * - `set`: The set to resize.
+ * - `length`: The new number of bits.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Modifies
+ * - `set`: It is resized, and its index is removed.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_BITSET_DEF void nsl_bitset_resize(NSL_BitSet *set, size_t length);
+
+/*!
+ * Checks whether a bit is set.
+ *
+ * # Parameters
+ * - `set`: The set to check.
+ * - `index`: The position of the bit.
+ *
+ * # Requires
+ * - `set` is initialized.
+ * - `index` is less than `set->length`.
+ *
+ * # Returns
+ * Whether the bit is set.
+ */
+static inline bool nsl_bitset_get(const NSL_BitSet *set, size_t index) {
+    return (set->words[index / 64] >> (index % 64)) & 1;
+}
+
+/*!
+ * Sets a bit.
+ *
+ * # Parameters
+ * - `set`: The set to modify.
+ * - `index`: The position of the bit.
+ *
+ * # Requires
+ * - `set` is initialized.
+ * - `index` is less than `set->length`.
+ *
+ * # Modifies
+ * - `set`: The bit is set.
+ */
+static inline void nsl_bitset_set(NSL_BitSet *set, size_t index) {
+    set->words[index / 64] |= (uint64_t)1 << (index % 64);
+}
+
+/*!
+ * Clears a bit.
+ *
+ * # Parameters
+ * - `set`: The set to modify.
+ * - `index`: The position of the bit.
+ *
+ * # Requires
+ * - `set` is initialized.
+ * - `index` is less than `set->length`.
+ *
+ * # Modifies
+ * - `set`: The bit is cleared.
+ */
+static inline void nsl_bitset_clear(NSL_BitSet *set, size_t index) {
+    set->words[index / 64] &= ~((uint64_t)1 << (index % 64));
+}
+
+/*!
+ * Sets or clears every bit.
+ *
+ * # Parameters
+ * - `set`: The set to modify.
+ * - `value`: Whether to set the bits.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Modifies
+ * - `set`: Every bit is `value`.
+ */
+NSL_BITSET_DEF void nsl_bitset_fill(NSL_BitSet *set, bool value);
+
+/*!
+ * Combines two sets in place, bit by bit: `nsl_bitset_and` keeps the bits
+ * that are set in both, `nsl_bitset_or` the bits set in either,
+ * `nsl_bitset_xor` the bits set in exactly one, and `nsl_bitset_andnot` the
+ * bits of `set` that are not set in `other`.
+ *
+ * # Parameters
+ * - `set`: The set to modify.
+ * - `other`: The set to combine with.
+ *
+ * # Requires
+ * - `set` and `other` are initialized, and have the same length.
+ *
+ * # Modifies
+ * - `set`: It holds the combination.
+ */
+NSL_BITSET_DEF void nsl_bitset_and(NSL_BitSet *set, const NSL_BitSet *other);
+NSL_BITSET_DEF void nsl_bitset_or(NSL_BitSet *set, const NSL_BitSet *other);
+NSL_BITSET_DEF void nsl_bitset_xor(NSL_BitSet *set, const NSL_BitSet *other);
+NSL_BITSET_DEF void nsl_bitset_andnot(NSL_BitSet *set, const NSL_BitSet *other);
+
+/*!
+ * Flips every bit.
+ *
+ * # Parameters
+ * - `set`: The set to modify.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Modifies
+ * - `set`: Every bit is flipped.
+ */
+NSL_BITSET_DEF void nsl_bitset_not(NSL_BitSet *set);
+
+/*!
+ * Counts the set bits.
+ *
+ * # Parameters
+ * - `set`: The set to count.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Returns
+ * The number of set bits.
+ */
+NSL_BITSET_DEF size_t nsl_bitset_count(const NSL_BitSet *set);
+
+/*!
+ * Finds the next set bit.
+ *
+ * # Parameters
+ * - `set`: The set to search.
+ * - `from`: The position to search from.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Returns
+ * The position of the first set bit at or after `from`, or `set->length` if
+ * there is none.
+ */
+NSL_BITSET_DEF size_t nsl_bitset_next(const NSL_BitSet *set, size_t from);
+
+/*!
+ * Builds the index used by `nsl_bitset_rank` and `nsl_bitset_select`,
+ * replacing any previous one.
+ *
+ * # Parameters
+ * - `set`: The set to index.
+ *
+ * # Requires
+ * - `set` is initialized.
+ *
+ * # Modifies
+ * - `set`: Its index is built.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_BITSET_DEF void nsl_bitset_build_index(NSL_BitSet *set);
+
+/*!
+ * Counts the set bits before a position.
+ *
+ * # Parameters
+ * - `set`: The set to count.
+ * - `index`: The position to count up to, excluding it.
+ *
+ * # Requires
+ * - `set` is initialized, and it has not changed since its index was built.
+ * - `index` is at most `set->length`.
+ *
+ * # Returns
+ * The number of set bits before `index`.
+ */
+NSL_BITSET_DEF size_t nsl_bitset_rank(const NSL_BitSet *set, size_t index);
+
+/*!
+ * Finds the position of a set bit by its rank.
+ *
+ * # Parameters
+ * - `set`: The set to search.
+ * - `rank`: The number of set bits before the one to find.
+ *
+ * # Requires
+ * - `set` is initialized, and it has not changed since its index was built.
+ *
+ * # Returns
+ * The position of the set bit that has `rank` set bits before it, or
+ * `set->length` if there are not that many.
+ */
+NSL_BITSET_DEF size_t nsl_bitset_select(const NSL_BitSet *set, size_t rank);
+
+#endif  // NSL_BITSET_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(BITSET)
+#    ifndef NSL_BITSET_IMPLEMENTATION_GUARD_
+#        define NSL_BITSET_IMPLEMENTATION_GUARD_
+
+#        include <string.h>
+
+#        if defined(__AVX2__) || defined(__BMI2__)
+#            include <immintrin.h>
+#        endif
+
+// The number of words in a block of the rank index, which is one cache line.
+#        define NSL__BITSET_BLOCK  8
+// The number of set bits between samples of the select index.
+#        define NSL__BITSET_SAMPLE 4096
+
+static size_t nsl__bitset_words(size_t length) {
+    return (length + 63) / 64;
+}
+
+static void *nsl__bitset_alloc(void *ptr, size_t size) {
+    // an empty set still gets a word, so that `words` is never null
+    ptr = nsl_realloc(ptr, size > 0 ? size : sizeof(uint64_t));
+    if (ptr == nullptr) {
+        nsl_eprintf("[BITSET] out of memory\n");
+        nsl_abort();
+    }
+    return ptr;
+}
+
+static void nsl__bitset_drop_index(NSL_BitSet *set) {
+    nsl_free(set->ranks);
+    nsl_free(set->samples);
+    set->ranks        = nullptr;
+    set->samples      = nullptr;
+    set->sample_count = 0;
+}
+
+// Clears the bits of the last word that are past the end of the set.
+static void nsl__bitset_trim(NSL_BitSet *set) {
+    if (set->length % 64 != 0) {
+        set->words[set->length / 64] &= ((uint64_t)1 << (set->length % 64)) - 1;
+    }
+}
+
+static size_t nsl__bitset_popcount(const uint64_t *words, size_t count) {
+    size_t total = 0;
+    size_t i     = 0;
+#        if defined(__AVX2__)
+    // looks up the count of each nibble, then sums the bytes of each lane,
+    // which is faster than a popcnt per word once there are a few lanes
+    const __m256i table  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i       sums   = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m256i bits  = _mm256_loadu_si256((const void *)(words + i));
+        __m256i shift = _mm256_srli_epi16(bits, 4);
+        __m256i low   = _mm256_shuffle_epi8(table, _mm256_and_si256(bits, nibble));
+        __m256i high  = _mm256_shuffle_epi8(table, _mm256_and_si256(shift, nibble));
+        __m256i bytes = _mm256_add_epi8(low, high);
+        sums          = _mm256_add_epi64(sums, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    total += (size_t)_mm256_extract_epi64(sums, 0) + (size_t)_mm256_extract_epi64(sums, 1)
+           + (size_t)_mm256_extract_epi64(sums, 2) + (size_t)_mm256_extract_epi64(sums, 3);
+#        endif
+    for (; i < count; i++) {
+        total += (size_t)__builtin_popcountll(words[i]);
+    }
+    return total;
+}
+
+// Returns the position of the set bit of `word` that has `rank` set bits
+// before it.
+static unsigned nsl__bitset_select_word(uint64_t word, size_t rank) {
+#        if defined(__BMI2__)
+    return (unsigned)__builtin_ctzll(_pdep_u64((uint64_t)1 << rank, word));
+#        else
+    for (size_t i = 0; i < rank; i++) {
+        word &= word - 1;
+    }
+    return (unsigned)__builtin_ctzll(word);
+#        endif
+}
+
+NSL_BITSET_DEF void nsl_bitset_init(NSL_BitSet *set, size_t length) {
+    size_t count = nsl__bitset_words(length);
+    *set         = (NSL_BitSet){.length = length};
+    set->words   = nsl__bitset_alloc(nullptr, count * sizeof(uint64_t));
+    memset(set->words, 0, count * sizeof(uint64_t));
+}
+
+NSL_BITSET_DEF void nsl_bitset_free(NSL_BitSet *set) {
+    nsl__bitset_drop_index(set);
+    nsl_free(set->words);
+}
+
+NSL_BITSET_DEF void nsl_bitset_resize(NSL_BitSet *set, size_t length) {
+    size_t old   = nsl__bitset_words(set->length);
+    size_t count = nsl__bitset_words(length);
+    nsl__bitset_drop_index(set);
+    set->words = nsl__bitset_alloc(set->words, count * sizeof(uint64_t));
+    if (count > old) { memset(set->words + old, 0, (count - old) * sizeof(uint64_t)); }
+    set->length = length;
+    nsl__bitset_trim(set);
+}
+
+NSL_BITSET_DEF void nsl_bitset_fill(NSL_BitSet *set, bool value) {
+    memset(set->words, value ? 0xff : 0, nsl__bitset_words(set->length) * sizeof(uint64_t));
+    nsl__bitset_trim(set);
+}
+
+#        if defined(__AVX2__)
+#            define NSL__BITSET_VECTOR_LOOP(vector)                                                \
+                for (; i + 4 <= count; i += 4) {                                                   \
+                    __m256i a = _mm256_loadu_si256((const void *)(words + i));                     \
+                    __m256i b = _mm256_loadu_si256((const void *)(other_words + i));               \
+                    _mm256_storeu_si256((void *)(words + i), vector);                              \
+                }
+#        else
+#            define NSL__BITSET_VECTOR_LOOP(vector)
+#        endif
+
+#        define NSL__BITSET_COMBINE(name, vector, scalar)                                          \
+            NSL_BITSET_DEF void nsl_bitset_##name(NSL_BitSet *set, const NSL_BitSet *other) {      \
+                uint64_t       *words       = set->words;                                          \
+                const uint64_t *other_words = other->words;                                        \
+                size_t          count       = nsl__bitset_words(set->length);                      \
+                size_t          i           = 0;                                                   \
+                NSL__BITSET_VECTOR_LOOP(vector)                                                    \
+                for (; i < count; i++) {                                                           \
+                    uint64_t a = words[i];                                                         \
+                    uint64_t b = other_words[i];                                                   \
+                    words[i]   = scalar;                                                           \
+                }                                                                                  \
+            }
+
+NSL__BITSET_COMBINE(and, _mm256_and_si256(a, b), a & b)
+NSL__BITSET_COMBINE(or, _mm256_or_si256(a, b), a | b)
+NSL__BITSET_COMBINE(xor, _mm256_xor_si256(a, b), a ^ b)
+NSL__BITSET_COMBINE(andnot, _mm256_andnot_si256(b, a), a & ~b)
+
+NSL_BITSET_DEF void nsl_bitset_not(NSL_BitSet *set) {
+    size_t count = nsl__bitset_words(set->length);
+    for (size_t i = 0; i < count; i++) {
+        set->words[i] = ~set->words[i];
+    }
+    nsl__bitset_trim(set);
+}
+
+NSL_BITSET_DEF size_t nsl_bitset_count(const NSL_BitSet *set) {
+    return nsl__bitset_popcount(set->words, nsl__bitset_words(set->length));
+}
+
+NSL_BITSET_DEF size_t nsl_bitset_next(const NSL_BitSet *set, size_t from) {
+    if (from >= set->length) { return set->length; }
+    size_t   count = nsl__bitset_words(set->length);
+    size_t   i     = from / 64;
+    uint64_t word  = set->words[i] & (~(uint64_t)0 << (from % 64));
+    while (word == 0) {
+        if (++i == count) { return set->length; }
+        word = set->words[i];
+    }
+    return i * 64 + (size_t)__builtin_ctzll(word);
+}
+
+NSL_BITSET_DEF void nsl_bitset_build_index(NSL_BitSet *set) {
+    nsl__bitset_drop_index(set);
+    size_t count  = nsl__bitset_words(set->length);
+    size_t blocks = (count + NSL__BITSET_BLOCK - 1) / NSL__BITSET_BLOCK;
+    set->ranks    = nsl__bitset_alloc(nullptr, (blocks + 1) * sizeof(uint64_t));
+    set->ranks[0] = 0;
+    for (size_t block = 0; block < blocks; block++) {
+        size_t start = block * NSL__BITSET_BLOCK;
+        size_t end   = start + NSL__BITSET_BLOCK < count ? start + NSL__BITSET_BLOCK : count;
+        set->ranks[block + 1] = set->ranks[block]
+                              + nsl__bitset_popcount(set->words + start, end - start);
+    }
+
+    size_t total      = (size_t)set->ranks[blocks];
+    set->sample_count = (total + NSL__BITSET_SAMPLE - 1) / NSL__BITSET_SAMPLE;
+    set->samples      = nsl__bitset_alloc(nullptr, set->sample_count * sizeof(size_t));
+    size_t sample     = 0;
+    for (size_t block = 0; block < blocks; block++) {
+        while (sample < set->sample_count && sample * NSL__BITSET_SAMPLE < set->ranks[block + 1]) {
+            set->samples[sample++] = block;
+        }
+    }
+}
+
+NSL_BITSET_DEF size_t nsl_bitset_rank(const NSL_BitSet *set, size_t index) {
+    size_t word  = index / 64;
+    size_t block = word / NSL__BITSET_BLOCK;
+    size_t rank  = (size_t)set->ranks[block];
+    rank += nsl__bitset_popcount(set->words + block * NSL__BITSET_BLOCK,
+                                 word - block * NSL__BITSET_BLOCK);
+    if (index % 64 != 0) {
+        uint64_t mask  = ((uint64_t)1 << (index % 64)) - 1;
+        rank          += (size_t)__builtin_popcountll(set->words[word] & mask);
+    }
+    return rank;
+}
+
+NSL_BITSET_DEF size_t nsl_bitset_select(const NSL_BitSet *set, size_t rank) {
+    size_t blocks = (nsl__bitset_words(set->length) + NSL__BITSET_BLOCK - 1) / NSL__BITSET_BLOCK;
+    if (rank >= set->ranks[blocks]) { return set->length; }
+    size_t sample = rank / NSL__BITSET_SAMPLE;
+
+    // the last block with fewer than `rank` set bits before it lies between
+    // the blocks of this sample and the next
+    size_t low  = set->samples[sample];
+    size_t high = sample + 1 < set->sample_count ? set->samples[sample + 1] : blocks - 1;
+    while (low < high) {
+        size_t middle = low + (high - low + 1) / 2;
+        if (set->ranks[middle] <= rank) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    rank -= (size_t)set->ranks[low];
+    for (size_t i = low * NSL__BITSET_BLOCK;; i++) {
+        size_t count = (size_t)__builtin_popcountll(set->words[i]);
+        if (rank < count) { return i * 64 + nsl__bitset_select_word(set->words[i], rank); }
+        rank -= count;
+    }
+}
+
+#    endif  // NSL_BITSET_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(BITSET)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(BITSET)
+#    ifndef NSL_BITSET_STRIP_PREFIX_GUARD_
+#        define NSL_BITSET_STRIP_PREFIX_GUARD_
+
+#        define BitSet             NSL_BitSet
+#        define bitset_init        nsl_bitset_init
+#        define bitset_free        nsl_bitset_free
+#        define bitset_resize      nsl_bitset_resize
+#        define bitset_get         nsl_bitset_get
+#        define bitset_set         nsl_bitset_set
+#        define bitset_clear       nsl_bitset_clear
+#        define bitset_fill        nsl_bitset_fill
+#        define bitset_and         nsl_bitset_and
+#        define bitset_or          nsl_bitset_or
+#        define bitset_xor         nsl_bitset_xor
+#        define bitset_andnot      nsl_bitset_andnot
+#        define bitset_not         nsl_bitset_not
+#        define bitset_count       nsl_bitset_count
+#        define bitset_next        nsl_bitset_next
+#        define bitset_build_index nsl_bitset_build_index
+#        define bitset_rank        nsl_bitset_rank
+#        define bitset_select      nsl_bitset_select
+
+#    endif  // NSL_BITSET_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(BITSET)
@@ -0,0 +1,869 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * A build tool in the style of `nob.h`, for building C projects with a C
+ * program instead of a `makefile`. Jobs are queued with `nsl_build_compile`
+ * or `nsl_build_command` and run by `nsl_build_wait`, with as many running at
+ * once as there are CPUs. Each job is started with `posix_spawnp`.
+ *
+ * Builds are incremental. The inputs of a job are hashed along with its
+ * command line, and the job is skipped if the hash matches the one saved in
+ * the cache file the last time it succeeded and its output exists. For
+ * compiles, the inputs are the source and every header listed in the
+ * dependency file written by `gcc -MMD`, so a change to a header rebuilds
+ * exactly the units that include it. Hashing contents instead of comparing
+ * modification times means that touching a file, or switching branches and
+ * back, does not cause a rebuild.
+ *
+ * The time of every job is recorded. `nsl_build_report` lists the slowest
+ * units, and the headers whose including units take the longest to compile
+ * in total, which are the ones worth splitting or precompiling.
+ *
+ * Jobs queued before a call to `nsl_build_wait` may run in any order, so a
+ * job that needs the output of another (e.g. linking) should be queued after
+ * waiting for it.
+ *
+ * This module needs `_POSIX_C_SOURCE` to be at least `200809L` before any
+ * header is included.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _POSIX_C_SOURCE 200809L
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/build.h"
+ *
+ * int main() {
+ *     NSL_Build build;
+ *     nsl_build_init(&build, &(NSL_BuildConfig){.cache = "build/.cache"});
+ *
+ *     const char *flags[] = {"-O2", "-I.", nullptr};
+ *     nsl_build_compile(&build, "cc", flags, "src/a.c", "build/a.o");
+ *     nsl_build_compile(&build, "cc", flags, "src/b.c", "build/b.o");
+ *     if (!nsl_build_wait(&build)) { return 1; }
+ *
+ *     const char *objects[] = {"build/a.o", "build/b.o"};
+ *     const char *link[]    = {"cc", "build/a.o", "build/b.o", "-o", "build/app", nullptr};
+ *     nsl_build_command(&build, link, "build/app", objects, 2, nullptr);
+ *     if (!nsl_build_wait(&build)) { return 1; }
+ *
+ *     nsl_build_report(&build, stdout, 10);
+ *     nsl_build_free(&build);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_BUILD_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_BUILD_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_BUILD_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_BUILD_MAX_DEPS`: The most dependencies read from one dependency file.
+ */
+
+#ifndef NSL_BUILD_H_
+#define NSL_BUILD_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_BUILD_VERSION_MAJOR 0
+#define NSL_BUILD_VERSION_MINOR 1
+#define NSL_BUILD_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_BUILD_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_BUILD_DEF
+#    define NSL_BUILD_DEF
+#endif  // NSL_BUILD_DEF
+
+/*!
+ * `NSL_BUILD_MAX_DEPS` is the most dependencies read from one dependency file.
+ * A job with more is always run.
+ */
+#ifndef NSL_BUILD_MAX_DEPS
+#    define NSL_BUILD_MAX_DEPS 4096
+#endif  // NSL_BUILD_MAX_DEPS
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * How jobs are run. Fields that are zero use their defaults.
+ */
+typedef struct NSL_BuildConfig {
+    //! The most jobs run at once. Defaults to the number of online CPUs.
+    size_t jobs;
+    //! The file that the hashes of successful jobs are kept in between
+    //! builds. If `nullptr`, every job is run.
+    const char *cache;
+    //! Whether every job is run, even if its inputs are unchanged.
+    bool force;
+    //! Whether the command line of each job is printed before it is run.
+    bool verbose;
+    //! Whether more jobs are started after one has failed.
+    bool keep_going;
+} NSL_BuildConfig;
+
+// Private: a string keyed hash table.
+typedef struct NSL__BuildEntry {
+    char    *key;
+    uint64_t hash;
+    uint64_t value;
+    uint64_t count;
+} NSL__BuildEntry;
+
+typedef struct NSL__BuildMap {
+    NSL__BuildEntry *entries;
+    size_t           capacity;
+    size_t           length;
+} NSL__BuildMap;
+
+typedef struct NSL__BuildJob NSL__BuildJob;
+
+/*!
+ * A build. This must be initialized with `nsl_build_init` and freed with
+ * `nsl_build_free`.
+ */
+typedef struct NSL_Build {
+    //! The number of jobs that have been run.
+    size_t ran;
+    //! The number of jobs that have been skipped because their inputs were
+    //! unchanged.
+    size_t skipped;
+    //! The number of jobs that have failed.
+    size_t failed;
+    //! Private: the configuration with the defaults filled in.
+    NSL_BuildConfig config;
+    //! Private: every queued job. Those before `next` have finished.
+    NSL__BuildJob *jobs;
+    size_t         job_count;
+    size_t         job_capacity;
+    size_t         next;
+    //! Private: the hash of each output from the cache file.
+    NSL__BuildMap cache;
+    //! Private: the hash of the contents of each file read during this wait.
+    NSL__BuildMap files;
+    //! Private: a buffer that files are read into.
+    char  *buffer;
+    size_t buffer_capacity;
+} NSL_Build;
+
+/*!
+ * Initializes a build and reads the cache file, if it exists.
+ *
+ * # Parameters
+ * - `build`: The build to initialize.
+ * - `config`: How jobs are run, or `nullptr` to use the defaults.
+ *
+ * # Modifies
+ * - `build`: Initialized.
+ */
+NSL_BUILD_DEF void nsl_build_init(NSL_Build *build, const NSL_BuildConfig *config);
+
+/*!
+ * Frees everything owned by the build. The cache file is written by
+ * `nsl_build_wait`, not here.
+ *
+ * # Parameters
+ * - `build`: The build to free.
+ */
+NSL_BUILD_DEF void nsl_build_free(NSL_Build *build);
+
+/*!
+ * Queues a job that runs a command.
+ *
+ * # Parameters
+ * - `build`: The build.
+ * - `argv`: The command and its arguments, ending with `nullptr`. The command
+ *   is looked up in `PATH`.
+ * - `output`: The file created by the command.
+ * - `inputs`: The files read by the command.
+ * - `input_count`: The number of inputs.
+ * - `depfile`: If not `nullptr`, a dependency file written by the command
+ *   that lists more inputs, as written by `gcc -MMD`.
+ *
+ * # Modifies
+ * - `build`: The job is queued. Every string is copied.
+ *
+ * # Aborts
+ * - Memory could not be allocated.
+ */
+NSL_BUILD_DEF void nsl_build_command(NSL_Build         *build,
+                                     const char *const *argv,
+                                     const char        *output,
+                                     const char *const *inputs,
+                                     size_t             input_count,
+                                     const char        *depfile);
+
+/*!
+ * Queues a job that compiles one source file to an object file with
+ * `cc flags... -MMD -MF object.d -c source -o object`.
+ *
+ * # Parameters
+ * - `build`: The build.
+ * - `cc`: The compiler.
+ * - `flags`: The compiler flags, ending with `nullptr`.
+ * - `source`: The file to compile.
+ * - `object`: The object file to write.
+ *
+ * # Modifies
+ * - `build`: The job is queued. Every string is copied.
+ *
+ * # Aborts
+ * - Memory could not be allocated.
+ */
+NSL_BUILD_DEF void nsl_build_compile(NSL_Build         *build,
+                                     const char        *cc,
+                                     const char *const *flags,
+                                     const char        *source,
+                                     const char        *object);
+
+/*!
+ * Runs every queued job whose inputs have changed, and updates the cache
+ * file.
+ *
+ * # Parameters
+ * - `build`: The build.
+ *
+ * # Modifies
+ * - `build`: Every queued job is finished, and the counts are updated.
+ *
+ * # Returns
+ * `true` if every job succeeded or was skipped, `false` otherwise.
+ */
+NSL_BUILD_DEF bool nsl_build_wait(NSL_Build *build);
+
+/*!
+ * Reads the prerequisites of the first rule in a dependency file, as written
+ * by `gcc -MMD`. Line continuations and escaped spaces, `#` and `$` are
+ * handled.
+ *
+ * # Parameters
+ * - `text`: The contents of the dependency file. This is modified in place,
+ *   and the returned paths point into it.
+ * - `deps`: Where the paths are written.
+ * - `capacity`: The number of paths that fit in `deps`.
+ *
+ * # Modifies
+ * - `text`: The paths are unescaped and terminated in place.
+ * - `deps`: The first `capacity` paths.
+ *
+ * # Returns
+ * The number of prerequisites, which may be more than `capacity`.
+ */
+NSL_BUILD_DEF size_t nsl_build_parse_depfile(char *text, const char **deps, size_t capacity);
+
+/*!
+ * Writes the slowest jobs, and the headers whose including units took the
+ * longest to compile in total, of the jobs that have run.
+ *
+ * # Parameters
+ * - `build`: The build.
+ * - `file`: Where the report is written.
+ * - `top`: The number of jobs and headers listed.
+ */
+NSL_BUILD_DEF void nsl_build_report(NSL_Build *build, FILE *file, size_t top);
+
+#endif  // NSL_BUILD_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(BUILD)
+#    ifndef NSL_BUILD_IMPLEMENTATION_GUARD_
+#        define NSL_BUILD_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <fcntl.h>
+#        include <spawn.h>
+#        include <stdlib.h>
+#        include <string.h>
+#        include <sys/stat.h>
+#        include <sys/wait.h>
+#        include <time.h>
+#        include <unistd.h>
+
+extern char **environ;
+
+struct NSL__BuildJob {
+    char   **argv;
+    char    *output;
+    char   **inputs;
+    size_t   input_count;
+    char    *depfile;
+    pid_t    pid;
+    bool     ran;
+    uint64_t start_ns;
+    uint64_t time_ns;
+};
+
+static uint64_t nsl__build_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+static void *nsl__build_alloc(void *ptr, size_t size) {
+    ptr = nsl_realloc(ptr, size);
+    if (ptr == nullptr) {
+        nsl_eprintf("[BUILD] out of memory\n");
+        abort();
+    }
+    return ptr;
+}
+
+static char *nsl__build_copy(const char *string) {
+    size_t size = strlen(string) + 1;
+    return memcpy(nsl__build_alloc(nullptr, size), string, size);
+}
+
+// Hashes eight bytes at a time. This only needs to detect changes, not to
+// resist attacks, and is limited by reading the files anyway.
+static uint64_t nsl__build_hash(uint64_t hash, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    hash ^= size * 0x9e3779b97f4a7c15;
+    for (; size >= 8; bytes += 8, size -= 8) {
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        hash = ((hash ^ word) * 0xff51afd7ed558ccd);
+        hash ^= hash >> 32;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, bytes, size);
+    hash  = (hash ^ tail) * 0xc4ceb9fe1a85ec53;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+// Returns the entry for `key`, adding it if `insert` is set, or `nullptr`.
+static NSL__BuildEntry *nsl__build_map_get(NSL__BuildMap *map, const char *key, bool insert) {
+    if (insert && 2 * (map->length + 1) > map->capacity) {
+        NSL__BuildMap grown = {.capacity = map->capacity == 0 ? 64 : 2 * map->capacity};
+        grown.entries       = nsl__build_alloc(nullptr, grown.capacity * sizeof(NSL__BuildEntry));
+        memset(grown.entries, 0, grown.capacity * sizeof(NSL__BuildEntry));
+        for (size_t i = 0; i < map->capacity; i++) {
+            NSL__BuildEntry *entry = &map->entries[i];
+            if (entry->key == nullptr) { continue; }
+            size_t slot = entry->hash & (grown.capacity - 1);
+            while (grown.entries[slot].key != nullptr) {
+                slot = (slot + 1) & (grown.capacity - 1);
+            }
+            grown.entries[slot] = *entry;
+        }
+        grown.length = map->length;
+        nsl_free(map->entries);
+        *map = grown;
+    }
+    if (map->capacity == 0) { return nullptr; }
+
+    uint64_t hash = nsl__build_hash(0, key, strlen(key));
+    size_t   slot = hash & (map->capacity - 1);
+    for (; map->entries[slot].key != nullptr; slot = (slot + 1) & (map->capacity - 1)) {
+        NSL__BuildEntry *entry = &map->entries[slot];
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) { return entry; }
+    }
+    if (!insert) { return nullptr; }
+    map->entries[slot] = (NSL__BuildEntry){.key = nsl__build_copy(key), .hash = hash};
+    map->length++;
+    return &map->entries[slot];
+}
+
+static void nsl__build_map_free(NSL__BuildMap *map) {
+    for (size_t i = 0; i < map->capacity; i++) {
+        nsl_free(map->entries[i].key);
+    }
+    nsl_free(map->entries);
+    *map = (NSL__BuildMap){};
+}
+
+// Reads a whole file into `build->buffer`, returning its size or -1.
+static ssize_t nsl__build_read(NSL_Build *build, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { return -1; }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)info.st_size;
+    if (size + 1 > build->buffer_capacity) {
+        build->buffer_capacity = size + 1;
+        build->buffer          = nsl__build_alloc(build->buffer, build->buffer_capacity);
+    }
+    size_t length = 0;
+    while (length < size) {
+        ssize_t count = read(fd, build->buffer + length, size - length);
+        if (count < 0 && errno == EINTR) { continue; }
+        if (count <= 0) { break; }
+        length += (size_t)count;
+    }
+    close(fd);
+    build->buffer[length] = '\0';
+    return (ssize_t)length;
+}
+
+// Returns the hash of the contents of `path`, or 0 if it cannot be read. Each
+// file is only read once per wait, however many units include it.
+static uint64_t nsl__build_file_hash(NSL_Build *build, const char *path) {
+    NSL__BuildEntry *entry = nsl__build_map_get(&build->files, path, true);
+    if (entry->value == 0) {
+        ssize_t size = nsl__build_read(build, path);
+        if (size < 0) { return 0; }
+        entry->value = nsl__build_hash(0, build->buffer, (size_t)size) | 1;
+    }
+    return entry->value;
+}
+
+// Returns the hash of the command line and every input of `job`, or 0 if an
+// input is missing and the job must run.
+static uint64_t nsl__build_job_hash(NSL_Build *build, const NSL__BuildJob *job) {
+    uint64_t hash = 0;
+    for (char **arg = job->argv; *arg != nullptr; arg++) {
+        hash = nsl__build_hash(hash, *arg, strlen(*arg) + 1);
+    }
+    for (size_t i = 0; i < job->input_count; i++) {
+        uint64_t file = nsl__build_file_hash(build, job->inputs[i]);
+        if (file == 0) { return 0; }
+        hash = nsl__build_hash(hash, &file, sizeof(file));
+    }
+    if (job->depfile == nullptr) { return hash | 1; }
+
+    static const char *deps[NSL_BUILD_MAX_DEPS];
+    if (nsl__build_read(build, job->depfile) < 0) { return 0; }
+    size_t count = nsl_build_parse_depfile(build->buffer, deps, NSL_BUILD_MAX_DEPS);
+    if (count > NSL_BUILD_MAX_DEPS) { return 0; }
+    // The paths point into the buffer, which is reused to read each file.
+    char  *paths = nsl__build_alloc(nullptr, 1);
+    size_t used  = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t size = strlen(deps[i]) + 1;
+        paths       = nsl__build_alloc(paths, used + size);
+        memcpy(paths + used, deps[i], size);
+        used += size;
+    }
+    for (size_t offset = 0; offset < used; offset += strlen(paths + offset) + 1) {
+        uint64_t file = nsl__build_file_hash(build, paths + offset);
+        if (file == 0) {
+            hash = 0;
+            break;
+        }
+        hash = nsl__build_hash(hash, &file, sizeof(file));
+    }
+    nsl_free(paths);
+    return hash | (hash != 0);
+}
+
+NSL_BUILD_DEF void nsl_build_init(NSL_Build *build, const NSL_BuildConfig *config) {
+    *build = (NSL_Build){.config = config == nullptr ? (NSL_BuildConfig){} : *config};
+    if (build->config.jobs == 0) {
+        long cpus           = sysconf(_SC_NPROCESSORS_ONLN);
+        build->config.jobs  = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (build->config.cache == nullptr) { return; }
+
+    // Each line is the hash of a job followed by its output.
+    FILE *file = fopen(build->config.cache, "r");
+    if (file == nullptr) { return; }
+    unsigned long long hash;
+    char               path[4096];
+    while (fscanf(file, "%llx %4095[^\n]", &hash, path) == 2) {
+        nsl__build_map_get(&build->cache, path, true)->value = hash;
+    }
+    fclose(file);
+}
+
+NSL_BUILD_DEF void nsl_build_free(NSL_Build *build) {
+    for (size_t i = 0; i < build->job_count; i++) {
+        NSL__BuildJob *job = &build->jobs[i];
+        for (char **arg = job->argv; *arg != nullptr; arg++) {
+            nsl_free(*arg);
+        }
+        for (size_t j = 0; j < job->input_count; j++) {
+            nsl_free(job->inputs[j]);
+        }
+        nsl_free(job->argv);
+        nsl_free(job->inputs);
+        nsl_free(job->output);
+        nsl_free(job->depfile);
+    }
+    nsl_free(build->jobs);
+    nsl__build_map_free(&build->cache);
+    nsl__build_map_free(&build->files);
+    nsl_free(build->buffer);
+    *build = (NSL_Build){};
+}
+
+NSL_BUILD_DEF void nsl_build_command(NSL_Build         *build,
+                                     const char *const *argv,
+                                     const char        *output,
+                                     const char *const *inputs,
+                                     size_t             input_count,
+                                     const char        *depfile) {
+    if (build->job_count == build->job_capacity) {
+        build->job_capacity = build->job_capacity == 0 ? 64 : 2 * build->job_capacity;
+        build->jobs = nsl__build_alloc(build->jobs, build->job_capacity * sizeof(NSL__BuildJob));
+    }
+    size_t argc = 0;
+    while (argv[argc] != nullptr) {
+        argc++;
+    }
+    NSL__BuildJob *job = &build->jobs[build->job_count++];
+    *job               = (NSL__BuildJob){
+        .argv        = nsl__build_alloc(nullptr, (argc + 1) * sizeof(char *)),
+        .output      = nsl__build_copy(output),
+        .inputs      = nsl__build_alloc(nullptr, (input_count + 1) * sizeof(char *)),
+        .input_count = input_count,
+        .depfile     = depfile == nullptr ? nullptr : nsl__build_copy(depfile),
+    };
+    for (size_t i = 0; i < argc; i++) {
+        job->argv[i] = nsl__build_copy(argv[i]);
+    }
+    job->argv[argc] = nullptr;
+    for (size_t i = 0; i < input_count; i++) {
+        job->inputs[i] = nsl__build_copy(inputs[i]);
+    }
+}
+
+NSL_BUILD_DEF void nsl_build_compile(NSL_Build         *build,
+                                     const char        *cc,
+                                     const char *const *flags,
+                                     const char        *source,
+                                     const char        *object) {
+    size_t flag_count = 0;
+    while (flags != nullptr && flags[flag_count] != nullptr) {
+        flag_count++;
+    }
+    size_t depfile_size = strlen(object) + 3;
+    char  *depfile      = nsl__build_alloc(nullptr, depfile_size);
+    snprintf(depfile, depfile_size, "%s.d", object);
+
+    const char **argv = nsl__build_alloc(nullptr, (flag_count + 9) * sizeof(char *));
+    size_t       argc = 0;
+    argv[argc++]      = cc;
+    for (size_t i = 0; i < flag_count; i++) {
+        argv[argc++] = flags[i];
+    }
+    argv[argc++] = "-MMD";
+    argv[argc++] = "-MF";
+    argv[argc++] = depfile;
+    argv[argc++] = "-c";
+    argv[argc++] = source;
+    argv[argc++] = "-o";
+    argv[argc++] = object;
+    argv[argc]   = nullptr;
+    nsl_build_command(build, argv, object, &source, 1, depfile);
+    nsl_free(argv);
+    nsl_free(depfile);
+}
+
+// Starts `job`, or skips it if its inputs are unchanged. Returns `false` if it
+// could not be started.
+static bool nsl__build_start(NSL_Build *build, NSL__BuildJob *job) {
+    if (!build->config.force && build->config.cache != nullptr) {
+        NSL__BuildEntry *cached = nsl__build_map_get(&build->cache, job->output, false);
+        if (cached != nullptr && access(job->output, F_OK) == 0
+            && nsl__build_job_hash(build, job) == cached->value) {
+            build->skipped++;
+            return true;
+        }
+    }
+    if (build->config.verbose) {
+        for (char **arg = job->argv; *arg != nullptr; arg++) {
+            printf("%s%s", arg == job->argv ? "" : " ", *arg);
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+    job->start_ns = nsl__build_now();
+    int error     = posix_spawnp(&job->pid, job->argv[0], nullptr, nullptr, job->argv, environ);
+    if (error != 0) {
+        nsl_eprintf("[BUILD] could not run %s: %s\n", job->argv[0], strerror(error));
+        job->pid = 0;
+        build->failed++;
+        return false;
+    }
+    return true;
+}
+
+// Records a finished job and saves its hash, returning whether it succeeded.
+static bool nsl__build_finish(NSL_Build *build, NSL__BuildJob *job, int status) {
+    job->time_ns = nsl__build_now() - job->start_ns;
+    job->ran     = true;
+    job->pid     = 0;
+    build->ran++;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        nsl_eprintf("[BUILD] failed to build %s\n", job->output);
+        build->failed++;
+        if (build->config.cache != nullptr) {
+            NSL__BuildEntry *cached = nsl__build_map_get(&build->cache, job->output, false);
+            if (cached != nullptr) { cached->value = 0; }
+        }
+        return false;
+    }
+    if (build->config.cache != nullptr) {
+        uint64_t hash = nsl__build_job_hash(build, job);
+        nsl__build_map_get(&build->cache, job->output, true)->value = hash;
+    }
+    return true;
+}
+
+static void nsl__build_save(const NSL_Build *build) {
+    FILE *file = fopen(build->config.cache, "w");
+    if (file == nullptr) {
+        nsl_eprintf("[BUILD] could not write %s: %s\n", build->config.cache, strerror(errno));
+        return;
+    }
+    for (size_t i = 0; i < build->cache.capacity; i++) {
+        const NSL__BuildEntry *entry = &build->cache.entries[i];
+        if (entry->key != nullptr && entry->value != 0) {
+            fprintf(file, "%016llx %s\n", (unsigned long long)entry->value, entry->key);
+        }
+    }
+    fclose(file);
+}
+
+NSL_BUILD_DEF bool nsl_build_wait(NSL_Build *build) {
+    // Files may have been changed by the jobs of the last wait.
+    nsl__build_map_free(&build->files);
+
+    size_t failed  = build->failed;
+    size_t running = 0;
+    size_t first   = build->next;
+    while (true) {
+        bool stopped = build->failed > failed && !build->config.keep_going;
+        while (running < build->config.jobs && build->next < build->job_count && !stopped) {
+            NSL__BuildJob *job = &build->jobs[build->next++];
+            if (nsl__build_start(build, job) && job->pid != 0) { running++; }
+            stopped = build->failed > failed && !build->config.keep_going;
+        }
+        if (running == 0) { break; }
+
+        int   status = 0;
+        pid_t pid    = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) { continue; }
+            nsl_eprintf("[BUILD] could not wait for a job: %s\n", strerror(errno));
+            abort();
+        }
+        for (size_t i = first; i < build->next; i++) {
+            if (build->jobs[i].pid == pid) {
+                nsl__build_finish(build, &build->jobs[i], status);
+                running--;
+                break;
+            }
+        }
+    }
+    // Jobs that were never started are dropped, so they do not run on the
+    // next wait.
+    build->next = build->job_count;
+
+    if (build->config.cache != nullptr) { nsl__build_save(build); }
+    return build->failed == failed;
+}
+
+NSL_BUILD_DEF size_t nsl_build_parse_depfile(char *text, const char **deps, size_t capacity) {
+    // Skip the targets, up to the first colon that is not part of a path
+    // such as `C:\file`.
+    char *read = text;
+    while (*read != '\0' && !(*read == ':' && (read[1] == ' ' || read[1] == '\t'
+                                               || read[1] == '\n' || read[1] == '\0'))) {
+        read += *read == '\\' && read[1] != '\0' ? 2 : 1;
+    }
+    if (*read == '\0') { return 0; }
+    read++;
+
+    size_t count = 0;
+    char  *write = read;
+    while (true) {
+        while (*read == ' ' || *read == '\t' || *read == '\r' || *read == '\\') {
+            if (*read != '\\') {
+                read++;
+            } else if (read[1] == '\n') {
+                read += 2;
+            } else if (read[1] == '\r' && read[2] == '\n') {
+                read += 3;
+            } else {
+                break;
+            }
+        }
+        if (*read == '\0' || *read == '\n') { break; }
+
+        char *path = write;
+        while (*read != '\0' && *read != ' ' && *read != '\t' && *read != '\n' && *read != '\r') {
+            if (*read == '\\' && (read[1] == '\n' || read[1] == '\r')) { break; }
+            if ((*read == '\\' && (read[1] == ' ' || read[1] == '#'))
+                || (*read == '$' && read[1] == '$')) {
+                read++;
+            }
+            *write++ = *read++;
+        }
+        if (count < capacity) { deps[count] = path; }
+        count++;
+
+        // The path is terminated in place, which may overwrite the character
+        // that ended it, so that character is looked at first.
+        bool last = *read == '\0' || *read == '\n';
+        if (*read == ' ' || *read == '\t') { read++; }
+        *write++ = '\0';
+        if (last) { break; }
+    }
+    return count;
+}
+
+static int nsl__build_compare_time(const void *a, const void *b) {
+    uint64_t x = (*(const NSL__BuildEntry *const *)a)->value;
+    uint64_t y = (*(const NSL__BuildEntry *const *)b)->value;
+    return (x < y) - (x > y);
+}
+
+static int nsl__build_compare_job(const void *a, const void *b) {
+    uint64_t x = (*(const NSL__BuildJob *const *)a)->time_ns;
+    uint64_t y = (*(const NSL__BuildJob *const *)b)->time_ns;
+    return (x < y) - (x > y);
+}
+
+NSL_BUILD_DEF void nsl_build_report(NSL_Build *build, FILE *file, size_t top) {
+    NSL__BuildJob **jobs  = nsl__build_alloc(nullptr, (build->job_count + 1) * sizeof(*jobs));
+    size_t          count = 0;
+    uint64_t        total = 0;
+    for (size_t i = 0; i < build->job_count; i++) {
+        if (build->jobs[i].ran) {
+            jobs[count++]  = &build->jobs[i];
+            total         += build->jobs[i].time_ns;
+        }
+    }
+    qsort(jobs, count, sizeof(*jobs), nsl__build_compare_job);
+    fprintf(file,
+            "%zu ran, %zu skipped, %zu failed, %.3f s of jobs\n",
+            build->ran,
+            build->skipped,
+            build->failed,
+            (double)total / 1e9);
+    fprintf(file, "slowest jobs:\n");
+    for (size_t i = 0; i < count && i < top; i++) {
+        fprintf(file, "  %10.3f ms  %s\n", (double)jobs[i]->time_ns / 1e6, jobs[i]->output);
+    }
+
+    // Charge the time of every unit to each header it includes. The first
+    // prerequisite is the source itself.
+    NSL__BuildMap      headers = {};
+    static const char *deps[NSL_BUILD_MAX_DEPS];
+    for (size_t i = 0; i < count; i++) {
+        if (jobs[i]->depfile == nullptr || nsl__build_read(build, jobs[i]->depfile) < 0) {
+            continue;
+        }
+        size_t found = nsl_build_parse_depfile(build->buffer, deps, NSL_BUILD_MAX_DEPS);
+        for (size_t j = 1; j < found && j < NSL_BUILD_MAX_DEPS; j++) {
+            NSL__BuildEntry *entry  = nsl__build_map_get(&headers, deps[j], true);
+            entry->value           += jobs[i]->time_ns;
+            entry->count++;
+        }
+    }
+    NSL__BuildEntry **sorted = nsl__build_alloc(nullptr, (headers.length + 1) * sizeof(*sorted));
+    size_t            length = 0;
+    for (size_t i = 0; i < headers.capacity; i++) {
+        if (headers.entries[i].key != nullptr) { sorted[length++] = &headers.entries[i]; }
+    }
+    qsort(sorted, length, sizeof(*sorted), nsl__build_compare_time);
+    fprintf(file, "headers by compile time of the units including them:\n");
+    for (size_t i = 0; i < length && i < top; i++) {
+        fprintf(file,
+                "  %10.3f ms  %4llu units  %s\n",
+                (double)sorted[i]->value / 1e6,
+                (unsigned long long)sorted[i]->count,
+                sorted[i]->key);
+    }
+    nsl_free(sorted);
+    nsl__build_map_free(&headers);
+    nsl_free(jobs);
+}
+
+#    endif  // NSL_BUILD_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(BUILD)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(BUILD)
+#    ifndef NSL_BUILD_STRIP_PREFIX_GUARD_
+#        define NSL_BUILD_STRIP_PREFIX_GUARD_
+
+#        define BuildConfig         NSL_BuildConfig
+#        define Build               NSL_Build
+#        define build_init          nsl_build_init
+#        define build_free          nsl_build_free
+#        define build_command       nsl_build_command
+#        define build_compile       nsl_build_compile
+#        define build_wait          nsl_build_wait
+#        define build_parse_depfile nsl_build_parse_depfile
+#        define build_report        nsl_build_report
+
+#    endif  // NSL_BUILD_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(BUILD)
@@ -36,6 +36,9 @@
  *   from their name.
  * - `NSL_COMMON_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
  *   prefixes for things in this module and not in the entire library.
+ * - `NSL_MEMTRACK_ENABLE`: Defining this macro for every translation unit
+ *   redirects `nsl_malloc`, `nsl_realloc` and `nsl_free` to the tracking
+ *   allocator in `nonstdlib/memtrack.h`.
  *
  * # Redefinable Macros
  *
@@ -57,6 +60,8 @@
 
 #include "nonstdlib/magic.h"
 
+#include <stddef.h>
+
 /******************************************************************************/
 /*                                                                            */
 /*                           LIBRARY VERSION MACROS                           */
@@ -132,6 +137,38 @@
 #define nsl_assert_is_of_type(expr, expected, msg)                                                 \
     static_assert(nsl_is_of_type(expr, expected), msg)
 
+/******************************************************************************/
+/*                                                                            */
+/*                                STRING VIEWS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * A borrowed slice of `length` bytes starting at `data`. The bytes are not
+ * null terminated, and they belong to whatever the view was taken from, such
+ * as a mapped file.
+ */
+typedef struct NSL_StringView {
+    //! The first byte of the view.
+    const char *data;
+    //! The number of bytes in the view.
+    size_t length;
+} NSL_StringView;
+
+/*!
+ * Formats a string view with `printf` style functions, as in
+ * `printf(NSL_SV_FMT "\n", NSL_SV_ARG(view))`.
+ *
+ * # Parameters
+ * - `sv`: The view to print.
+ *
+ * # Requires
+ * - `sv.length` fits in an `int`.
+ * - `sv` has no side effects, since it is evaluated twice.
+ */
+#define NSL_SV_FMT     "%.*s"
+#define NSL_SV_ARG(sv) (int)(sv).length, (sv).data
+
 /******************************************************************************/
 /*                                                                            */
 /*                      USER-DEFINED FUNCTION OVERRIDES                       */
@@ -226,6 +263,11 @@ extern void nsl_abort(void);
 #endif  // defined(nsl_abort)
 nsl_assert_is_of_type(nsl_abort, void (*)(void), "'nsl_abort' is of wrong type");
 
+#if defined(NSL_MEMTRACK_ENABLE)                                                                   \
+    && (defined(nsl_malloc) || defined(nsl_realloc) || defined(nsl_free))
+#    error "`NSL_MEMTRACK_ENABLE` cannot be combined with redefining the allocation hooks"
+#endif
+
 /*!
  * `nsl_malloc` can optionally be defined by the user to redirect `malloc` to a
  * different handler.
@@ -241,7 +283,7 @@ nsl_assert_is_of_type(nsl_abort, void (*)(void), "'nsl_abort' is of wrong type")
  * - Redefining `nsl_malloc` requires redefining `nsl_realloc` and `nsl_free`.
  */
 #if defined(nsl_malloc)
-extern void *nsl_malloc(void);
+extern void *nsl_malloc(size_t size);
 #    if !defined(nsl_free) || !defined(nsl_realloc)
 #        error "Defining `nsl_malloc` requires defining both `nsl_realloc` and `nsl_free`"
 #    endif
@@ -266,7 +308,7 @@ nsl_assert_is_of_type(nsl_malloc, void *(*)(size_t), "'nsl_malloc' is of wrong t
  * - Redefining `nsl_realloc` requires redefining `nsl_malloc` and `nsl_free`.
  */
 #if defined(nsl_realloc)
-extern void *nsl_realloc(void);
+extern void *nsl_realloc(void *ptr, size_t size);
 #    if !defined(nsl_free) || !defined(nsl_malloc)
 #        error "Defining `nsl_realloc` requires defining both `nsl_malloc` and `nsl_free`"
 #    endif
@@ -290,7 +332,7 @@ nsl_assert_is_of_type(nsl_realloc, void *(*)(void *, size_t), "'nsl_realloc' is
  * - Redefining `nsl_free` requires redefining `nsl_malloc` and `nsl_realloc`.
  */
 #if defined(nsl_free)
-extern void *nsl_free(void);
+extern void nsl_free(void *ptr);
 #    if !defined(nsl_malloc) || !defined(nsl_realloc)
 #        error "Defining `nsl_free` requires defining both `nsl_malloc` and `nsl_realloc`"
 #    endif
@@ -300,6 +342,28 @@ extern void *nsl_free(void);
 #endif  // defined(nsl_free)
 nsl_assert_is_of_type(nsl_free, void (*)(void *), "'nsl_free' is of wrong type");
 
+/*!
+ * When `NSL_MEMTRACK_ENABLE` is defined, `nsl_malloc`, `nsl_realloc` and
+ * `nsl_free` are redirected to the tracking allocator in
+ * `nonstdlib/memtrack.h`, which records the file and line of every call. The
+ * flag must be defined for every translation unit, and the implementation of
+ * `nonstdlib/memtrack.h` must be included in one of them.
+ *
+ * # Requires
+ * - `nsl_malloc`, `nsl_realloc` and `nsl_free` are not redefined by the user.
+ */
+#if defined(NSL_MEMTRACK_ENABLE)
+extern void *nsl_memtrack_malloc(size_t size, const char *file, int line);
+extern void *nsl_memtrack_realloc(void *ptr, size_t size, const char *file, int line);
+extern void  nsl_memtrack_free(void *ptr);
+#    undef nsl_malloc
+#    undef nsl_realloc
+#    undef nsl_free
+#    define nsl_malloc(size)       nsl_memtrack_malloc(size, __FILE__, __LINE__)
+#    define nsl_realloc(ptr, size) nsl_memtrack_realloc(ptr, size, __FILE__, __LINE__)
+#    define nsl_free(ptr)          nsl_memtrack_free(ptr)
+#endif  // defined(NSL_MEMTRACK_ENABLE)
+
 /******************************************************************************/
 /*                                                                            */
 /*              MACROS FOR GENERATING ERRORS ON UNFINISHED CODE               */
@@ -387,21 +451,18 @@ void nsl__todo_runtime(const char *message, const char *file, int line) {
  *
  * NOTE on the implementation of this macro: The macro cannot use `defined()` to
  * determine if the relevant macros are defined, as that is undefined behavior.
- * Instead, `NSL_NARGS` is used. If the macro is defined, it should expand to
- * nothing, thus `NSL_NARGS` would evaluate to 0. Otherwise, it will not be
- * expanded, and `NSL_NARGS` would evaluate to 1.
+ * Instead, `NSL__IS_EMPTY` is used. If the macro is defined, it should expand
+ * to nothing, thus `NSL__IS_EMPTY` would evaluate to 1. Otherwise, it will not
+ * be expanded, and `NSL__IS_EMPTY` would evaluate to 0.
  *
  * # Parameters
- * - The path names that make up the module names.
+ * - The path names that make up the module names. At most 8 may be given.
  *
  * # Returns
  * - True (1) if the prefixes should be stripped, and false (0) otherwise.
  */
 #define NSL_SHOULD_STRIP_PREFIX(...)                                                               \
-    (NSL_NSEP(||, NSL_FORALL_INIT(NSL__SHOULD_STRIP_PREFIX, __VA_ARGS__))                          \
-     || (NSL_NARGS(NSL_STRIP_PREFIX) == 0))
-#define NSL__SHOULD_STRIP_PREFIX(...)                                                              \
-    (NSL_NARGS(NSL_NCAT_SEP(_, NSL, __VA_ARGS__, STRIP, PREFIX)) == 0)
+    (NSL__SHOULD(STRIP_PREFIX, __VA_ARGS__) || NSL__IS_EMPTY(NSL_STRIP_PREFIX))
 
 /*!
  * Evaluates whether or not the implementation should be included for the
@@ -414,21 +475,51 @@ void nsl__todo_runtime(const char *message, const char *file, int line) {
  *
  * NOTE on the implementation of this macro: The macro cannot use `defined()` to
  * determine if the relevant macros are defined, as that is undefined behavior.
- * Instead, `NSL_NARGS` is used. If the macro is defined, it should expand to
- * nothing, thus `NSL_NARGS` would evaluate to 0. Otherwise, it will not be
- * expanded, and `NSL_NARGS` would evaluate to 1.
+ * Instead, `NSL__IS_EMPTY` is used. If the macro is defined, it should expand
+ * to nothing, thus `NSL__IS_EMPTY` would evaluate to 1. Otherwise, it will not
+ * be expanded, and `NSL__IS_EMPTY` would evaluate to 0.
  *
  * # Parameters
- * - The path names that make up the module names.
+ * - The path names that make up the module names. At most 8 may be given.
  *
  * # Returns
  * - True (1) if the implementation should be included, and false (0) otherwise.
  */
 #define NSL_SHOULD_INCLUDE_IMPLEMENTATION(...)                                                     \
-    (NSL_NSEP(||, NSL_FORALL_INIT(NSL__SHOULD_INCLUDE_IMPLEMENTATION, __VA_ARGS__))                \
-     || (NSL_NARGS(NSL_IMPLEMENTATION) == 0))
-#define NSL__SHOULD_INCLUDE_IMPLEMENTATION(...)                                                    \
-    (NSL_NARGS(NSL_NCAT_SEP(_, NSL, __VA_ARGS__, IMPLEMENTATION)) == 0)
+    (NSL__SHOULD(IMPLEMENTATION, __VA_ARGS__) || NSL__IS_EMPTY(NSL_IMPLEMENTATION))
+
+/*
+ * These guards are evaluated every time a module is included, so they avoid the
+ * general purpose macros in `magic.h`, which scale poorly with the number of
+ * arguments. Instead, the flag name for every prefix of the module path is
+ * pasted directly, using one macro per path depth.
+ *
+ * `NSL__IS_EMPTY` expands its argument before checking it with `__VA_OPT__`, so
+ * that a flag defined as nothing is seen as empty.
+ */
+#define NSL__IS_EMPTY(...)  NSL__IS_EMPTY_(__VA_ARGS__)
+#define NSL__IS_EMPTY_(...) (1 __VA_OPT__(-1))
+
+#define NSL__SHOULD(flag, ...)                                                                     \
+    NSL_CAT(NSL__SHOULD_, NSL__SHOULD_DEPTH(__VA_ARGS__))(flag, NSL, __VA_ARGS__)
+#define NSL__SHOULD_DEPTH(...) NSL__SHOULD_DEPTH_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, )
+#define NSL__SHOULD_DEPTH_(_1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+
+#define NSL__SHOULD_1(f, p, a) NSL__IS_EMPTY(p##_##a##_##f)
+#define NSL__SHOULD_2(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_1(f, p##_##a, __VA_ARGS__)
+#define NSL__SHOULD_3(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_2(f, p##_##a, __VA_ARGS__)
+#define NSL__SHOULD_4(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_3(f, p##_##a, __VA_ARGS__)
+#define NSL__SHOULD_5(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_4(f, p##_##a, __VA_ARGS__)
+#define NSL__SHOULD_6(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_5(f, p##_##a, __VA_ARGS__)
+#define NSL__SHOULD_7(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_6(f, p##_##a, __VA_ARGS__)
+#define NSL__SHOULD_8(f, p, a, ...)                                                                \
+    NSL__IS_EMPTY(p##_##a##_##f) || NSL__SHOULD_7(f, p##_##a, __VA_ARGS__)
 
 /******************************************************************************/
 /*                                                                            */
@@ -443,6 +534,9 @@ void nsl__todo_runtime(const char *message, const char *file, int line) {
 #    define todo              nsl_todo
 #    define todo_runtime      nsl_todo_runtime
 #    define todo_comptime     nsl_todo_comptime
+#    define StringView        NSL_StringView
+#    define SV_FMT            NSL_SV_FMT
+#    define SV_ARG            NSL_SV_ARG
 #endif  // defined(NSL_STRIP_PREFIX) || defined(NSL_COMMON_STRIP_PREFIX)
 
 #endif  // NSL_COMMON_H_
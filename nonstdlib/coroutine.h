@@ -0,0 +1,554 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * Stackless coroutines and a scheduler that runs them on one thread. A
+ * coroutine is a function that returns whenever it would block and, when it
+ * is called again, jumps back to where it left off. The jump is a `switch`
+ * over the line that it left off on, in the style of Duff's device, so a
+ * coroutine costs only the size of its state and switching between them is a
+ * function call.
+ *
+ * Because nothing is kept on a stack, local variables are lost when a
+ * coroutine yields. Anything that lives across a yield must be stored in a
+ * struct that has an `NSL_Coroutine` as its first member. A coroutine can
+ * only yield from its own body, not from a function it calls, and it cannot
+ * yield from inside a `switch` of its own or twice on the same line.
+ *
+ * `nsl_coroutine_await_fd` parks a coroutine until a file descriptor is
+ * ready, using `epoll`. Parked coroutines are not looked at again until
+ * `epoll_wait` reports their file descriptor, so thousands of idle
+ * connections cost nothing but their memory. A scheduler is not thread safe;
+ * to use every core, run one scheduler per thread (e.g. one in each task of a
+ * `nonstdlib/sequencer.h` sequencer).
+ *
+ * This module is Linux only, and needs `_POSIX_C_SOURCE` to be at least
+ * `200809L` before any header is included.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _POSIX_C_SOURCE 200809L
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/coroutine.h"
+ *
+ * typedef struct Echo {
+ *     NSL_Coroutine co;
+ *     int           fd;
+ *     char          buffer[4096];
+ *     ssize_t       length;
+ * } Echo;
+ *
+ * NSL_CoroutineStatus echo(NSL_Coroutine *co) {
+ *     Echo *echo = (Echo *)co;
+ *     nsl_coroutine_begin(co);
+ *     while (true) {
+ *         nsl_coroutine_await_fd(co, echo->fd, EPOLLIN);
+ *         echo->length = read(echo->fd, echo->buffer, sizeof(echo->buffer));
+ *         if (echo->length <= 0) { break; }
+ *         nsl_coroutine_await_fd(co, echo->fd, EPOLLOUT);
+ *         write(echo->fd, echo->buffer, (size_t)echo->length);
+ *     }
+ *     close(echo->fd);
+ *     nsl_coroutine_end(co);
+ * }
+ *
+ * int main() {
+ *     NSL_CoroutineScheduler scheduler;
+ *     if (!nsl_coroutine_scheduler_init(&scheduler)) { return 1; }
+ *     for (size_t i = 0; i < count; i++) {
+ *         echoes[i].fd = connections[i];
+ *         nsl_coroutine_spawn(&scheduler, &echoes[i].co, echo);
+ *     }
+ *     nsl_coroutine_scheduler_run(&scheduler);
+ *     nsl_coroutine_scheduler_free(&scheduler);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_COROUTINE_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will
+ *   only include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_COROUTINE_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_COROUTINE_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ * - `NSL_COROUTINE_EVENTS`: The most events read by one call to `epoll_wait`.
+ */
+
+#ifndef NSL_COROUTINE_H_
+#define NSL_COROUTINE_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_COROUTINE_VERSION_MAJOR 0
+#define NSL_COROUTINE_VERSION_MINOR 1
+#define NSL_COROUTINE_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_COROUTINE_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_COROUTINE_DEF
+#    define NSL_COROUTINE_DEF
+#endif  // NSL_COROUTINE_DEF
+
+/*!
+ * `NSL_COROUTINE_EVENTS` is the most events read by one call to `epoll_wait`.
+ * Any others are read by the next call.
+ */
+#ifndef NSL_COROUTINE_EVENTS
+#    define NSL_COROUTINE_EVENTS 64
+#endif  // NSL_COROUTINE_EVENTS
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * What a coroutine returns to the scheduler. This is only ever returned by the
+ * macros in this module.
+ */
+typedef enum NSL_CoroutineStatus {
+    //! The coroutine can run again immediately.
+    NSL_COROUTINE_READY,
+    //! The coroutine waits for a file descriptor or another coroutine.
+    NSL_COROUTINE_PARKED,
+    //! The coroutine has finished.
+    NSL_COROUTINE_DONE,
+} NSL_CoroutineStatus;
+
+typedef struct NSL_Coroutine          NSL_Coroutine;
+typedef struct NSL_CoroutineScheduler NSL_CoroutineScheduler;
+
+/*!
+ * The body of a coroutine, which starts with `nsl_coroutine_begin` and ends
+ * with `nsl_coroutine_end`.
+ */
+typedef NSL_CoroutineStatus NSL_CoroutineFn(NSL_Coroutine *co);
+
+/*!
+ * The state of a coroutine. This is meant to be the first member of a struct
+ * that holds the rest of its state.
+ */
+struct NSL_Coroutine {
+    //! The body of the coroutine.
+    NSL_CoroutineFn *fn;
+    //! The events reported for the file descriptor that the coroutine last
+    //! waited for with `nsl_coroutine_await_fd`.
+    uint32_t revents;
+    //! Whether the coroutine has finished.
+    bool done;
+    //! Private: the line to resume from, or zero to start from the beginning.
+    int line;
+    //! Private: the scheduler that runs the coroutine.
+    NSL_CoroutineScheduler *scheduler;
+    //! Private: the next coroutine in the ready queue.
+    NSL_Coroutine *next;
+    //! Private: the coroutine that waits for this one to finish.
+    NSL_Coroutine *waiter;
+};
+
+/*!
+ * Runs coroutines on the calling thread. This must be initialized with
+ * `nsl_coroutine_scheduler_init` and freed with `nsl_coroutine_scheduler_free`.
+ */
+struct NSL_CoroutineScheduler {
+    //! The number of coroutines that have been spawned and have not finished.
+    size_t live;
+    //! The number of coroutines waiting for a file descriptor.
+    size_t waiting;
+    //! Private: the `epoll` instance that file descriptors are watched with.
+    int epoll;
+    //! Private: the coroutines that can run, in the order they became ready.
+    NSL_Coroutine *head;
+    NSL_Coroutine *tail;
+};
+
+/*!
+ * Starts or resumes the body of a coroutine. This must be the first statement
+ * of the body.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ */
+#define nsl_coroutine_begin(co)                                                                    \
+    switch ((co)->line) {                                                                          \
+    case 0:
+
+/*!
+ * Finishes a coroutine and wakes the coroutine that joined it, if any. This
+ * must be the last statement of the body.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ */
+#define nsl_coroutine_end(co)                                                                      \
+    }                                                                                              \
+    return nsl__coroutine_finish(co)
+
+/*!
+ * Lets every other ready coroutine run before this one continues.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ */
+#define nsl_coroutine_yield(co)                                                                    \
+    do {                                                                                           \
+        (co)->line = __LINE__;                                                                     \
+        return NSL_COROUTINE_READY;                                                                \
+    case __LINE__:;                                                                                \
+    } while (0)
+
+/*!
+ * Parks the coroutine until a file descriptor is ready, and stores the events
+ * that were reported in `co->revents`. A file descriptor that `epoll` cannot
+ * watch, such as a regular file, is always ready, so the coroutine only
+ * yields.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ * - `fd`: The file descriptor to wait for.
+ * - `events`: The `epoll` events to wait for (e.g. `EPOLLIN`).
+ *
+ * # Requires
+ * - No other coroutine of the same scheduler waits for `fd` at the same time.
+ */
+#define nsl_coroutine_await_fd(co, fd, events)                                                     \
+    do {                                                                                           \
+        (co)->line = __LINE__;                                                                     \
+        return nsl__coroutine_park(co, fd, events);                                                \
+    case __LINE__:;                                                                                \
+    } while (0)
+
+/*!
+ * Parks the coroutine until another coroutine has finished.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ * - `other`: The coroutine to wait for.
+ *
+ * # Requires
+ * - `other` has been spawned on the same scheduler.
+ * - No other coroutine joins `other`.
+ */
+#define nsl_coroutine_join(co, other)                                                              \
+    do {                                                                                           \
+        (co)->line = __LINE__;                                                                     \
+        if (!(other)->done) {                                                                      \
+            (other)->waiter = (co);                                                                \
+            return NSL_COROUTINE_PARKED;                                                           \
+        }                                                                                          \
+        [[fallthrough]];                                                                           \
+    case __LINE__:;                                                                                \
+    } while (0)
+
+/*!
+ * Parks the coroutine until `nsl_coroutine_wake` is called for it. This is for
+ * coroutines that are woken by something other than a file descriptor, such
+ * as the completion of a request in `nonstdlib/io.h`.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ *
+ * # Requires
+ * - Something will call `nsl_coroutine_wake` for `co`, or the scheduler will
+ *   consider it finished with its work.
+ */
+#define nsl_coroutine_park(co)                                                                     \
+    do {                                                                                           \
+        (co)->line = __LINE__;                                                                     \
+        return NSL_COROUTINE_PARKED;                                                               \
+    case __LINE__:;                                                                                \
+    } while (0)
+
+/*!
+ * Initializes a scheduler with no coroutines.
+ *
+ * # Parameters
+ * - `scheduler`: The scheduler to initialize.
+ *
+ * # Modifies
+ * - `scheduler`: It is initialized.
+ *
+ * # Returns
+ * Whether the `epoll` instance could be created. If not, `scheduler` is not
+ * initialized.
+ */
+NSL_COROUTINE_DEF bool nsl_coroutine_scheduler_init(NSL_CoroutineScheduler *scheduler);
+
+/*!
+ * Frees a scheduler. Coroutines that have not finished are abandoned.
+ *
+ * # Parameters
+ * - `scheduler`: The scheduler to free.
+ *
+ * # Requires
+ * - `scheduler` is initialized.
+ *
+ * # Modifies
+ * - `scheduler`: It is no longer initialized.
+ */
+NSL_COROUTINE_DEF void nsl_coroutine_scheduler_free(NSL_CoroutineScheduler *scheduler);
+
+/*!
+ * Adds a coroutine to the end of the ready queue of a scheduler. It starts
+ * the next time the scheduler runs.
+ *
+ * # Parameters
+ * - `scheduler`: The scheduler that runs the coroutine.
+ * - `co`: The coroutine.
+ * - `fn`: The body of the coroutine.
+ *
+ * # Requires
+ * - `co` has finished, or has never been spawned.
+ *
+ * # Modifies
+ * - `co`: It starts from the beginning of `fn`.
+ * - `scheduler`: It holds `co` until it finishes.
+ */
+NSL_COROUTINE_DEF void
+nsl_coroutine_spawn(NSL_CoroutineScheduler *scheduler, NSL_Coroutine *co, NSL_CoroutineFn *fn);
+
+/*!
+ * Moves a coroutine parked by `nsl_coroutine_park` to the end of the ready
+ * queue of its scheduler.
+ *
+ * # Parameters
+ * - `co`: The coroutine to wake.
+ *
+ * # Requires
+ * - `co` is parked by `nsl_coroutine_park`.
+ *
+ * # Modifies
+ * - `co`: It runs the next time its scheduler runs.
+ */
+NSL_COROUTINE_DEF void nsl_coroutine_wake(NSL_Coroutine *co);
+
+/*!
+ * Runs each coroutine that is ready once, then waits for file descriptors.
+ * This allows a scheduler to be driven by an outer event loop.
+ *
+ * # Parameters
+ * - `scheduler`: The scheduler.
+ * - `timeout_ms`: The longest time to wait for a file descriptor if no
+ *   coroutine is ready, or -1 to wait until one is.
+ *
+ * # Modifies
+ * - `scheduler`: Coroutines are run, and those whose file descriptors are
+ *   ready are moved to the ready queue.
+ *
+ * # Returns
+ * Whether any coroutine is ready or waiting for a file descriptor.
+ */
+NSL_COROUTINE_DEF bool nsl_coroutine_scheduler_poll(NSL_CoroutineScheduler *scheduler,
+                                                    int                     timeout_ms);
+
+/*!
+ * Runs coroutines until none are ready or waiting for a file descriptor.
+ *
+ * # Parameters
+ * - `scheduler`: The scheduler.
+ *
+ * # Modifies
+ * - `scheduler`: Its coroutines are run.
+ */
+NSL_COROUTINE_DEF void nsl_coroutine_scheduler_run(NSL_CoroutineScheduler *scheduler);
+
+NSL_COROUTINE_DEF NSL_CoroutineStatus nsl__coroutine_park(NSL_Coroutine *co,
+                                                          int            fd,
+                                                          uint32_t       events);
+NSL_COROUTINE_DEF NSL_CoroutineStatus nsl__coroutine_finish(NSL_Coroutine *co);
+
+#endif  // NSL_COROUTINE_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(COROUTINE)
+#    ifndef NSL_COROUTINE_IMPLEMENTATION_GUARD_
+#        define NSL_COROUTINE_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <unistd.h>
+
+static void nsl__coroutine_push(NSL_CoroutineScheduler *scheduler, NSL_Coroutine *co) {
+    co->next = nullptr;
+    if (scheduler->tail == nullptr) {
+        scheduler->head = co;
+    } else {
+        scheduler->tail->next = co;
+    }
+    scheduler->tail = co;
+}
+
+NSL_COROUTINE_DEF bool nsl_coroutine_scheduler_init(NSL_CoroutineScheduler *scheduler) {
+    *scheduler       = (NSL_CoroutineScheduler){};
+    scheduler->epoll = epoll_create1(EPOLL_CLOEXEC);
+    return scheduler->epoll >= 0;
+}
+
+NSL_COROUTINE_DEF void nsl_coroutine_scheduler_free(NSL_CoroutineScheduler *scheduler) {
+    close(scheduler->epoll);
+    *scheduler = (NSL_CoroutineScheduler){.epoll = -1};
+}
+
+NSL_COROUTINE_DEF void
+nsl_coroutine_spawn(NSL_CoroutineScheduler *scheduler, NSL_Coroutine *co, NSL_CoroutineFn *fn) {
+    *co = (NSL_Coroutine){.fn = fn, .scheduler = scheduler};
+    scheduler->live++;
+    nsl__coroutine_push(scheduler, co);
+}
+
+NSL_COROUTINE_DEF void nsl_coroutine_wake(NSL_Coroutine *co) {
+    nsl__coroutine_push(co->scheduler, co);
+}
+
+NSL_COROUTINE_DEF NSL_CoroutineStatus nsl__coroutine_park(NSL_Coroutine *co,
+                                                          int            fd,
+                                                          uint32_t       events) {
+    // One shot registrations are disabled once they fire, so a file descriptor
+    // only needs to be added once and is modified from then on.
+    struct epoll_event event = {.events = events | EPOLLONESHOT, .data.ptr = co};
+    int                epoll = co->scheduler->epoll;
+    if (epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event) == 0
+        || (errno == ENOENT && epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) == 0)) {
+        co->scheduler->waiting++;
+        return NSL_COROUTINE_PARKED;
+    }
+    co->revents = events;
+    return NSL_COROUTINE_READY;
+}
+
+NSL_COROUTINE_DEF NSL_CoroutineStatus nsl__coroutine_finish(NSL_Coroutine *co) {
+    co->done = true;
+    co->scheduler->live--;
+    if (co->waiter != nullptr) { nsl__coroutine_push(co->scheduler, co->waiter); }
+    return NSL_COROUTINE_DONE;
+}
+
+NSL_COROUTINE_DEF bool nsl_coroutine_scheduler_poll(NSL_CoroutineScheduler *scheduler,
+                                                    int                     timeout_ms) {
+    // Only the coroutines that are ready now are run, so one that keeps
+    // yielding cannot starve those waiting for file descriptors.
+    NSL_Coroutine *last = scheduler->tail;
+    while (last != nullptr) {
+        NSL_Coroutine *co = scheduler->head;
+        scheduler->head   = co->next;
+        if (scheduler->head == nullptr) { scheduler->tail = nullptr; }
+        if (co->fn(co) == NSL_COROUTINE_READY) { nsl__coroutine_push(scheduler, co); }
+        if (co == last) { break; }
+    }
+
+    if (scheduler->waiting > 0) {
+        struct epoll_event events[NSL_COROUTINE_EVENTS];
+        int                timeout = scheduler->head != nullptr ? 0 : timeout_ms;
+
+        int count = epoll_wait(scheduler->epoll, events, NSL_COROUTINE_EVENTS, timeout);
+        for (int i = 0; i < count; i++) {
+            NSL_Coroutine *co = events[i].data.ptr;
+            co->revents       = events[i].events;
+            scheduler->waiting--;
+            nsl__coroutine_push(scheduler, co);
+        }
+    }
+    return scheduler->head != nullptr || scheduler->waiting > 0;
+}
+
+NSL_COROUTINE_DEF void nsl_coroutine_scheduler_run(NSL_CoroutineScheduler *scheduler) {
+    while (nsl_coroutine_scheduler_poll(scheduler, -1)) {}
+}
+
+#    endif  // NSL_COROUTINE_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(COROUTINE)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(COROUTINE)
+#    ifndef NSL_COROUTINE_STRIP_PREFIX_GUARD_
+#        define NSL_COROUTINE_STRIP_PREFIX_GUARD_
+
+#        define CoroutineStatus          NSL_CoroutineStatus
+#        define COROUTINE_READY          NSL_COROUTINE_READY
+#        define COROUTINE_PARKED         NSL_COROUTINE_PARKED
+#        define COROUTINE_DONE           NSL_COROUTINE_DONE
+#        define Coroutine                NSL_Coroutine
+#        define CoroutineScheduler       NSL_CoroutineScheduler
+#        define CoroutineFn              NSL_CoroutineFn
+#        define coroutine_begin          nsl_coroutine_begin
+#        define coroutine_end            nsl_coroutine_end
+#        define coroutine_yield          nsl_coroutine_yield
+#        define coroutine_await_fd       nsl_coroutine_await_fd
+#        define coroutine_join           nsl_coroutine_join
+#        define coroutine_park           nsl_coroutine_park
+#        define coroutine_wake           nsl_coroutine_wake
+#        define coroutine_scheduler_init nsl_coroutine_scheduler_init
+#        define coroutine_scheduler_free nsl_coroutine_scheduler_free
+#        define coroutine_spawn          nsl_coroutine_spawn
+#        define coroutine_scheduler_poll nsl_coroutine_scheduler_poll
+#        define coroutine_scheduler_run  nsl_coroutine_scheduler_run
+
+#    endif  // NSL_COROUTINE_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(COROUTINE)
@@ -0,0 +1,498 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * Priority queues as d-ary heaps, generated for a type of item. With four
+ * children per node, the default, a heap of n items is half as deep as a
+ * binary heap, and the children of a node are next to each other in memory,
+ * so popping touches half as many cache lines for one more comparison per
+ * level. The arity can be set for each heap, as any number from 2 up.
+ *
+ * `NSL_HEAP_DEFINE` generates a heap of items. Items are moved through a
+ * hole rather than swapped, and `prefix_heapify` adds many items at once with
+ * Floyd's method in linear time.
+ *
+ * `NSL_INDEXED_HEAP_DEFINE` generates a heap where every item has an id,
+ * a small integer such as the index of a vertex in a graph, and keeps the
+ * position of every id in the heap. This lets `prefix_update` change the
+ * priority of any item (decrease-key), and `prefix_remove` take it out, in
+ * logarithmic time, as Dijkstra's algorithm and timer queues need.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/heap.h"
+ *
+ * #define less(a, b) ((a) < (b))
+ * NSL_INDEXED_HEAP_DEFINE(Frontier, frontier, uint64_t, less)
+ *
+ * // `edges[v]` is the first of the edges of vertex `v` in `targets` and
+ * // `weights`, and `edges[v + 1]` is one past its last edge
+ * void dijkstra(size_t count, const size_t *edges, const size_t *targets,
+ *               const uint64_t *weights, size_t source, uint64_t *distances) {
+ *     for (size_t v = 0; v < count; v++) {
+ *         distances[v] = UINT64_MAX;
+ *     }
+ *     distances[source] = 0;
+ *
+ *     Frontier frontier;
+ *     frontier_init(&frontier);
+ *     frontier_push(&frontier, source, 0);
+ *     while (frontier.count > 0) {
+ *         size_t   v;
+ *         uint64_t distance = frontier_pop(&frontier, &v);
+ *         for (size_t e = edges[v]; e < edges[v + 1]; e++) {
+ *             size_t   w       = targets[e];
+ *             uint64_t through = distance + weights[e];
+ *             if (through >= distances[w]) { continue; }
+ *             if (frontier_contains(&frontier, w)) {
+ *                 frontier_update(&frontier, w, through);
+ *             } else {
+ *                 frontier_push(&frontier, w, through);
+ *             }
+ *             distances[w] = through;
+ *         }
+ *     }
+ *     frontier_free(&frontier);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_HEAP_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_HEAP_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_HEAP_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_HEAP_ARITY`: The number of children of each node of heaps that are
+ *   defined without one. Defaults to 4.
+ */
+
+#ifndef NSL_HEAP_H_
+#define NSL_HEAP_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_HEAP_VERSION_MAJOR 0
+#define NSL_HEAP_VERSION_MINOR 1
+#define NSL_HEAP_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_HEAP_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_HEAP_DEF
+#    define NSL_HEAP_DEF
+#endif  // NSL_HEAP_DEF
+
+/*!
+ * `NSL_HEAP_ARITY` is the number of children of each node of a heap that is
+ * defined without an arity.
+ */
+#ifndef NSL_HEAP_ARITY
+#    define NSL_HEAP_ARITY 4
+#endif  // NSL_HEAP_ARITY
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * Defines a heap of items. This generates:
+ *
+ * - `type`, a struct with the fields `items`, the items in heap order, and
+ *   `count`, the number of items.
+ * - `void prefix_init(type *heap)`, which initializes an empty heap.
+ * - `void prefix_free(type *heap)`, which frees a heap.
+ * - `void prefix_push(type *heap, item_type item)`, which adds an item.
+ * - `item_type prefix_peek(const type *heap)`, which returns the first item.
+ * - `item_type prefix_pop(type *heap)`, which removes the first item and
+ *   returns it.
+ * - `void prefix_heapify(type *heap, const item_type *items, size_t count)`,
+ *   which adds many items at once. If there are at least as many of them as
+ *   there are items in the heap, this takes linear time in the size of the
+ *   heap, instead of pushing them one by one.
+ *
+ * The functions are `static`, and abort if memory cannot be allocated.
+ * `prefix_peek` and `prefix_pop` require the heap to not be empty.
+ *
+ * # Parameters
+ * - `type`: The name of the generated struct.
+ * - `prefix`: The prefix of the generated functions.
+ * - `item_type`: The type of the items.
+ * - `less`: A function or function-like macro that takes two items, and
+ *   returns whether the first comes out of the heap before the second.
+ * - `...`: The number of children of each node, which is `NSL_HEAP_ARITY` if
+ *   it is not given.
+ *
+ * # Requires
+ * - `less` is a strict weak ordering.
+ * - The number of children is at least 2.
+ */
+#define NSL_HEAP_DEFINE(type, prefix, item_type, less, ...)                                        \
+    typedef struct type {                                                                          \
+        item_type *items;                                                                          \
+        size_t     count;                                                                          \
+        size_t     capacity;                                                                       \
+    } type;                                                                                        \
+                                                                                                   \
+    NSL__HEAP_SIFT(type,                                                                           \
+                   prefix,                                                                         \
+                   item_type,                                                                      \
+                   NSL__HEAP_LESS,                                                                 \
+                   less,                                                                           \
+                   NSL_ARG_HEAD(__VA_ARGS__ __VA_OPT__(, ) NSL_HEAP_ARITY),                        \
+                   NSL__HEAP_UNTRACKED)                                                            \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _init)(type *heap) {                              \
+        *heap = (type){};                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _free)(type *heap) {                              \
+        nsl_free(heap->items);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _push)(type *heap, item_type item) {              \
+        heap->items = nsl__heap_grow(heap->items, &heap->capacity, heap->count + 1, sizeof(item)); \
+        heap->items[heap->count] = item;                                                           \
+        NSL_CAT(prefix, __sift_up)(heap, heap->count++);                                           \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static item_type NSL_CAT(prefix, _peek)(const type *heap) {                   \
+        return heap->items[0];                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static item_type NSL_CAT(prefix, _pop)(type *heap) {                          \
+        item_type first = heap->items[0];                                                          \
+        if (--heap->count > 0) {                                                                   \
+            heap->items[0] = heap->items[heap->count];                                             \
+            NSL_CAT(prefix, __sift_down)(heap, 0);                                                 \
+        }                                                                                          \
+        return first;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _heapify)(type *heap,                             \
+                                                           const item_type *items,                 \
+                                                           size_t count) {                         \
+        size_t total = heap->count + count;                                                        \
+        heap->items  = nsl__heap_grow(heap->items, &heap->capacity, total, sizeof(*items));        \
+        if (count < heap->count) {                                                                 \
+            for (size_t i = 0; i < count; i++) {                                                   \
+                heap->items[heap->count] = items[i];                                               \
+                NSL_CAT(prefix, __sift_up)(heap, heap->count++);                                   \
+            }                                                                                      \
+            return;                                                                                \
+        }                                                                                          \
+        if (count > 0) { memcpy(heap->items + heap->count, items, count * sizeof(*items)); }       \
+        heap->count = total;                                                                       \
+        NSL_CAT(prefix, __heapify)(heap);                                                          \
+    }
+
+/*!
+ * Defines a heap of items that each have an id. This generates:
+ *
+ * - `type`, a struct with the fields `items`, the items and their ids in heap
+ *   order, as `type##Entry` structs with the fields `item` and `id`, and
+ *   `count`, the number of items.
+ * - `void prefix_init(type *heap)`, which initializes an empty heap.
+ * - `void prefix_free(type *heap)`, which frees a heap.
+ * - `bool prefix_contains(const type *heap, size_t id)`, which returns
+ *   whether there is an item with an id in the heap.
+ * - `void prefix_push(type *heap, size_t id, item_type item)`, which adds an
+ *   item with an id that is not in the heap.
+ * - `void prefix_update(type *heap, size_t id, item_type item)`, which
+ *   replaces the item with an id that is in the heap, moving it up or down.
+ * - `void prefix_remove(type *heap, size_t id)`, which removes the item with
+ *   an id that is in the heap.
+ * - `item_type prefix_peek(const type *heap)`, which returns the first item.
+ * - `item_type prefix_pop(type *heap, size_t *id)`, which removes the first
+ *   item and returns it, and stores its id in `id` if it is not `nullptr`.
+ *
+ * The position of each id is kept in an array that is as long as the largest
+ * id that has been pushed, so ids should be small and dense, like the indices
+ * of an array. The functions are `static`, and abort if memory cannot be
+ * allocated. `prefix_peek` and `prefix_pop` require the heap to not be empty.
+ *
+ * # Parameters
+ * - `type`: The name of the generated struct.
+ * - `prefix`: The prefix of the generated functions.
+ * - `item_type`: The type of the items.
+ * - `less`: A function or function-like macro that takes two items, and
+ *   returns whether the first comes out of the heap before the second.
+ * - `...`: The number of children of each node, which is `NSL_HEAP_ARITY` if
+ *   it is not given.
+ *
+ * # Requires
+ * - `less` is a strict weak ordering.
+ * - The number of children is at least 2.
+ * - Ids are less than `SIZE_MAX`.
+ */
+#define NSL_INDEXED_HEAP_DEFINE(type, prefix, item_type, less, ...)                                \
+    typedef struct NSL_CAT(type, Entry) {                                                          \
+        item_type item;                                                                            \
+        size_t    id;                                                                              \
+    } NSL_CAT(type, Entry);                                                                        \
+                                                                                                   \
+    typedef struct type {                                                                          \
+        NSL_CAT(type, Entry) * items;                                                              \
+        size_t  count;                                                                             \
+        size_t  capacity;                                                                          \
+        size_t *positions;                                                                         \
+        size_t  id_capacity;                                                                       \
+    } type;                                                                                        \
+                                                                                                   \
+    NSL__HEAP_SIFT(type,                                                                           \
+                   prefix,                                                                         \
+                   NSL_CAT(type, Entry),                                                           \
+                   NSL__HEAP_ENTRY_LESS,                                                           \
+                   less,                                                                           \
+                   NSL_ARG_HEAD(__VA_ARGS__ __VA_OPT__(, ) NSL_HEAP_ARITY),                        \
+                   NSL__HEAP_TRACKED)                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _init)(type *heap) {                              \
+        *heap = (type){};                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _free)(type *heap) {                              \
+        nsl_free(heap->items);                                                                     \
+        nsl_free(heap->positions);                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static bool NSL_CAT(prefix, _contains)(const type *heap, size_t id) {         \
+        return id < heap->id_capacity && heap->positions[id] != SIZE_MAX;                          \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _push)(type *heap, size_t id, item_type item) {   \
+        if (id >= heap->id_capacity) {                                                             \
+            size_t old      = heap->id_capacity;                                                   \
+            heap->positions = nsl__heap_grow(                                                      \
+                heap->positions, &heap->id_capacity, id + 1, sizeof(*heap->positions));            \
+            memset(heap->positions + old, 0xff, (heap->id_capacity - old) * sizeof(size_t));       \
+        }                                                                                          \
+        heap->items = nsl__heap_grow(                                                              \
+            heap->items, &heap->capacity, heap->count + 1, sizeof(*heap->items));                  \
+        heap->items[heap->count] = (NSL_CAT(type, Entry)){item, id};                               \
+        NSL_CAT(prefix, __sift_up)(heap, heap->count++);                                           \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _update)(type *heap, size_t id, item_type item) { \
+        size_t index            = heap->positions[id];                                             \
+        heap->items[index].item = item;                                                            \
+        NSL_CAT(prefix, __sift_up)(heap, index);                                                   \
+        NSL_CAT(prefix, __sift_down)(heap, heap->positions[id]);                                   \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _remove)(type *heap, size_t id) {                 \
+        size_t index        = heap->positions[id];                                                 \
+        heap->positions[id] = SIZE_MAX;                                                            \
+        if (index == --heap->count) { return; }                                                    \
+        size_t last        = heap->items[heap->count].id;                                          \
+        heap->items[index] = heap->items[heap->count];                                             \
+        NSL_CAT(prefix, __sift_up)(heap, index);                                                   \
+        NSL_CAT(prefix, __sift_down)(heap, heap->positions[last]);                                 \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static item_type NSL_CAT(prefix, _peek)(const type *heap) {                   \
+        return heap->items[0].item;                                                                \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static item_type NSL_CAT(prefix, _pop)(type *heap, size_t *id) {              \
+        NSL_CAT(type, Entry) first  = heap->items[0];                                              \
+        heap->positions[first.id]   = SIZE_MAX;                                                    \
+        if (--heap->count > 0) {                                                                   \
+            heap->items[0] = heap->items[heap->count];                                             \
+            NSL_CAT(prefix, __sift_down)(heap, 0);                                                 \
+        }                                                                                          \
+        if (id != nullptr) { *id = first.id; }                                                     \
+        return first.item;                                                                         \
+    }
+
+/*!
+ * Grows an array to hold at least `count` elements, doubling its capacity.
+ * This is used by the functions generated by `NSL_HEAP_DEFINE` and
+ * `NSL_INDEXED_HEAP_DEFINE`.
+ *
+ * # Parameters
+ * - `items`: The array, or `nullptr`.
+ * - `capacity`: The number of elements that `items` can hold.
+ * - `count`: The number of elements that it has to hold.
+ * - `size`: The size of an element.
+ *
+ * # Modifies
+ * - `capacity`: It is set to the new capacity.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ *
+ * # Returns
+ * The array, which may have moved.
+ */
+NSL_HEAP_DEF void *nsl__heap_grow(void *items, size_t *capacity, size_t count, size_t size);
+
+// Compares two items, or the items of two entries of an indexed heap.
+#define NSL__HEAP_LESS(less, a, b)       less(a, b)
+#define NSL__HEAP_ENTRY_LESS(less, a, b) less((a).item, (b).item)
+
+// Records that an item has moved to `index`, which only indexed heaps do.
+#define NSL__HEAP_UNTRACKED(heap, index) ((void)0)
+#define NSL__HEAP_TRACKED(heap, index)   ((heap)->positions[(heap)->items[index].id] = (index))
+
+// Generates the functions that restore the heap order, which move an item up
+// or down through a hole instead of swapping it at every level. The first of
+// more than two children is picked with conditional moves, since which one it
+// is cannot be predicted, but guessing the first of two children and loading
+// ahead is faster.
+#define NSL__HEAP_SIFT(type, prefix, entry_type, compare, less, arity, track)                      \
+    [[maybe_unused]] static void NSL_CAT(prefix, __sift_up)(type *heap, size_t index) {            \
+        entry_type *items = heap->items;                                                           \
+        entry_type  item  = items[index];                                                          \
+        while (index > 0) {                                                                        \
+            size_t parent = (index - 1) / (arity);                                                 \
+            if (!compare(less, item, items[parent])) { break; }                                    \
+            items[index] = items[parent];                                                          \
+            track(heap, index);                                                                    \
+            index = parent;                                                                        \
+        }                                                                                          \
+        items[index] = item;                                                                       \
+        track(heap, index);                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, __sift_down)(type *heap, size_t index) {          \
+        entry_type *items = heap->items;                                                           \
+        entry_type  item  = items[index];                                                          \
+        size_t      count = heap->count;                                                           \
+        while (true) {                                                                             \
+            size_t first = index * (arity) + 1;                                                    \
+            if (first >= count) { break; }                                                         \
+            size_t     end       = count - first > (arity) ? first + (arity) : count;              \
+            size_t     best      = first;                                                          \
+            entry_type best_item = items[first];                                                   \
+            if ((arity) == 2) {                                                                    \
+                if (end > first + 1 && compare(less, items[first + 1], best_item)) {               \
+                    best      = first + 1;                                                         \
+                    best_item = items[best];                                                       \
+                }                                                                                  \
+            } else {                                                                               \
+                for (size_t child = first + 1; child < end; child++) {                             \
+                    bool before = compare(less, items[child], best_item);                          \
+                    best        = before ? child : best;                                           \
+                    best_item   = before ? items[child] : best_item;                               \
+                }                                                                                  \
+            }                                                                                      \
+            if (!compare(less, best_item, item)) { break; }                                        \
+            items[index] = best_item;                                                              \
+            track(heap, index);                                                                    \
+            index = best;                                                                          \
+        }                                                                                          \
+        items[index] = item;                                                                       \
+        track(heap, index);                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, __heapify)(type *heap) {                          \
+        if (heap->count < 2) { return; }                                                           \
+        for (size_t i = (heap->count - 2) / (arity) + 1; i-- > 0;) {                               \
+            NSL_CAT(prefix, __sift_down)(heap, i);                                                 \
+        }                                                                                          \
+    }
+
+#endif  // NSL_HEAP_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(HEAP)
+#    ifndef NSL_HEAP_IMPLEMENTATION_GUARD_
+#        define NSL_HEAP_IMPLEMENTATION_GUARD_
+
+NSL_HEAP_DEF void *nsl__heap_grow(void *items, size_t *capacity, size_t count, size_t size) {
+    if (count <= *capacity) { return items; }
+    size_t grown = *capacity == 0 ? 16 : *capacity;
+    while (grown < count) {
+        grown *= 2;
+    }
+    items = nsl_realloc(items, grown * size);
+    if (items == nullptr) {
+        nsl_eprintf("[HEAP] out of memory\n");
+        nsl_abort();
+    }
+    *capacity = grown;
+    return items;
+}
+
+#    endif  // NSL_HEAP_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(HEAP)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(HEAP)
+#    ifndef NSL_HEAP_STRIP_PREFIX_GUARD_
+#        define NSL_HEAP_STRIP_PREFIX_GUARD_
+
+#        define HEAP_DEFINE         NSL_HEAP_DEFINE
+#        define INDEXED_HEAP_DEFINE NSL_INDEXED_HEAP_DEFINE
+
+#    endif  // NSL_HEAP_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(HEAP)
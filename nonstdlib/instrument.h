@@ -0,0 +1,632 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * Instrumentation for finding where time goes in production. Every call site
+ * of `nsl_instr_scope`, `nsl_instr_count` and `nsl_instr_record` has its own
+ * statistics, which are identified by a name along with the file and line of
+ * the call site.
+ *
+ * - `nsl_instr_scope` times the rest of the enclosing block.
+ * - `nsl_instr_count` adds to a counter.
+ * - `nsl_instr_record` adds a value to a histogram.
+ *
+ * Each thread accumulates into its own statistics, so recording never takes a
+ * lock or executes an atomic read-modify-write. The statistics of every thread
+ * are only combined when they are asked for with `nsl_instr_collect` or
+ * `nsl_instr_report`. Histograms use buckets that are a quarter of a power of
+ * two wide, so percentiles are accurate to within 25%.
+ *
+ * Times are measured in ticks of `nsl_instr_now`, which is the time stamp
+ * counter on x86-64 and `clock_gettime` elsewhere. `nsl_instr_ticks_to_ns`
+ * converts them to nanoseconds.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/instrument.h"
+ *
+ * void handle(Request *request) {
+ *     nsl_instr_scope("handle");
+ *     nsl_instr_count("requests", 1);
+ *     nsl_instr_record("request bytes", request->size);
+ *     // ...
+ * }
+ *
+ * int main(void) {
+ *     // ...
+ *     nsl_instr_report(stderr);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_INSTRUMENT_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will
+ *   only include the implementation for this module.
+ * - `NSL_INSTRUMENT_DISABLE`: Defining this macro before this file is included
+ *   will remove every `nsl_instr_scope`, `nsl_instr_count` and
+ *   `nsl_instr_record` at compile time. Their arguments are not evaluated.
+ * - `NSL_INSTRUMENT_CLOCK_GETTIME`: Defining this macro before this file is
+ *   included will cause `nsl_instr_now` to use `clock_gettime` even when the
+ *   time stamp counter is available.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_INSTRUMENT_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_INSTRUMENT_DEF`: Can be defined to change the storage class or
+ *   linkage of the functions in this module (e.g. `static`).
+ * - `NSL_INSTRUMENT_MAX_SITES`: The maximum number of call sites that are
+ *   recorded.
+ */
+
+#ifndef NSL_INSTRUMENT_H_
+#define NSL_INSTRUMENT_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_INSTRUMENT_VERSION_MAJOR 0
+#define NSL_INSTRUMENT_VERSION_MINOR 1
+#define NSL_INSTRUMENT_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_INSTRUMENT_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_INSTRUMENT_DEF
+#    define NSL_INSTRUMENT_DEF
+#endif  // NSL_INSTRUMENT_DEF
+
+/*!
+ * `NSL_INSTRUMENT_MAX_SITES` is the maximum number of call sites that are
+ * recorded. Call sites that are first reached after the limit is hit are
+ * ignored. Each thread that records anything uses a table of this many
+ * pointers.
+ */
+#ifndef NSL_INSTRUMENT_MAX_SITES
+#    define NSL_INSTRUMENT_MAX_SITES 256
+#endif  // NSL_INSTRUMENT_MAX_SITES
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+// The number of histogram buckets. Values below 4 have their own bucket, and
+// every power of two above that is split into 4 buckets.
+#define NSL__INSTR_BUCKETS 252
+
+/*!
+ * What a call site measures.
+ */
+typedef enum NSL_InstrKind {
+    //! Created by `nsl_instr_count`.
+    NSL_INSTR_COUNTER,
+    //! Created by `nsl_instr_record`.
+    NSL_INSTR_HISTOGRAM,
+    //! Created by `nsl_instr_scope`. Values are in ticks of `nsl_instr_now`.
+    NSL_INSTR_TIMER,
+} NSL_InstrKind;
+
+/*!
+ * The statistics of a call site, combined across every thread.
+ */
+typedef struct NSL_InstrStats {
+    //! The name given at the call site.
+    const char *name;
+    //! The file of the call site.
+    const char *file;
+    //! The line of the call site.
+    int line;
+    //! What the call site measures.
+    NSL_InstrKind kind;
+    //! The number of times the call site was reached.
+    uint64_t count;
+    //! The total of every value, or of every amount for counters.
+    uint64_t sum;
+    //! The smallest value. Not used for counters.
+    uint64_t min;
+    //! The largest value. Not used for counters.
+    uint64_t max;
+    //! The number of values in each histogram bucket. Not used for counters.
+    uint64_t buckets[NSL__INSTR_BUCKETS];
+} NSL_InstrStats;
+
+/*!
+ * Returns the current time in ticks. On x86-64 this reads the time stamp
+ * counter, unless `NSL_INSTRUMENT_CLOCK_GETTIME` is defined. Otherwise, this is
+ * the time in nanoseconds from `clock_gettime` with `CLOCK_MONOTONIC`.
+ *
+ * # Returns
+ * The current time in ticks.
+ */
+static inline uint64_t nsl_instr_now(void) {
+#if defined(__x86_64__) && !defined(NSL_INSTRUMENT_CLOCK_GETTIME)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/*!
+ * Times the rest of the enclosing block, from this point until the block is
+ * exited in any way other than `longjmp`.
+ *
+ * # Parameters
+ * - `name`: A string literal that names the timer.
+ *
+ * # Requires
+ * - There is only one `nsl_instr_scope` on each line.
+ */
+#if defined(NSL_INSTRUMENT_DISABLE)
+#    define nsl_instr_scope(name) static_assert(true, "")
+#else
+#    define nsl_instr_scope(name)                                                                  \
+        static NSL__InstrSite NSL_CAT(nsl__instr_site_, __LINE__) = {                              \
+            name,                                                                                  \
+            __FILE__,                                                                              \
+            __LINE__,                                                                              \
+            NSL_INSTR_TIMER,                                                                       \
+            0,                                                                                     \
+        };                                                                                         \
+        [[gnu::cleanup(nsl__instr_scope_end)]]                                                     \
+        NSL__InstrScope NSL_CAT(nsl__instr_scope_, __LINE__) = {                                   \
+            &NSL_CAT(nsl__instr_site_, __LINE__),                                                  \
+            nsl_instr_now(),                                                                       \
+        }
+#endif  // defined(NSL_INSTRUMENT_DISABLE)
+
+/*!
+ * Adds to a counter.
+ *
+ * # Parameters
+ * - `name`: A string literal that names the counter.
+ * - `amount`: The amount to add, which is converted to `uint64_t`.
+ */
+#if defined(NSL_INSTRUMENT_DISABLE)
+#    define nsl_instr_count(name, amount) ((void)0)
+#else
+#    define nsl_instr_count(name, amount) nsl__instr_site(name, NSL_INSTR_COUNTER, amount)
+#endif  // defined(NSL_INSTRUMENT_DISABLE)
+
+/*!
+ * Adds a value to a histogram.
+ *
+ * # Parameters
+ * - `name`: A string literal that names the histogram.
+ * - `value`: The value to add, which is converted to `uint64_t`.
+ */
+#if defined(NSL_INSTRUMENT_DISABLE)
+#    define nsl_instr_record(name, value) ((void)0)
+#else
+#    define nsl_instr_record(name, value) nsl__instr_site(name, NSL_INSTR_HISTOGRAM, value)
+#endif  // defined(NSL_INSTRUMENT_DISABLE)
+
+/*!
+ * Combines the statistics of every thread for each call site that has been
+ * reached. Threads may keep recording while this runs, in which case their
+ * latest values may or may not be included.
+ *
+ * # Parameters
+ * - `stats`: Where the statistics are written.
+ * - `capacity`: The number of elements in `stats`.
+ *
+ * # Modifies
+ * - `stats`: The first `capacity` call sites, in the order they were first
+ *   reached, are written to it.
+ *
+ * # Returns
+ * The number of call sites that have been reached, which may be more than
+ * `capacity`.
+ */
+NSL_INSTRUMENT_DEF size_t nsl_instr_collect(NSL_InstrStats *stats, size_t capacity);
+
+/*!
+ * Estimates a percentile of a histogram or timer from its buckets.
+ *
+ * # Parameters
+ * - `stats`: The statistics of the call site.
+ * - `percentile`: The percentile, between 0 and 100.
+ *
+ * # Returns
+ * The upper bound of the bucket that contains the percentile, which is never
+ * more than `stats->max`, or 0 if there are no values.
+ */
+NSL_INSTRUMENT_DEF uint64_t nsl_instr_percentile(const NSL_InstrStats *stats, double percentile);
+
+/*!
+ * Converts a number of ticks of `nsl_instr_now` to nanoseconds. The first call
+ * takes a few milliseconds to measure the frequency of the time stamp counter.
+ *
+ * # Parameters
+ * - `ticks`: The number of ticks.
+ *
+ * # Returns
+ * The number of nanoseconds.
+ */
+NSL_INSTRUMENT_DEF double nsl_instr_ticks_to_ns(uint64_t ticks);
+
+/*!
+ * Writes a table of the combined statistics of every call site, with times in
+ * nanoseconds.
+ *
+ * # Parameters
+ * - `file`: Where the table is written.
+ */
+NSL_INSTRUMENT_DEF void nsl_instr_report(FILE *file);
+
+// The static description of a call site. `id` is assigned the first time the
+// call site is reached, and is the index into each thread's table plus one.
+typedef struct NSL__InstrSite {
+    const char       *name;
+    const char       *file;
+    int               line;
+    NSL_InstrKind     kind;
+    _Atomic uint32_t  id;
+} NSL__InstrSite;
+
+typedef struct NSL__InstrScope {
+    NSL__InstrSite *site;
+    uint64_t        start;
+} NSL__InstrScope;
+
+#define nsl__instr_site(name, kind, value)                                                         \
+    do {                                                                                           \
+        static NSL__InstrSite nsl__instr_site_ = {                                                 \
+            name,                                                                                  \
+            __FILE__,                                                                              \
+            __LINE__,                                                                              \
+            kind,                                                                                  \
+            0,                                                                                     \
+        };                                                                                         \
+        nsl__instr_add(&nsl__instr_site_, (uint64_t)(value));                                      \
+    } while (0)
+
+NSL_INSTRUMENT_DEF void nsl__instr_add(NSL__InstrSite *site, uint64_t value);
+
+static inline void nsl__instr_scope_end(NSL__InstrScope *scope) {
+    nsl__instr_add(scope->site, nsl_instr_now() - scope->start);
+}
+
+#endif  // NSL_INSTRUMENT_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(INSTRUMENT)
+#    ifndef NSL_INSTRUMENT_IMPLEMENTATION_GUARD_
+#        define NSL_INSTRUMENT_IMPLEMENTATION_GUARD_
+
+#        include <inttypes.h>
+#        include <stdatomic.h>
+#        include <threads.h>
+
+// The statistics of a call site for a single thread. Only the owning thread
+// writes them, so relaxed loads and stores are enough, and compile to plain
+// moves. Counters do not have buckets.
+typedef struct NSL__InstrSlot {
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum;
+    _Atomic uint64_t min;
+    _Atomic uint64_t max;
+    _Atomic uint64_t buckets[];
+} NSL__InstrSlot;
+
+// The statistics of every call site for a single thread. These are never freed,
+// so that the statistics of threads that have exited are still reported.
+typedef struct NSL__InstrThread NSL__InstrThread;
+struct NSL__InstrThread {
+    _Atomic(NSL__InstrSlot *) slots[NSL_INSTRUMENT_MAX_SITES];
+    NSL__InstrThread         *next;
+};
+
+static struct {
+    once_flag                   once;
+    mtx_t                       mutex;
+    NSL__InstrSite             *sites[NSL_INSTRUMENT_MAX_SITES];
+    _Atomic uint32_t            count;
+    _Atomic(NSL__InstrThread *) threads;
+    once_flag                   calibrated;
+    double                      ns_per_tick;
+} g_nsl__instr = {.once = ONCE_FLAG_INIT, .calibrated = ONCE_FLAG_INIT};
+
+static thread_local NSL__InstrThread *g_nsl__instr_thread;
+
+static void nsl__instr_init(void) {
+    mtx_init(&g_nsl__instr.mutex, mtx_plain);
+}
+
+// Assigns an id to a call site the first time it is reached.
+static uint32_t nsl__instr_register(NSL__InstrSite *site) {
+    call_once(&g_nsl__instr.once, nsl__instr_init);
+    mtx_lock(&g_nsl__instr.mutex);
+    uint32_t id = atomic_load_explicit(&site->id, memory_order_relaxed);
+    if (id == 0) {
+        uint32_t count = atomic_load_explicit(&g_nsl__instr.count, memory_order_relaxed);
+        if (count < NSL_INSTRUMENT_MAX_SITES) {
+            g_nsl__instr.sites[count] = site;
+            atomic_store_explicit(&g_nsl__instr.count, count + 1, memory_order_release);
+            id = count + 1;
+        } else {
+            id = UINT32_MAX;
+        }
+        atomic_store_explicit(&site->id, id, memory_order_release);
+    }
+    mtx_unlock(&g_nsl__instr.mutex);
+    return id;
+}
+
+// Allocates the table of the current thread the first time it records.
+static NSL__InstrThread *nsl__instr_thread(void) {
+    NSL__InstrThread *thread = nsl_malloc(sizeof(*thread));
+    if (thread == nullptr) { return nullptr; }
+    for (size_t i = 0; i < NSL_INSTRUMENT_MAX_SITES; i++) {
+        atomic_init(&thread->slots[i], nullptr);
+    }
+    thread->next = atomic_load_explicit(&g_nsl__instr.threads, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&g_nsl__instr.threads,
+                                                  &thread->next,
+                                                  thread,
+                                                  memory_order_release,
+                                                  memory_order_relaxed)) {}
+    g_nsl__instr_thread = thread;
+    return thread;
+}
+
+// Allocates the statistics of a call site the first time the current thread
+// reaches it.
+static NSL__InstrSlot *nsl__instr_slot(NSL__InstrThread *thread, NSL_InstrKind kind, uint32_t id) {
+    size_t          buckets = kind == NSL_INSTR_COUNTER ? 0 : NSL__INSTR_BUCKETS;
+    NSL__InstrSlot *slot    = nsl_malloc(sizeof(*slot) + buckets * sizeof(*slot->buckets));
+    if (slot == nullptr) { return nullptr; }
+    atomic_init(&slot->count, 0);
+    atomic_init(&slot->sum, 0);
+    atomic_init(&slot->min, UINT64_MAX);
+    atomic_init(&slot->max, 0);
+    for (size_t i = 0; i < buckets; i++) {
+        atomic_init(&slot->buckets[i], 0);
+    }
+    atomic_store_explicit(&thread->slots[id - 1], slot, memory_order_release);
+    return slot;
+}
+
+static size_t nsl__instr_bucket(uint64_t value) {
+    if (value < 4) { return (size_t)value; }
+    int exponent = 63 - __builtin_clzll(value);
+    return (size_t)(exponent - 1) * 4 + ((value >> (exponent - 2)) & 3);
+}
+
+// Returns the largest value that falls into `bucket`.
+static uint64_t nsl__instr_bucket_max(size_t bucket) {
+    if (bucket < 4) { return bucket; }
+    int      exponent = (int)(bucket / 4) + 1;
+    uint64_t width    = (uint64_t)1 << (exponent - 2);
+    return (4 + bucket % 4) * width + (width - 1);
+}
+
+// Adds to a value that only the current thread writes.
+static inline void nsl__instr_bump(_Atomic uint64_t *value, uint64_t amount) {
+    uint64_t current = atomic_load_explicit(value, memory_order_relaxed);
+    atomic_store_explicit(value, current + amount, memory_order_relaxed);
+}
+
+NSL_INSTRUMENT_DEF void nsl__instr_add(NSL__InstrSite *site, uint64_t value) {
+    uint32_t id = atomic_load_explicit(&site->id, memory_order_acquire);
+    if (id == 0) { id = nsl__instr_register(site); }
+    if (id > NSL_INSTRUMENT_MAX_SITES) { return; }
+
+    NSL__InstrThread *thread = g_nsl__instr_thread;
+    if (thread == nullptr && (thread = nsl__instr_thread()) == nullptr) { return; }
+    NSL__InstrSlot *slot = atomic_load_explicit(&thread->slots[id - 1], memory_order_relaxed);
+    if (slot == nullptr && (slot = nsl__instr_slot(thread, site->kind, id)) == nullptr) { return; }
+
+    nsl__instr_bump(&slot->count, 1);
+    nsl__instr_bump(&slot->sum, value);
+    if (site->kind == NSL_INSTR_COUNTER) { return; }
+    if (value < atomic_load_explicit(&slot->min, memory_order_relaxed)) {
+        atomic_store_explicit(&slot->min, value, memory_order_relaxed);
+    }
+    if (value > atomic_load_explicit(&slot->max, memory_order_relaxed)) {
+        atomic_store_explicit(&slot->max, value, memory_order_relaxed);
+    }
+    nsl__instr_bump(&slot->buckets[nsl__instr_bucket(value)], 1);
+}
+
+NSL_INSTRUMENT_DEF size_t nsl_instr_collect(NSL_InstrStats *stats, size_t capacity) {
+    uint32_t count = atomic_load_explicit(&g_nsl__instr.count, memory_order_acquire);
+    for (uint32_t id = 0; id < count && id < capacity; id++) {
+        NSL__InstrSite *site = g_nsl__instr.sites[id];
+        NSL_InstrStats *out  = &stats[id];
+        *out = (NSL_InstrStats){
+            .name = site->name,
+            .file = site->file,
+            .line = site->line,
+            .kind = site->kind,
+            .min  = UINT64_MAX,
+        };
+
+        NSL__InstrThread *thread =
+            atomic_load_explicit(&g_nsl__instr.threads, memory_order_acquire);
+        for (; thread != nullptr; thread = thread->next) {
+            NSL__InstrSlot *slot = atomic_load_explicit(&thread->slots[id], memory_order_acquire);
+            if (slot == nullptr) { continue; }
+            out->count    += atomic_load_explicit(&slot->count, memory_order_relaxed);
+            out->sum      += atomic_load_explicit(&slot->sum, memory_order_relaxed);
+            if (site->kind == NSL_INSTR_COUNTER) { continue; }
+            uint64_t min   = atomic_load_explicit(&slot->min, memory_order_relaxed);
+            uint64_t max   = atomic_load_explicit(&slot->max, memory_order_relaxed);
+            out->min       = min < out->min ? min : out->min;
+            out->max       = max > out->max ? max : out->max;
+            for (size_t i = 0; i < NSL__INSTR_BUCKETS; i++) {
+                out->buckets[i] += atomic_load_explicit(&slot->buckets[i], memory_order_relaxed);
+            }
+        }
+        if (out->min == UINT64_MAX) { out->min = 0; }
+    }
+    return count;
+}
+
+NSL_INSTRUMENT_DEF uint64_t nsl_instr_percentile(const NSL_InstrStats *stats, double percentile) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < NSL__INSTR_BUCKETS; i++) {
+        total += stats->buckets[i];
+    }
+    if (total == 0) { return 0; }
+
+    double   rank = percentile / 100.0 * (double)total;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NSL__INSTR_BUCKETS; i++) {
+        seen += stats->buckets[i];
+        if (seen > 0 && (double)seen >= rank) {
+            uint64_t max = nsl__instr_bucket_max(i);
+            return max < stats->max ? max : stats->max;
+        }
+    }
+    return stats->max;
+}
+
+static void nsl__instr_calibrate(void) {
+#if defined(__x86_64__) && !defined(NSL_INSTRUMENT_CLOCK_GETTIME)
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t ticks   = nsl_instr_now();
+    double   elapsed = 0.0;
+    while (elapsed < 5e6) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (double)(now.tv_sec - start.tv_sec) * 1e9 + (double)(now.tv_nsec - start.tv_nsec);
+    }
+    g_nsl__instr.ns_per_tick = elapsed / (double)(nsl_instr_now() - ticks);
+#else
+    g_nsl__instr.ns_per_tick = 1.0;
+#endif
+}
+
+NSL_INSTRUMENT_DEF double nsl_instr_ticks_to_ns(uint64_t ticks) {
+    call_once(&g_nsl__instr.calibrated, nsl__instr_calibrate);
+    return (double)ticks * g_nsl__instr.ns_per_tick;
+}
+
+NSL_INSTRUMENT_DEF void nsl_instr_report(FILE *file) {
+    static const char *const kinds[] = {"counter", "histogram", "timer (ns)"};
+
+    static NSL_InstrStats stats[NSL_INSTRUMENT_MAX_SITES];
+    size_t                count = nsl_instr_collect(stats, NSL_INSTRUMENT_MAX_SITES);
+    if (count > NSL_INSTRUMENT_MAX_SITES) { count = NSL_INSTRUMENT_MAX_SITES; }
+
+    fprintf(file,
+            "%-24s %-10s %12s %14s %12s %12s %12s %12s  %s\n",
+            "name",
+            "kind",
+            "count",
+            "total",
+            "mean",
+            "p50",
+            "p99",
+            "max",
+            "location");
+    for (size_t i = 0; i < count; i++) {
+        NSL_InstrStats *s     = &stats[i];
+        double          scale = s->kind == NSL_INSTR_TIMER ? nsl_instr_ticks_to_ns(1) : 1.0;
+        fprintf(file, "%-24s %-10s %12" PRIu64, s->name, kinds[s->kind], s->count);
+        if (s->kind == NSL_INSTR_COUNTER) {
+            fprintf(file, " %14" PRIu64 " %12s %12s %12s %12s", s->sum, "", "", "", "");
+        } else {
+            fprintf(file,
+                    " %14.0f %12.1f %12.0f %12.0f %12.0f",
+                    (double)s->sum * scale,
+                    s->count == 0 ? 0.0 : (double)s->sum * scale / (double)s->count,
+                    (double)nsl_instr_percentile(s, 50) * scale,
+                    (double)nsl_instr_percentile(s, 99) * scale,
+                    (double)s->max * scale);
+        }
+        fprintf(file, "  %s:%d\n", s->file, s->line);
+    }
+}
+
+#    endif  // NSL_INSTRUMENT_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(INSTRUMENT)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(INSTRUMENT)
+#    ifndef NSL_INSTRUMENT_STRIP_PREFIX_GUARD_
+#        define NSL_INSTRUMENT_STRIP_PREFIX_GUARD_
+
+#        define InstrKind         NSL_InstrKind
+#        define INSTR_COUNTER     NSL_INSTR_COUNTER
+#        define INSTR_HISTOGRAM   NSL_INSTR_HISTOGRAM
+#        define INSTR_TIMER       NSL_INSTR_TIMER
+#        define InstrStats        NSL_InstrStats
+#        define instr_now         nsl_instr_now
+#        define instr_scope       nsl_instr_scope
+#        define instr_count       nsl_instr_count
+#        define instr_record      nsl_instr_record
+#        define instr_collect     nsl_instr_collect
+#        define instr_percentile  nsl_instr_percentile
+#        define instr_ticks_to_ns nsl_instr_ticks_to_ns
+#        define instr_report      nsl_instr_report
+
+#    endif  // NSL_INSTRUMENT_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(INSTRUMENT)
@@ -0,0 +1,954 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * Batched file and socket I/O on Linux. Requests are queued with
+ * `nsl_io_read`, `nsl_io_write`, `nsl_io_open` and `nsl_io_close`, and all of
+ * the queued requests are passed to the kernel with a single system call by
+ * `nsl_io_submit`. Completed requests are collected with `nsl_io_poll` or
+ * `nsl_io_wait_all`, which also submit anything still queued. Reading many
+ * small files this way costs a few system calls per batch, instead of three
+ * per file.
+ *
+ * Requests go through `io_uring` when the kernel supports it. Otherwise, or
+ * when `NSL_IoConfig.fallback` is set, each request is run with `preadv`,
+ * `pwritev`, `openat` or `close` when it is submitted, and requests on
+ * non-blocking file descriptors that would block are retried when `epoll`
+ * reports them ready. Both give the same results.
+ *
+ * Buffers that are reused for many requests can be registered with
+ * `nsl_io_register_buffers` and used with `nsl_io_read_fixed` and
+ * `nsl_io_write_fixed`, which saves the kernel from mapping them on every
+ * request. Any memory can be registered, such as a single allocation that is
+ * split into one slot per request in flight.
+ *
+ * A coroutine from `nonstdlib/coroutine.h` can wait for a request with
+ * `nsl_io_await`, which parks it until the request completes. The requests
+ * are submitted and collected by a coroutine that is started on the same
+ * scheduler, and that waits for completions in `epoll` when there is nothing
+ * else to do.
+ *
+ * This module is Linux only, and needs `_GNU_SOURCE` to be defined before any
+ * header is included, for `syscall`, `preadv` and `pwritev`.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _GNU_SOURCE
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/io.h"
+ *
+ * int main() {
+ *     NSL_Io io;
+ *     if (!nsl_io_init(&io, nullptr)) { return 1; }
+ *
+ *     NSL_IoRequest opens[COUNT], reads[COUNT];
+ *     for (size_t i = 0; i < COUNT; i++) {
+ *         nsl_io_open(&io, &opens[i], paths[i], O_RDONLY);
+ *     }
+ *     nsl_io_wait_all(&io);
+ *     for (size_t i = 0; i < COUNT; i++) {
+ *         nsl_io_read(&io, &reads[i], (int)opens[i].result, buffers[i], SIZE, 0);
+ *     }
+ *     nsl_io_wait_all(&io);
+ *
+ *     nsl_io_free(&io);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_IO_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_IO_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_IO_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_IO_ENTRIES`: The default number of requests that can be submitted at
+ *   once.
+ */
+
+#ifndef NSL_IO_H_
+#define NSL_IO_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_IO_VERSION_MAJOR 0
+#define NSL_IO_VERSION_MINOR 1
+#define NSL_IO_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+#include "nonstdlib/coroutine.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_IO_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_IO_DEF
+#    define NSL_IO_DEF
+#endif  // NSL_IO_DEF
+
+/*!
+ * `NSL_IO_ENTRIES` is the default number of requests that can be submitted at
+ * once. More may be queued, in which case they are submitted in several
+ * batches.
+ */
+#ifndef NSL_IO_ENTRIES
+#    define NSL_IO_ENTRIES 256
+#endif  // NSL_IO_ENTRIES
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * How requests are run. Fields that are zero use their defaults.
+ */
+typedef struct NSL_IoConfig {
+    //! The number of requests that can be submitted at once, which is rounded
+    //! up to a power of two. Defaults to `NSL_IO_ENTRIES`.
+    unsigned entries;
+    //! Whether to run requests with ordinary system calls even if `io_uring`
+    //! is available.
+    bool fallback;
+} NSL_IoConfig;
+
+typedef struct NSL_IoRequest NSL_IoRequest;
+
+// The requests on one file descriptor that wait for it to be ready without
+// `io_uring`, in the order that they were submitted.
+typedef struct NSL__IoWaiters {
+    NSL_IoRequest *readers;
+    NSL_IoRequest *writers;
+} NSL__IoWaiters;
+
+/*!
+ * A single read, write, open or close. The request must stay at the same
+ * address until it has completed.
+ */
+struct NSL_IoRequest {
+    //! The result of the request once it has completed: the number of bytes
+    //! transferred, the file descriptor that was opened, or zero for a close.
+    //! A negative `errno` if it failed.
+    int64_t result;
+    //! Whether the request has completed.
+    bool done;
+    //! Private: how the request is run.
+    uint8_t     op;
+    int         fd;
+    int         flags;
+    uint16_t    buffer_index;
+    void       *buffer;
+    size_t      length;
+    int64_t     offset;
+    const char *path;
+    //! Private: the next request in the fallback queue, or in the waiters of
+    //! its file descriptor.
+    NSL_IoRequest *next;
+    //! Private: the coroutine to wake once the request has completed.
+    NSL_Coroutine *waiter;
+};
+
+/*!
+ * A queue of I/O requests. This must be initialized with `nsl_io_init` and
+ * freed with `nsl_io_free`.
+ */
+typedef struct NSL_Io {
+    //! Whether requests go through `io_uring`.
+    bool uring;
+    //! The number of requests that have been queued and have not completed.
+    size_t pending;
+    //! A file descriptor that `epoll` reports as readable when a submitted
+    //! request may have completed.
+    int fd;
+    //! Private: the number of requests that have been queued and not
+    //! submitted, and of those submitted and not completed.
+    size_t queued;
+    size_t in_flight;
+    //! Private: the rings shared with the kernel.
+    void     *sq_ring;
+    size_t    sq_ring_size;
+    void     *cq_ring;
+    size_t    cq_ring_size;
+    void     *sqes;
+    size_t    sqes_size;
+    unsigned  sq_entries;
+    unsigned  cq_entries;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    void     *cqes;
+    //! Private: the requests that have not been run without `io_uring`.
+    NSL_IoRequest *head;
+    NSL_IoRequest *tail;
+    //! Private: the requests waiting in `epoll` without `io_uring`, indexed by
+    //! file descriptor.
+    NSL__IoWaiters *waiters;
+    size_t          waiters_count;
+    //! Private: the coroutine that submits and collects requests for
+    //! `nsl_io_await`.
+    NSL_Coroutine poller;
+    bool          polling;
+} NSL_Io;
+
+/*!
+ * Parks a coroutine until a request has completed. The request is submitted
+ * if it has only been queued.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ * - `io`: The `NSL_Io *` that the request was queued on.
+ * - `request`: The `NSL_IoRequest *` to wait for.
+ *
+ * # Requires
+ * - Only one coroutine waits for `request`.
+ * - Every coroutine that waits for a request of `io` runs on the same
+ *   scheduler.
+ */
+#define nsl_io_await(co, io, request)                                                              \
+    do {                                                                                           \
+        if (!(request)->done && nsl__io_watch(io, co, request)) {                                  \
+            nsl_coroutine_park(co);                                                                \
+        }                                                                                          \
+    } while (0)
+
+/*!
+ * Sets up a queue of requests.
+ *
+ * # Parameters
+ * - `io`: The queue to initialize.
+ * - `config`: How requests are run, or `nullptr` for the defaults.
+ *
+ * # Modifies
+ * - `io`: It is initialized.
+ *
+ * # Returns
+ * Whether the queue could be set up. If not, `io` is not initialized.
+ */
+NSL_IO_DEF bool nsl_io_init(NSL_Io *io, const NSL_IoConfig *config);
+
+/*!
+ * Frees a queue of requests.
+ *
+ * # Parameters
+ * - `io`: The queue to free.
+ *
+ * # Requires
+ * - `io` is initialized, and no request is pending.
+ *
+ * # Modifies
+ * - `io`: It is no longer initialized.
+ */
+NSL_IO_DEF void nsl_io_free(NSL_Io *io);
+
+/*!
+ * Registers buffers with the kernel, for use with `nsl_io_read_fixed` and
+ * `nsl_io_write_fixed`. Registering again replaces the buffers.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ * - `buffers`: The buffers.
+ * - `count`: The number of buffers.
+ *
+ * # Requires
+ * - No fixed request is pending.
+ * - The buffers stay allocated until they are replaced or `io` is freed.
+ *
+ * # Returns
+ * Whether the buffers could be registered. This fails if there are more than
+ * 65535 buffers, or if they are larger than the limit on locked memory.
+ * Without `io_uring`, there is nothing to register, so this only fails if
+ * there are too many buffers.
+ */
+NSL_IO_DEF bool nsl_io_register_buffers(NSL_Io *io, const struct iovec *buffers, unsigned count);
+
+/*!
+ * Queues a read.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ * - `request`: The request, which holds the result once it has completed.
+ * - `fd`: The file descriptor to read from.
+ * - `buffer`: Where the bytes are read to.
+ * - `length`: The most bytes to read.
+ * - `offset`: The offset in the file to read from, or -1 to read from the
+ *   current position, as is needed for sockets and pipes.
+ *
+ * # Modifies
+ * - `request`: It is pending.
+ * - `io`: The request is queued.
+ */
+NSL_IO_DEF void nsl_io_read(
+    NSL_Io *io, NSL_IoRequest *request, int fd, void *buffer, size_t length, int64_t offset);
+
+/*!
+ * Queues a read into a registered buffer. This is the same as `nsl_io_read`,
+ * except that `buffer` must lie within the registered buffer at `index`.
+ */
+NSL_IO_DEF void nsl_io_read_fixed(NSL_Io        *io,
+                                  NSL_IoRequest *request,
+                                  int            fd,
+                                  unsigned       index,
+                                  void          *buffer,
+                                  size_t         length,
+                                  int64_t        offset);
+
+/*!
+ * Queues a write.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ * - `request`: The request, which holds the result once it has completed.
+ * - `fd`: The file descriptor to write to.
+ * - `buffer`: The bytes to write.
+ * - `length`: The number of bytes to write.
+ * - `offset`: The offset in the file to write to, or -1 to write at the
+ *   current position, as is needed for sockets and pipes.
+ *
+ * # Modifies
+ * - `request`: It is pending.
+ * - `io`: The request is queued.
+ */
+NSL_IO_DEF void nsl_io_write(
+    NSL_Io *io, NSL_IoRequest *request, int fd, const void *buffer, size_t length, int64_t offset);
+
+/*!
+ * Queues a write from a registered buffer. This is the same as
+ * `nsl_io_write`, except that `buffer` must lie within the registered buffer
+ * at `index`.
+ */
+NSL_IO_DEF void nsl_io_write_fixed(NSL_Io        *io,
+                                   NSL_IoRequest *request,
+                                   int            fd,
+                                   unsigned       index,
+                                   const void    *buffer,
+                                   size_t         length,
+                                   int64_t        offset);
+
+/*!
+ * Queues the opening of a file, relative to the working directory.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ * - `request`: The request, whose result is the file descriptor.
+ * - `path`: The path of the file, which must stay valid until the request
+ *   has completed.
+ * - `flags`: The flags given to `open`. New files are created with mode
+ *   `0644`.
+ *
+ * # Modifies
+ * - `request`: It is pending.
+ * - `io`: The request is queued.
+ */
+NSL_IO_DEF void nsl_io_open(NSL_Io *io, NSL_IoRequest *request, const char *path, int flags);
+
+/*!
+ * Queues the closing of a file descriptor.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ * - `request`: The request.
+ * - `fd`: The file descriptor to close.
+ *
+ * # Modifies
+ * - `request`: It is pending.
+ * - `io`: The request is queued.
+ */
+NSL_IO_DEF void nsl_io_close(NSL_Io *io, NSL_IoRequest *request, int fd);
+
+/*!
+ * Passes every queued request to the kernel with one system call. Without
+ * `io_uring`, the requests are run.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ *
+ * # Returns
+ * The number of requests that were submitted.
+ */
+NSL_IO_DEF size_t nsl_io_submit(NSL_Io *io);
+
+/*!
+ * Submits any queued requests, and marks those that have completed as done.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ * - `block`: Whether to wait for at least one request to complete, if any are
+ *   pending and none have completed.
+ *
+ * # Modifies
+ * - `io`: Completed requests are removed.
+ *
+ * # Returns
+ * The number of requests that completed.
+ */
+NSL_IO_DEF size_t nsl_io_poll(NSL_Io *io, bool block);
+
+/*!
+ * Submits any queued requests, and waits for every pending request to
+ * complete.
+ *
+ * # Parameters
+ * - `io`: The queue.
+ *
+ * # Modifies
+ * - `io`: No request is pending.
+ */
+NSL_IO_DEF void nsl_io_wait_all(NSL_Io *io);
+
+NSL_IO_DEF bool nsl__io_watch(NSL_Io *io, NSL_Coroutine *co, NSL_IoRequest *request);
+
+#endif  // NSL_IO_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(IO)
+#    ifndef NSL_IO_IMPLEMENTATION_GUARD_
+#        define NSL_IO_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <fcntl.h>
+#        include <linux/io_uring.h>
+#        include <stdatomic.h>
+#        include <string.h>
+#        include <sys/epoll.h>
+#        include <sys/mman.h>
+#        include <sys/syscall.h>
+#        include <unistd.h>
+
+enum {
+    NSL__IO_READ,
+    NSL__IO_WRITE,
+    NSL__IO_OPEN,
+    NSL__IO_CLOSE,
+};
+
+// Marks a request that does not use a registered buffer.
+#        define NSL__IO_NOT_FIXED UINT16_MAX
+
+static void nsl__io_complete(NSL_Io *io, NSL_IoRequest *request, int64_t result) {
+    request->result = result;
+    request->done   = true;
+    io->pending--;
+    if (request->waiter != nullptr) {
+        NSL_Coroutine *waiter = request->waiter;
+        request->waiter       = nullptr;
+        nsl_coroutine_wake(waiter);
+    }
+}
+
+static int nsl__io_enter(NSL_Io *io, unsigned submit, unsigned wait, unsigned flags) {
+    int result;
+    do {
+        result = (int)syscall(SYS_io_uring_enter, io->fd, submit, wait, flags, nullptr, 0);
+    } while (result < 0 && errno == EINTR);
+    return result;
+}
+
+static bool nsl__io_uring_init(NSL_Io *io, unsigned entries) {
+    struct io_uring_params params = {};
+    io->fd                        = (int)syscall(SYS_io_uring_setup, entries, &params);
+    if (io->fd < 0) { return false; }
+
+    io->sq_entries   = params.sq_entries;
+    io->cq_entries   = params.cq_entries;
+    io->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    io->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    io->sqes_size    = params.sq_entries * sizeof(struct io_uring_sqe);
+    bool single      = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single && io->cq_ring_size > io->sq_ring_size) { io->sq_ring_size = io->cq_ring_size; }
+
+    int protection = PROT_READ | PROT_WRITE;
+    int flags      = MAP_SHARED | MAP_POPULATE;
+    io->sq_ring    = mmap(nullptr, io->sq_ring_size, protection, flags, io->fd, IORING_OFF_SQ_RING);
+    io->cq_ring    = single ? io->sq_ring
+                            : mmap(nullptr, io->cq_ring_size, protection, flags, io->fd,
+                                   IORING_OFF_CQ_RING);
+    io->sqes       = mmap(nullptr, io->sqes_size, protection, flags, io->fd, IORING_OFF_SQES);
+    if (io->sq_ring == MAP_FAILED || io->cq_ring == MAP_FAILED || io->sqes == MAP_FAILED) {
+        if (io->sq_ring != MAP_FAILED) { munmap(io->sq_ring, io->sq_ring_size); }
+        if (!single && io->cq_ring != MAP_FAILED) { munmap(io->cq_ring, io->cq_ring_size); }
+        if (io->sqes != MAP_FAILED) { munmap(io->sqes, io->sqes_size); }
+        close(io->fd);
+        return false;
+    }
+
+    char *sq     = io->sq_ring;
+    char *cq     = io->cq_ring;
+    io->sq_head  = (unsigned *)(sq + params.sq_off.head);
+    io->sq_tail  = (unsigned *)(sq + params.sq_off.tail);
+    io->sq_mask  = (unsigned *)(sq + params.sq_off.ring_mask);
+    io->sq_array = (unsigned *)(sq + params.sq_off.array);
+    io->cq_head  = (unsigned *)(cq + params.cq_off.head);
+    io->cq_tail  = (unsigned *)(cq + params.cq_off.tail);
+    io->cq_mask  = (unsigned *)(cq + params.cq_off.ring_mask);
+    io->cqes     = cq + params.cq_off.cqes;
+    return true;
+}
+
+NSL_IO_DEF bool nsl_io_init(NSL_Io *io, const NSL_IoConfig *config) {
+    NSL_IoConfig result = config != nullptr ? *config : (NSL_IoConfig){};
+    if (result.entries == 0) { result.entries = NSL_IO_ENTRIES; }
+
+    *io = (NSL_Io){};
+    if (!result.fallback && nsl__io_uring_init(io, result.entries)) {
+        io->uring = true;
+        return true;
+    }
+    io->fd = epoll_create1(EPOLL_CLOEXEC);
+    return io->fd >= 0;
+}
+
+NSL_IO_DEF void nsl_io_free(NSL_Io *io) {
+    if (io->uring) {
+        munmap(io->sqes, io->sqes_size);
+        if (io->cq_ring != io->sq_ring) { munmap(io->cq_ring, io->cq_ring_size); }
+        munmap(io->sq_ring, io->sq_ring_size);
+    }
+    close(io->fd);
+    nsl_free(io->waiters);
+    *io = (NSL_Io){.fd = -1};
+}
+
+NSL_IO_DEF bool nsl_io_register_buffers(NSL_Io *io, const struct iovec *buffers, unsigned count) {
+    // the last index marks requests that do not use a registered buffer
+    if (count > NSL__IO_NOT_FIXED) { return false; }
+    if (!io->uring) { return true; }
+    syscall(SYS_io_uring_register, io->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    return syscall(SYS_io_uring_register, io->fd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+}
+
+// Collects every completion in the ring, returning how many there were.
+static size_t nsl__io_reap(NSL_Io *io) {
+    unsigned head  = *io->cq_head;
+    unsigned tail  = atomic_load_explicit((_Atomic unsigned *)io->cq_tail, memory_order_acquire);
+    size_t   count = 0;
+    for (; head != tail; head++, count++) {
+        struct io_uring_cqe *cqe     = (struct io_uring_cqe *)io->cqes + (head & *io->cq_mask);
+        NSL_IoRequest       *request = (NSL_IoRequest *)(uintptr_t)cqe->user_data;
+        io->in_flight--;
+        nsl__io_complete(io, request, cqe->res);
+    }
+    atomic_store_explicit((_Atomic unsigned *)io->cq_head, head, memory_order_release);
+    return count;
+}
+
+static void nsl__io_queue_uring(NSL_Io *io, NSL_IoRequest *request) {
+    // Submitted requests may not outnumber the completion queue, or their
+    // completions could be lost, so a full ring is drained first.
+    unsigned head = atomic_load_explicit((_Atomic unsigned *)io->sq_head, memory_order_acquire);
+    unsigned tail = *io->sq_tail;
+    while (tail - head == io->sq_entries || io->queued + io->in_flight == io->cq_entries) {
+        nsl_io_poll(io, true);
+        head = atomic_load_explicit((_Atomic unsigned *)io->sq_head, memory_order_acquire);
+    }
+
+    unsigned             index = tail & *io->sq_mask;
+    struct io_uring_sqe *sqe   = (struct io_uring_sqe *)io->sqes + index;
+    *sqe                       = (struct io_uring_sqe){
+                              .fd        = request->fd,
+                              .off       = (uint64_t)request->offset,
+                              .addr      = (uint64_t)(uintptr_t)request->buffer,
+                              .len       = (uint32_t)request->length,
+                              .user_data = (uint64_t)(uintptr_t)request,
+    };
+    bool fixed = request->buffer_index != NSL__IO_NOT_FIXED;
+    switch (request->op) {
+    case NSL__IO_READ:
+        sqe->opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        break;
+    case NSL__IO_WRITE:
+        sqe->opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        break;
+    case NSL__IO_OPEN:
+        sqe->opcode     = IORING_OP_OPENAT;
+        sqe->fd         = AT_FDCWD;
+        sqe->addr       = (uint64_t)(uintptr_t)request->path;
+        sqe->len        = 0644;
+        sqe->open_flags = (uint32_t)(request->flags | O_CLOEXEC);
+        break;
+    case NSL__IO_CLOSE:
+        sqe->opcode = IORING_OP_CLOSE;
+        break;
+    }
+    if (fixed) { sqe->buf_index = request->buffer_index; }
+    io->sq_array[index] = index;
+    atomic_store_explicit((_Atomic unsigned *)io->sq_tail, tail + 1, memory_order_release);
+}
+
+static void nsl__io_queue(NSL_Io *io, NSL_IoRequest *request) {
+    request->done   = false;
+    request->result = 0;
+    request->waiter = nullptr;
+    io->pending++;
+    if (io->uring) {
+        nsl__io_queue_uring(io, request);
+    } else {
+        request->next = nullptr;
+        if (io->tail == nullptr) {
+            io->head = request;
+        } else {
+            io->tail->next = request;
+        }
+        io->tail = request;
+    }
+    io->queued++;
+}
+
+static void nsl__io_prepare(NSL_IoRequest *request,
+                            uint8_t        op,
+                            int            fd,
+                            unsigned       index,
+                            const void    *buffer,
+                            size_t         length,
+                            int64_t        offset) {
+    *request = (NSL_IoRequest){
+        .op           = op,
+        .fd           = fd,
+        .buffer_index = (uint16_t)index,
+        .buffer       = (void *)buffer,
+        .length       = length,
+        .offset       = offset,
+    };
+}
+
+NSL_IO_DEF void nsl_io_read(
+    NSL_Io *io, NSL_IoRequest *request, int fd, void *buffer, size_t length, int64_t offset) {
+    nsl__io_prepare(request, NSL__IO_READ, fd, NSL__IO_NOT_FIXED, buffer, length, offset);
+    nsl__io_queue(io, request);
+}
+
+NSL_IO_DEF void nsl_io_read_fixed(NSL_Io        *io,
+                                  NSL_IoRequest *request,
+                                  int            fd,
+                                  unsigned       index,
+                                  void          *buffer,
+                                  size_t         length,
+                                  int64_t        offset) {
+    nsl__io_prepare(request, NSL__IO_READ, fd, index, buffer, length, offset);
+    nsl__io_queue(io, request);
+}
+
+NSL_IO_DEF void nsl_io_write(
+    NSL_Io *io, NSL_IoRequest *request, int fd, const void *buffer, size_t length, int64_t offset) {
+    nsl__io_prepare(request, NSL__IO_WRITE, fd, NSL__IO_NOT_FIXED, buffer, length, offset);
+    nsl__io_queue(io, request);
+}
+
+NSL_IO_DEF void nsl_io_write_fixed(NSL_Io        *io,
+                                   NSL_IoRequest *request,
+                                   int            fd,
+                                   unsigned       index,
+                                   const void    *buffer,
+                                   size_t         length,
+                                   int64_t        offset) {
+    nsl__io_prepare(request, NSL__IO_WRITE, fd, index, buffer, length, offset);
+    nsl__io_queue(io, request);
+}
+
+NSL_IO_DEF void nsl_io_open(NSL_Io *io, NSL_IoRequest *request, const char *path, int flags) {
+    nsl__io_prepare(request, NSL__IO_OPEN, -1, NSL__IO_NOT_FIXED, nullptr, 0, 0);
+    request->path  = path;
+    request->flags = flags;
+    nsl__io_queue(io, request);
+}
+
+NSL_IO_DEF void nsl_io_close(NSL_Io *io, NSL_IoRequest *request, int fd) {
+    nsl__io_prepare(request, NSL__IO_CLOSE, fd, NSL__IO_NOT_FIXED, nullptr, 0, 0);
+    nsl__io_queue(io, request);
+}
+
+// Runs a request without `io_uring`, returning -EAGAIN if it would block.
+static int64_t nsl__io_run(NSL_IoRequest *request) {
+    struct iovec iov    = {request->buffer, request->length};
+    ssize_t      result = 0;
+    do {
+        switch (request->op) {
+        case NSL__IO_READ:
+            result = request->offset < 0 ? readv(request->fd, &iov, 1)
+                                         : preadv(request->fd, &iov, 1, request->offset);
+            break;
+        case NSL__IO_WRITE:
+            result = request->offset < 0 ? writev(request->fd, &iov, 1)
+                                         : pwritev(request->fd, &iov, 1, request->offset);
+            break;
+        case NSL__IO_OPEN:
+            result = open(request->path, request->flags | O_CLOEXEC, 0644);
+            break;
+        case NSL__IO_CLOSE:
+            // Linux releases the file descriptor even if `close` is
+            // interrupted, so it must not be retried.
+            result = close(request->fd);
+            if (result < 0 && errno == EINTR) { return 0; }
+            break;
+        }
+    } while (result < 0 && errno == EINTR);
+    return result < 0 ? -errno : result;
+}
+
+// Registers a file descriptor in `epoll` for the union of what its waiters
+// wait for, returning whether it could be.
+static bool nsl__io_arm(NSL_Io *io, int fd) {
+    NSL__IoWaiters    *waiters = &io->waiters[fd];
+    struct epoll_event event   = {.events = EPOLLONESHOT, .data.fd = fd};
+    if (waiters->readers != nullptr) { event.events |= EPOLLIN; }
+    if (waiters->writers != nullptr) { event.events |= EPOLLOUT; }
+    return epoll_ctl(io->fd, EPOLL_CTL_MOD, fd, &event) == 0
+        || (errno == ENOENT && epoll_ctl(io->fd, EPOLL_CTL_ADD, fd, &event) == 0);
+}
+
+// Adds a request to the waiters of its file descriptor, returning whether it
+// could be registered in `epoll`. If not, the request is not added.
+static bool nsl__io_park(NSL_Io *io, NSL_IoRequest *request) {
+    size_t fd = (size_t)request->fd;
+    if (fd >= io->waiters_count) {
+        size_t count = io->waiters_count == 0 ? 16 : io->waiters_count;
+        while (count <= fd) {
+            count *= 2;
+        }
+        io->waiters = nsl_realloc(io->waiters, count * sizeof(NSL__IoWaiters));
+        if (io->waiters == nullptr) {
+            nsl_eprintf("[IO] out of memory\n");
+            nsl_abort();
+        }
+        memset(io->waiters + io->waiters_count, 0,
+               (count - io->waiters_count) * sizeof(NSL__IoWaiters));
+        io->waiters_count = count;
+    }
+
+    NSL__IoWaiters *waiters = &io->waiters[fd];
+    NSL_IoRequest **link    = request->op == NSL__IO_READ ? &waiters->readers : &waiters->writers;
+    while (*link != nullptr) {
+        link = &(*link)->next;
+    }
+    request->next = nullptr;
+    *link         = request;
+    if (nsl__io_arm(io, request->fd)) { return true; }
+    *link = nullptr;
+    return false;
+}
+
+// Runs a request without `io_uring`, or parks it in `epoll` if it would block.
+static size_t nsl__io_run_or_park(NSL_Io *io, NSL_IoRequest *request) {
+    int64_t result = nsl__io_run(request);
+    if ((result == -EAGAIN || result == -EWOULDBLOCK) && nsl__io_park(io, request)) {
+        io->in_flight++;
+        return 0;
+    }
+    nsl__io_complete(io, request, result);
+    return 1;
+}
+
+// Takes the waiters of a file descriptor that `epoll` reported, and runs them
+// again, returning how many completed.
+static size_t nsl__io_resume(NSL_Io *io, int fd, uint32_t events) {
+    NSL__IoWaiters *waiters = &io->waiters[fd];
+    NSL_IoRequest  *readers = nullptr, *writers = nullptr;
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+        readers          = waiters->readers;
+        waiters->readers = nullptr;
+    }
+    if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+        writers          = waiters->writers;
+        waiters->writers = nullptr;
+    }
+    // The registration is disabled once it fires, so waiters that were not
+    // ready are registered again. If that fails, they are run as well, which
+    // completes them with the error.
+    if ((waiters->readers != nullptr || waiters->writers != nullptr) && !nsl__io_arm(io, fd)) {
+        if (readers == nullptr) { readers = waiters->readers; }
+        if (writers == nullptr) { writers = waiters->writers; }
+        *waiters = (NSL__IoWaiters){};
+    }
+
+    size_t         completed = 0;
+    NSL_IoRequest *lists[]   = {readers, writers};
+    for (size_t i = 0; i < 2; i++) {
+        NSL_IoRequest *request = lists[i];
+        while (request != nullptr) {
+            NSL_IoRequest *next = request->next;
+            io->in_flight--;
+            completed += nsl__io_run_or_park(io, request);
+            request    = next;
+        }
+    }
+    return completed;
+}
+
+NSL_IO_DEF size_t nsl_io_submit(NSL_Io *io) {
+    size_t submitted = 0;
+    if (io->uring) {
+        if (io->queued == 0) { return 0; }
+        int result = nsl__io_enter(io, (unsigned)io->queued, 0, 0);
+        if (result > 0) { submitted = (size_t)result; }
+    } else {
+        // Requests are taken off the queue before running them, so that one
+        // that completes and wakes a coroutine may be queued again.
+        while (io->head != nullptr) {
+            NSL_IoRequest *request = io->head;
+            io->head               = request->next;
+            if (io->head == nullptr) { io->tail = nullptr; }
+            submitted++;
+            io->queued--;
+            nsl__io_run_or_park(io, request);
+        }
+        return submitted;
+    }
+    io->queued    -= submitted;
+    io->in_flight += submitted;
+    return submitted;
+}
+
+NSL_IO_DEF size_t nsl_io_poll(NSL_Io *io, bool block) {
+    size_t pending = io->pending;
+    nsl_io_submit(io);
+    size_t completed = pending - io->pending;
+
+    if (io->uring) {
+        completed += nsl__io_reap(io);
+        if (completed == 0 && block && io->in_flight > 0) {
+            nsl__io_enter(io, 0, 1, IORING_ENTER_GETEVENTS);
+            completed += nsl__io_reap(io);
+        }
+        return completed;
+    }
+
+    if (io->in_flight == 0) { return completed; }
+    struct epoll_event events[64];
+    int timeout = completed == 0 && block ? -1 : 0;
+    int count   = epoll_wait(io->fd, events, 64, timeout);
+    for (int i = 0; i < count; i++) {
+        completed += nsl__io_resume(io, events[i].data.fd, events[i].events);
+    }
+    return completed;
+}
+
+NSL_IO_DEF void nsl_io_wait_all(NSL_Io *io) {
+    while (io->pending > 0) {
+        nsl_io_poll(io, true);
+    }
+}
+
+static NSL_CoroutineStatus nsl__io_poller(NSL_Coroutine *co) {
+    NSL_Io *io = (NSL_Io *)((char *)co - offsetof(NSL_Io, poller));
+    nsl_coroutine_begin(co);
+    while (io->pending > 0) {
+        if (nsl_io_poll(io, false) > 0) {
+            // Let the woken coroutines queue more requests before waiting.
+            nsl_coroutine_yield(co);
+        } else if (io->queued == 0) {
+            nsl_coroutine_await_fd(co, io->fd, EPOLLIN);
+        }
+    }
+    io->polling = false;
+    nsl_coroutine_end(co);
+}
+
+// Returns whether `co` has to park, which it does not if submitting the
+// request completed it.
+NSL_IO_DEF bool nsl__io_watch(NSL_Io *io, NSL_Coroutine *co, NSL_IoRequest *request) {
+    // The poller may already be parked in `epoll`, where it would not notice
+    // a request that was queued after it, so the request is submitted here.
+    nsl_io_submit(io);
+    if (request->done) { return false; }
+    request->waiter = co;
+    if (!io->polling) {
+        io->polling = true;
+        nsl_coroutine_spawn(co->scheduler, &io->poller, nsl__io_poller);
+    }
+    return true;
+}
+
+#    endif  // NSL_IO_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(IO)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(IO)
+#    ifndef NSL_IO_STRIP_PREFIX_GUARD_
+#        define NSL_IO_STRIP_PREFIX_GUARD_
+
+#        define IoConfig            NSL_IoConfig
+#        define IoRequest           NSL_IoRequest
+#        define Io                  NSL_Io
+#        define io_await            nsl_io_await
+#        define io_init             nsl_io_init
+#        define io_free             nsl_io_free
+#        define io_register_buffers nsl_io_register_buffers
+#        define io_read             nsl_io_read
+#        define io_read_fixed       nsl_io_read_fixed
+#        define io_write            nsl_io_write
+#        define io_write_fixed      nsl_io_write_fixed
+#        define io_open             nsl_io_open
+#        define io_close            nsl_io_close
+#        define io_submit           nsl_io_submit
+#        define io_poll             nsl_io_poll
+#        define io_wait_all         nsl_io_wait_all
+
+#    endif  // NSL_IO_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(IO)
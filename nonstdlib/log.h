@@ -0,0 +1,961 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * Asynchronous logging that does not block the thread that logs. Each thread
+ * formats its messages into its own ring buffer, and a background thread
+ * started by `nsl_log_start` periodically flushes all of the buffers to the
+ * sink in batches. Logging never takes a lock or makes a system call. If a
+ * buffer is full, the message is dropped, and the number of dropped messages is
+ * reported by the flusher.
+ *
+ * Messages are logged with `nsl_log_trace`, `nsl_log_debug`, `nsl_log_info`,
+ * `nsl_log_warn` and `nsl_log_error`. Levels below `NSL_LOG_MIN_LEVEL` are
+ * removed at compile time, so their arguments are never evaluated.
+ *
+ * When `NSL_LOG_DEFERRED` is defined, messages are not formatted by the thread
+ * that logs them. Instead, only the address of a static description of the call
+ * site and the raw values of the arguments are copied into the buffer, and the
+ * flusher formats them. This is much cheaper for the thread that logs, but
+ * limits the arguments to integers, floating point numbers, strings and
+ * pointers (see `nsl_log_deferred`).
+ *
+ * Messages from a single thread are written in order, but messages from
+ * different threads may be interleaved in any order. Before `nsl_log_start` is
+ * called, and after `nsl_log_stop` is called, messages are written
+ * synchronously using `nsl_eprintf`.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_LOG_MIN_LEVEL NSL_LOG_LEVEL_INFO
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/log.h"
+ *
+ * int main(void) {
+ *     nsl_log_start(&(NSL_LogConfig){.sink = NSL_LOG_SINK_FD, .fd = 2});
+ *     nsl_log_info("listening on port %d", 8080);
+ *     nsl_log_debug("compiled away: %d", expensive()); // not evaluated
+ *     nsl_log_deferred(NSL_LOG_LEVEL_INFO, "formatted by the flusher: %d", 42);
+ *     nsl_log_stop();
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_LOG_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_LOG_DEFERRED`: Defining this macro before this file is included will
+ *   cause `nsl_log` and the per-level macros to use `nsl_log_deferred`.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_LOG_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_LOG_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_LOG_MIN_LEVEL`: The lowest level that is logged. Defaults to
+ *   `NSL_LOG_LEVEL_TRACE`.
+ * - `NSL_LOG_BUFFER_SIZE`: The default size of each thread's buffer in bytes.
+ * - `NSL_LOG_MAX_MESSAGE`: The maximum length of a formatted message in bytes.
+ *   Longer messages are truncated.
+ * - `NSL_LOG_FLUSH_INTERVAL_MS`: The default time between flushes.
+ * - `NSL_LOG_MAX_ARGS`: The maximum number of arguments to `nsl_log_deferred`.
+ */
+
+#ifndef NSL_LOG_H_
+#define NSL_LOG_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_LOG_VERSION_MAJOR 0
+#define NSL_LOG_VERSION_MINOR 1
+#define NSL_LOG_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+#include "nonstdlib/stream.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                                 LOG LEVELS                                 */
+/*                                                                            */
+/******************************************************************************/
+
+// clang-format off
+#define NSL_LOG_LEVEL_TRACE 0 //!< Very detailed messages, such as function entry.
+#define NSL_LOG_LEVEL_DEBUG 1 //!< Messages that are useful when debugging.
+#define NSL_LOG_LEVEL_INFO  2 //!< Normal, but significant, events.
+#define NSL_LOG_LEVEL_WARN  3 //!< Unexpected events that can be recovered from.
+#define NSL_LOG_LEVEL_ERROR 4 //!< Errors that cannot be recovered from.
+#define NSL_LOG_LEVEL_OFF   5 //!< Used as `NSL_LOG_MIN_LEVEL` to disable logging.
+// clang-format on
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_LOG_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_LOG_DEF
+#    define NSL_LOG_DEF
+#endif  // NSL_LOG_DEF
+
+/*!
+ * `NSL_LOG_MIN_LEVEL` is the lowest level that is logged. Messages below this
+ * level are removed at compile time.
+ */
+#ifndef NSL_LOG_MIN_LEVEL
+#    define NSL_LOG_MIN_LEVEL NSL_LOG_LEVEL_TRACE
+#endif  // NSL_LOG_MIN_LEVEL
+
+/*!
+ * `NSL_LOG_BUFFER_SIZE` is the size of each thread's buffer, in bytes, if it is
+ * not given to `nsl_log_start`. It must be a power of two.
+ */
+#ifndef NSL_LOG_BUFFER_SIZE
+#    define NSL_LOG_BUFFER_SIZE (1 << 16)
+#endif  // NSL_LOG_BUFFER_SIZE
+
+/*!
+ * `NSL_LOG_MAX_MESSAGE` is the maximum length of a formatted message, in
+ * bytes, including the level and the trailing newline. Longer messages are
+ * truncated.
+ */
+#ifndef NSL_LOG_MAX_MESSAGE
+#    define NSL_LOG_MAX_MESSAGE 512
+#endif  // NSL_LOG_MAX_MESSAGE
+
+/*!
+ * `NSL_LOG_FLUSH_INTERVAL_MS` is the time between flushes, in milliseconds, if
+ * it is not given to `nsl_log_start`.
+ */
+#ifndef NSL_LOG_FLUSH_INTERVAL_MS
+#    define NSL_LOG_FLUSH_INTERVAL_MS 10
+#endif  // NSL_LOG_FLUSH_INTERVAL_MS
+
+/*!
+ * `NSL_LOG_MAX_ARGS` is the maximum number of arguments that can be passed to
+ * `nsl_log_deferred`, not counting the format string.
+ */
+#ifndef NSL_LOG_MAX_ARGS
+#    define NSL_LOG_MAX_ARGS 16
+#endif  // NSL_LOG_MAX_ARGS
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * Where the flusher writes messages.
+ */
+typedef enum NSL_LogSink {
+    //! Messages are written using `nsl_eprintf`.
+    NSL_LOG_SINK_EPRINTF,
+    //! Messages are written to a file descriptor using `nsl_stream_writev`,
+    //! which is `writev` unless it is redefined.
+    NSL_LOG_SINK_FD,
+} NSL_LogSink;
+
+/*!
+ * The configuration passed to `nsl_log_start`. Zero initialized members are
+ * given their default values.
+ */
+typedef struct NSL_LogConfig {
+    //! Where the flusher writes messages.
+    NSL_LogSink sink;
+    //! The file descriptor to write to if `sink` is `NSL_LOG_SINK_FD`.
+    int fd;
+    //! The size of each thread's buffer, in bytes. Must be a power of two.
+    size_t buffer_size;
+    //! The time between flushes, in milliseconds.
+    unsigned flush_interval_ms;
+} NSL_LogConfig;
+
+/*!
+ * Logs a message at the given level if it is at least `NSL_LOG_MIN_LEVEL`.
+ *
+ * # Parameters
+ * - `level`: The level of the message.
+ * - `...`: The format string, followed by its arguments.
+ *
+ * # Requires
+ * - `level` is between `NSL_LOG_LEVEL_TRACE` and `NSL_LOG_LEVEL_ERROR`.
+ * - The arguments can be formatted using `printf`.
+ * - If `NSL_LOG_DEFERRED` is defined, the requirements of `nsl_log_deferred`.
+ */
+#if defined(NSL_LOG_DEFERRED)
+#    define nsl_log(level, ...) nsl_log_deferred(level, __VA_ARGS__)
+#else
+#    define nsl_log(level, ...)                                                                    \
+        ((level) >= NSL_LOG_MIN_LEVEL ? nsl__log_write(level, __VA_ARGS__)                         \
+                                      : nsl__log_discard(__VA_ARGS__))
+#endif  // defined(NSL_LOG_DEFERRED)
+
+/*!
+ * Logs a message at the corresponding level. If the level is below
+ * `NSL_LOG_MIN_LEVEL`, the call is removed at compile time and its arguments
+ * are not evaluated, but the format string is still checked.
+ *
+ * # Parameters
+ * - `...`: The format string, followed by its arguments.
+ *
+ * # Requires
+ * - The arguments can be formatted using `printf`.
+ * - If `NSL_LOG_DEFERRED` is defined, the requirements of `nsl_log_deferred`.
+ */
+#if defined(NSL_LOG_DEFERRED)
+#    define nsl__log_emit(level, ...) nsl_log_deferred(level, __VA_ARGS__)
+#else
+#    define nsl__log_emit(level, ...) nsl__log_write(level, __VA_ARGS__)
+#endif  // defined(NSL_LOG_DEFERRED)
+#if NSL_LOG_MIN_LEVEL <= NSL_LOG_LEVEL_TRACE
+#    define nsl_log_trace(...) nsl__log_emit(NSL_LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#    define nsl_log_trace(...) nsl__log_discard(__VA_ARGS__)
+#endif
+#if NSL_LOG_MIN_LEVEL <= NSL_LOG_LEVEL_DEBUG
+#    define nsl_log_debug(...) nsl__log_emit(NSL_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#    define nsl_log_debug(...) nsl__log_discard(__VA_ARGS__)
+#endif
+#if NSL_LOG_MIN_LEVEL <= NSL_LOG_LEVEL_INFO
+#    define nsl_log_info(...) nsl__log_emit(NSL_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#    define nsl_log_info(...) nsl__log_discard(__VA_ARGS__)
+#endif
+#if NSL_LOG_MIN_LEVEL <= NSL_LOG_LEVEL_WARN
+#    define nsl_log_warn(...) nsl__log_emit(NSL_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#    define nsl_log_warn(...) nsl__log_discard(__VA_ARGS__)
+#endif
+#if NSL_LOG_MIN_LEVEL <= NSL_LOG_LEVEL_ERROR
+#    define nsl_log_error(...) nsl__log_emit(NSL_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#    define nsl_log_error(...) nsl__log_discard(__VA_ARGS__)
+#endif
+
+/*!
+ * Logs a message at the given level if it is at least `NSL_LOG_MIN_LEVEL`, but
+ * leaves the formatting to the flusher. The format string and the types of the
+ * arguments are stored in a static description of the call site, and its
+ * address identifies the format. Only that address and the raw values of the
+ * arguments are copied into the buffer. Strings are copied as well, so they do
+ * not need to outlive the call.
+ *
+ * Unlike the other logging macros, this is a statement rather than an
+ * expression.
+ *
+ * # Parameters
+ * - `level`: The level of the message.
+ * - `fmt`: The format string.
+ * - `...`: The arguments to the format string.
+ *
+ * # Requires
+ * - `level` is between `NSL_LOG_LEVEL_TRACE` and `NSL_LOG_LEVEL_ERROR`.
+ * - `fmt` is a string literal, and the arguments can be formatted with it
+ *   using `printf`.
+ * - `fmt` does not use `*` as a width or precision, or the `%n` conversion.
+ * - There are at most `NSL_LOG_MAX_ARGS` arguments, and each is an integer, a
+ *   floating point number other than `long double`, a string or a pointer.
+ */
+#define nsl_log_deferred(level, fmt, ...)                                                          \
+    do {                                                                                           \
+        static_assert(NSL_NARGS(__VA_ARGS__) <= NSL_LOG_MAX_ARGS, "too many arguments to log");    \
+        static const NSL__LogFormat nsl__log_format = {                                            \
+            .string = fmt,                                                                         \
+            .count  = NSL_NARGS(__VA_ARGS__),                                                      \
+            .types  = {NSL_FOREACH(nsl__log_type, __VA_ARGS__)},                                   \
+        };                                                                                         \
+        if ((level) >= NSL_LOG_MIN_LEVEL) {                                                        \
+            nsl__log_discard(fmt __VA_OPT__(, ) __VA_ARGS__);                                      \
+            const NSL__LogArg nsl__log_args[] = {                                                  \
+                {} __VA_OPT__(, NSL_FOREACH(nsl__log_arg, __VA_ARGS__))};                          \
+            nsl__log_write_deferred(level, &nsl__log_format, nsl__log_args + 1);                   \
+        }                                                                                          \
+    } while (0)
+
+/*!
+ * Starts the background thread that flushes the buffers to the sink.
+ *
+ * # Parameters
+ * - `config`: The configuration of the logger, or `nullptr` to use the
+ *   defaults.
+ *
+ * # Requires
+ * - The logger is not already started.
+ *
+ * # Returns
+ * True if the logger was started, and false if the buffer size is not a power
+ * of two, or the thread could not be started.
+ */
+NSL_LOG_DEF bool nsl_log_start(const NSL_LogConfig *config);
+
+/*!
+ * Flushes all buffers to the sink, then stops the background thread and frees
+ * the buffers. Messages logged afterwards are written synchronously using
+ * `nsl_eprintf`.
+ *
+ * # Requires
+ * - The logger is started.
+ * - No other thread is logging while the logger is stopped.
+ */
+NSL_LOG_DEF void nsl_log_stop(void);
+
+/*!
+ * Flushes all buffers to the sink without waiting for the background thread.
+ * Does nothing if the logger is not started.
+ */
+NSL_LOG_DEF void nsl_log_flush(void);
+
+[[gnu::format(printf, 2, 3)]]
+NSL_LOG_DEF void nsl__log_write(int level, const char *fmt, ...);
+
+// Checks the format string of a removed call without evaluating its arguments.
+[[gnu::format(printf, 1, 2)]]
+static inline void nsl__log_check(const char *, ...) {}
+#define nsl__log_discard(...) ((void)(false && (nsl__log_check(__VA_ARGS__), true)))
+
+// The types that arguments to `nsl_log_deferred` are converted to. Arguments
+// smaller than an `int` are promoted, as they would be for `printf`.
+enum {
+    NSL__LOG_TYPE_INT,
+    NSL__LOG_TYPE_LONG,
+    NSL__LOG_TYPE_LLONG,
+    NSL__LOG_TYPE_UINT,
+    NSL__LOG_TYPE_ULONG,
+    NSL__LOG_TYPE_ULLONG,
+    NSL__LOG_TYPE_DOUBLE,
+    NSL__LOG_TYPE_STRING,
+    NSL__LOG_TYPE_POINTER,
+};
+
+// The static description of a call to `nsl_log_deferred`.
+typedef struct NSL__LogFormat {
+    const char *string;
+    uint32_t    count;
+    uint8_t     types[NSL_LOG_MAX_ARGS];
+} NSL__LogFormat;
+
+// The raw value of an argument to `nsl_log_deferred`.
+typedef union NSL__LogArg {
+    long long          i;
+    unsigned long long u;
+    double             d;
+    const void        *p;
+} NSL__LogArg;
+
+#define nsl__log_type(x)                                                                           \
+    _Generic((x),                                                                                  \
+        bool: NSL__LOG_TYPE_INT,                                                                   \
+        char: NSL__LOG_TYPE_INT,                                                                   \
+        signed char: NSL__LOG_TYPE_INT,                                                            \
+        short: NSL__LOG_TYPE_INT,                                                                  \
+        int: NSL__LOG_TYPE_INT,                                                                    \
+        long: NSL__LOG_TYPE_LONG,                                                                  \
+        long long: NSL__LOG_TYPE_LLONG,                                                            \
+        unsigned char: NSL__LOG_TYPE_INT,                                                          \
+        unsigned short: NSL__LOG_TYPE_INT,                                                         \
+        unsigned int: NSL__LOG_TYPE_UINT,                                                          \
+        unsigned long: NSL__LOG_TYPE_ULONG,                                                        \
+        unsigned long long: NSL__LOG_TYPE_ULLONG,                                                  \
+        float: NSL__LOG_TYPE_DOUBLE,                                                               \
+        double: NSL__LOG_TYPE_DOUBLE,                                                              \
+        char *: NSL__LOG_TYPE_STRING,                                                              \
+        const char *: NSL__LOG_TYPE_STRING,                                                        \
+        default: NSL__LOG_TYPE_POINTER)
+#define nsl__log_arg(x)                                                                            \
+    _Generic((x),                                                                                  \
+        bool: nsl__log_arg_signed,                                                                 \
+        char: nsl__log_arg_signed,                                                                 \
+        signed char: nsl__log_arg_signed,                                                          \
+        short: nsl__log_arg_signed,                                                                \
+        int: nsl__log_arg_signed,                                                                  \
+        long: nsl__log_arg_signed,                                                                 \
+        long long: nsl__log_arg_signed,                                                            \
+        unsigned char: nsl__log_arg_unsigned,                                                      \
+        unsigned short: nsl__log_arg_unsigned,                                                     \
+        unsigned int: nsl__log_arg_unsigned,                                                       \
+        unsigned long: nsl__log_arg_unsigned,                                                      \
+        unsigned long long: nsl__log_arg_unsigned,                                                 \
+        float: nsl__log_arg_double,                                                                \
+        double: nsl__log_arg_double,                                                               \
+        char *: nsl__log_arg_pointer,                                                              \
+        const char *: nsl__log_arg_pointer,                                                        \
+        default: nsl__log_arg_pointer)(x)
+
+static inline NSL__LogArg nsl__log_arg_signed(long long x) {
+    return (NSL__LogArg){.i = x};
+}
+
+static inline NSL__LogArg nsl__log_arg_unsigned(unsigned long long x) {
+    return (NSL__LogArg){.u = x};
+}
+
+static inline NSL__LogArg nsl__log_arg_double(double x) {
+    return (NSL__LogArg){.d = x};
+}
+
+static inline NSL__LogArg nsl__log_arg_pointer(const void *x) {
+    return (NSL__LogArg){.p = x};
+}
+
+NSL_LOG_DEF void
+nsl__log_write_deferred(int level, const NSL__LogFormat *format, const NSL__LogArg *args);
+
+#endif  // NSL_LOG_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(LOG)
+#    ifndef NSL_LOG_IMPLEMENTATION_GUARD_
+#        define NSL_LOG_IMPLEMENTATION_GUARD_
+
+#        include <assert.h>
+#        include <errno.h>
+#        include <stdarg.h>
+#        include <stdatomic.h>
+#        include <stdint.h>
+#        include <stdio.h>
+#        include <string.h>
+#        include <sys/uio.h>
+#        include <threads.h>
+#        include <time.h>
+
+// Every record in a buffer starts with a header and is padded to a multiple of
+// the header size, so that headers are always aligned and records never wrap
+// around the end of the buffer. When a record does not fit before the end, the
+// rest of the buffer is filled with a padding record.
+typedef struct NSL__LogHeader {
+    uint32_t size; // Size of the payload, excluding the header and padding.
+    uint32_t kind; // One of `NSL__LogRecord`, with the level in the upper bits.
+} NSL__LogHeader;
+
+// A deferred record holds the address of its `NSL__LogFormat`, followed by the
+// value of every argument, followed by the bytes of every string argument
+// including their null terminators.
+typedef enum NSL__LogRecord {
+    NSL__LOG_RECORD_PAD,
+    NSL__LOG_RECORD_TEXT,
+    NSL__LOG_RECORD_DEFERRED,
+} NSL__LogRecord;
+
+#        define NSL__LOG_RECORD_KIND(kind) ((kind) & 0xff)
+#        define NSL__LOG_RECORD_LEVEL(kind) ((int)((kind) >> 8))
+
+// A single producer, single consumer ring buffer. The owning thread advances
+// `head` and the flusher advances `tail`. Both only ever increase, and are
+// reduced modulo the capacity when indexing. They are kept on separate cache
+// lines so that the two threads do not contend.
+typedef struct NSL__LogBuffer NSL__LogBuffer;
+struct NSL__LogBuffer {
+    _Atomic size_t  head;
+    char            padding[64 - sizeof(size_t)];
+    _Atomic size_t  tail;
+    _Atomic size_t  dropped;
+    atomic_bool     owned;
+    NSL__LogBuffer *next;
+    size_t          capacity;
+    char           *data;
+};
+
+// The number of iovecs written with a single `writev`.
+#        define NSL__LOG_BATCH 64
+
+static struct {
+    atomic_bool               running;
+    _Atomic unsigned          generation;
+    _Atomic(NSL__LogBuffer *) buffers;
+    NSL_LogConfig             config;
+    tss_t                     owner;
+    thrd_t                    flusher;
+    mtx_t                     mutex;
+    cnd_t                     wake;
+    bool                      stopping;
+} g_nsl__log;
+
+static thread_local struct {
+    NSL__LogBuffer *buffer;
+    unsigned        generation;
+} g_nsl__log_local;
+
+// Deferred records are formatted here by the flusher before being written.
+static char nsl__log_scratch[NSL__LOG_BATCH][NSL_LOG_MAX_MESSAGE];
+
+static const char *const nsl__log_levels[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+
+static size_t nsl__log_align(size_t size) {
+    return (size + sizeof(NSL__LogHeader) - 1) & ~(sizeof(NSL__LogHeader) - 1);
+}
+
+// Writes all of `iov` to the sink, retrying partial writes.
+static void nsl__log_sink_write(struct iovec *iov, int count) {
+    if (g_nsl__log.config.sink == NSL_LOG_SINK_EPRINTF) {
+        for (int i = 0; i < count; i++) {
+            nsl_eprintf("%.*s", (int)iov[i].iov_len, (const char *)iov[i].iov_base);
+        }
+        return;
+    }
+    while (count > 0) {
+        ssize_t written = nsl_stream_writev(g_nsl__log.config.fd, iov, count);
+        if (written < 0 && errno == EINTR) { continue; }
+        if (written < 0) { return; }
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+}
+
+static size_t nsl__log_format_deferred(char *out, int level, const char *record);
+
+// Writes every complete record in `buffer` to the sink and releases the space.
+static void nsl__log_drain(NSL__LogBuffer *buffer) {
+    size_t tail = atomic_load_explicit(&buffer->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+    while (tail != head) {
+        struct iovec iov[NSL__LOG_BATCH];
+        int          count = 0;
+        while (tail != head && count < NSL__LOG_BATCH) {
+            char          *record = buffer->data + (tail & (buffer->capacity - 1));
+            NSL__LogHeader header;
+            memcpy(&header, record, sizeof(header));
+            char *payload = record + sizeof(header);
+            if (NSL__LOG_RECORD_KIND(header.kind) == NSL__LOG_RECORD_TEXT) {
+                iov[count++] = (struct iovec){payload, header.size};
+            } else if (NSL__LOG_RECORD_KIND(header.kind) == NSL__LOG_RECORD_DEFERRED) {
+                int    level = NSL__LOG_RECORD_LEVEL(header.kind);
+                char  *out   = nsl__log_scratch[count];
+                size_t size  = nsl__log_format_deferred(out, level, payload);
+                iov[count++] = (struct iovec){out, size};
+            }
+            tail += sizeof(header) + nsl__log_align(header.size);
+        }
+        nsl__log_sink_write(iov, count);
+        atomic_store_explicit(&buffer->tail, tail, memory_order_release);
+    }
+
+    size_t dropped = atomic_exchange_explicit(&buffer->dropped, 0, memory_order_relaxed);
+    if (dropped > 0) {
+        char message[64];
+        int  length = snprintf(message, sizeof(message), "[WARN] dropped %zu messages\n", dropped);
+        nsl__log_sink_write(&(struct iovec){message, (size_t)length}, 1);
+    }
+}
+
+static void nsl__log_drain_all(void) {
+    NSL__LogBuffer *buffer = atomic_load_explicit(&g_nsl__log.buffers, memory_order_acquire);
+    for (; buffer != nullptr; buffer = buffer->next) {
+        nsl__log_drain(buffer);
+    }
+}
+
+static int nsl__log_flusher(void *) {
+    mtx_lock(&g_nsl__log.mutex);
+    while (!g_nsl__log.stopping) {
+        nsl__log_drain_all();
+
+        struct timespec deadline;
+        timespec_get(&deadline, TIME_UTC);
+        long interval     = (long)g_nsl__log.config.flush_interval_ms * 1000000;
+        deadline.tv_sec  += (deadline.tv_nsec + interval) / 1000000000;
+        deadline.tv_nsec  = (deadline.tv_nsec + interval) % 1000000000;
+        cnd_timedwait(&g_nsl__log.wake, &g_nsl__log.mutex, &deadline);
+    }
+    nsl__log_drain_all();
+    mtx_unlock(&g_nsl__log.mutex);
+    return 0;
+}
+
+// Called when a thread exits, so that its buffer can be reused by another.
+static void nsl__log_release(void *buffer) {
+    atomic_store_explicit(&((NSL__LogBuffer *)buffer)->owned, false, memory_order_release);
+}
+
+// Returns the buffer of the current thread, claiming an unowned buffer or
+// allocating a new one if needed.
+static NSL__LogBuffer *nsl__log_buffer(void) {
+    unsigned generation = atomic_load_explicit(&g_nsl__log.generation, memory_order_relaxed);
+    if (g_nsl__log_local.buffer != nullptr && g_nsl__log_local.generation == generation) {
+        return g_nsl__log_local.buffer;
+    }
+
+    NSL__LogBuffer *buffer = atomic_load_explicit(&g_nsl__log.buffers, memory_order_acquire);
+    for (; buffer != nullptr; buffer = buffer->next) {
+        bool owned = false;
+        if (atomic_compare_exchange_strong(&buffer->owned, &owned, true)) { break; }
+    }
+
+    if (buffer == nullptr) {
+        buffer = nsl_malloc(sizeof(*buffer));
+        char *data = nsl_malloc(g_nsl__log.config.buffer_size);
+        if (buffer == nullptr || data == nullptr) {
+            nsl_free(buffer);
+            nsl_free(data);
+            return nullptr;
+        }
+        *buffer = (NSL__LogBuffer){.capacity = g_nsl__log.config.buffer_size, .data = data};
+        atomic_init(&buffer->owned, true);
+        buffer->next = atomic_load_explicit(&g_nsl__log.buffers, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&g_nsl__log.buffers,
+                                                      &buffer->next,
+                                                      buffer,
+                                                      memory_order_release,
+                                                      memory_order_relaxed)) {}
+    }
+
+    tss_set(g_nsl__log.owner, buffer);
+    g_nsl__log_local.buffer     = buffer;
+    g_nsl__log_local.generation = generation;
+    return buffer;
+}
+
+// Reserves space for a record with a payload of up to `size` bytes, and returns
+// a pointer to the payload, or `nullptr` if the buffer is full. `head` is set to
+// the position of the record, which is passed to `nsl__log_commit`.
+static char *nsl__log_reserve(NSL__LogBuffer *buffer, size_t size, size_t *head) {
+    size_t total      = sizeof(NSL__LogHeader) + nsl__log_align(size);
+    size_t start      = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    size_t tail       = atomic_load_explicit(&buffer->tail, memory_order_acquire);
+    size_t offset     = start & (buffer->capacity - 1);
+    size_t contiguous = buffer->capacity - offset;
+    size_t padding    = contiguous < total ? contiguous : 0;
+    if (start + padding + total - tail > buffer->capacity) { return nullptr; }
+
+    if (padding > 0) {
+        NSL__LogHeader header = {
+            .size = (uint32_t)(padding - sizeof(header)),
+            .kind = NSL__LOG_RECORD_PAD,
+        };
+        memcpy(buffer->data + offset, &header, sizeof(header));
+        start += padding;
+    }
+    *head = start;
+    return buffer->data + (start & (buffer->capacity - 1)) + sizeof(NSL__LogHeader);
+}
+
+// Publishes the record reserved at `head` with a payload of `size` bytes.
+static void nsl__log_commit(NSL__LogBuffer *buffer, size_t head, uint32_t kind, size_t size) {
+    NSL__LogHeader header = {.size = (uint32_t)size, .kind = kind};
+    memcpy(buffer->data + (head & (buffer->capacity - 1)), &header, sizeof(header));
+    size_t next = head + sizeof(header) + nsl__log_align(size);
+    atomic_store_explicit(&buffer->head, next, memory_order_release);
+}
+
+// Formats a message, including its level and trailing newline, into `out`,
+// which holds `NSL_LOG_MAX_MESSAGE` bytes. The result is not null terminated.
+static size_t nsl__log_format(char *out, int level, const char *fmt, va_list args) {
+    int prefix = snprintf(out, NSL_LOG_MAX_MESSAGE, "[%s] ", nsl__log_levels[level]);
+    int length = vsnprintf(out + prefix, NSL_LOG_MAX_MESSAGE - (size_t)prefix, fmt, args);
+    size_t size = (size_t)prefix + (length < 0 ? 0 : (size_t)length);
+    if (size > NSL_LOG_MAX_MESSAGE - 1) { size = NSL_LOG_MAX_MESSAGE - 1; }
+    out[size] = '\n';
+    return size + 1;
+}
+
+NSL_LOG_DEF void nsl__log_write(int level, const char *fmt, ...) {
+    assert(level >= NSL_LOG_LEVEL_TRACE && level <= NSL_LOG_LEVEL_ERROR);
+    va_list args;
+    va_start(args, fmt);
+
+    NSL__LogBuffer *buffer = nullptr;
+    if (atomic_load_explicit(&g_nsl__log.running, memory_order_acquire)) {
+        buffer = nsl__log_buffer();
+    }
+
+    if (buffer == nullptr) {
+        char   message[NSL_LOG_MAX_MESSAGE];
+        size_t size = nsl__log_format(message, level, fmt, args);
+        nsl_eprintf("%.*s", (int)size, message);
+    } else {
+        size_t head;
+        char  *payload = nsl__log_reserve(buffer, NSL_LOG_MAX_MESSAGE, &head);
+        if (payload == nullptr) {
+            atomic_fetch_add_explicit(&buffer->dropped, 1, memory_order_relaxed);
+        } else {
+            size_t size = nsl__log_format(payload, level, fmt, args);
+            nsl__log_commit(buffer, head, NSL__LOG_RECORD_TEXT, size);
+        }
+    }
+
+    va_end(args);
+}
+
+// Formats the conversion specification `spec` with the argument `arg` of type
+// `type` into `out`, which holds `size` bytes. Returns the length of the result,
+// which may exceed `size` as with `snprintf`.
+static int nsl__log_format_arg(
+    char *out, size_t size, const char *spec, uint8_t type, NSL__LogArg arg, const char *string) {
+    switch (type) {
+    case NSL__LOG_TYPE_INT: return snprintf(out, size, spec, (int)arg.i);
+    case NSL__LOG_TYPE_LONG: return snprintf(out, size, spec, (long)arg.i);
+    case NSL__LOG_TYPE_LLONG: return snprintf(out, size, spec, arg.i);
+    case NSL__LOG_TYPE_UINT: return snprintf(out, size, spec, (unsigned)arg.u);
+    case NSL__LOG_TYPE_ULONG: return snprintf(out, size, spec, (unsigned long)arg.u);
+    case NSL__LOG_TYPE_ULLONG: return snprintf(out, size, spec, arg.u);
+    case NSL__LOG_TYPE_DOUBLE: return snprintf(out, size, spec, arg.d);
+    case NSL__LOG_TYPE_STRING: return snprintf(out, size, spec, string);
+    default: return snprintf(out, size, spec, arg.p);
+    }
+}
+
+// Formats a deferred record the same way as `nsl__log_format`. The format
+// string is walked one conversion specification at a time, and each is passed
+// to `snprintf` along with its argument converted back to its original type.
+static size_t nsl__log_format_deferred(char *out, int level, const char *record) {
+    const NSL__LogFormat *format;
+    memcpy(&format, record, sizeof(format));
+    const char *args   = record + sizeof(format);
+    const char *string = args + format->count * sizeof(NSL__LogArg);
+
+    size_t      limit = NSL_LOG_MAX_MESSAGE - 1;
+    size_t      size  = (size_t)snprintf(out, limit, "[%s] ", nsl__log_levels[level]);
+    const char *fmt   = format->string;
+    uint32_t    next  = 0;
+    while (*fmt != '\0' && size < limit) {
+        if (fmt[0] != '%' || fmt[1] == '%' || next == format->count) {
+            size_t skip = fmt[0] == '%' && fmt[1] == '%' ? 2 : 1;
+            out[size++] = *fmt;
+            fmt        += skip;
+            continue;
+        }
+
+        char   spec[32];
+        size_t length = strcspn(fmt + 1, "diouxXeEfFgGaAcsp") + 2;
+        if (length >= sizeof(spec) || fmt[length - 1] == '\0') { break; }
+        memcpy(spec, fmt, length);
+        spec[length] = '\0';
+
+        NSL__LogArg arg;
+        memcpy(&arg, args + next * sizeof(arg), sizeof(arg));
+        int written = nsl__log_format_arg(
+            out + size, limit - size + 1, spec, format->types[next], arg, string);
+        if (format->types[next] == NSL__LOG_TYPE_STRING) { string += arg.u + 1; }
+        size += written < 0 ? 0 : (size_t)written;
+        fmt  += length;
+        next++;
+    }
+
+    if (size > limit) { size = limit; }
+    out[size] = '\n';
+    return size + 1;
+}
+
+// Returns the size of the record for a call to `nsl_log_deferred`, and stores
+// the length of every string argument in `lengths`. The total length of the
+// strings is limited to `NSL_LOG_MAX_MESSAGE`, since anything longer would be
+// truncated when formatted anyway.
+static size_t
+nsl__log_deferred_size(const NSL__LogFormat *format, const NSL__LogArg *args, size_t *lengths) {
+    size_t size      = sizeof(format) + format->count * sizeof(*args);
+    size_t remaining = NSL_LOG_MAX_MESSAGE;
+    for (uint32_t i = 0; i < format->count; i++) {
+        if (format->types[i] != NSL__LOG_TYPE_STRING) { continue; }
+        const char *string = args[i].p == nullptr ? "(null)" : args[i].p;
+        const char *end    = memchr(string, '\0', remaining);
+        lengths[i]         = end == nullptr ? remaining : (size_t)(end - string);
+        remaining         -= lengths[i];
+        size              += lengths[i] + 1;
+    }
+    return size;
+}
+
+// Writes the record for a call to `nsl_log_deferred` into `out`.
+static void nsl__log_deferred_encode(
+    char *out, const NSL__LogFormat *format, const NSL__LogArg *args, const size_t *lengths) {
+    memcpy(out, &format, sizeof(format));
+    char *values = out + sizeof(format);
+    char *string = values + format->count * sizeof(*args);
+    for (uint32_t i = 0; i < format->count; i++) {
+        NSL__LogArg arg = args[i];
+        if (format->types[i] == NSL__LOG_TYPE_STRING) {
+            memcpy(string, arg.p == nullptr ? "(null)" : arg.p, lengths[i]);
+            string[lengths[i]]  = '\0';
+            string             += lengths[i] + 1;
+            arg.u               = lengths[i];
+        }
+        memcpy(values + i * sizeof(arg), &arg, sizeof(arg));
+    }
+}
+
+NSL_LOG_DEF void
+nsl__log_write_deferred(int level, const NSL__LogFormat *format, const NSL__LogArg *args) {
+    assert(level >= NSL_LOG_LEVEL_TRACE && level <= NSL_LOG_LEVEL_ERROR);
+    NSL__LogBuffer *buffer = nullptr;
+    if (atomic_load_explicit(&g_nsl__log.running, memory_order_acquire)) {
+        buffer = nsl__log_buffer();
+    }
+
+    size_t lengths[NSL_LOG_MAX_ARGS];
+    size_t size = nsl__log_deferred_size(format, args, lengths);
+    if (buffer == nullptr) {
+        char record[sizeof(format) + NSL_LOG_MAX_ARGS * sizeof(*args) + 2 * NSL_LOG_MAX_MESSAGE];
+        char message[NSL_LOG_MAX_MESSAGE];
+        nsl__log_deferred_encode(record, format, args, lengths);
+        size_t length = nsl__log_format_deferred(message, level, record);
+        nsl_eprintf("%.*s", (int)length, message);
+    } else {
+        size_t head;
+        char  *payload = nsl__log_reserve(buffer, size, &head);
+        if (payload == nullptr) {
+            atomic_fetch_add_explicit(&buffer->dropped, 1, memory_order_relaxed);
+        } else {
+            nsl__log_deferred_encode(payload, format, args, lengths);
+            uint32_t kind = NSL__LOG_RECORD_DEFERRED | (uint32_t)level << 8;
+            nsl__log_commit(buffer, head, kind, size);
+        }
+    }
+}
+
+NSL_LOG_DEF bool nsl_log_start(const NSL_LogConfig *config) {
+    NSL_LogConfig result = config == nullptr ? (NSL_LogConfig){} : *config;
+    if (result.buffer_size == 0) { result.buffer_size = NSL_LOG_BUFFER_SIZE; }
+    if (result.flush_interval_ms == 0) { result.flush_interval_ms = NSL_LOG_FLUSH_INTERVAL_MS; }
+    if ((result.buffer_size & (result.buffer_size - 1)) != 0
+        || result.buffer_size < 4 * (NSL_LOG_MAX_MESSAGE + sizeof(NSL__LogHeader))) {
+        return false;
+    }
+
+    g_nsl__log.config   = result;
+    g_nsl__log.stopping = false;
+    if (tss_create(&g_nsl__log.owner, nsl__log_release) != thrd_success) { return false; }
+    if (mtx_init(&g_nsl__log.mutex, mtx_plain) != thrd_success) {
+        tss_delete(g_nsl__log.owner);
+        return false;
+    }
+    if (cnd_init(&g_nsl__log.wake) != thrd_success) {
+        mtx_destroy(&g_nsl__log.mutex);
+        tss_delete(g_nsl__log.owner);
+        return false;
+    }
+    if (thrd_create(&g_nsl__log.flusher, nsl__log_flusher, nullptr) != thrd_success) {
+        cnd_destroy(&g_nsl__log.wake);
+        mtx_destroy(&g_nsl__log.mutex);
+        tss_delete(g_nsl__log.owner);
+        return false;
+    }
+
+    atomic_fetch_add_explicit(&g_nsl__log.generation, 1, memory_order_relaxed);
+    atomic_store_explicit(&g_nsl__log.running, true, memory_order_release);
+    return true;
+}
+
+NSL_LOG_DEF void nsl_log_stop(void) {
+    atomic_store_explicit(&g_nsl__log.running, false, memory_order_release);
+
+    mtx_lock(&g_nsl__log.mutex);
+    g_nsl__log.stopping = true;
+    cnd_signal(&g_nsl__log.wake);
+    mtx_unlock(&g_nsl__log.mutex);
+    thrd_join(g_nsl__log.flusher, nullptr);
+
+    // Deleting the key first ensures the destructor never sees a freed buffer.
+    tss_delete(g_nsl__log.owner);
+    NSL__LogBuffer *buffer = atomic_exchange(&g_nsl__log.buffers, nullptr);
+    while (buffer != nullptr) {
+        NSL__LogBuffer *next = buffer->next;
+        nsl_free(buffer->data);
+        nsl_free(buffer);
+        buffer = next;
+    }
+    cnd_destroy(&g_nsl__log.wake);
+    mtx_destroy(&g_nsl__log.mutex);
+}
+
+NSL_LOG_DEF void nsl_log_flush(void) {
+    if (!atomic_load_explicit(&g_nsl__log.running, memory_order_acquire)) { return; }
+    mtx_lock(&g_nsl__log.mutex);
+    nsl__log_drain_all();
+    mtx_unlock(&g_nsl__log.mutex);
+}
+
+#    endif  // NSL_LOG_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(LOG)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(LOG)
+#    ifndef NSL_LOG_STRIP_PREFIX_GUARD_
+#        define NSL_LOG_STRIP_PREFIX_GUARD_
+
+#        define LOG_LEVEL_TRACE  NSL_LOG_LEVEL_TRACE
+#        define LOG_LEVEL_DEBUG  NSL_LOG_LEVEL_DEBUG
+#        define LOG_LEVEL_INFO   NSL_LOG_LEVEL_INFO
+#        define LOG_LEVEL_WARN   NSL_LOG_LEVEL_WARN
+#        define LOG_LEVEL_ERROR  NSL_LOG_LEVEL_ERROR
+#        define LOG_LEVEL_OFF    NSL_LOG_LEVEL_OFF
+#        define LogSink          NSL_LogSink
+#        define LOG_SINK_EPRINTF NSL_LOG_SINK_EPRINTF
+#        define LOG_SINK_FD      NSL_LOG_SINK_FD
+#        define LogConfig        NSL_LogConfig
+#        define log_trace        nsl_log_trace
+#        define log_debug        nsl_log_debug
+#        define log_info         nsl_log_info
+#        define log_warn         nsl_log_warn
+#        define log_error        nsl_log_error
+#        define log_deferred     nsl_log_deferred
+#        define log_start        nsl_log_start
+#        define log_stop         nsl_log_stop
+#        define log_flush        nsl_log_flush
+
+#    endif  // NSL_LOG_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(LOG)
@@ -47,17 +47,39 @@
  * which correlates with a higher value. In short, `NSL__ARG_N` acts as a
  * sliding window over `NSL__REVERSE_SEQUENCE_N`. `NSL__NARGS` ensures that all
  * necessary layers of indirection are present to fully expand the macros. And
- * finally, `NSL_NARGS` provides the extra arguments to push the sliding window.
+ * finally, `NSL__NARGS_SMALL` provides the extra arguments to push the sliding
+ * window.
+ *
+ * The sliding window only covers 127 arguments. If more arguments are
+ * provided, `NSL__NARGS_LARGE` drops 127 arguments at a time, adding 127 to
+ * the result each time, until the remaining arguments fit in the window. This
+ * is done recursively using `NSL_DEFER` and `NSL_EVAL`.
  *
  * # Requirements
- * - The number of arguments is less than 128. If 128 or more arguments are
- *   provided, the macro will evaluate to the 128th argument.
+ * - The number of arguments is less than roughly 10,000 (see `NSL_EVAL`).
  *
  * # Returns
- * The number of arguments, N, provided. If N >= 128, then the 128th argument.
+ * The number of arguments, N, provided. If N < 128, this is a single integer
+ * literal that can be used for concatenation. Otherwise, it is a parenthesized
+ * integer constant expression (e.g. `(127 + 127 + 6)`).
  */
-#define NSL_NARGS(...)  NSL__NARGS(__VA_ARGS__ __VA_OPT__(, ) NSL__REVERSE_SEQUENCE_N)
-#define NSL__NARGS(...) NSL__ARG_N(__VA_ARGS__)
+#define NSL_NARGS(...)             NSL_CAT(NSL__NARGS_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__NARGS_SMALL(...)      NSL__NARGS(__VA_ARGS__ __VA_OPT__(, ) NSL__REVERSE_SEQUENCE_N)
+#define NSL__NARGS(...)            NSL__ARG_N(__VA_ARGS__)
+#define NSL__NARGS_LARGE(...)      (NSL__NARGS_EVAL(NSL__NARGS_LOOP_LARGE(__VA_ARGS__)))
+#define NSL__NARGS_LOOP(...)                                                                       \
+    NSL_CAT(NSL__NARGS_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__NARGS_LOOP_ID()       NSL__NARGS_LOOP
+#define NSL__NARGS_LOOP_SMALL(...) NSL__NARGS_SMALL(__VA_ARGS__)
+#define NSL__NARGS_LOOP_LARGE(...)                                                                 \
+    127 + NSL_DEFER(NSL__NARGS_LOOP_ID)()(NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__NARGS_EVAL(...)                                                                       \
+    NSL__NARGS_EVAL3(NSL__NARGS_EVAL3(NSL__NARGS_EVAL3(NSL__NARGS_EVAL3(__VA_ARGS__))))
+#define NSL__NARGS_EVAL3(...)                                                                      \
+    NSL__NARGS_EVAL2(NSL__NARGS_EVAL2(NSL__NARGS_EVAL2(NSL__NARGS_EVAL2(__VA_ARGS__))))
+#define NSL__NARGS_EVAL2(...)                                                                      \
+    NSL__NARGS_EVAL1(NSL__NARGS_EVAL1(NSL__NARGS_EVAL1(NSL__NARGS_EVAL1(__VA_ARGS__))))
+#define NSL__NARGS_EVAL1(...) __VA_ARGS__
 // clang-format off
 #define NSL__ARG_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, \
                    _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26,  \
@@ -83,6 +105,109 @@
      14,  13,  12,  11,  10,   9,   8,   7,   6,   5,   4,   3,   2,   1,   0
 // clang-format on
 
+/*!
+ * Expands to nothing. This is used together with `NSL_DEFER` to delay the
+ * expansion of a macro by one scan of the preprocessor.
+ */
+#define NSL_EMPTY()
+
+/*!
+ * Defers the expansion of the function-like macro `id` by one scan. For
+ * example, `NSL_DEFER(f)(x)` expands to `f (x)` and it is only on the next scan
+ * that `f` is invoked.
+ *
+ * The preprocessor will never expand a macro within its own expansion, which
+ * prevents writing recursive macros directly. Deferring the call until the
+ * enclosing macro has finished expanding (and wrapping everything in
+ * `NSL_EVAL` to force the extra scans) allows a macro to indirectly call
+ * itself. This is how the macros in this file handle more than 127 arguments.
+ *
+ * # Parameters
+ * - `id`: The name of a function-like macro.
+ */
+#define NSL_DEFER(id) id NSL_EMPTY()
+
+/*!
+ * Forces the preprocessor to repeatedly scan the provided arguments, expanding
+ * any calls that were deferred with `NSL_DEFER`. Each scan allows a deferred
+ * recursive macro to take one more step, and the nesting below provides enough
+ * scans for at least 80 steps.
+ *
+ * A macro is never expanded within its own expansion, so `NSL_EVAL` cannot be
+ * nested inside of itself. For this reason, each of the recursive macros in
+ * this file has its own private copy of `NSL_EVAL`, allowing them to be freely
+ * combined (e.g. `NSL_FORALL_INIT(NSL_NCAT, ...)`) as long as a macro is not
+ * nested within itself.
+ *
+ * # Returns
+ * The provided arguments with all deferred expressions fully expanded.
+ */
+#define NSL_EVAL(...)   NSL__EVAL3(NSL__EVAL3(NSL__EVAL3(NSL__EVAL3(__VA_ARGS__))))
+#define NSL__EVAL3(...) NSL__EVAL2(NSL__EVAL2(NSL__EVAL2(NSL__EVAL2(__VA_ARGS__))))
+#define NSL__EVAL2(...) NSL__EVAL1(NSL__EVAL1(NSL__EVAL1(NSL__EVAL1(__VA_ARGS__))))
+#define NSL__EVAL1(...) __VA_ARGS__
+
+/*!
+ * Evaluates to `LARGE` if more than 127 arguments are provided, and `SMALL`
+ * otherwise. This is used to dispatch between the fixed-size implementations,
+ * which only support up to 127 arguments, and the recursive implementations.
+ *
+ * This works in the same way as `NSL_NARGS`, except the sliding window is over
+ * a list of empty arguments. The 128th argument will be empty unless the user
+ * provided at least 128 arguments, which is then checked with `__VA_OPT__`.
+ *
+ * # Requires
+ * - If more than 127 arguments are provided, the 128th argument is not empty.
+ */
+#define NSL__ARGS_SIZE(...)  NSL__ARGS_SIZE_(NSL__NARGS(__VA_ARGS__, NSL__EMPTY_SEQUENCE_N))
+#define NSL__ARGS_SIZE_(...) NSL_ARG_HEAD(__VA_OPT__(LARGE, ) SMALL)
+
+/*!
+ * Evaluates to the first 127 arguments (`NSL__ARG_TAKE127`) or everything
+ * after the first 127 arguments (`NSL__ARG_DROP127`). These are used to split
+ * large argument lists into chunks that the fixed-size implementations can
+ * handle.
+ *
+ * # Requires
+ * - At least 127 arguments are provided.
+ */
+// clang-format off
+#define NSL__EMPTY_SEQUENCE_N                                                   \
+    ,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,                                            \
+    ,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,                                            \
+    ,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,                                            \
+    ,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,
+#define NSL__ARG_TAKE127(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,    \
+                         _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30,     \
+                         _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44,     \
+                         _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+                         _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72,     \
+                         _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86,     \
+                         _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100,    \
+                         _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112,   \
+                         _113, _114, _115, _116, _117, _118, _119, _120, _121, _122, _123, _124,   \
+                         _125, _126, _127, ...)                                                    \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20,     \
+    _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,      \
+    _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56,      \
+    _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74,      \
+    _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92,      \
+    _93, _94, _95, _96, _97, _98, _99, _100, _101, _102, _103, _104, _105, _106, _107, _108,       \
+    _109, _110, _111, _112, _113, _114, _115, _116, _117, _118, _119, _120, _121, _122, _123,      \
+    _124, _125, _126, _127
+#define NSL__ARG_DROP127(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,    \
+                         _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30,     \
+                         _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44,     \
+                         _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+                         _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72,     \
+                         _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86,     \
+                         _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100,    \
+                         _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112,   \
+                         _113, _114, _115, _116, _117, _118, _119, _120, _121, _122, _123, _124,   \
+                         _125, _126, _127, ...)                                                    \
+    __VA_ARGS__
+// clang-format on
+
 /*!
  * Concatenates the two provided arguments into one. For example,
  * `NSL_CAT(foo, bar)` would be expanded by the preprocessor to `foobar`.
@@ -135,18 +260,36 @@
  * `NSL_NCAT` requires two levels of indirection. This is because the
  * preprocessor does not recursively expand macros if `#` or `##` are present.
  * `NSL__NCAT` will call the correct "recursive" macro to concatenate all
- * arguments.
+ * arguments. If there are more than 127 arguments, they are concatenated 127
+ * at a time and the results are concatenated with each other.
  *
  * # Requirements
- * - The number of parameters is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - The number of parameters is less than roughly 10,000 (see `NSL_EVAL`).
  *
  * # Returns
  * The concatenated full name.
  */
-#define NSL_NCAT(...)  NSL__NCAT(__VA_ARGS__)
-#define NSL__NCAT(...) NSL_CAT(NSL__NCAT, NSL_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define NSL_NCAT(...)        NSL__NCAT(__VA_ARGS__)
+#define NSL__NCAT(...)       NSL_CAT(NSL__NCAT_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__NCAT_SMALL(...) NSL_CAT(NSL__NCAT, NSL__NARGS_SMALL(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__NCAT_LARGE(...)                                                                       \
+    NSL__NCAT_EVAL(NSL__NCAT_LOOP(NSL__NCAT_CHUNK(NSL__ARG_TAKE127(__VA_ARGS__)),                  \
+                                  NSL__ARG_DROP127(__VA_ARGS__)))
+#define NSL__NCAT_LOOP(acc, ...)                                                                   \
+    NSL_CAT(NSL__NCAT_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(acc, __VA_ARGS__)
+#define NSL__NCAT_LOOP_ID() NSL__NCAT_LOOP
+#define NSL__NCAT_LOOP_SMALL(acc, ...) NSL_CAT(acc, NSL__NCAT_SMALL(__VA_ARGS__))
+#define NSL__NCAT_LOOP_LARGE(acc, ...)                                                             \
+    NSL_DEFER(NSL__NCAT_LOOP_ID)()(NSL_CAT(acc, NSL__NCAT_CHUNK(NSL__ARG_TAKE127(__VA_ARGS__))),   \
+                                   NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__NCAT_CHUNK(...) NSL__NCAT127(__VA_ARGS__)
+#define NSL__NCAT_EVAL(...)                                                                        \
+    NSL__NCAT_EVAL3(NSL__NCAT_EVAL3(NSL__NCAT_EVAL3(NSL__NCAT_EVAL3(__VA_ARGS__))))
+#define NSL__NCAT_EVAL3(...)                                                                       \
+    NSL__NCAT_EVAL2(NSL__NCAT_EVAL2(NSL__NCAT_EVAL2(NSL__NCAT_EVAL2(__VA_ARGS__))))
+#define NSL__NCAT_EVAL2(...)                                                                       \
+    NSL__NCAT_EVAL1(NSL__NCAT_EVAL1(NSL__NCAT_EVAL1(NSL__NCAT_EVAL1(__VA_ARGS__))))
+#define NSL__NCAT_EVAL1(...) __VA_ARGS__
 #define NSL__NCAT0()
 #define NSL__NCAT1(x)        x
 #define NSL__NCAT2(x, ...)   NSL_CAT(x, NSL__NCAT1(__VA_ARGS__))
@@ -284,23 +427,48 @@
  * `NSL_NCAT_SEP` requires two levels of indirection. This is because the
  * preprocessor does not recursively expand macros if `#` or `##` are present.
  * `NSL__NCAT_SEP` will call the correct "recursive" macro to concatenate
- * all arguments.
+ * all arguments. If there are more than 127 arguments, they are concatenated
+ * 127 at a time and the results are concatenated with each other.
  *
  * # Parameters
  * - `sep`: The separator to be placed between each argument.
  * - `...`: The arguments to concatenate.
  *
  * # Requirements
- * - The number of arguments to concatentate is less than 128. If 128 or more
- *   arguments are provided, a compile time error is likely to be generated.
- *   There is no guarantee of this, however.
+ * - The number of arguments to concatentate is less than roughly 10,000 (see
+ *   `NSL_EVAL`).
  *
  * # Returns
  * The concatenated full name with separators.
  */
 #define NSL_NCAT_SEP(sep, ...) NSL__NCAT_SEP(sep, __VA_ARGS__)
 #define NSL__NCAT_SEP(sep, ...)                                                                    \
-    NSL_CAT(NSL__NCAT_SEP, NSL_NARGS(__VA_ARGS__))(sep __VA_OPT__(, ) __VA_ARGS__)
+    NSL_CAT(NSL__NCAT_SEP_, NSL__ARGS_SIZE(__VA_ARGS__))(sep __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__NCAT_SEP_SMALL(sep, ...)                                                              \
+    NSL_CAT(NSL__NCAT_SEP, NSL__NARGS_SMALL(__VA_ARGS__))(sep __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__NCAT_SEP_LARGE(sep, ...)                                                              \
+    NSL__NCAT_SEP_EVAL(                                                                            \
+        NSL__NCAT_SEP_LOOP(sep,                                                                    \
+                           NSL__NCAT_SEP_CHUNK(sep, NSL__ARG_TAKE127(__VA_ARGS__)),                \
+                           NSL__ARG_DROP127(__VA_ARGS__)))
+#define NSL__NCAT_SEP_LOOP(sep, acc, ...)                                                          \
+    NSL_CAT(NSL__NCAT_SEP_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(sep, acc, __VA_ARGS__)
+#define NSL__NCAT_SEP_LOOP_ID() NSL__NCAT_SEP_LOOP
+#define NSL__NCAT_SEP_LOOP_SMALL(sep, acc, ...)                                                    \
+    NSL_CAT_SEP(sep, acc, NSL__NCAT_SEP_SMALL(sep, __VA_ARGS__))
+#define NSL__NCAT_SEP_LOOP_LARGE(sep, acc, ...)                                                    \
+    NSL_DEFER(NSL__NCAT_SEP_LOOP_ID)()(                                                            \
+        sep,                                                                                       \
+        NSL_CAT_SEP(sep, acc, NSL__NCAT_SEP_CHUNK(sep, NSL__ARG_TAKE127(__VA_ARGS__))),            \
+        NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__NCAT_SEP_CHUNK(sep, ...) NSL__NCAT_SEP127(sep, __VA_ARGS__)
+#define NSL__NCAT_SEP_EVAL(...)                                                                    \
+    NSL__NCAT_SEP_EVAL3(NSL__NCAT_SEP_EVAL3(NSL__NCAT_SEP_EVAL3(NSL__NCAT_SEP_EVAL3(__VA_ARGS__))))
+#define NSL__NCAT_SEP_EVAL3(...)                                                                   \
+    NSL__NCAT_SEP_EVAL2(NSL__NCAT_SEP_EVAL2(NSL__NCAT_SEP_EVAL2(NSL__NCAT_SEP_EVAL2(__VA_ARGS__))))
+#define NSL__NCAT_SEP_EVAL2(...)                                                                   \
+    NSL__NCAT_SEP_EVAL1(NSL__NCAT_SEP_EVAL1(NSL__NCAT_SEP_EVAL1(NSL__NCAT_SEP_EVAL1(__VA_ARGS__))))
+#define NSL__NCAT_SEP_EVAL1(...) __VA_ARGS__
 #define NSL__NCAT_SEP0(sep)
 #define NSL__NCAT_SEP1(sep, x)        x
 #define NSL__NCAT_SEP2(sep, x, ...)   NSL_CAT_SEP(sep, x, NSL__NCAT_SEP1(sep, __VA_ARGS__))
@@ -451,23 +619,41 @@
  *
  * `NSL_NSEP` requires two levels of indirection. This is to ensure that passing
  * a macro that expands to the variadic arguments works correctly and is
- * expanded.
+ * expanded. If there are more than 127 arguments, they are separated 127 at a
+ * time.
  *
  * # Parameters
  * - `sep`: The separator between the arguments
  * - `...`: The arguments to be separated.
  *
  * # Requires
- * - The number of arguments to be separated is less than 128. If 128 or more
- *   arguments are provided, a compile time error is likely to be generated.
- *   There is no guarantee of this, however.
+ * - The number of arguments to be separated is less than roughly 10,000 (see
+ *   `NSL_EVAL`).
  *
  * # Returns
  * The arguments with `sep` between each pair.
  */
 #define NSL_NSEP(sep, ...) NSL__NSEP(sep, __VA_ARGS__)
 #define NSL__NSEP(sep, ...)                                                                        \
-    NSL_CAT(NSL__NSEP, NSL_NARGS(__VA_ARGS__))(sep __VA_OPT__(, ) __VA_ARGS__)
+    NSL_CAT(NSL__NSEP_, NSL__ARGS_SIZE(__VA_ARGS__))(sep __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__NSEP_SMALL(sep, ...)                                                                  \
+    NSL_CAT(NSL__NSEP, NSL__NARGS_SMALL(__VA_ARGS__))(sep __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__NSEP_LARGE(sep, ...) NSL__NSEP_EVAL(NSL__NSEP_LOOP_LARGE(sep, __VA_ARGS__))
+#define NSL__NSEP_LOOP(sep, ...)                                                                   \
+    NSL_CAT(NSL__NSEP_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(sep, __VA_ARGS__)
+#define NSL__NSEP_LOOP_ID() NSL__NSEP_LOOP
+#define NSL__NSEP_LOOP_SMALL(sep, ...) NSL__NSEP_SMALL(sep, __VA_ARGS__)
+#define NSL__NSEP_LOOP_LARGE(sep, ...)                                                             \
+    NSL__NSEP_CHUNK(sep, NSL__ARG_TAKE127(__VA_ARGS__))                                            \
+    sep NSL_DEFER(NSL__NSEP_LOOP_ID)()(sep, NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__NSEP_CHUNK(sep, ...) NSL__NSEP127(sep, __VA_ARGS__)
+#define NSL__NSEP_EVAL(...)                                                                        \
+    NSL__NSEP_EVAL3(NSL__NSEP_EVAL3(NSL__NSEP_EVAL3(NSL__NSEP_EVAL3(__VA_ARGS__))))
+#define NSL__NSEP_EVAL3(...)                                                                       \
+    NSL__NSEP_EVAL2(NSL__NSEP_EVAL2(NSL__NSEP_EVAL2(NSL__NSEP_EVAL2(__VA_ARGS__))))
+#define NSL__NSEP_EVAL2(...)                                                                       \
+    NSL__NSEP_EVAL1(NSL__NSEP_EVAL1(NSL__NSEP_EVAL1(NSL__NSEP_EVAL1(__VA_ARGS__))))
+#define NSL__NSEP_EVAL1(...) __VA_ARGS__
 #define NSL__NSEP0(sep)
 #define NSL__NSEP1(sep, x)        x
 #define NSL__NSEP2(sep, x, ...)   NSL_SEP(sep, x, NSL__NSEP1(sep, __VA_ARGS__))
@@ -630,20 +816,33 @@
  * `NSL_ARG_TAIL` requires two levels of indirection. This is to ensure that
  * passing a macro that expands to the variadic arguments works correctly and is
  * expanded. `NSL__ARG_TAIl` concatentates `NSL__ARG_TAIL` with the number of
- * arguments provided (using `NSL_NARGS`, which is restricted to [0-127]). The
- * corresponding macro is called and it pops off elements in the list until only
- * the last is left which returned.
+ * arguments provided. The corresponding macro is called and it pops off
+ * elements in the list until only the last is left which returned. If there are
+ * more than 127 arguments, 127 are dropped at a time until the rest fit.
  *
  * # Requires
- * - The number of arguments, N, is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - The number of arguments, N, is less than roughly 10,000 (see `NSL_EVAL`).
  *
  * # Returns
  * The last argument in the variadic list of arguments, if any exists.
  */
-#define NSL_ARG_TAIL(...)  NSL__ARG_TAIL(__VA_ARGS__)
-#define NSL__ARG_TAIL(...) NSL_CAT(NSL__ARG_TAIL, NSL_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define NSL_ARG_TAIL(...)        NSL__ARG_TAIL(__VA_ARGS__)
+#define NSL__ARG_TAIL(...)       NSL_CAT(NSL__ARG_TAIL_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_TAIL_SMALL(...) NSL_CAT(NSL__ARG_TAIL, NSL__NARGS_SMALL(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_TAIL_LARGE(...) NSL__ARG_TAIL_EVAL(NSL__ARG_TAIL_LOOP_LARGE(__VA_ARGS__))
+#define NSL__ARG_TAIL_LOOP(...)                                                                    \
+    NSL_CAT(NSL__ARG_TAIL_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_TAIL_LOOP_ID()       NSL__ARG_TAIL_LOOP
+#define NSL__ARG_TAIL_LOOP_SMALL(...) NSL__ARG_TAIL_SMALL(__VA_ARGS__)
+#define NSL__ARG_TAIL_LOOP_LARGE(...)                                                              \
+    NSL_DEFER(NSL__ARG_TAIL_LOOP_ID)()(NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__ARG_TAIL_EVAL(...)                                                                    \
+    NSL__ARG_TAIL_EVAL3(NSL__ARG_TAIL_EVAL3(NSL__ARG_TAIL_EVAL3(NSL__ARG_TAIL_EVAL3(__VA_ARGS__))))
+#define NSL__ARG_TAIL_EVAL3(...)                                                                   \
+    NSL__ARG_TAIL_EVAL2(NSL__ARG_TAIL_EVAL2(NSL__ARG_TAIL_EVAL2(NSL__ARG_TAIL_EVAL2(__VA_ARGS__))))
+#define NSL__ARG_TAIL_EVAL2(...)                                                                   \
+    NSL__ARG_TAIL_EVAL1(NSL__ARG_TAIL_EVAL1(NSL__ARG_TAIL_EVAL1(NSL__ARG_TAIL_EVAL1(__VA_ARGS__))))
+#define NSL__ARG_TAIL_EVAL1(...) __VA_ARGS__
 #define NSL__ARG_TAIL0()
 #define NSL__ARG_TAIL1(x)        x
 #define NSL__ARG_TAIL2(x, ...)   NSL__ARG_TAIL1(__VA_ARGS__)
@@ -780,20 +979,38 @@
  * `NSL_ARG_INIT` requires two levels of indirection. This is to ensure that
  * passing a macro that expands to the variadic arguments works correctly and is
  * expanded. `NSL__ARG_INIT` concatentates `NSL__ARG_INIT` with the number
- * of arguments provided (using `NSL_NARGS`, which is restricted to [0-127]).
- * The corresponding macro is called and it pops off and replaces elements in
- * the list until only the last is left which is popped off without replacement.
+ * of arguments provided. The corresponding macro is called and it pops off and
+ * replaces elements in the list until only the last is left which is popped off
+ * without replacement. If there are more than 127 arguments, 127 are kept at a
+ * time until the rest fit.
  *
  * # Requires
- * - The number of arguments, N, is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - The number of arguments, N, is less than roughly 10,000 (see `NSL_EVAL`).
  *
  * # Returns
  * The initial argument in the variadic list of arguments, if any exists.
  */
-#define NSL_ARG_INIT(...)  NSL__ARG_INIT(__VA_ARGS__)
-#define NSL__ARG_INIT(...) NSL_CAT(NSL__ARG_INIT, NSL_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define NSL_ARG_INIT(...)        NSL__ARG_INIT(__VA_ARGS__)
+#define NSL__ARG_INIT(...)       NSL_CAT(NSL__ARG_INIT_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_INIT_SMALL(...) NSL_CAT(NSL__ARG_INIT, NSL__NARGS_SMALL(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_INIT_LARGE(...)                                                                   \
+    NSL__ARG_INIT_EVAL(                                                                            \
+        NSL__ARG_TAKE127(__VA_ARGS__) NSL__ARG_INIT_LOOP(NSL__ARG_DROP127(__VA_ARGS__)))
+#define NSL__ARG_INIT_LOOP(...)                                                                    \
+    NSL_CAT(NSL__ARG_INIT_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_INIT_LOOP_ID()       NSL__ARG_INIT_LOOP
+#define NSL__ARG_INIT_LOOP_SMALL(...) NSL__ARG_INIT_TRAILING(NSL__ARG_INIT_SMALL(__VA_ARGS__))
+#define NSL__ARG_INIT_LOOP_LARGE(...)                                                              \
+    , NSL__ARG_TAKE127(__VA_ARGS__)                                                                \
+    NSL_DEFER(NSL__ARG_INIT_LOOP_ID)()(NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__ARG_INIT_TRAILING(...) __VA_OPT__(, __VA_ARGS__)
+#define NSL__ARG_INIT_EVAL(...)                                                                    \
+    NSL__ARG_INIT_EVAL3(NSL__ARG_INIT_EVAL3(NSL__ARG_INIT_EVAL3(NSL__ARG_INIT_EVAL3(__VA_ARGS__))))
+#define NSL__ARG_INIT_EVAL3(...)                                                                   \
+    NSL__ARG_INIT_EVAL2(NSL__ARG_INIT_EVAL2(NSL__ARG_INIT_EVAL2(NSL__ARG_INIT_EVAL2(__VA_ARGS__))))
+#define NSL__ARG_INIT_EVAL2(...)                                                                   \
+    NSL__ARG_INIT_EVAL1(NSL__ARG_INIT_EVAL1(NSL__ARG_INIT_EVAL1(NSL__ARG_INIT_EVAL1(__VA_ARGS__))))
+#define NSL__ARG_INIT_EVAL1(...) __VA_ARGS__
 #define NSL__ARG_INIT0()
 #define NSL__ARG_INIT1(x)
 #define NSL__ARG_INIT2(x, ...)   x
@@ -930,20 +1147,40 @@
  * `NSL_ARG_REVERSE` requires two levels of indirection. This is to ensure that
  * passing a macro that expands to the variadic arguments works correctly and is
  * expanded. `NSL__ARG_REVERSE` concatentates `NSL__ARG_REVERSE` with the number
- * of arguments provided (using `NSL_NARGS`, which is restricted to [0-127]).
- * The corresponding macro is called and it pops off the current head, calls the
- * next macro in the chain, and then puts the head at the back.
+ * of arguments provided. The corresponding macro is called and it pops off the
+ * current head, calls the next macro in the chain, and then puts the head at
+ * the back. If there are more than 127 arguments, the first 127 are reversed
+ * and placed after the rest of the reversed arguments.
  *
  * # Requires
- * - The number of arguments, N, is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - The number of arguments, N, is less than roughly 10,000 (see `NSL_EVAL`).
  *
  * # Returns
  * The reversed variadic list of arguments, if any exists.
  */
-#define NSL_ARG_REVERSE(...)  NSL__ARG_REVERSE(__VA_ARGS__)
-#define NSL__ARG_REVERSE(...) NSL_CAT(NSL__ARG_REVERSE, NSL_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define NSL_ARG_REVERSE(...) NSL__ARG_REVERSE(__VA_ARGS__)
+#define NSL__ARG_REVERSE(...) NSL_CAT(NSL__ARG_REVERSE_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_REVERSE_SMALL(...)                                                                \
+    NSL_CAT(NSL__ARG_REVERSE, NSL__NARGS_SMALL(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_REVERSE_LARGE(...) NSL__ARG_REVERSE_EVAL(NSL__ARG_REVERSE_LOOP_LARGE(__VA_ARGS__))
+#define NSL__ARG_REVERSE_LOOP(...)                                                                 \
+    NSL_CAT(NSL__ARG_REVERSE_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(__VA_ARGS__)
+#define NSL__ARG_REVERSE_LOOP_ID()       NSL__ARG_REVERSE_LOOP
+#define NSL__ARG_REVERSE_LOOP_SMALL(...) NSL__ARG_REVERSE_SMALL(__VA_ARGS__)
+#define NSL__ARG_REVERSE_LOOP_LARGE(...)                                                           \
+    NSL_DEFER(NSL__ARG_REVERSE_LOOP_ID)()(NSL__ARG_DROP127(__VA_ARGS__)),                          \
+    NSL__ARG_REVERSE_CHUNK(NSL__ARG_TAKE127(__VA_ARGS__))
+#define NSL__ARG_REVERSE_CHUNK(...) NSL__ARG_REVERSE127(__VA_ARGS__)
+#define NSL__ARG_REVERSE_EVAL(...)                                                                 \
+    NSL__ARG_REVERSE_EVAL3(                                                                        \
+        NSL__ARG_REVERSE_EVAL3(NSL__ARG_REVERSE_EVAL3(NSL__ARG_REVERSE_EVAL3(__VA_ARGS__))))
+#define NSL__ARG_REVERSE_EVAL3(...)                                                                \
+    NSL__ARG_REVERSE_EVAL2(                                                                        \
+        NSL__ARG_REVERSE_EVAL2(NSL__ARG_REVERSE_EVAL2(NSL__ARG_REVERSE_EVAL2(__VA_ARGS__))))
+#define NSL__ARG_REVERSE_EVAL2(...)                                                                \
+    NSL__ARG_REVERSE_EVAL1(                                                                        \
+        NSL__ARG_REVERSE_EVAL1(NSL__ARG_REVERSE_EVAL1(NSL__ARG_REVERSE_EVAL1(__VA_ARGS__))))
+#define NSL__ARG_REVERSE_EVAL1(...) __VA_ARGS__
 #define NSL__ARG_REVERSE0()
 #define NSL__ARG_REVERSE1(x)        x
 #define NSL__ARG_REVERSE2(x, ...)   NSL__ARG_REVERSE1(__VA_ARGS__), x
@@ -1080,25 +1317,43 @@
  * `NSL_FOREACH` requires two levels of indirection. This is to ensure that
  * passing a macro that expands to the variadic arguments works correctly and is
  * expanded. `NSL__FOREACH` concatentates `NSL__FOREACH` with the number
- * of arguments provided (using `NSL_NARGS`, which is restricted to [0-127]).
- * The corresponding macro is called and it applies the function to the current
- * head and then calls the next macro in the chain.
+ * of arguments provided. The corresponding macro is called and it applies the
+ * function to the current head and then calls the next macro in the chain. If
+ * there are more than 127 arguments, the function is applied 127 arguments at a
+ * time.
  *
  * # Arguments
  * - `f`: The name of a function, macro, etc.
  *
  * # Requires
  * - `f` only accepts one argument and can be applied using `f(x)`.
- * - The number of arguments, N, is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - `f` does not expand to another `NSL_FOREACH` with more than 127 arguments.
+ * - The number of arguments, N, is less than roughly 10,000 (see `NSL_EVAL`).
  *
  * # Returns
  * The function `f` mapped to all arguments provided.
  */
 #define NSL_FOREACH(f, ...) NSL__FOREACH(f, __VA_ARGS__)
 #define NSL__FOREACH(f, ...)                                                                       \
-    NSL_CAT(NSL__FOREACH, NSL_NARGS(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+    NSL_CAT(NSL__FOREACH_, NSL__ARGS_SIZE(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FOREACH_SMALL(f, ...)                                                                 \
+    NSL_CAT(NSL__FOREACH, NSL__NARGS_SMALL(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FOREACH_LARGE(f, ...) NSL__FOREACH_EVAL(NSL__FOREACH_LOOP_LARGE(f, __VA_ARGS__))
+#define NSL__FOREACH_LOOP(f, ...)                                                                  \
+    NSL_CAT(NSL__FOREACH_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(f, __VA_ARGS__)
+#define NSL__FOREACH_LOOP_ID() NSL__FOREACH_LOOP
+#define NSL__FOREACH_LOOP_SMALL(f, ...) NSL__FOREACH_SMALL(f, __VA_ARGS__)
+#define NSL__FOREACH_LOOP_LARGE(f, ...)                                                            \
+    NSL__FOREACH_CHUNK(f, NSL__ARG_TAKE127(__VA_ARGS__)),                                          \
+    NSL_DEFER(NSL__FOREACH_LOOP_ID)()(f, NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__FOREACH_CHUNK(f, ...) NSL__FOREACH127(f, __VA_ARGS__)
+#define NSL__FOREACH_EVAL(...)                                                                     \
+    NSL__FOREACH_EVAL3(NSL__FOREACH_EVAL3(NSL__FOREACH_EVAL3(NSL__FOREACH_EVAL3(__VA_ARGS__))))
+#define NSL__FOREACH_EVAL3(...)                                                                    \
+    NSL__FOREACH_EVAL2(NSL__FOREACH_EVAL2(NSL__FOREACH_EVAL2(NSL__FOREACH_EVAL2(__VA_ARGS__))))
+#define NSL__FOREACH_EVAL2(...)                                                                    \
+    NSL__FOREACH_EVAL1(NSL__FOREACH_EVAL1(NSL__FOREACH_EVAL1(NSL__FOREACH_EVAL1(__VA_ARGS__))))
+#define NSL__FOREACH_EVAL1(...) __VA_ARGS__
 #define NSL__FOREACH0(f)
 #define NSL__FOREACH1(f, x)        f(x)
 #define NSL__FOREACH2(f, x, ...)   f(x), NSL__FOREACH1(f, __VA_ARGS__)
@@ -1228,6 +1483,182 @@
 #define NSL__FOREACH126(f, x, ...) f(x), NSL__FOREACH125(f, __VA_ARGS__)
 #define NSL__FOREACH127(f, x, ...) f(x), NSL__FOREACH126(f, __VA_ARGS__)
 
+/*!
+ * Applies the function `f` to all arguments provided, along with the index of
+ * each argument. For example, `NSL_FOREACH_I(f, a, b, c)` would evaluate to
+ * `f(0, a), f(1, b), f(2, c)`. The indices are integer literals, so they can be
+ * pasted onto other tokens or used as array designators and case labels.
+ *
+ * `NSL_FOREACH_I` works the same way as `NSL_FOREACH`, but carries the index
+ * of the current head along the chain of macros. The next index is looked up
+ * in a table of successors, rather than computed.
+ *
+ * # Arguments
+ * - `f`: The name of a function, macro, etc.
+ *
+ * # Requires
+ * - `f` accepts two arguments and can be applied using `f(i, x)`.
+ * - `f` does not expand to another `NSL_FOREACH_I` with more than 127
+ *   arguments.
+ * - The number of arguments, N, is at most 256.
+ *
+ * # Returns
+ * The function `f` mapped to all arguments provided and their indices.
+ */
+#define NSL_FOREACH_I(f, ...) NSL__FOREACH_I(f, __VA_ARGS__)
+#define NSL__FOREACH_I(f, ...)                                                                     \
+    NSL_CAT(NSL__FOREACH_I_, NSL__ARGS_SIZE(__VA_ARGS__))(f, 0 __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FOREACH_I_SMALL(f, i, ...)                                                            \
+    NSL_CAT(NSL__FOREACH_I, NSL__NARGS_SMALL(__VA_ARGS__))(f, i __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FOREACH_I_LARGE(f, i, ...)                                                            \
+    NSL__FOREACH_I_EVAL(NSL__FOREACH_I_LOOP_LARGE(f, i, __VA_ARGS__))
+#define NSL__FOREACH_I_LOOP(f, i, ...)                                                             \
+    NSL_CAT(NSL__FOREACH_I_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(f, i, __VA_ARGS__)
+#define NSL__FOREACH_I_LOOP_ID() NSL__FOREACH_I_LOOP
+#define NSL__FOREACH_I_LOOP_SMALL(f, i, ...) NSL__FOREACH_I_SMALL(f, i, __VA_ARGS__)
+#define NSL__FOREACH_I_LOOP_LARGE(f, i, ...)                                                       \
+    NSL__FOREACH_I_CHUNK(f, i, NSL__ARG_TAKE127(__VA_ARGS__)),                                     \
+    NSL_DEFER(NSL__FOREACH_I_LOOP_ID)()(f, NSL__ADD127(i), NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__FOREACH_I_CHUNK(f, i, ...) NSL__FOREACH_I127(f, i, __VA_ARGS__)
+#define NSL__FOREACH_I_EVAL(...)                                                                   \
+    NSL__FOREACH_I_EVAL3(                                                                          \
+        NSL__FOREACH_I_EVAL3(NSL__FOREACH_I_EVAL3(NSL__FOREACH_I_EVAL3(__VA_ARGS__))))
+#define NSL__FOREACH_I_EVAL3(...)                                                                  \
+    NSL__FOREACH_I_EVAL2(                                                                          \
+        NSL__FOREACH_I_EVAL2(NSL__FOREACH_I_EVAL2(NSL__FOREACH_I_EVAL2(__VA_ARGS__))))
+#define NSL__FOREACH_I_EVAL2(...)                                                                  \
+    NSL__FOREACH_I_EVAL1(                                                                          \
+        NSL__FOREACH_I_EVAL1(NSL__FOREACH_I_EVAL1(NSL__FOREACH_I_EVAL1(__VA_ARGS__))))
+#define NSL__FOREACH_I_EVAL1(...) __VA_ARGS__
+#define NSL__FOREACH_I0(f, i)
+#define NSL__FOREACH_I1(f, i, x)        f(i, x)
+#define NSL__FOREACH_I2(f, i, x, ...)   f(i, x), NSL__FOREACH_I1(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I3(f, i, x, ...)   f(i, x), NSL__FOREACH_I2(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I4(f, i, x, ...)   f(i, x), NSL__FOREACH_I3(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I5(f, i, x, ...)   f(i, x), NSL__FOREACH_I4(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I6(f, i, x, ...)   f(i, x), NSL__FOREACH_I5(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I7(f, i, x, ...)   f(i, x), NSL__FOREACH_I6(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I8(f, i, x, ...)   f(i, x), NSL__FOREACH_I7(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I9(f, i, x, ...)   f(i, x), NSL__FOREACH_I8(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I10(f, i, x, ...)  f(i, x), NSL__FOREACH_I9(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I11(f, i, x, ...)  f(i, x), NSL__FOREACH_I10(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I12(f, i, x, ...)  f(i, x), NSL__FOREACH_I11(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I13(f, i, x, ...)  f(i, x), NSL__FOREACH_I12(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I14(f, i, x, ...)  f(i, x), NSL__FOREACH_I13(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I15(f, i, x, ...)  f(i, x), NSL__FOREACH_I14(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I16(f, i, x, ...)  f(i, x), NSL__FOREACH_I15(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I17(f, i, x, ...)  f(i, x), NSL__FOREACH_I16(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I18(f, i, x, ...)  f(i, x), NSL__FOREACH_I17(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I19(f, i, x, ...)  f(i, x), NSL__FOREACH_I18(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I20(f, i, x, ...)  f(i, x), NSL__FOREACH_I19(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I21(f, i, x, ...)  f(i, x), NSL__FOREACH_I20(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I22(f, i, x, ...)  f(i, x), NSL__FOREACH_I21(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I23(f, i, x, ...)  f(i, x), NSL__FOREACH_I22(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I24(f, i, x, ...)  f(i, x), NSL__FOREACH_I23(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I25(f, i, x, ...)  f(i, x), NSL__FOREACH_I24(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I26(f, i, x, ...)  f(i, x), NSL__FOREACH_I25(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I27(f, i, x, ...)  f(i, x), NSL__FOREACH_I26(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I28(f, i, x, ...)  f(i, x), NSL__FOREACH_I27(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I29(f, i, x, ...)  f(i, x), NSL__FOREACH_I28(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I30(f, i, x, ...)  f(i, x), NSL__FOREACH_I29(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I31(f, i, x, ...)  f(i, x), NSL__FOREACH_I30(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I32(f, i, x, ...)  f(i, x), NSL__FOREACH_I31(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I33(f, i, x, ...)  f(i, x), NSL__FOREACH_I32(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I34(f, i, x, ...)  f(i, x), NSL__FOREACH_I33(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I35(f, i, x, ...)  f(i, x), NSL__FOREACH_I34(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I36(f, i, x, ...)  f(i, x), NSL__FOREACH_I35(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I37(f, i, x, ...)  f(i, x), NSL__FOREACH_I36(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I38(f, i, x, ...)  f(i, x), NSL__FOREACH_I37(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I39(f, i, x, ...)  f(i, x), NSL__FOREACH_I38(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I40(f, i, x, ...)  f(i, x), NSL__FOREACH_I39(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I41(f, i, x, ...)  f(i, x), NSL__FOREACH_I40(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I42(f, i, x, ...)  f(i, x), NSL__FOREACH_I41(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I43(f, i, x, ...)  f(i, x), NSL__FOREACH_I42(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I44(f, i, x, ...)  f(i, x), NSL__FOREACH_I43(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I45(f, i, x, ...)  f(i, x), NSL__FOREACH_I44(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I46(f, i, x, ...)  f(i, x), NSL__FOREACH_I45(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I47(f, i, x, ...)  f(i, x), NSL__FOREACH_I46(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I48(f, i, x, ...)  f(i, x), NSL__FOREACH_I47(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I49(f, i, x, ...)  f(i, x), NSL__FOREACH_I48(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I50(f, i, x, ...)  f(i, x), NSL__FOREACH_I49(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I51(f, i, x, ...)  f(i, x), NSL__FOREACH_I50(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I52(f, i, x, ...)  f(i, x), NSL__FOREACH_I51(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I53(f, i, x, ...)  f(i, x), NSL__FOREACH_I52(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I54(f, i, x, ...)  f(i, x), NSL__FOREACH_I53(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I55(f, i, x, ...)  f(i, x), NSL__FOREACH_I54(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I56(f, i, x, ...)  f(i, x), NSL__FOREACH_I55(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I57(f, i, x, ...)  f(i, x), NSL__FOREACH_I56(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I58(f, i, x, ...)  f(i, x), NSL__FOREACH_I57(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I59(f, i, x, ...)  f(i, x), NSL__FOREACH_I58(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I60(f, i, x, ...)  f(i, x), NSL__FOREACH_I59(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I61(f, i, x, ...)  f(i, x), NSL__FOREACH_I60(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I62(f, i, x, ...)  f(i, x), NSL__FOREACH_I61(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I63(f, i, x, ...)  f(i, x), NSL__FOREACH_I62(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I64(f, i, x, ...)  f(i, x), NSL__FOREACH_I63(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I65(f, i, x, ...)  f(i, x), NSL__FOREACH_I64(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I66(f, i, x, ...)  f(i, x), NSL__FOREACH_I65(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I67(f, i, x, ...)  f(i, x), NSL__FOREACH_I66(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I68(f, i, x, ...)  f(i, x), NSL__FOREACH_I67(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I69(f, i, x, ...)  f(i, x), NSL__FOREACH_I68(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I70(f, i, x, ...)  f(i, x), NSL__FOREACH_I69(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I71(f, i, x, ...)  f(i, x), NSL__FOREACH_I70(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I72(f, i, x, ...)  f(i, x), NSL__FOREACH_I71(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I73(f, i, x, ...)  f(i, x), NSL__FOREACH_I72(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I74(f, i, x, ...)  f(i, x), NSL__FOREACH_I73(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I75(f, i, x, ...)  f(i, x), NSL__FOREACH_I74(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I76(f, i, x, ...)  f(i, x), NSL__FOREACH_I75(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I77(f, i, x, ...)  f(i, x), NSL__FOREACH_I76(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I78(f, i, x, ...)  f(i, x), NSL__FOREACH_I77(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I79(f, i, x, ...)  f(i, x), NSL__FOREACH_I78(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I80(f, i, x, ...)  f(i, x), NSL__FOREACH_I79(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I81(f, i, x, ...)  f(i, x), NSL__FOREACH_I80(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I82(f, i, x, ...)  f(i, x), NSL__FOREACH_I81(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I83(f, i, x, ...)  f(i, x), NSL__FOREACH_I82(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I84(f, i, x, ...)  f(i, x), NSL__FOREACH_I83(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I85(f, i, x, ...)  f(i, x), NSL__FOREACH_I84(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I86(f, i, x, ...)  f(i, x), NSL__FOREACH_I85(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I87(f, i, x, ...)  f(i, x), NSL__FOREACH_I86(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I88(f, i, x, ...)  f(i, x), NSL__FOREACH_I87(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I89(f, i, x, ...)  f(i, x), NSL__FOREACH_I88(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I90(f, i, x, ...)  f(i, x), NSL__FOREACH_I89(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I91(f, i, x, ...)  f(i, x), NSL__FOREACH_I90(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I92(f, i, x, ...)  f(i, x), NSL__FOREACH_I91(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I93(f, i, x, ...)  f(i, x), NSL__FOREACH_I92(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I94(f, i, x, ...)  f(i, x), NSL__FOREACH_I93(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I95(f, i, x, ...)  f(i, x), NSL__FOREACH_I94(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I96(f, i, x, ...)  f(i, x), NSL__FOREACH_I95(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I97(f, i, x, ...)  f(i, x), NSL__FOREACH_I96(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I98(f, i, x, ...)  f(i, x), NSL__FOREACH_I97(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I99(f, i, x, ...)  f(i, x), NSL__FOREACH_I98(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I100(f, i, x, ...) f(i, x), NSL__FOREACH_I99(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I101(f, i, x, ...) f(i, x), NSL__FOREACH_I100(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I102(f, i, x, ...) f(i, x), NSL__FOREACH_I101(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I103(f, i, x, ...) f(i, x), NSL__FOREACH_I102(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I104(f, i, x, ...) f(i, x), NSL__FOREACH_I103(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I105(f, i, x, ...) f(i, x), NSL__FOREACH_I104(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I106(f, i, x, ...) f(i, x), NSL__FOREACH_I105(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I107(f, i, x, ...) f(i, x), NSL__FOREACH_I106(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I108(f, i, x, ...) f(i, x), NSL__FOREACH_I107(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I109(f, i, x, ...) f(i, x), NSL__FOREACH_I108(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I110(f, i, x, ...) f(i, x), NSL__FOREACH_I109(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I111(f, i, x, ...) f(i, x), NSL__FOREACH_I110(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I112(f, i, x, ...) f(i, x), NSL__FOREACH_I111(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I113(f, i, x, ...) f(i, x), NSL__FOREACH_I112(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I114(f, i, x, ...) f(i, x), NSL__FOREACH_I113(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I115(f, i, x, ...) f(i, x), NSL__FOREACH_I114(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I116(f, i, x, ...) f(i, x), NSL__FOREACH_I115(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I117(f, i, x, ...) f(i, x), NSL__FOREACH_I116(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I118(f, i, x, ...) f(i, x), NSL__FOREACH_I117(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I119(f, i, x, ...) f(i, x), NSL__FOREACH_I118(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I120(f, i, x, ...) f(i, x), NSL__FOREACH_I119(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I121(f, i, x, ...) f(i, x), NSL__FOREACH_I120(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I122(f, i, x, ...) f(i, x), NSL__FOREACH_I121(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I123(f, i, x, ...) f(i, x), NSL__FOREACH_I122(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I124(f, i, x, ...) f(i, x), NSL__FOREACH_I123(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I125(f, i, x, ...) f(i, x), NSL__FOREACH_I124(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I126(f, i, x, ...) f(i, x), NSL__FOREACH_I125(f, NSL__INC(i), __VA_ARGS__)
+#define NSL__FOREACH_I127(f, i, x, ...) f(i, x), NSL__FOREACH_I126(f, NSL__INC(i), __VA_ARGS__)
+
 /*!
  * Calls the function `f` with all arguments provided. This is done recusively,
  * taking the rest of the provided arguments each time. For example,
@@ -1237,18 +1668,20 @@
  * `NSL_FORALL_REST` requires two levels of indirection. This is to ensure that
  * passing a macro that expands to the variadic arguments works correctly and is
  * expanded. `NSL__FORALL_REST` concatentates `NSL__FORALL_REST` with the number
- * of arguments provided (using `NSL_NARGS`, which is restricted to [0-127]).
- * The corresponding macro is called and it applies the function to the current
- * list of arguments, pops the head, and then calls the next macro in the chain.
+ * of arguments provided. The corresponding macro is called and it applies the
+ * function to the current list of arguments, pops the head, and then calls the
+ * next macro in the chain. If there are more than 127 arguments, the head is
+ * popped one at a time using `NSL_DEFER` until the rest fit.
  *
  * # Arguments
  * - `f`: The name of a function, macro, etc.
  *
  * # Requires
  * - `f` accepts a variadic number of arguments and can be applied using `f(x)`.
- * - The number of arguments, N, is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - `f` does not expand to another `NSL_FORALL_REST` with more than 127
+ *   arguments.
+ * - The number of arguments, N, is less than roughly 200. Past 127 arguments,
+ *   each argument takes one step of `NSL_EVAL`.
  *
  * # Returns
  * The function `f` called with all arguments provided, recursing until there
@@ -1256,7 +1689,27 @@
  */
 #define NSL_FORALL_REST(f, ...) NSL__FORALL_REST(f, __VA_ARGS__)
 #define NSL__FORALL_REST(f, ...)                                                                   \
-    NSL_CAT(NSL__FORALL_REST, NSL_NARGS(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+    NSL_CAT(NSL__FORALL_REST_, NSL__ARGS_SIZE(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FORALL_REST_SMALL(f, ...)                                                             \
+    NSL_CAT(NSL__FORALL_REST, NSL__NARGS_SMALL(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FORALL_REST_LARGE(f, ...)                                                             \
+    NSL__FORALL_REST_EVAL(NSL__FORALL_REST_LOOP_LARGE(f, __VA_ARGS__))
+#define NSL__FORALL_REST_LOOP(f, ...)                                                              \
+    NSL_CAT(NSL__FORALL_REST_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(f, __VA_ARGS__)
+#define NSL__FORALL_REST_LOOP_ID() NSL__FORALL_REST_LOOP
+#define NSL__FORALL_REST_LOOP_SMALL(f, ...) NSL__FORALL_REST_SMALL(f, __VA_ARGS__)
+#define NSL__FORALL_REST_LOOP_LARGE(f, ...)                                                        \
+    f(__VA_ARGS__), NSL_DEFER(NSL__FORALL_REST_LOOP_ID)()(f, NSL_ARG_REST(__VA_ARGS__))
+#define NSL__FORALL_REST_EVAL(...)                                                                 \
+    NSL__FORALL_REST_EVAL3(                                                                        \
+        NSL__FORALL_REST_EVAL3(NSL__FORALL_REST_EVAL3(NSL__FORALL_REST_EVAL3(__VA_ARGS__))))
+#define NSL__FORALL_REST_EVAL3(...)                                                                \
+    NSL__FORALL_REST_EVAL2(                                                                        \
+        NSL__FORALL_REST_EVAL2(NSL__FORALL_REST_EVAL2(NSL__FORALL_REST_EVAL2(__VA_ARGS__))))
+#define NSL__FORALL_REST_EVAL2(...)                                                                \
+    NSL__FORALL_REST_EVAL1(                                                                        \
+        NSL__FORALL_REST_EVAL1(NSL__FORALL_REST_EVAL1(NSL__FORALL_REST_EVAL1(__VA_ARGS__))))
+#define NSL__FORALL_REST_EVAL1(...) __VA_ARGS__
 #define NSL__FORALL_REST0(f)
 #define NSL__FORALL_REST1(f, x)        f(x)
 #define NSL__FORALL_REST2(f, x, ...)   f(x, __VA_ARGS__), NSL__FORALL_REST1(f, __VA_ARGS__)
@@ -1395,19 +1848,21 @@
  * `NSL_FORALL_INIT` requires two levels of indirection. This is to ensure
  * that passing a macro that expands to the variadic arguments works correctly
  * and is expanded. `NSL__FORALL_INIT` concatentates `NSL__FORALL_INIT`
- * with the number of arguments provided (using `NSL_NARGS`, which is restricted
- * to [0-127]). The corresponding macro is called and it applies the function to
- * the current list of arguments, pops the tail, and then calls the next macro
- * in the chain.
+ * with the number of arguments provided. The corresponding macro is called and
+ * it applies the function to the current list of arguments, pops the tail, and
+ * then calls the next macro in the chain. If there are more than 127
+ * arguments, the tail is popped one at a time using `NSL_DEFER` until the rest
+ * fit.
  *
  * # Arguments
  * - `f`: The name of a function, macro, etc.
  *
  * # Requires
  * - `f` accepts a variadic number of arguments and can be applied using `f(x)`.
- * - The number of arguments, N, is less than 128. If 128 or more arguments are
- *   provided, a compile time error is likely to be generated. There is no
- *   guarantee of this, however.
+ * - `f` does not expand to another `NSL_FORALL_INIT` with more than 127
+ *   arguments.
+ * - The number of arguments, N, is less than roughly 200. Past 127 arguments,
+ *   each argument takes one step of `NSL_EVAL`.
  *
  * # Returns
  * The function `f` called with all arguments provided, recursing until there
@@ -1415,7 +1870,27 @@
  */
 #define NSL_FORALL_INIT(f, ...) NSL__FORALL_INIT(f, __VA_ARGS__)
 #define NSL__FORALL_INIT(f, ...)                                                                   \
-    NSL_CAT(NSL__FORALL_INIT, NSL_NARGS(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+    NSL_CAT(NSL__FORALL_INIT_, NSL__ARGS_SIZE(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FORALL_INIT_SMALL(f, ...)                                                             \
+    NSL_CAT(NSL__FORALL_INIT, NSL__NARGS_SMALL(__VA_ARGS__))(f __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FORALL_INIT_LARGE(f, ...)                                                             \
+    NSL__FORALL_INIT_EVAL(NSL__FORALL_INIT_LOOP_LARGE(f, __VA_ARGS__))
+#define NSL__FORALL_INIT_LOOP(f, ...)                                                              \
+    NSL_CAT(NSL__FORALL_INIT_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(f, __VA_ARGS__)
+#define NSL__FORALL_INIT_LOOP_ID() NSL__FORALL_INIT_LOOP
+#define NSL__FORALL_INIT_LOOP_SMALL(f, ...) NSL__FORALL_INIT_SMALL(f, __VA_ARGS__)
+#define NSL__FORALL_INIT_LOOP_LARGE(f, ...)                                                        \
+    f(__VA_ARGS__), NSL_DEFER(NSL__FORALL_INIT_LOOP_ID)()(f, NSL_ARG_INIT(__VA_ARGS__))
+#define NSL__FORALL_INIT_EVAL(...)                                                                 \
+    NSL__FORALL_INIT_EVAL3(                                                                        \
+        NSL__FORALL_INIT_EVAL3(NSL__FORALL_INIT_EVAL3(NSL__FORALL_INIT_EVAL3(__VA_ARGS__))))
+#define NSL__FORALL_INIT_EVAL3(...)                                                                \
+    NSL__FORALL_INIT_EVAL2(                                                                        \
+        NSL__FORALL_INIT_EVAL2(NSL__FORALL_INIT_EVAL2(NSL__FORALL_INIT_EVAL2(__VA_ARGS__))))
+#define NSL__FORALL_INIT_EVAL2(...)                                                                \
+    NSL__FORALL_INIT_EVAL1(                                                                        \
+        NSL__FORALL_INIT_EVAL1(NSL__FORALL_INIT_EVAL1(NSL__FORALL_INIT_EVAL1(__VA_ARGS__))))
+#define NSL__FORALL_INIT_EVAL1(...) __VA_ARGS__
 #define NSL__FORALL_INIT0(f)
 #define NSL__FORALL_INIT1(f, x)     f(x)
 #define NSL__FORALL_INIT2(f, ...)   f(__VA_ARGS__), NSL__FORALL_INIT1(f, NSL_ARG_INIT(__VA_ARGS__))
@@ -1572,4 +2047,725 @@
 #define NSL__FORALL_INIT127(f, ...)                                                                \
     f(__VA_ARGS__), NSL__FORALL_INIT126(f, NSL_ARG_INIT(__VA_ARGS__))
 
+/*!
+ * Folds the arguments provided from the left, using the function `f` and the
+ * initial value `init`. For example, `NSL_FOLD(f, 0, a, b, c)` would evaluate
+ * to `f(f(f(0, a), b), c)`. If no arguments are provided, it evaluates to
+ * `init`.
+ *
+ * `NSL_FOLD` requires two levels of indirection. This is to ensure that passing
+ * a macro that expands to the variadic arguments works correctly and is
+ * expanded. `NSL__FOLD` concatentates `NSL__FOLD` with the number of arguments
+ * provided. The corresponding macro is called and it applies the function to
+ * the accumulator and the current head, and then calls the next macro in the
+ * chain with the result as the new accumulator. If there are more than 127
+ * arguments, they are folded 127 arguments at a time.
+ *
+ * # Arguments
+ * - `f`: The name of a function, macro, etc.
+ * - `init`: The initial value of the accumulator.
+ *
+ * # Requires
+ * - `f` accepts two arguments and can be applied using `f(acc, x)`.
+ * - `init` and the result of `f` do not contain commas that are not enclosed
+ *   in parentheses.
+ * - `f` does not expand to another `NSL_FOLD` with more than 127 arguments.
+ * - The number of arguments, N, is less than roughly 10,000 (see `NSL_EVAL`).
+ *
+ * # Returns
+ * The result of folding all arguments provided with `f`.
+ */
+#define NSL_FOLD(f, init, ...) NSL__FOLD(f, init, __VA_ARGS__)
+#define NSL__FOLD(f, acc, ...)                                                                     \
+    NSL_CAT(NSL__FOLD_, NSL__ARGS_SIZE(__VA_ARGS__))(f, acc __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FOLD_SMALL(f, acc, ...)                                                               \
+    NSL_CAT(NSL__FOLD, NSL__NARGS_SMALL(__VA_ARGS__))(f, acc __VA_OPT__(, ) __VA_ARGS__)
+#define NSL__FOLD_LARGE(f, acc, ...) NSL__FOLD_EVAL(NSL__FOLD_LOOP_LARGE(f, acc, __VA_ARGS__))
+#define NSL__FOLD_LOOP(f, acc, ...)                                                                \
+    NSL_CAT(NSL__FOLD_LOOP_, NSL__ARGS_SIZE(__VA_ARGS__))(f, acc, __VA_ARGS__)
+#define NSL__FOLD_LOOP_ID() NSL__FOLD_LOOP
+#define NSL__FOLD_LOOP_SMALL(f, acc, ...) NSL__FOLD_SMALL(f, acc, __VA_ARGS__)
+#define NSL__FOLD_LOOP_LARGE(f, acc, ...)                                                          \
+    NSL_DEFER(NSL__FOLD_LOOP_ID)()                                                                 \
+    (f, NSL__FOLD_CHUNK(f, acc, NSL__ARG_TAKE127(__VA_ARGS__)), NSL__ARG_DROP127(__VA_ARGS__))
+#define NSL__FOLD_CHUNK(f, acc, ...) NSL__FOLD127(f, acc, __VA_ARGS__)
+#define NSL__FOLD_EVAL(...)                                                                        \
+    NSL__FOLD_EVAL3(NSL__FOLD_EVAL3(NSL__FOLD_EVAL3(NSL__FOLD_EVAL3(__VA_ARGS__))))
+#define NSL__FOLD_EVAL3(...)                                                                       \
+    NSL__FOLD_EVAL2(NSL__FOLD_EVAL2(NSL__FOLD_EVAL2(NSL__FOLD_EVAL2(__VA_ARGS__))))
+#define NSL__FOLD_EVAL2(...)                                                                       \
+    NSL__FOLD_EVAL1(NSL__FOLD_EVAL1(NSL__FOLD_EVAL1(NSL__FOLD_EVAL1(__VA_ARGS__))))
+#define NSL__FOLD_EVAL1(...) __VA_ARGS__
+#define NSL__FOLD0(f, acc)           acc
+#define NSL__FOLD1(f, acc, x)        f(acc, x)
+#define NSL__FOLD2(f, acc, x, ...)   NSL__FOLD1(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD3(f, acc, x, ...)   NSL__FOLD2(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD4(f, acc, x, ...)   NSL__FOLD3(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD5(f, acc, x, ...)   NSL__FOLD4(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD6(f, acc, x, ...)   NSL__FOLD5(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD7(f, acc, x, ...)   NSL__FOLD6(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD8(f, acc, x, ...)   NSL__FOLD7(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD9(f, acc, x, ...)   NSL__FOLD8(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD10(f, acc, x, ...)  NSL__FOLD9(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD11(f, acc, x, ...)  NSL__FOLD10(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD12(f, acc, x, ...)  NSL__FOLD11(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD13(f, acc, x, ...)  NSL__FOLD12(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD14(f, acc, x, ...)  NSL__FOLD13(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD15(f, acc, x, ...)  NSL__FOLD14(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD16(f, acc, x, ...)  NSL__FOLD15(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD17(f, acc, x, ...)  NSL__FOLD16(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD18(f, acc, x, ...)  NSL__FOLD17(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD19(f, acc, x, ...)  NSL__FOLD18(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD20(f, acc, x, ...)  NSL__FOLD19(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD21(f, acc, x, ...)  NSL__FOLD20(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD22(f, acc, x, ...)  NSL__FOLD21(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD23(f, acc, x, ...)  NSL__FOLD22(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD24(f, acc, x, ...)  NSL__FOLD23(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD25(f, acc, x, ...)  NSL__FOLD24(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD26(f, acc, x, ...)  NSL__FOLD25(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD27(f, acc, x, ...)  NSL__FOLD26(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD28(f, acc, x, ...)  NSL__FOLD27(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD29(f, acc, x, ...)  NSL__FOLD28(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD30(f, acc, x, ...)  NSL__FOLD29(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD31(f, acc, x, ...)  NSL__FOLD30(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD32(f, acc, x, ...)  NSL__FOLD31(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD33(f, acc, x, ...)  NSL__FOLD32(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD34(f, acc, x, ...)  NSL__FOLD33(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD35(f, acc, x, ...)  NSL__FOLD34(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD36(f, acc, x, ...)  NSL__FOLD35(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD37(f, acc, x, ...)  NSL__FOLD36(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD38(f, acc, x, ...)  NSL__FOLD37(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD39(f, acc, x, ...)  NSL__FOLD38(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD40(f, acc, x, ...)  NSL__FOLD39(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD41(f, acc, x, ...)  NSL__FOLD40(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD42(f, acc, x, ...)  NSL__FOLD41(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD43(f, acc, x, ...)  NSL__FOLD42(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD44(f, acc, x, ...)  NSL__FOLD43(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD45(f, acc, x, ...)  NSL__FOLD44(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD46(f, acc, x, ...)  NSL__FOLD45(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD47(f, acc, x, ...)  NSL__FOLD46(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD48(f, acc, x, ...)  NSL__FOLD47(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD49(f, acc, x, ...)  NSL__FOLD48(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD50(f, acc, x, ...)  NSL__FOLD49(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD51(f, acc, x, ...)  NSL__FOLD50(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD52(f, acc, x, ...)  NSL__FOLD51(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD53(f, acc, x, ...)  NSL__FOLD52(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD54(f, acc, x, ...)  NSL__FOLD53(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD55(f, acc, x, ...)  NSL__FOLD54(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD56(f, acc, x, ...)  NSL__FOLD55(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD57(f, acc, x, ...)  NSL__FOLD56(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD58(f, acc, x, ...)  NSL__FOLD57(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD59(f, acc, x, ...)  NSL__FOLD58(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD60(f, acc, x, ...)  NSL__FOLD59(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD61(f, acc, x, ...)  NSL__FOLD60(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD62(f, acc, x, ...)  NSL__FOLD61(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD63(f, acc, x, ...)  NSL__FOLD62(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD64(f, acc, x, ...)  NSL__FOLD63(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD65(f, acc, x, ...)  NSL__FOLD64(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD66(f, acc, x, ...)  NSL__FOLD65(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD67(f, acc, x, ...)  NSL__FOLD66(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD68(f, acc, x, ...)  NSL__FOLD67(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD69(f, acc, x, ...)  NSL__FOLD68(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD70(f, acc, x, ...)  NSL__FOLD69(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD71(f, acc, x, ...)  NSL__FOLD70(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD72(f, acc, x, ...)  NSL__FOLD71(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD73(f, acc, x, ...)  NSL__FOLD72(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD74(f, acc, x, ...)  NSL__FOLD73(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD75(f, acc, x, ...)  NSL__FOLD74(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD76(f, acc, x, ...)  NSL__FOLD75(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD77(f, acc, x, ...)  NSL__FOLD76(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD78(f, acc, x, ...)  NSL__FOLD77(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD79(f, acc, x, ...)  NSL__FOLD78(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD80(f, acc, x, ...)  NSL__FOLD79(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD81(f, acc, x, ...)  NSL__FOLD80(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD82(f, acc, x, ...)  NSL__FOLD81(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD83(f, acc, x, ...)  NSL__FOLD82(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD84(f, acc, x, ...)  NSL__FOLD83(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD85(f, acc, x, ...)  NSL__FOLD84(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD86(f, acc, x, ...)  NSL__FOLD85(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD87(f, acc, x, ...)  NSL__FOLD86(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD88(f, acc, x, ...)  NSL__FOLD87(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD89(f, acc, x, ...)  NSL__FOLD88(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD90(f, acc, x, ...)  NSL__FOLD89(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD91(f, acc, x, ...)  NSL__FOLD90(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD92(f, acc, x, ...)  NSL__FOLD91(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD93(f, acc, x, ...)  NSL__FOLD92(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD94(f, acc, x, ...)  NSL__FOLD93(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD95(f, acc, x, ...)  NSL__FOLD94(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD96(f, acc, x, ...)  NSL__FOLD95(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD97(f, acc, x, ...)  NSL__FOLD96(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD98(f, acc, x, ...)  NSL__FOLD97(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD99(f, acc, x, ...)  NSL__FOLD98(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD100(f, acc, x, ...) NSL__FOLD99(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD101(f, acc, x, ...) NSL__FOLD100(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD102(f, acc, x, ...) NSL__FOLD101(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD103(f, acc, x, ...) NSL__FOLD102(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD104(f, acc, x, ...) NSL__FOLD103(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD105(f, acc, x, ...) NSL__FOLD104(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD106(f, acc, x, ...) NSL__FOLD105(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD107(f, acc, x, ...) NSL__FOLD106(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD108(f, acc, x, ...) NSL__FOLD107(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD109(f, acc, x, ...) NSL__FOLD108(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD110(f, acc, x, ...) NSL__FOLD109(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD111(f, acc, x, ...) NSL__FOLD110(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD112(f, acc, x, ...) NSL__FOLD111(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD113(f, acc, x, ...) NSL__FOLD112(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD114(f, acc, x, ...) NSL__FOLD113(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD115(f, acc, x, ...) NSL__FOLD114(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD116(f, acc, x, ...) NSL__FOLD115(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD117(f, acc, x, ...) NSL__FOLD116(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD118(f, acc, x, ...) NSL__FOLD117(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD119(f, acc, x, ...) NSL__FOLD118(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD120(f, acc, x, ...) NSL__FOLD119(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD121(f, acc, x, ...) NSL__FOLD120(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD122(f, acc, x, ...) NSL__FOLD121(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD123(f, acc, x, ...) NSL__FOLD122(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD124(f, acc, x, ...) NSL__FOLD123(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD125(f, acc, x, ...) NSL__FOLD124(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD126(f, acc, x, ...) NSL__FOLD125(f, f(acc, x), __VA_ARGS__)
+#define NSL__FOLD127(f, acc, x, ...) NSL__FOLD126(f, f(acc, x), __VA_ARGS__)
+
+/*!
+ * Generates the integer literals from 0 up to, but not including, `n`. For
+ * example, `NSL_RANGE(4)` would evaluate to `0, 1, 2, 3`. This can be combined
+ * with `NSL_FOREACH` or `NSL_FOREACH_I` to generate lookup tables and unrolled
+ * loops.
+ *
+ * # Arguments
+ * - `n`: The number of integers to generate.
+ *
+ * # Requires
+ * - `n` is an integer literal, or a macro that expands to one, between 0 and
+ *   256 (inclusive) with no suffix.
+ *
+ * # Returns
+ * The comma separated integer literals from 0 to `n - 1`, or nothing if `n` is
+ * 0.
+ */
+#define NSL_RANGE(n) NSL_CAT(NSL__RANGE, n)
+#define NSL__RANGE0
+#define NSL__RANGE1   0
+#define NSL__RANGE2   NSL__RANGE1, 1
+#define NSL__RANGE3   NSL__RANGE2, 2
+#define NSL__RANGE4   NSL__RANGE3, 3
+#define NSL__RANGE5   NSL__RANGE4, 4
+#define NSL__RANGE6   NSL__RANGE5, 5
+#define NSL__RANGE7   NSL__RANGE6, 6
+#define NSL__RANGE8   NSL__RANGE7, 7
+#define NSL__RANGE9   NSL__RANGE8, 8
+#define NSL__RANGE10  NSL__RANGE9, 9
+#define NSL__RANGE11  NSL__RANGE10, 10
+#define NSL__RANGE12  NSL__RANGE11, 11
+#define NSL__RANGE13  NSL__RANGE12, 12
+#define NSL__RANGE14  NSL__RANGE13, 13
+#define NSL__RANGE15  NSL__RANGE14, 14
+#define NSL__RANGE16  NSL__RANGE15, 15
+#define NSL__RANGE17  NSL__RANGE16, 16
+#define NSL__RANGE18  NSL__RANGE17, 17
+#define NSL__RANGE19  NSL__RANGE18, 18
+#define NSL__RANGE20  NSL__RANGE19, 19
+#define NSL__RANGE21  NSL__RANGE20, 20
+#define NSL__RANGE22  NSL__RANGE21, 21
+#define NSL__RANGE23  NSL__RANGE22, 22
+#define NSL__RANGE24  NSL__RANGE23, 23
+#define NSL__RANGE25  NSL__RANGE24, 24
+#define NSL__RANGE26  NSL__RANGE25, 25
+#define NSL__RANGE27  NSL__RANGE26, 26
+#define NSL__RANGE28  NSL__RANGE27, 27
+#define NSL__RANGE29  NSL__RANGE28, 28
+#define NSL__RANGE30  NSL__RANGE29, 29
+#define NSL__RANGE31  NSL__RANGE30, 30
+#define NSL__RANGE32  NSL__RANGE31, 31
+#define NSL__RANGE33  NSL__RANGE32, 32
+#define NSL__RANGE34  NSL__RANGE33, 33
+#define NSL__RANGE35  NSL__RANGE34, 34
+#define NSL__RANGE36  NSL__RANGE35, 35
+#define NSL__RANGE37  NSL__RANGE36, 36
+#define NSL__RANGE38  NSL__RANGE37, 37
+#define NSL__RANGE39  NSL__RANGE38, 38
+#define NSL__RANGE40  NSL__RANGE39, 39
+#define NSL__RANGE41  NSL__RANGE40, 40
+#define NSL__RANGE42  NSL__RANGE41, 41
+#define NSL__RANGE43  NSL__RANGE42, 42
+#define NSL__RANGE44  NSL__RANGE43, 43
+#define NSL__RANGE45  NSL__RANGE44, 44
+#define NSL__RANGE46  NSL__RANGE45, 45
+#define NSL__RANGE47  NSL__RANGE46, 46
+#define NSL__RANGE48  NSL__RANGE47, 47
+#define NSL__RANGE49  NSL__RANGE48, 48
+#define NSL__RANGE50  NSL__RANGE49, 49
+#define NSL__RANGE51  NSL__RANGE50, 50
+#define NSL__RANGE52  NSL__RANGE51, 51
+#define NSL__RANGE53  NSL__RANGE52, 52
+#define NSL__RANGE54  NSL__RANGE53, 53
+#define NSL__RANGE55  NSL__RANGE54, 54
+#define NSL__RANGE56  NSL__RANGE55, 55
+#define NSL__RANGE57  NSL__RANGE56, 56
+#define NSL__RANGE58  NSL__RANGE57, 57
+#define NSL__RANGE59  NSL__RANGE58, 58
+#define NSL__RANGE60  NSL__RANGE59, 59
+#define NSL__RANGE61  NSL__RANGE60, 60
+#define NSL__RANGE62  NSL__RANGE61, 61
+#define NSL__RANGE63  NSL__RANGE62, 62
+#define NSL__RANGE64  NSL__RANGE63, 63
+#define NSL__RANGE65  NSL__RANGE64, 64
+#define NSL__RANGE66  NSL__RANGE65, 65
+#define NSL__RANGE67  NSL__RANGE66, 66
+#define NSL__RANGE68  NSL__RANGE67, 67
+#define NSL__RANGE69  NSL__RANGE68, 68
+#define NSL__RANGE70  NSL__RANGE69, 69
+#define NSL__RANGE71  NSL__RANGE70, 70
+#define NSL__RANGE72  NSL__RANGE71, 71
+#define NSL__RANGE73  NSL__RANGE72, 72
+#define NSL__RANGE74  NSL__RANGE73, 73
+#define NSL__RANGE75  NSL__RANGE74, 74
+#define NSL__RANGE76  NSL__RANGE75, 75
+#define NSL__RANGE77  NSL__RANGE76, 76
+#define NSL__RANGE78  NSL__RANGE77, 77
+#define NSL__RANGE79  NSL__RANGE78, 78
+#define NSL__RANGE80  NSL__RANGE79, 79
+#define NSL__RANGE81  NSL__RANGE80, 80
+#define NSL__RANGE82  NSL__RANGE81, 81
+#define NSL__RANGE83  NSL__RANGE82, 82
+#define NSL__RANGE84  NSL__RANGE83, 83
+#define NSL__RANGE85  NSL__RANGE84, 84
+#define NSL__RANGE86  NSL__RANGE85, 85
+#define NSL__RANGE87  NSL__RANGE86, 86
+#define NSL__RANGE88  NSL__RANGE87, 87
+#define NSL__RANGE89  NSL__RANGE88, 88
+#define NSL__RANGE90  NSL__RANGE89, 89
+#define NSL__RANGE91  NSL__RANGE90, 90
+#define NSL__RANGE92  NSL__RANGE91, 91
+#define NSL__RANGE93  NSL__RANGE92, 92
+#define NSL__RANGE94  NSL__RANGE93, 93
+#define NSL__RANGE95  NSL__RANGE94, 94
+#define NSL__RANGE96  NSL__RANGE95, 95
+#define NSL__RANGE97  NSL__RANGE96, 96
+#define NSL__RANGE98  NSL__RANGE97, 97
+#define NSL__RANGE99  NSL__RANGE98, 98
+#define NSL__RANGE100 NSL__RANGE99, 99
+#define NSL__RANGE101 NSL__RANGE100, 100
+#define NSL__RANGE102 NSL__RANGE101, 101
+#define NSL__RANGE103 NSL__RANGE102, 102
+#define NSL__RANGE104 NSL__RANGE103, 103
+#define NSL__RANGE105 NSL__RANGE104, 104
+#define NSL__RANGE106 NSL__RANGE105, 105
+#define NSL__RANGE107 NSL__RANGE106, 106
+#define NSL__RANGE108 NSL__RANGE107, 107
+#define NSL__RANGE109 NSL__RANGE108, 108
+#define NSL__RANGE110 NSL__RANGE109, 109
+#define NSL__RANGE111 NSL__RANGE110, 110
+#define NSL__RANGE112 NSL__RANGE111, 111
+#define NSL__RANGE113 NSL__RANGE112, 112
+#define NSL__RANGE114 NSL__RANGE113, 113
+#define NSL__RANGE115 NSL__RANGE114, 114
+#define NSL__RANGE116 NSL__RANGE115, 115
+#define NSL__RANGE117 NSL__RANGE116, 116
+#define NSL__RANGE118 NSL__RANGE117, 117
+#define NSL__RANGE119 NSL__RANGE118, 118
+#define NSL__RANGE120 NSL__RANGE119, 119
+#define NSL__RANGE121 NSL__RANGE120, 120
+#define NSL__RANGE122 NSL__RANGE121, 121
+#define NSL__RANGE123 NSL__RANGE122, 122
+#define NSL__RANGE124 NSL__RANGE123, 123
+#define NSL__RANGE125 NSL__RANGE124, 124
+#define NSL__RANGE126 NSL__RANGE125, 125
+#define NSL__RANGE127 NSL__RANGE126, 126
+#define NSL__RANGE128 NSL__RANGE127, 127
+#define NSL__RANGE129 NSL__RANGE128, 128
+#define NSL__RANGE130 NSL__RANGE129, 129
+#define NSL__RANGE131 NSL__RANGE130, 130
+#define NSL__RANGE132 NSL__RANGE131, 131
+#define NSL__RANGE133 NSL__RANGE132, 132
+#define NSL__RANGE134 NSL__RANGE133, 133
+#define NSL__RANGE135 NSL__RANGE134, 134
+#define NSL__RANGE136 NSL__RANGE135, 135
+#define NSL__RANGE137 NSL__RANGE136, 136
+#define NSL__RANGE138 NSL__RANGE137, 137
+#define NSL__RANGE139 NSL__RANGE138, 138
+#define NSL__RANGE140 NSL__RANGE139, 139
+#define NSL__RANGE141 NSL__RANGE140, 140
+#define NSL__RANGE142 NSL__RANGE141, 141
+#define NSL__RANGE143 NSL__RANGE142, 142
+#define NSL__RANGE144 NSL__RANGE143, 143
+#define NSL__RANGE145 NSL__RANGE144, 144
+#define NSL__RANGE146 NSL__RANGE145, 145
+#define NSL__RANGE147 NSL__RANGE146, 146
+#define NSL__RANGE148 NSL__RANGE147, 147
+#define NSL__RANGE149 NSL__RANGE148, 148
+#define NSL__RANGE150 NSL__RANGE149, 149
+#define NSL__RANGE151 NSL__RANGE150, 150
+#define NSL__RANGE152 NSL__RANGE151, 151
+#define NSL__RANGE153 NSL__RANGE152, 152
+#define NSL__RANGE154 NSL__RANGE153, 153
+#define NSL__RANGE155 NSL__RANGE154, 154
+#define NSL__RANGE156 NSL__RANGE155, 155
+#define NSL__RANGE157 NSL__RANGE156, 156
+#define NSL__RANGE158 NSL__RANGE157, 157
+#define NSL__RANGE159 NSL__RANGE158, 158
+#define NSL__RANGE160 NSL__RANGE159, 159
+#define NSL__RANGE161 NSL__RANGE160, 160
+#define NSL__RANGE162 NSL__RANGE161, 161
+#define NSL__RANGE163 NSL__RANGE162, 162
+#define NSL__RANGE164 NSL__RANGE163, 163
+#define NSL__RANGE165 NSL__RANGE164, 164
+#define NSL__RANGE166 NSL__RANGE165, 165
+#define NSL__RANGE167 NSL__RANGE166, 166
+#define NSL__RANGE168 NSL__RANGE167, 167
+#define NSL__RANGE169 NSL__RANGE168, 168
+#define NSL__RANGE170 NSL__RANGE169, 169
+#define NSL__RANGE171 NSL__RANGE170, 170
+#define NSL__RANGE172 NSL__RANGE171, 171
+#define NSL__RANGE173 NSL__RANGE172, 172
+#define NSL__RANGE174 NSL__RANGE173, 173
+#define NSL__RANGE175 NSL__RANGE174, 174
+#define NSL__RANGE176 NSL__RANGE175, 175
+#define NSL__RANGE177 NSL__RANGE176, 176
+#define NSL__RANGE178 NSL__RANGE177, 177
+#define NSL__RANGE179 NSL__RANGE178, 178
+#define NSL__RANGE180 NSL__RANGE179, 179
+#define NSL__RANGE181 NSL__RANGE180, 180
+#define NSL__RANGE182 NSL__RANGE181, 181
+#define NSL__RANGE183 NSL__RANGE182, 182
+#define NSL__RANGE184 NSL__RANGE183, 183
+#define NSL__RANGE185 NSL__RANGE184, 184
+#define NSL__RANGE186 NSL__RANGE185, 185
+#define NSL__RANGE187 NSL__RANGE186, 186
+#define NSL__RANGE188 NSL__RANGE187, 187
+#define NSL__RANGE189 NSL__RANGE188, 188
+#define NSL__RANGE190 NSL__RANGE189, 189
+#define NSL__RANGE191 NSL__RANGE190, 190
+#define NSL__RANGE192 NSL__RANGE191, 191
+#define NSL__RANGE193 NSL__RANGE192, 192
+#define NSL__RANGE194 NSL__RANGE193, 193
+#define NSL__RANGE195 NSL__RANGE194, 194
+#define NSL__RANGE196 NSL__RANGE195, 195
+#define NSL__RANGE197 NSL__RANGE196, 196
+#define NSL__RANGE198 NSL__RANGE197, 197
+#define NSL__RANGE199 NSL__RANGE198, 198
+#define NSL__RANGE200 NSL__RANGE199, 199
+#define NSL__RANGE201 NSL__RANGE200, 200
+#define NSL__RANGE202 NSL__RANGE201, 201
+#define NSL__RANGE203 NSL__RANGE202, 202
+#define NSL__RANGE204 NSL__RANGE203, 203
+#define NSL__RANGE205 NSL__RANGE204, 204
+#define NSL__RANGE206 NSL__RANGE205, 205
+#define NSL__RANGE207 NSL__RANGE206, 206
+#define NSL__RANGE208 NSL__RANGE207, 207
+#define NSL__RANGE209 NSL__RANGE208, 208
+#define NSL__RANGE210 NSL__RANGE209, 209
+#define NSL__RANGE211 NSL__RANGE210, 210
+#define NSL__RANGE212 NSL__RANGE211, 211
+#define NSL__RANGE213 NSL__RANGE212, 212
+#define NSL__RANGE214 NSL__RANGE213, 213
+#define NSL__RANGE215 NSL__RANGE214, 214
+#define NSL__RANGE216 NSL__RANGE215, 215
+#define NSL__RANGE217 NSL__RANGE216, 216
+#define NSL__RANGE218 NSL__RANGE217, 217
+#define NSL__RANGE219 NSL__RANGE218, 218
+#define NSL__RANGE220 NSL__RANGE219, 219
+#define NSL__RANGE221 NSL__RANGE220, 220
+#define NSL__RANGE222 NSL__RANGE221, 221
+#define NSL__RANGE223 NSL__RANGE222, 222
+#define NSL__RANGE224 NSL__RANGE223, 223
+#define NSL__RANGE225 NSL__RANGE224, 224
+#define NSL__RANGE226 NSL__RANGE225, 225
+#define NSL__RANGE227 NSL__RANGE226, 226
+#define NSL__RANGE228 NSL__RANGE227, 227
+#define NSL__RANGE229 NSL__RANGE228, 228
+#define NSL__RANGE230 NSL__RANGE229, 229
+#define NSL__RANGE231 NSL__RANGE230, 230
+#define NSL__RANGE232 NSL__RANGE231, 231
+#define NSL__RANGE233 NSL__RANGE232, 232
+#define NSL__RANGE234 NSL__RANGE233, 233
+#define NSL__RANGE235 NSL__RANGE234, 234
+#define NSL__RANGE236 NSL__RANGE235, 235
+#define NSL__RANGE237 NSL__RANGE236, 236
+#define NSL__RANGE238 NSL__RANGE237, 237
+#define NSL__RANGE239 NSL__RANGE238, 238
+#define NSL__RANGE240 NSL__RANGE239, 239
+#define NSL__RANGE241 NSL__RANGE240, 240
+#define NSL__RANGE242 NSL__RANGE241, 241
+#define NSL__RANGE243 NSL__RANGE242, 242
+#define NSL__RANGE244 NSL__RANGE243, 243
+#define NSL__RANGE245 NSL__RANGE244, 244
+#define NSL__RANGE246 NSL__RANGE245, 245
+#define NSL__RANGE247 NSL__RANGE246, 246
+#define NSL__RANGE248 NSL__RANGE247, 247
+#define NSL__RANGE249 NSL__RANGE248, 248
+#define NSL__RANGE250 NSL__RANGE249, 249
+#define NSL__RANGE251 NSL__RANGE250, 250
+#define NSL__RANGE252 NSL__RANGE251, 251
+#define NSL__RANGE253 NSL__RANGE252, 252
+#define NSL__RANGE254 NSL__RANGE253, 253
+#define NSL__RANGE255 NSL__RANGE254, 254
+#define NSL__RANGE256 NSL__RANGE255, 255
+
+/*
+ * Successor tables used to carry integer literals through the macros above. The
+ * increment table covers every index that `NSL_FOREACH_I` can produce, and
+ * `NSL__ADD127` covers the start of each chunk of 127 arguments.
+ */
+#define NSL__INC(i)    NSL_CAT(NSL__INC, i)
+#define NSL__ADD127(i) NSL_CAT(NSL__ADD127_, i)
+#define NSL__ADD127_0   127
+#define NSL__ADD127_127 254
+#define NSL__ADD127_254 381
+#define NSL__INC0   1
+#define NSL__INC1   2
+#define NSL__INC2   3
+#define NSL__INC3   4
+#define NSL__INC4   5
+#define NSL__INC5   6
+#define NSL__INC6   7
+#define NSL__INC7   8
+#define NSL__INC8   9
+#define NSL__INC9   10
+#define NSL__INC10  11
+#define NSL__INC11  12
+#define NSL__INC12  13
+#define NSL__INC13  14
+#define NSL__INC14  15
+#define NSL__INC15  16
+#define NSL__INC16  17
+#define NSL__INC17  18
+#define NSL__INC18  19
+#define NSL__INC19  20
+#define NSL__INC20  21
+#define NSL__INC21  22
+#define NSL__INC22  23
+#define NSL__INC23  24
+#define NSL__INC24  25
+#define NSL__INC25  26
+#define NSL__INC26  27
+#define NSL__INC27  28
+#define NSL__INC28  29
+#define NSL__INC29  30
+#define NSL__INC30  31
+#define NSL__INC31  32
+#define NSL__INC32  33
+#define NSL__INC33  34
+#define NSL__INC34  35
+#define NSL__INC35  36
+#define NSL__INC36  37
+#define NSL__INC37  38
+#define NSL__INC38  39
+#define NSL__INC39  40
+#define NSL__INC40  41
+#define NSL__INC41  42
+#define NSL__INC42  43
+#define NSL__INC43  44
+#define NSL__INC44  45
+#define NSL__INC45  46
+#define NSL__INC46  47
+#define NSL__INC47  48
+#define NSL__INC48  49
+#define NSL__INC49  50
+#define NSL__INC50  51
+#define NSL__INC51  52
+#define NSL__INC52  53
+#define NSL__INC53  54
+#define NSL__INC54  55
+#define NSL__INC55  56
+#define NSL__INC56  57
+#define NSL__INC57  58
+#define NSL__INC58  59
+#define NSL__INC59  60
+#define NSL__INC60  61
+#define NSL__INC61  62
+#define NSL__INC62  63
+#define NSL__INC63  64
+#define NSL__INC64  65
+#define NSL__INC65  66
+#define NSL__INC66  67
+#define NSL__INC67  68
+#define NSL__INC68  69
+#define NSL__INC69  70
+#define NSL__INC70  71
+#define NSL__INC71  72
+#define NSL__INC72  73
+#define NSL__INC73  74
+#define NSL__INC74  75
+#define NSL__INC75  76
+#define NSL__INC76  77
+#define NSL__INC77  78
+#define NSL__INC78  79
+#define NSL__INC79  80
+#define NSL__INC80  81
+#define NSL__INC81  82
+#define NSL__INC82  83
+#define NSL__INC83  84
+#define NSL__INC84  85
+#define NSL__INC85  86
+#define NSL__INC86  87
+#define NSL__INC87  88
+#define NSL__INC88  89
+#define NSL__INC89  90
+#define NSL__INC90  91
+#define NSL__INC91  92
+#define NSL__INC92  93
+#define NSL__INC93  94
+#define NSL__INC94  95
+#define NSL__INC95  96
+#define NSL__INC96  97
+#define NSL__INC97  98
+#define NSL__INC98  99
+#define NSL__INC99  100
+#define NSL__INC100 101
+#define NSL__INC101 102
+#define NSL__INC102 103
+#define NSL__INC103 104
+#define NSL__INC104 105
+#define NSL__INC105 106
+#define NSL__INC106 107
+#define NSL__INC107 108
+#define NSL__INC108 109
+#define NSL__INC109 110
+#define NSL__INC110 111
+#define NSL__INC111 112
+#define NSL__INC112 113
+#define NSL__INC113 114
+#define NSL__INC114 115
+#define NSL__INC115 116
+#define NSL__INC116 117
+#define NSL__INC117 118
+#define NSL__INC118 119
+#define NSL__INC119 120
+#define NSL__INC120 121
+#define NSL__INC121 122
+#define NSL__INC122 123
+#define NSL__INC123 124
+#define NSL__INC124 125
+#define NSL__INC125 126
+#define NSL__INC126 127
+#define NSL__INC127 128
+#define NSL__INC128 129
+#define NSL__INC129 130
+#define NSL__INC130 131
+#define NSL__INC131 132
+#define NSL__INC132 133
+#define NSL__INC133 134
+#define NSL__INC134 135
+#define NSL__INC135 136
+#define NSL__INC136 137
+#define NSL__INC137 138
+#define NSL__INC138 139
+#define NSL__INC139 140
+#define NSL__INC140 141
+#define NSL__INC141 142
+#define NSL__INC142 143
+#define NSL__INC143 144
+#define NSL__INC144 145
+#define NSL__INC145 146
+#define NSL__INC146 147
+#define NSL__INC147 148
+#define NSL__INC148 149
+#define NSL__INC149 150
+#define NSL__INC150 151
+#define NSL__INC151 152
+#define NSL__INC152 153
+#define NSL__INC153 154
+#define NSL__INC154 155
+#define NSL__INC155 156
+#define NSL__INC156 157
+#define NSL__INC157 158
+#define NSL__INC158 159
+#define NSL__INC159 160
+#define NSL__INC160 161
+#define NSL__INC161 162
+#define NSL__INC162 163
+#define NSL__INC163 164
+#define NSL__INC164 165
+#define NSL__INC165 166
+#define NSL__INC166 167
+#define NSL__INC167 168
+#define NSL__INC168 169
+#define NSL__INC169 170
+#define NSL__INC170 171
+#define NSL__INC171 172
+#define NSL__INC172 173
+#define NSL__INC173 174
+#define NSL__INC174 175
+#define NSL__INC175 176
+#define NSL__INC176 177
+#define NSL__INC177 178
+#define NSL__INC178 179
+#define NSL__INC179 180
+#define NSL__INC180 181
+#define NSL__INC181 182
+#define NSL__INC182 183
+#define NSL__INC183 184
+#define NSL__INC184 185
+#define NSL__INC185 186
+#define NSL__INC186 187
+#define NSL__INC187 188
+#define NSL__INC188 189
+#define NSL__INC189 190
+#define NSL__INC190 191
+#define NSL__INC191 192
+#define NSL__INC192 193
+#define NSL__INC193 194
+#define NSL__INC194 195
+#define NSL__INC195 196
+#define NSL__INC196 197
+#define NSL__INC197 198
+#define NSL__INC198 199
+#define NSL__INC199 200
+#define NSL__INC200 201
+#define NSL__INC201 202
+#define NSL__INC202 203
+#define NSL__INC203 204
+#define NSL__INC204 205
+#define NSL__INC205 206
+#define NSL__INC206 207
+#define NSL__INC207 208
+#define NSL__INC208 209
+#define NSL__INC209 210
+#define NSL__INC210 211
+#define NSL__INC211 212
+#define NSL__INC212 213
+#define NSL__INC213 214
+#define NSL__INC214 215
+#define NSL__INC215 216
+#define NSL__INC216 217
+#define NSL__INC217 218
+#define NSL__INC218 219
+#define NSL__INC219 220
+#define NSL__INC220 221
+#define NSL__INC221 222
+#define NSL__INC222 223
+#define NSL__INC223 224
+#define NSL__INC224 225
+#define NSL__INC225 226
+#define NSL__INC226 227
+#define NSL__INC227 228
+#define NSL__INC228 229
+#define NSL__INC229 230
+#define NSL__INC230 231
+#define NSL__INC231 232
+#define NSL__INC232 233
+#define NSL__INC233 234
+#define NSL__INC234 235
+#define NSL__INC235 236
+#define NSL__INC236 237
+#define NSL__INC237 238
+#define NSL__INC238 239
+#define NSL__INC239 240
+#define NSL__INC240 241
+#define NSL__INC241 242
+#define NSL__INC242 243
+#define NSL__INC243 244
+#define NSL__INC244 245
+#define NSL__INC245 246
+#define NSL__INC246 247
+#define NSL__INC247 248
+#define NSL__INC248 249
+#define NSL__INC249 250
+#define NSL__INC250 251
+#define NSL__INC251 252
+#define NSL__INC252 253
+#define NSL__INC253 254
+#define NSL__INC254 255
+#define NSL__INC255 256
+
 #endif  // NSL_MAGIC_H_
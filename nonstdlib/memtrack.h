@@ -0,0 +1,659 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * Allocation tracking for finding allocation hot spots without ASan or
+ * valgrind. When `NSL_MEMTRACK_ENABLE` is defined for every translation unit,
+ * `nsl_malloc`, `nsl_realloc` and `nsl_free` from `nonstdlib/common.h` are
+ * redirected to `nsl_memtrack_malloc`, `nsl_memtrack_realloc` and
+ * `nsl_memtrack_free`, which record the file and line of every call.
+ *
+ * For every call site, the number of allocations and frees, the number of
+ * bytes allocated and freed, the peak number of live bytes, and a histogram of
+ * how long its allocations lived are recorded. The counts and histograms are
+ * accumulated per thread and only combined when they are asked for with
+ * `nsl_memtrack_collect` or `nsl_memtrack_report`. Only the number of live
+ * bytes is shared between threads, so that the peak can be tracked.
+ *
+ * Each allocation is prefixed with a small header that records its size, call
+ * site and when it was made, so the underlying allocations are made with libc's
+ * `malloc`, `realloc` and `free`. A reallocation is recorded as a free of the
+ * old allocation and a new allocation at the call site of `nsl_realloc`.
+ *
+ * # Example
+ *
+ * ```c
+ * // compiled with -DNSL_MEMTRACK_ENABLE
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/memtrack.h"
+ *
+ * int main(void) {
+ *     char *buffer = nsl_malloc(4096);
+ *     // ...
+ *     nsl_free(buffer);
+ *     nsl_memtrack_report(stderr);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_MEMTRACK_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_MEMTRACK_ENABLE`: Defining this macro for every translation unit
+ *   redirects the allocation hooks in `nonstdlib/common.h` to this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_MEMTRACK_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_MEMTRACK_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ * - `NSL_MEMTRACK_MAX_SITES`: The maximum number of call sites that are
+ *   recorded separately.
+ */
+
+#ifndef NSL_MEMTRACK_H_
+#define NSL_MEMTRACK_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_MEMTRACK_VERSION_MAJOR 0
+#define NSL_MEMTRACK_VERSION_MINOR 1
+#define NSL_MEMTRACK_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_MEMTRACK_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_MEMTRACK_DEF
+#    define NSL_MEMTRACK_DEF
+#endif  // NSL_MEMTRACK_DEF
+
+/*!
+ * `NSL_MEMTRACK_MAX_SITES` is the maximum number of call sites that are
+ * recorded separately. Once it is reached, new call sites are combined into a
+ * single entry with the file `"(other)"`. Each thread that allocates uses a
+ * table of this many pointers.
+ */
+#ifndef NSL_MEMTRACK_MAX_SITES
+#    define NSL_MEMTRACK_MAX_SITES 1024
+#endif  // NSL_MEMTRACK_MAX_SITES
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+// The number of lifetime buckets. Bucket `i` holds the lifetimes that are
+// shorter than `2^i` nanoseconds but not shorter than `2^(i - 1)`.
+#define NSL__MEMTRACK_BUCKETS 64
+
+/*!
+ * The statistics of an allocation call site, combined across every thread.
+ */
+typedef struct NSL_MemtrackStats {
+    //! The file of the call site.
+    const char *file;
+    //! The line of the call site.
+    int line;
+    //! The number of allocations made at the call site.
+    uint64_t allocations;
+    //! The number of those allocations that have been freed.
+    uint64_t frees;
+    //! The total number of bytes allocated at the call site.
+    uint64_t bytes;
+    //! The number of those bytes that have been freed.
+    uint64_t freed_bytes;
+    //! The largest number of bytes from the call site that were live at once.
+    uint64_t peak_bytes;
+    //! The number of freed allocations in each lifetime bucket. Bucket `i`
+    //! holds lifetimes shorter than `2^i` nanoseconds.
+    uint64_t lifetimes[NSL__MEMTRACK_BUCKETS];
+} NSL_MemtrackStats;
+
+/*!
+ * Allocates memory and records the call site. This is what `nsl_malloc` calls
+ * when `NSL_MEMTRACK_ENABLE` is defined.
+ *
+ * # Parameters
+ * - `size`: The number of bytes to allocate.
+ * - `file`: The file of the call site.
+ * - `line`: The line of the call site.
+ *
+ * # Requires
+ * - `file` lives for the rest of the program, such as `__FILE__`.
+ *
+ * # Returns
+ * The allocated memory, or `nullptr` if the allocation failed.
+ */
+NSL_MEMTRACK_DEF void *nsl_memtrack_malloc(size_t size, const char *file, int line);
+
+/*!
+ * Reallocates memory and records the call site. This is what `nsl_realloc`
+ * calls when `NSL_MEMTRACK_ENABLE` is defined.
+ *
+ * # Parameters
+ * - `ptr`: The memory to reallocate, or `nullptr`.
+ * - `size`: The new number of bytes.
+ * - `file`: The file of the call site.
+ * - `line`: The line of the call site.
+ *
+ * # Requires
+ * - `ptr` was allocated by this module, or is `nullptr`.
+ * - `file` lives for the rest of the program, such as `__FILE__`.
+ *
+ * # Returns
+ * The reallocated memory, or `nullptr` if the reallocation failed, in which
+ * case `ptr` is not freed.
+ */
+NSL_MEMTRACK_DEF void *nsl_memtrack_realloc(void *ptr, size_t size, const char *file, int line);
+
+/*!
+ * Frees memory and records how long it lived. This is what `nsl_free` calls
+ * when `NSL_MEMTRACK_ENABLE` is defined.
+ *
+ * # Parameters
+ * - `ptr`: The memory to free, or `nullptr`.
+ *
+ * # Requires
+ * - `ptr` was allocated by this module, or is `nullptr`.
+ *
+ * # Aborts
+ * If `ptr` was not allocated by this module or has already been freed, which is
+ * detected on a best effort basis.
+ */
+NSL_MEMTRACK_DEF void nsl_memtrack_free(void *ptr);
+
+/*!
+ * Combines the statistics of every thread for each call site that has
+ * allocated. Threads may keep allocating while this runs, in which case their
+ * latest allocations may or may not be included.
+ *
+ * # Parameters
+ * - `stats`: Where the statistics are written.
+ * - `capacity`: The number of elements in `stats`.
+ *
+ * # Modifies
+ * - `stats`: The first `capacity` call sites, in the order they first
+ *   allocated, are written to it.
+ *
+ * # Returns
+ * The number of call sites that have allocated, which may be more than
+ * `capacity`.
+ */
+NSL_MEMTRACK_DEF size_t nsl_memtrack_collect(NSL_MemtrackStats *stats, size_t capacity);
+
+/*!
+ * Returns the number of bytes that are currently allocated.
+ *
+ * # Returns
+ * The number of live bytes across every call site.
+ */
+NSL_MEMTRACK_DEF uint64_t nsl_memtrack_live_bytes(void);
+
+/*!
+ * Returns the largest number of bytes that have been allocated at once.
+ *
+ * # Returns
+ * The peak number of live bytes across every call site.
+ */
+NSL_MEMTRACK_DEF uint64_t nsl_memtrack_peak_bytes(void);
+
+/*!
+ * Writes a table of the combined statistics of every call site, ordered from
+ * the most bytes allocated to the least.
+ *
+ * # Parameters
+ * - `file`: Where the table is written.
+ */
+NSL_MEMTRACK_DEF void nsl_memtrack_report(FILE *file);
+
+#endif  // NSL_MEMTRACK_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(MEMTRACK)
+#    ifndef NSL_MEMTRACK_IMPLEMENTATION_GUARD_
+#        define NSL_MEMTRACK_IMPLEMENTATION_GUARD_
+
+#        include <inttypes.h>
+#        include <stdatomic.h>
+#        include <stdlib.h>
+#        include <string.h>
+#        include <threads.h>
+#        include <time.h>
+
+// Placed in front of every allocation. The size is a multiple of the largest
+// alignment, so the allocation that follows it is still suitably aligned.
+typedef struct NSL__MemtrackHeader {
+    uint64_t size;
+    uint64_t time;
+    uint32_t site;
+    uint32_t magic;
+    uint64_t padding;
+} NSL__MemtrackHeader;
+
+static_assert(sizeof(NSL__MemtrackHeader) % alignof(max_align_t) == 0);
+
+#        define NSL__MEMTRACK_LIVE  0x6d656d74
+#        define NSL__MEMTRACK_FREED 0x66726565
+
+// The statistics of a call site for a single thread. Only the owning thread
+// writes them, so relaxed loads and stores are enough, and compile to plain
+// moves.
+typedef struct NSL__MemtrackSlot {
+    _Atomic uint64_t allocations;
+    _Atomic uint64_t frees;
+    _Atomic uint64_t bytes;
+    _Atomic uint64_t freed_bytes;
+    _Atomic uint64_t lifetimes[NSL__MEMTRACK_BUCKETS];
+} NSL__MemtrackSlot;
+
+// The statistics of every call site for a single thread. These are never freed,
+// so that the statistics of threads that have exited are still reported.
+typedef struct NSL__MemtrackThread NSL__MemtrackThread;
+struct NSL__MemtrackThread {
+    _Atomic(NSL__MemtrackSlot *) slots[NSL_MEMTRACK_MAX_SITES];
+    NSL__MemtrackThread         *next;
+};
+
+// A call site. `file` is published last, so that a site is only seen once its
+// line is set. The number of live bytes is shared between threads.
+typedef struct NSL__MemtrackSite {
+    _Atomic(const char *) file;
+    int                   line;
+    _Atomic uint64_t      live;
+    _Atomic uint64_t      peak;
+} NSL__MemtrackSite;
+
+// The call site that an entry of the table of sites was made for. This is not
+// the site that the entry refers to for call sites past the limit, which all
+// refer to the first site.
+typedef struct NSL__MemtrackKey {
+    const char *file;
+    int         line;
+} NSL__MemtrackKey;
+
+static struct {
+    once_flag                      once;
+    mtx_t                          mutex;
+    NSL__MemtrackSite              sites[NSL_MEMTRACK_MAX_SITES];
+    _Atomic uint32_t               table[2 * NSL_MEMTRACK_MAX_SITES];
+    NSL__MemtrackKey               keys[2 * NSL_MEMTRACK_MAX_SITES];
+    size_t                         entries;
+    _Atomic uint32_t               count;
+    _Atomic(NSL__MemtrackThread *) threads;
+    _Atomic uint64_t               live;
+    _Atomic uint64_t               peak;
+} g_nsl__memtrack = {.once = ONCE_FLAG_INIT};
+
+static thread_local NSL__MemtrackThread *g_nsl__memtrack_thread;
+
+static void nsl__memtrack_init(void) {
+    mtx_init(&g_nsl__memtrack.mutex, mtx_plain);
+    // The first site collects every call site past the limit.
+    g_nsl__memtrack.sites[0].line = 0;
+    atomic_store_explicit(&g_nsl__memtrack.sites[0].file, "(other)", memory_order_release);
+    atomic_store_explicit(&g_nsl__memtrack.count, 1, memory_order_release);
+}
+
+static uint64_t nsl__memtrack_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+static bool nsl__memtrack_matches(const NSL__MemtrackKey *key, const char *file, int line) {
+    return key->line == line && (key->file == file || strcmp(key->file, file) == 0);
+}
+
+// Returns the index of the call site. `table` is an open addressing hash table
+// of site indices plus one, keyed by line, which is only written while holding
+// the mutex, after the key of the entry. Files are compared by pointer first,
+// since `__FILE__` is almost always the same pointer for the same file.
+//
+// Call sites past the limit get entries as well, so that they find the first
+// site without taking the mutex, until only one entry is left empty to end
+// every probe.
+static uint32_t nsl__memtrack_site(const char *file, int line) {
+    call_once(&g_nsl__memtrack.once, nsl__memtrack_init);
+
+    const size_t mask  = 2 * NSL_MEMTRACK_MAX_SITES - 1;
+    size_t       start = ((size_t)line * 0x9e3779b97f4a7c15u >> 32) & mask;
+    for (size_t i = start;; i = (i + 1) & mask) {
+        uint32_t index = atomic_load_explicit(&g_nsl__memtrack.table[i], memory_order_acquire);
+        if (index == 0) { break; }
+        if (nsl__memtrack_matches(&g_nsl__memtrack.keys[i], file, line)) { return index - 1; }
+    }
+
+    mtx_lock(&g_nsl__memtrack.mutex);
+    uint32_t result = 0;
+    for (size_t i = start;; i = (i + 1) & mask) {
+        _Atomic uint32_t *entry = &g_nsl__memtrack.table[i];
+        uint32_t          index = atomic_load_explicit(entry, memory_order_relaxed);
+        if (index != 0) {
+            if (nsl__memtrack_matches(&g_nsl__memtrack.keys[i], file, line)) {
+                result = index - 1;
+                break;
+            }
+            continue;
+        }
+
+        uint32_t count = atomic_load_explicit(&g_nsl__memtrack.count, memory_order_relaxed);
+        if (count < NSL_MEMTRACK_MAX_SITES) {
+            NSL__MemtrackSite *site = &g_nsl__memtrack.sites[count];
+            site->line              = line;
+            atomic_store_explicit(&site->file, file, memory_order_release);
+            atomic_store_explicit(&g_nsl__memtrack.count, count + 1, memory_order_release);
+            result = count;
+        }
+        if (g_nsl__memtrack.entries + 1 < 2 * NSL_MEMTRACK_MAX_SITES) {
+            g_nsl__memtrack.keys[i] = (NSL__MemtrackKey){file, line};
+            g_nsl__memtrack.entries++;
+            atomic_store_explicit(entry, result + 1, memory_order_release);
+        }
+        break;
+    }
+    mtx_unlock(&g_nsl__memtrack.mutex);
+    return result;
+}
+
+// Returns the table of the current thread, allocating it the first time.
+static NSL__MemtrackThread *nsl__memtrack_thread(void) {
+    if (g_nsl__memtrack_thread != nullptr) { return g_nsl__memtrack_thread; }
+
+    NSL__MemtrackThread *thread = malloc(sizeof(*thread));
+    if (thread == nullptr) { return nullptr; }
+    for (size_t i = 0; i < NSL_MEMTRACK_MAX_SITES; i++) {
+        atomic_init(&thread->slots[i], nullptr);
+    }
+    thread->next = atomic_load_explicit(&g_nsl__memtrack.threads, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&g_nsl__memtrack.threads,
+                                                  &thread->next,
+                                                  thread,
+                                                  memory_order_release,
+                                                  memory_order_relaxed)) {}
+    g_nsl__memtrack_thread = thread;
+    return thread;
+}
+
+// Returns the statistics of a call site for the current thread, allocating
+// them the first time.
+static NSL__MemtrackSlot *nsl__memtrack_slot(uint32_t site) {
+    NSL__MemtrackThread *thread = nsl__memtrack_thread();
+    if (thread == nullptr) { return nullptr; }
+    NSL__MemtrackSlot *slot = atomic_load_explicit(&thread->slots[site], memory_order_relaxed);
+    if (slot != nullptr) { return slot; }
+
+    slot = malloc(sizeof(*slot));
+    if (slot == nullptr) { return nullptr; }
+    atomic_init(&slot->allocations, 0);
+    atomic_init(&slot->frees, 0);
+    atomic_init(&slot->bytes, 0);
+    atomic_init(&slot->freed_bytes, 0);
+    for (size_t i = 0; i < NSL__MEMTRACK_BUCKETS; i++) {
+        atomic_init(&slot->lifetimes[i], 0);
+    }
+    atomic_store_explicit(&thread->slots[site], slot, memory_order_release);
+    return slot;
+}
+
+// Adds to a value that only the current thread writes.
+static inline void nsl__memtrack_bump(_Atomic uint64_t *value, uint64_t amount) {
+    uint64_t current = atomic_load_explicit(value, memory_order_relaxed);
+    atomic_store_explicit(value, current + amount, memory_order_relaxed);
+}
+
+// Adds `size` live bytes, updating the peak if needed.
+static void nsl__memtrack_grow(_Atomic uint64_t *live, _Atomic uint64_t *peak, uint64_t size) {
+    uint64_t now  = atomic_fetch_add_explicit(live, size, memory_order_relaxed) + size;
+    uint64_t high = atomic_load_explicit(peak, memory_order_relaxed);
+    while (now > high
+           && !atomic_compare_exchange_weak_explicit(
+               peak, &high, now, memory_order_relaxed, memory_order_relaxed)) {}
+}
+
+static void nsl__memtrack_allocated(NSL__MemtrackHeader *header, size_t size, uint32_t site) {
+    *header = (NSL__MemtrackHeader){
+        .size  = size,
+        .time  = nsl__memtrack_now(),
+        .site  = site,
+        .magic = NSL__MEMTRACK_LIVE,
+    };
+    NSL__MemtrackSite *shared = &g_nsl__memtrack.sites[site];
+    nsl__memtrack_grow(&g_nsl__memtrack.live, &g_nsl__memtrack.peak, size);
+    nsl__memtrack_grow(&shared->live, &shared->peak, size);
+
+    NSL__MemtrackSlot *slot = nsl__memtrack_slot(site);
+    if (slot == nullptr) { return; }
+    nsl__memtrack_bump(&slot->allocations, 1);
+    nsl__memtrack_bump(&slot->bytes, size);
+}
+
+static void nsl__memtrack_check(NSL__MemtrackHeader *header) {
+    if (header->magic != NSL__MEMTRACK_LIVE) {
+        nsl_eprintf("[MEMTRACK] freeing memory that is not live: %p\n", (void *)(header + 1));
+        nsl_abort();
+    }
+}
+
+// Records that the allocation described by `header` was freed.
+static void nsl__memtrack_freed(const NSL__MemtrackHeader *header) {
+    NSL__MemtrackSite *shared = &g_nsl__memtrack.sites[header->site];
+    atomic_fetch_sub_explicit(&g_nsl__memtrack.live, header->size, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&shared->live, header->size, memory_order_relaxed);
+
+    NSL__MemtrackSlot *slot = nsl__memtrack_slot(header->site);
+    if (slot == nullptr) { return; }
+    uint64_t lifetime = nsl__memtrack_now() - header->time;
+    size_t   bucket   = lifetime == 0 ? 0 : (size_t)(64 - __builtin_clzll(lifetime));
+    nsl__memtrack_bump(&slot->frees, 1);
+    nsl__memtrack_bump(&slot->freed_bytes, header->size);
+    nsl__memtrack_bump(&slot->lifetimes[bucket < NSL__MEMTRACK_BUCKETS ? bucket : 63], 1);
+}
+
+NSL_MEMTRACK_DEF void *nsl_memtrack_malloc(size_t size, const char *file, int line) {
+    if (size > SIZE_MAX - sizeof(NSL__MemtrackHeader)) { return nullptr; }
+    NSL__MemtrackHeader *header = malloc(sizeof(*header) + size);
+    if (header == nullptr) { return nullptr; }
+    nsl__memtrack_allocated(header, size, nsl__memtrack_site(file, line));
+    return header + 1;
+}
+
+NSL_MEMTRACK_DEF void *nsl_memtrack_realloc(void *ptr, size_t size, const char *file, int line) {
+    if (ptr == nullptr) { return nsl_memtrack_malloc(size, file, line); }
+    if (size > SIZE_MAX - sizeof(NSL__MemtrackHeader)) { return nullptr; }
+
+    // The header is copied, since it cannot be read after a successful
+    // `realloc`. If `realloc` fails, the old allocation is left untouched.
+    NSL__MemtrackHeader *header = (NSL__MemtrackHeader *)ptr - 1;
+    nsl__memtrack_check(header);
+    NSL__MemtrackHeader  old    = *header;
+    NSL__MemtrackHeader *result = realloc(header, sizeof(*header) + size);
+    if (result == nullptr) { return nullptr; }
+    nsl__memtrack_freed(&old);
+    nsl__memtrack_allocated(result, size, nsl__memtrack_site(file, line));
+    return result + 1;
+}
+
+NSL_MEMTRACK_DEF void nsl_memtrack_free(void *ptr) {
+    if (ptr == nullptr) { return; }
+    NSL__MemtrackHeader *header = (NSL__MemtrackHeader *)ptr - 1;
+    nsl__memtrack_check(header);
+    header->magic = NSL__MEMTRACK_FREED;
+    nsl__memtrack_freed(header);
+    free(header);
+}
+
+NSL_MEMTRACK_DEF size_t nsl_memtrack_collect(NSL_MemtrackStats *stats, size_t capacity) {
+    uint32_t count = atomic_load_explicit(&g_nsl__memtrack.count, memory_order_acquire);
+    for (uint32_t i = 0; i < count && i < capacity; i++) {
+        NSL__MemtrackSite *site = &g_nsl__memtrack.sites[i];
+        NSL_MemtrackStats *out  = &stats[i];
+        *out = (NSL_MemtrackStats){
+            .file       = atomic_load_explicit(&site->file, memory_order_acquire),
+            .line       = site->line,
+            .peak_bytes = atomic_load_explicit(&site->peak, memory_order_relaxed),
+        };
+
+        NSL__MemtrackThread *thread =
+            atomic_load_explicit(&g_nsl__memtrack.threads, memory_order_acquire);
+        for (; thread != nullptr; thread = thread->next) {
+            NSL__MemtrackSlot *slot = atomic_load_explicit(&thread->slots[i], memory_order_acquire);
+            if (slot == nullptr) { continue; }
+            out->allocations += atomic_load_explicit(&slot->allocations, memory_order_relaxed);
+            out->frees       += atomic_load_explicit(&slot->frees, memory_order_relaxed);
+            out->bytes       += atomic_load_explicit(&slot->bytes, memory_order_relaxed);
+            out->freed_bytes += atomic_load_explicit(&slot->freed_bytes, memory_order_relaxed);
+            for (size_t j = 0; j < NSL__MEMTRACK_BUCKETS; j++) {
+                out->lifetimes[j] +=
+                    atomic_load_explicit(&slot->lifetimes[j], memory_order_relaxed);
+            }
+        }
+    }
+    return count;
+}
+
+NSL_MEMTRACK_DEF uint64_t nsl_memtrack_live_bytes(void) {
+    return atomic_load_explicit(&g_nsl__memtrack.live, memory_order_relaxed);
+}
+
+NSL_MEMTRACK_DEF uint64_t nsl_memtrack_peak_bytes(void) {
+    return atomic_load_explicit(&g_nsl__memtrack.peak, memory_order_relaxed);
+}
+
+static int nsl__memtrack_compare(const void *a, const void *b) {
+    uint64_t x = ((const NSL_MemtrackStats *)a)->bytes;
+    uint64_t y = ((const NSL_MemtrackStats *)b)->bytes;
+    return (x < y) - (x > y);
+}
+
+NSL_MEMTRACK_DEF void nsl_memtrack_report(FILE *file) {
+    NSL_MemtrackStats *stats = malloc(NSL_MEMTRACK_MAX_SITES * sizeof(*stats));
+    if (stats == nullptr) { return; }
+    size_t count = nsl_memtrack_collect(stats, NSL_MEMTRACK_MAX_SITES);
+    if (count > NSL_MEMTRACK_MAX_SITES) { count = NSL_MEMTRACK_MAX_SITES; }
+    qsort(stats, count, sizeof(*stats), nsl__memtrack_compare);
+
+    fprintf(file,
+            "live: %" PRIu64 " bytes, peak: %" PRIu64 " bytes\n",
+            nsl_memtrack_live_bytes(),
+            nsl_memtrack_peak_bytes());
+    fprintf(file,
+            "%12s %12s %14s %14s %14s %14s  %s\n",
+            "allocations",
+            "frees",
+            "bytes",
+            "live bytes",
+            "peak bytes",
+            "median life",
+            "location");
+    for (size_t i = 0; i < count && stats[i].allocations > 0; i++) {
+        NSL_MemtrackStats *s = &stats[i];
+
+        // The median lifetime is reported as the upper bound of its bucket.
+        uint64_t seen   = 0;
+        size_t   median = 0;
+        for (; median < NSL__MEMTRACK_BUCKETS; median++) {
+            seen += s->lifetimes[median];
+            if (seen > 0 && 2 * seen >= s->frees) { break; }
+        }
+        char life[32] = "-";
+        if (s->frees > 0) {
+            snprintf(life, sizeof(life), "<%.3gus", (double)(1ull << median) / 1e3);
+        }
+
+        fprintf(file,
+                "%12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %14" PRIu64 " %14" PRIu64
+                " %14s  %s:%d\n",
+                s->allocations,
+                s->frees,
+                s->bytes,
+                s->bytes - s->freed_bytes,
+                s->peak_bytes,
+                life,
+                s->file,
+                s->line);
+    }
+    free(stats);
+}
+
+#    endif  // NSL_MEMTRACK_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(MEMTRACK)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(MEMTRACK)
+#    ifndef NSL_MEMTRACK_STRIP_PREFIX_GUARD_
+#        define NSL_MEMTRACK_STRIP_PREFIX_GUARD_
+
+#        define MemtrackStats       NSL_MemtrackStats
+#        define memtrack_malloc     nsl_memtrack_malloc
+#        define memtrack_realloc    nsl_memtrack_realloc
+#        define memtrack_free       nsl_memtrack_free
+#        define memtrack_collect    nsl_memtrack_collect
+#        define memtrack_live_bytes nsl_memtrack_live_bytes
+#        define memtrack_peak_bytes nsl_memtrack_peak_bytes
+#        define memtrack_report     nsl_memtrack_report
+
+#    endif  // NSL_MEMTRACK_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(MEMTRACK)
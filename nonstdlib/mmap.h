@@ -0,0 +1,488 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * Read-only access to files through `mmap`. An opened file is exposed as an
+ * `NSL_StringView` of its bytes, so it can be scanned without copying any of
+ * it into a buffer. Files that are larger than the address space that should
+ * be spent on them can be mapped through a window of a fixed size, which is
+ * moved through the file with `nsl_mmap_seek`.
+ *
+ * `nsl_mmap_next_line` splits the file into lines, moving the window as
+ * needed so that a line is never split between two windows. Each line is a
+ * view into the mapping, and newlines are found 64 bytes at a time, as four
+ * SSE2 or two AVX2 vectors, when the compiler targets them.
+ *
+ * The kernel can be told how the file will be read with `NSL_MmapAdvice`,
+ * which is passed to `madvise` for every window. `NSL_MMAP_SEQUENTIAL` reads
+ * ahead more aggressively and frees pages once they have been read,
+ * `NSL_MMAP_WILLNEED` starts reading the whole window right away and
+ * `NSL_MMAP_HUGEPAGE` asks for transparent huge pages, which cut the number
+ * of page faults and TLB misses on large files if the file system supports
+ * them for the page cache. Advice that the kernel does not support is
+ * ignored.
+ *
+ * This module is Linux only, and needs `_DEFAULT_SOURCE` (or `_GNU_SOURCE`)
+ * to be defined before any header is included.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _DEFAULT_SOURCE
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/mmap.h"
+ *
+ * int main() {
+ *     NSL_MmapFile file;
+ *     NSL_MmapConfig config = {.window = 64 << 20, .advice = NSL_MMAP_SEQUENTIAL};
+ *     if (!nsl_mmap_open(&file, "huge.log", &config)) { return 1; }
+ *
+ *     NSL_StringView line;
+ *     size_t         errors = 0;
+ *     while (nsl_mmap_next_line(&file, &line)) {
+ *         if (line.length >= 5 && memcmp(line.data, "ERROR", 5) == 0) { errors++; }
+ *     }
+ *
+ *     nsl_mmap_close(&file);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_MMAP_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_MMAP_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_MMAP_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_MMAP_HUGE_PAGE_SIZE`: The size of a huge page, which windows are
+ *   rounded up to when `NSL_MMAP_HUGEPAGE` is given.
+ */
+
+#ifndef NSL_MMAP_H_
+#define NSL_MMAP_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_MMAP_VERSION_MAJOR 0
+#define NSL_MMAP_VERSION_MINOR 1
+#define NSL_MMAP_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_MMAP_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_MMAP_DEF
+#    define NSL_MMAP_DEF
+#endif  // NSL_MMAP_DEF
+
+/*!
+ * `NSL_MMAP_HUGE_PAGE_SIZE` is the size of a huge page. Windows are rounded up
+ * to a multiple of it when `NSL_MMAP_HUGEPAGE` is given, so that every window
+ * can be backed by whole huge pages.
+ */
+#ifndef NSL_MMAP_HUGE_PAGE_SIZE
+#    define NSL_MMAP_HUGE_PAGE_SIZE ((size_t)2 << 20)
+#endif  // NSL_MMAP_HUGE_PAGE_SIZE
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * How a mapped file will be read. The values are flags that can be combined
+ * with `|`, except for `NSL_MMAP_SEQUENTIAL` and `NSL_MMAP_RANDOM`.
+ */
+typedef enum NSL_MmapAdvice {
+    //! No advice, the kernel's default read ahead is used.
+    NSL_MMAP_NORMAL = 0,
+    //! The file is read from front to back, once.
+    NSL_MMAP_SEQUENTIAL = 1 << 0,
+    //! The file is read in no particular order, so reading ahead is wasted.
+    NSL_MMAP_RANDOM = 1 << 1,
+    //! All of a window will be read soon, so it is read in as soon as it is
+    //! mapped.
+    NSL_MMAP_WILLNEED = 1 << 2,
+    //! Map the file with transparent huge pages if possible.
+    NSL_MMAP_HUGEPAGE = 1 << 3,
+} NSL_MmapAdvice;
+
+/*!
+ * How a file is mapped. Fields that are zero use their defaults.
+ */
+typedef struct NSL_MmapConfig {
+    //! The number of bytes that are mapped at once, which is rounded up to a
+    //! multiple of the page size. Defaults to the whole file.
+    size_t window;
+    //! The `NSL_MmapAdvice` flags for every window. Defaults to
+    //! `NSL_MMAP_NORMAL`.
+    unsigned advice;
+} NSL_MmapConfig;
+
+/*!
+ * A file that is mapped into memory, one window at a time.
+ */
+typedef struct NSL_MmapFile {
+    //! The bytes of the file that are currently mapped, starting at `offset`.
+    //! They are only valid until the window is moved.
+    NSL_StringView view;
+    //! The offset of `view` in the file.
+    uint64_t offset;
+    //! The size of the file.
+    uint64_t size;
+    //! Private: The file descriptor of the file.
+    int fd;
+    //! Private: The address and length of the mapping, which starts at a page
+    //! boundary at or before `offset`.
+    char  *base;
+    size_t mapped;
+    //! Private: The number of bytes that are mapped after `offset`, or zero to
+    //! map the whole file.
+    size_t window;
+    //! Private: The `NSL_MmapAdvice` flags for every window.
+    unsigned advice;
+    //! Private: The position in `view` of the next line.
+    size_t cursor;
+} NSL_MmapFile;
+
+/*!
+ * Opens a file and maps its first window.
+ *
+ * # Parameters
+ * - `file`: The file to initialize.
+ * - `path`: The path of the file to open.
+ * - `config`: How the file is mapped, or `nullptr` for the defaults.
+ *
+ * # Modifies
+ * - `file`: It is initialized.
+ * - `errno`: It is set if the file could not be opened or mapped.
+ *
+ * # Returns
+ * Whether the file could be opened and mapped. If not, `file` is not
+ * initialized.
+ */
+NSL_MMAP_DEF bool nsl_mmap_open(NSL_MmapFile *file, const char *path, const NSL_MmapConfig *config);
+
+/*!
+ * Unmaps and closes a file.
+ *
+ * # Parameters
+ * - `file`: The file to close.
+ *
+ * # Requires
+ * - `file` is initialized.
+ *
+ * # Modifies
+ * - `file`: It is no longer initialized, and every view into it is invalid.
+ */
+NSL_MMAP_DEF void nsl_mmap_close(NSL_MmapFile *file);
+
+/*!
+ * Moves the window so that it starts at `offset`, and restarts
+ * `nsl_mmap_next_line` from there. When the whole file is mapped, this only
+ * moves the start of `file->view`.
+ *
+ * # Parameters
+ * - `file`: The file whose window is moved.
+ * - `offset`: The offset in the file of the first byte of the window.
+ *
+ * # Requires
+ * - `file` is initialized.
+ * - `offset` is at most `file->size`.
+ *
+ * # Modifies
+ * - `file`: Its view starts at `offset`. Views into the previous window are
+ *   invalid if it was unmapped.
+ * - `errno`: It is set if the window could not be mapped.
+ *
+ * # Returns
+ * Whether the window could be mapped. If not, `file->view` is empty.
+ */
+NSL_MMAP_DEF bool nsl_mmap_seek(NSL_MmapFile *file, uint64_t offset);
+
+/*!
+ * Returns the next line of a file, without its newline. The last line is
+ * returned even if it does not end with a newline.
+ *
+ * # Parameters
+ * - `file`: The file to read.
+ * - `line`: Where the line is stored.
+ *
+ * # Requires
+ * - `file` is initialized.
+ *
+ * # Modifies
+ * - `file`: The window is moved forward when the line does not fit in the
+ *   rest of it, and grown when the line is longer than the window. Views
+ *   into the previous window are invalid if it was unmapped.
+ * - `line`: It is set to a view of the line in the mapping.
+ *
+ * # Aborts
+ * - If the window cannot be moved, e.g. because the file was truncated.
+ *
+ * # Returns
+ * Whether there was another line.
+ */
+NSL_MMAP_DEF bool nsl_mmap_next_line(NSL_MmapFile *file, NSL_StringView *line);
+
+/*!
+ * Finds the first newline in `length` bytes at `data`, like `memchr`.
+ *
+ * # Parameters
+ * - `data`: The bytes to search.
+ * - `length`: The number of bytes to search.
+ *
+ * # Returns
+ * The address of the first newline, or `nullptr` if there is none.
+ */
+NSL_MMAP_DEF const char *nsl_mmap_find_newline(const char *data, size_t length);
+
+#endif  // NSL_MMAP_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(MMAP)
+#    ifndef NSL_MMAP_IMPLEMENTATION_GUARD_
+#        define NSL_MMAP_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <fcntl.h>
+#        include <string.h>
+#        include <sys/mman.h>
+#        include <sys/stat.h>
+#        include <unistd.h>
+
+#        if defined(__AVX2__) || defined(__SSE2__)
+#            include <immintrin.h>
+#        endif
+
+// Maps `file->window` bytes of the file from `offset`, or the whole file if
+// there is no window, and points the view at `offset`.
+static bool nsl__mmap_map(NSL_MmapFile *file, uint64_t offset) {
+    uint64_t page  = (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t start = file->window == 0 ? 0 : offset / page * page;
+    uint64_t end   = file->window == 0 ? file->size : offset + file->window;
+    if (end > file->size) { end = file->size; }
+
+    if (file->base != nullptr) { munmap(file->base, file->mapped); }
+    file->base   = nullptr;
+    file->mapped = 0;
+    file->offset = offset;
+    file->view   = (NSL_StringView){"", 0};
+    file->cursor = 0;
+    if (end == start) { return true; }
+
+    size_t length = (size_t)(end - start);
+    void  *base   = mmap(nullptr, length, PROT_READ, MAP_SHARED, file->fd, (off_t)start);
+    if (base == MAP_FAILED) { return false; }
+    file->base   = base;
+    file->mapped = length;
+    file->view   = (NSL_StringView){file->base + (offset - start), (size_t)(end - offset)};
+
+    // advice is only a hint, so failures (e.g. no huge pages for this file
+    // system) are ignored
+    if (file->advice & NSL_MMAP_SEQUENTIAL) { madvise(base, file->mapped, MADV_SEQUENTIAL); }
+    if (file->advice & NSL_MMAP_RANDOM) { madvise(base, file->mapped, MADV_RANDOM); }
+    if (file->advice & NSL_MMAP_WILLNEED) { madvise(base, file->mapped, MADV_WILLNEED); }
+#        if defined(MADV_HUGEPAGE)
+    if (file->advice & NSL_MMAP_HUGEPAGE) { madvise(base, file->mapped, MADV_HUGEPAGE); }
+#        endif
+    return true;
+}
+
+NSL_MMAP_DEF bool
+nsl_mmap_open(NSL_MmapFile *file, const char *path, const NSL_MmapConfig *config) {
+    NSL_MmapConfig defaults = {};
+    if (config == nullptr) { config = &defaults; }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { return false; }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t page   = (size_t)sysconf(_SC_PAGESIZE);
+    size_t window = config->window;
+    if (window != 0 && (config->advice & NSL_MMAP_HUGEPAGE)) { page = NSL_MMAP_HUGE_PAGE_SIZE; }
+    window = (window + page - 1) / page * page;
+
+    *file = (NSL_MmapFile){
+        .size   = (uint64_t)status.st_size,
+        .fd     = fd,
+        .window = window,
+        .advice = config->advice,
+    };
+    if (!nsl__mmap_map(file, 0)) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+NSL_MMAP_DEF void nsl_mmap_close(NSL_MmapFile *file) {
+    if (file->base != nullptr) { munmap(file->base, file->mapped); }
+    close(file->fd);
+}
+
+NSL_MMAP_DEF bool nsl_mmap_seek(NSL_MmapFile *file, uint64_t offset) {
+    if (file->window == 0) {
+        size_t length = (size_t)(file->size - offset);
+        file->view    = (NSL_StringView){length == 0 ? "" : file->base + offset, length};
+        file->offset  = offset;
+        file->cursor = 0;
+        return true;
+    }
+    return nsl__mmap_map(file, offset);
+}
+
+NSL_MMAP_DEF bool nsl_mmap_next_line(NSL_MmapFile *file, NSL_StringView *line) {
+    while (true) {
+        const char *start   = file->view.data + file->cursor;
+        size_t      left    = file->view.length - file->cursor;
+        const char *newline = nsl_mmap_find_newline(start, left);
+        if (newline != nullptr) {
+            *line         = (NSL_StringView){start, (size_t)(newline - start)};
+            file->cursor += line->length + 1;
+            return true;
+        }
+        if (file->offset + file->view.length == file->size) {
+            if (left == 0) { return false; }
+            *line        = (NSL_StringView){start, left};
+            file->cursor = file->view.length;
+            return true;
+        }
+
+        // the line continues past the window, so the window is moved to start
+        // at the line, and doubled if the line already started the window
+        if (file->cursor == 0) { file->window *= 2; }
+        if (!nsl__mmap_map(file, file->offset + file->cursor)) {
+            nsl_eprintf("[MMAP] failed to map window: %s\n", strerror(errno));
+            nsl_abort();
+        }
+    }
+}
+
+NSL_MMAP_DEF const char *nsl_mmap_find_newline(const char *data, size_t length) {
+    size_t i = 0;
+#        if defined(__AVX2__)
+    __m256i newline = _mm256_set1_epi8('\n');
+    for (; i + 64 <= length; i += 64) {
+        const __m256i *chunk = (const void *)(data + i);
+        __m256i        a     = _mm256_cmpeq_epi8(_mm256_loadu_si256(chunk), newline);
+        __m256i        b     = _mm256_cmpeq_epi8(_mm256_loadu_si256(chunk + 1), newline);
+        uint64_t mask = (uint32_t)_mm256_movemask_epi8(a)
+                      | (uint64_t)(uint32_t)_mm256_movemask_epi8(b) << 32;
+        if (mask != 0) { return data + i + __builtin_ctzll(mask); }
+    }
+#        elif defined(__SSE2__)
+    // four vectors at a time, so that the loop is not bound by the branch on
+    // every 16 bytes
+    __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 64 <= length; i += 64) {
+        const __m128i *chunk = (const void *)(data + i);
+        __m128i        a     = _mm_cmpeq_epi8(_mm_loadu_si128(chunk), newline);
+        __m128i        b     = _mm_cmpeq_epi8(_mm_loadu_si128(chunk + 1), newline);
+        __m128i        c     = _mm_cmpeq_epi8(_mm_loadu_si128(chunk + 2), newline);
+        __m128i        d     = _mm_cmpeq_epi8(_mm_loadu_si128(chunk + 3), newline);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) {
+            uint64_t mask = (uint16_t)_mm_movemask_epi8(a)
+                          | (uint64_t)(uint16_t)_mm_movemask_epi8(b) << 16
+                          | (uint64_t)(uint16_t)_mm_movemask_epi8(c) << 32
+                          | (uint64_t)(uint16_t)_mm_movemask_epi8(d) << 48;
+            return data + i + __builtin_ctzll(mask);
+        }
+    }
+#        endif
+    return length == i ? nullptr : memchr(data + i, '\n', length - i);
+}
+
+#    endif  // NSL_MMAP_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(MMAP)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(MMAP)
+#    ifndef NSL_MMAP_STRIP_PREFIX_GUARD_
+#        define NSL_MMAP_STRIP_PREFIX_GUARD_
+
+#        define MmapAdvice        NSL_MmapAdvice
+#        define MMAP_NORMAL       NSL_MMAP_NORMAL
+#        define MMAP_SEQUENTIAL   NSL_MMAP_SEQUENTIAL
+#        define MMAP_RANDOM       NSL_MMAP_RANDOM
+#        define MMAP_WILLNEED     NSL_MMAP_WILLNEED
+#        define MMAP_HUGEPAGE     NSL_MMAP_HUGEPAGE
+#        define MmapConfig        NSL_MmapConfig
+#        define MmapFile          NSL_MmapFile
+#        define mmap_open         nsl_mmap_open
+#        define mmap_close        nsl_mmap_close
+#        define mmap_seek         nsl_mmap_seek
+#        define mmap_next_line    nsl_mmap_next_line
+#        define mmap_find_newline nsl_mmap_find_newline
+
+#    endif  // NSL_MMAP_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(MMAP)
@@ -0,0 +1,542 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * Perfect hashing for static sets of keys, such as the keywords of a parser.
+ * A perfect hash maps every key in the set to its own slot, so a lookup is a
+ * single hash and a single comparison, regardless of the number of keys.
+ *
+ * Searching for a perfect hash function cannot be done by the preprocessor, so
+ * the tables are generated by a small program that is run as part of the build.
+ * `NSL_PHASH_GENERATOR` defines the `main` function for that program, which
+ * prints the tables as constants. The generated file is then included wherever
+ * the lookup is needed, so there is no cost at startup. `nsl_phash_build` can
+ * also be used to build the tables at runtime instead.
+ *
+ * The tables use the hash and displace scheme. Each key is hashed once. The
+ * upper half of the hash picks a bucket, and each bucket stores a seed that is
+ * mixed with the lower half of the hash to pick the slot of the key. The seeds
+ * are chosen by the generator so that no two keys share a slot.
+ *
+ * # Example
+ *
+ * The generator, `keywords.c`:
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/phash.h"
+ *
+ * NSL_PHASH_GENERATOR(keywords, "GET", "PUT", "POST", "DELETE")
+ * ```
+ *
+ * The rule to generate the tables, in a `makefile`:
+ *
+ * ```make
+ * keywords.h: keywords.c nonstdlib/phash.h
+ *     $(CC) -std=c23 -I. keywords.c -o keywords && ./keywords > keywords.h
+ * ```
+ *
+ * Using the tables:
+ *
+ * ```c
+ * #include "nonstdlib/phash.h"
+ * #include "keywords.h"
+ *
+ * size_t method = nsl_phash_find(&keywords, token, token_length);
+ * if (method == NSL_PHASH_NOT_FOUND) {
+ *     // not a keyword
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_PHASH_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_PHASH_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_PHASH_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static` or `static inline`).
+ */
+
+#ifndef NSL_PHASH_H_
+#define NSL_PHASH_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_PHASH_VERSION_MAJOR 0
+#define NSL_PHASH_VERSION_MINOR 1
+#define NSL_PHASH_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_PHASH_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_PHASH_DEF
+#    define NSL_PHASH_DEF
+#endif  // NSL_PHASH_DEF
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * The value returned by `nsl_phash_find` when the key is not in the set.
+ */
+#define NSL_PHASH_NOT_FOUND SIZE_MAX
+
+/*!
+ * The tables for a perfect hash of a static set of keys. These are either
+ * generated as constants using `nsl_phash_write`, or built at runtime using
+ * `nsl_phash_build`.
+ */
+typedef struct NSL_PerfectHash {
+    //! The keys in the set. The index of a key is its position in this array.
+    const char *const *keys;
+    //! The length of each key, in bytes.
+    const uint32_t *lengths;
+    //! The number of keys in the set.
+    uint32_t count;
+    //! The seed for each bucket, used to pick the slot of its keys.
+    const uint32_t *seeds;
+    //! The number of buckets.
+    uint32_t buckets;
+    //! The index of the key in each slot. Empty slots hold any valid index.
+    const uint32_t *slots;
+    //! The number of slots.
+    uint32_t size;
+} NSL_PerfectHash;
+
+/*!
+ * Defines a `main` function that builds the perfect hash for the keys provided
+ * and writes its tables to `stdout` using `nsl_phash_write`. The program exits
+ * with failure if the tables could not be built or written.
+ *
+ * # Parameters
+ * - `name`: The name of the generated `NSL_PerfectHash` constant.
+ * - `...`: The keys, as string literals.
+ *
+ * # Requires
+ * - `name` is a valid identifier.
+ * - There is at least one key and no key appears more than once.
+ */
+#define NSL_PHASH_GENERATOR(name, ...)                                                             \
+    int main(void) {                                                                               \
+        static const char *const keys[] = {__VA_ARGS__};                                           \
+        NSL_PerfectHash          ph;                                                               \
+        if (!nsl_phash_build(&ph, keys, nsl_carrlen(keys))) { return 1; }                          \
+        bool ok = nsl_phash_write(stdout, #name, &ph);                                             \
+        nsl_phash_free(&ph);                                                                       \
+        return ok ? 0 : 1;                                                                         \
+    }
+
+/*!
+ * Finds the index of `key` in the set of keys of `ph`.
+ *
+ * # Parameters
+ * - `ph`: The perfect hash to search.
+ * - `key`: The key to search for. It does not need to be null terminated.
+ * - `length`: The length of `key`, in bytes.
+ *
+ * # Requires
+ * - `ph` is a perfect hash generated by `nsl_phash_write` or built by
+ *   `nsl_phash_build`.
+ * - `key` points to at least `length` bytes.
+ *
+ * # Returns
+ * The index of `key` in `ph->keys`, or `NSL_PHASH_NOT_FOUND` if it is not one
+ * of the keys.
+ */
+NSL_PHASH_DEF size_t nsl_phash_find(const NSL_PerfectHash *ph, const char *key, size_t length);
+
+/*!
+ * Builds the perfect hash for the set of `keys`. The tables are allocated with
+ * `nsl_malloc`, but the keys themselves are not copied.
+ *
+ * # Parameters
+ * - `ph`: The perfect hash to build.
+ * - `keys`: The null terminated keys in the set.
+ * - `count`: The number of keys.
+ *
+ * # Requires
+ * - `keys` outlives `ph`.
+ *
+ * # Modifies
+ * - `ph` is set to the built perfect hash if successful. It must be freed using
+ *   `nsl_phash_free`.
+ *
+ * # Returns
+ * True if the perfect hash was built, and false if `count` is 0, a key appears
+ * more than once, or memory could not be allocated.
+ */
+NSL_PHASH_DEF bool nsl_phash_build(NSL_PerfectHash *ph, const char *const *keys, size_t count);
+
+/*!
+ * Frees the tables of a perfect hash built by `nsl_phash_build`.
+ *
+ * # Parameters
+ * - `ph`: The perfect hash to free.
+ *
+ * # Requires
+ * - `ph` was built by `nsl_phash_build` and has not already been freed.
+ *
+ * # Modifies
+ * - The tables of `ph` are freed and `ph` is zeroed.
+ */
+NSL_PHASH_DEF void nsl_phash_free(NSL_PerfectHash *ph);
+
+/*!
+ * Writes the tables of `ph` to `file` as C source code. The code defines a
+ * `static const NSL_PerfectHash` named `name`, along with the arrays that it
+ * refers to, and includes this header.
+ *
+ * # Parameters
+ * - `file`: The file to write to.
+ * - `name`: The name of the generated constant.
+ * - `ph`: The perfect hash to write.
+ *
+ * # Requires
+ * - `name` is a valid identifier.
+ *
+ * # Modifies
+ * - The source code is written to `file`.
+ *
+ * # Returns
+ * True if the source code was written, and false if there was an error writing
+ * to `file`.
+ */
+NSL_PHASH_DEF bool nsl_phash_write(FILE *file, const char *name, const NSL_PerfectHash *ph);
+
+#endif  // NSL_PHASH_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(PHASH)
+#    ifndef NSL_PHASH_IMPLEMENTATION_GUARD_
+#        define NSL_PHASH_IMPLEMENTATION_GUARD_
+
+#        include <inttypes.h>
+#        include <string.h>
+
+// The number of keys per bucket, on average, and the number of slots per key.
+// More keys per bucket makes the seed table smaller, and more slots makes the
+// seeds quicker to find.
+#        define NSL__PHASH_KEYS_PER_BUCKET 4
+#        define NSL__PHASH_LOAD_FACTOR     0.9
+
+// The number of seeds tried for a bucket before giving up. With the load factor
+// above, this is never reached unless two different keys have the same hash.
+#        define NSL__PHASH_MAX_SEED (1u << 24)
+
+// 64-bit FNV-1a, followed by the 64-bit finalizer of MurmurHash3. The upper bits
+// of FNV-1a alone are poorly distributed for short keys that only differ in
+// their last few bytes, which would put most keys in the same few buckets.
+static uint64_t nsl__phash_hash(const char *key, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint64_t)(unsigned char)key[i]) * 0x100000001b3u;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdu;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53u;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// The finalizer of MurmurHash3, so that every bit of the seed affects the slot.
+static uint32_t nsl__phash_mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+// Maps `x` onto `[0, n)` using a multiplication instead of a division.
+static uint32_t nsl__phash_reduce(uint32_t x, uint32_t n) {
+    return (uint32_t)(((uint64_t)x * n) >> 32);
+}
+
+static uint32_t nsl__phash_bucket(uint64_t hash, uint32_t buckets) {
+    return nsl__phash_reduce((uint32_t)(hash >> 32), buckets);
+}
+
+static uint32_t nsl__phash_slot(uint64_t hash, uint32_t seed, uint32_t size) {
+    return nsl__phash_reduce(nsl__phash_mix((uint32_t)hash ^ seed), size);
+}
+
+NSL_PHASH_DEF size_t nsl_phash_find(const NSL_PerfectHash *ph, const char *key, size_t length) {
+    uint64_t hash  = nsl__phash_hash(key, length);
+    uint32_t seed  = ph->seeds[nsl__phash_bucket(hash, ph->buckets)];
+    uint32_t index = ph->slots[nsl__phash_slot(hash, seed, ph->size)];
+    bool     found = ph->lengths[index] == length && memcmp(ph->keys[index], key, length) == 0;
+    return found ? index : NSL_PHASH_NOT_FOUND;
+}
+
+static int nsl__phash_compare_hashes(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Finds a seed for each bucket, starting with the buckets holding the most keys,
+// and fills in the slots.
+static bool nsl__phash_place(NSL_PerfectHash *ph,
+                             const uint64_t  *hashes,
+                             uint32_t        *seeds,
+                             uint32_t        *slots,
+                             uint32_t        *scratch) {
+    uint32_t  count   = ph->count;
+    uint32_t  buckets = ph->buckets;
+    uint32_t  size    = ph->size;
+    uint32_t *start   = scratch;               // [buckets + 1] first key of each bucket
+    uint32_t *keys    = start + buckets + 1;   // [count] keys sorted by bucket
+    uint32_t *order   = keys + count;          // [buckets] buckets sorted by size
+    uint32_t *placed  = order + buckets;       // [count] slots picked for the bucket
+    bool     *taken   = (bool *)(placed + count);
+
+    // Counting sort of the keys by bucket.
+    memset(start, 0, (buckets + 1) * sizeof(*start));
+    for (uint32_t i = 0; i < count; i++) {
+        start[nsl__phash_bucket(hashes[i], buckets) + 1]++;
+    }
+    uint32_t largest = 0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        if (start[b + 1] > largest) { largest = start[b + 1]; }
+        start[b + 1] += start[b];
+    }
+    memset(order, 0, buckets * sizeof(*order));
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t b = nsl__phash_bucket(hashes[i], buckets);
+        keys[start[b] + order[b]] = i;
+        order[b]++;
+    }
+
+    // The buckets, from largest to smallest.
+    uint32_t n = 0;
+    for (uint32_t length = largest; length > 0; length--) {
+        for (uint32_t b = 0; b < buckets; b++) {
+            if (start[b + 1] - start[b] == length) { order[n++] = b; }
+        }
+    }
+
+    memset(taken, 0, size * sizeof(*taken));
+    memset(seeds, 0, buckets * sizeof(*seeds));
+    memset(slots, 0, size * sizeof(*slots));
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t b     = order[i];
+        uint32_t first = start[b];
+        uint32_t last  = start[b + 1];
+        uint32_t seed  = 0;
+        for (; seed < NSL__PHASH_MAX_SEED; seed++) {
+            uint32_t k = first;
+            for (; k < last; k++) {
+                uint32_t slot = nsl__phash_slot(hashes[keys[k]], seed, size);
+                if (taken[slot]) { break; }
+                taken[slot]       = true;
+                placed[k - first] = slot;
+            }
+            if (k == last) { break; }
+            for (uint32_t j = first; j < k; j++) {
+                taken[placed[j - first]] = false;
+            }
+        }
+        if (seed == NSL__PHASH_MAX_SEED) { return false; }
+        seeds[b] = seed;
+        for (uint32_t k = first; k < last; k++) {
+            slots[placed[k - first]] = keys[k];
+        }
+    }
+    return true;
+}
+
+NSL_PHASH_DEF bool nsl_phash_build(NSL_PerfectHash *ph, const char *const *keys, size_t count) {
+    if (count == 0 || count >= UINT32_MAX / 2) { return false; }
+
+    uint32_t n       = (uint32_t)count;
+    uint32_t buckets = (n + NSL__PHASH_KEYS_PER_BUCKET - 1) / NSL__PHASH_KEYS_PER_BUCKET;
+    uint32_t size    = (uint32_t)((double)n / NSL__PHASH_LOAD_FACTOR) + 1;
+
+    uint32_t *lengths = nsl_malloc(n * sizeof(*lengths));
+    uint32_t *seeds   = nsl_malloc(buckets * sizeof(*seeds));
+    uint32_t *slots   = nsl_malloc(size * sizeof(*slots));
+    uint64_t *hashes  = nsl_malloc(2 * n * sizeof(*hashes));
+    void     *scratch = nsl_malloc((2 * buckets + 2 * n + 1) * sizeof(uint32_t) + size);
+    bool      ok      = lengths != nullptr && seeds != nullptr && slots != nullptr
+              && hashes != nullptr && scratch != nullptr;
+
+    for (uint32_t i = 0; ok && i < n; i++) {
+        size_t length = strlen(keys[i]);
+        ok            = length < UINT32_MAX;
+        lengths[i]    = (uint32_t)length;
+        hashes[i]     = nsl__phash_hash(keys[i], length);
+    }
+
+    // Keys with the same hash can never be placed in different slots, so they
+    // are rejected up front. In practice, this only happens for duplicate keys.
+    if (ok) {
+        uint64_t *sorted = hashes + n;
+        memcpy(sorted, hashes, n * sizeof(*sorted));
+        qsort(sorted, n, sizeof(*sorted), nsl__phash_compare_hashes);
+        for (uint32_t i = 1; ok && i < n; i++) {
+            ok = sorted[i - 1] != sorted[i];
+        }
+    }
+
+    *ph = (NSL_PerfectHash){
+        .keys    = keys,
+        .lengths = lengths,
+        .count   = n,
+        .seeds   = seeds,
+        .buckets = buckets,
+        .slots   = slots,
+        .size    = size,
+    };
+    ok = ok && nsl__phash_place(ph, hashes, seeds, slots, scratch);
+
+    nsl_free(hashes);
+    nsl_free(scratch);
+    if (!ok) { nsl_phash_free(ph); }
+    return ok;
+}
+
+NSL_PHASH_DEF void nsl_phash_free(NSL_PerfectHash *ph) {
+    nsl_free((void *)ph->lengths);
+    nsl_free((void *)ph->seeds);
+    nsl_free((void *)ph->slots);
+    *ph = (NSL_PerfectHash){};
+}
+
+// Writes `values` as the body of an array initializer, 12 values per line.
+static void nsl__phash_write_array(FILE *file, const uint32_t *values, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        fprintf(file, "%s%" PRIu32 ",", i % 12 == 0 ? "\n   " : "", values[i]);
+    }
+    fprintf(file, "\n");
+}
+
+NSL_PHASH_DEF bool nsl_phash_write(FILE *file, const char *name, const NSL_PerfectHash *ph) {
+    fprintf(file, "// Generated by nsl_phash_write. Do not edit.\n\n");
+    fprintf(file, "#include \"nonstdlib/phash.h\"\n\n");
+
+    fprintf(file, "static const char *const %s_keys[] = {\n", name);
+    for (uint32_t i = 0; i < ph->count; i++) {
+        fprintf(file, "    \"");
+        for (uint32_t j = 0; j < ph->lengths[i]; j++) {
+            unsigned char c = (unsigned char)ph->keys[i][j];
+            if (c == '"' || c == '\\') {
+                fprintf(file, "\\%c", c);
+            } else if (c >= ' ' && c <= '~') {
+                fputc(c, file);
+            } else {
+                fprintf(file, "\\%03o", c);
+            }
+        }
+        fprintf(file, "\",\n");
+    }
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "static const uint32_t %s_lengths[] = {", name);
+    nsl__phash_write_array(file, ph->lengths, ph->count);
+    fprintf(file, "};\n\nstatic const uint32_t %s_seeds[] = {", name);
+    nsl__phash_write_array(file, ph->seeds, ph->buckets);
+    fprintf(file, "};\n\nstatic const uint32_t %s_slots[] = {", name);
+    nsl__phash_write_array(file, ph->slots, ph->size);
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "static const NSL_PerfectHash %s = {\n", name);
+    fprintf(file, "    .keys    = %s_keys,\n", name);
+    fprintf(file, "    .lengths = %s_lengths,\n", name);
+    fprintf(file, "    .count   = %" PRIu32 ",\n", ph->count);
+    fprintf(file, "    .seeds   = %s_seeds,\n", name);
+    fprintf(file, "    .buckets = %" PRIu32 ",\n", ph->buckets);
+    fprintf(file, "    .slots   = %s_slots,\n", name);
+    fprintf(file, "    .size    = %" PRIu32 ",\n", ph->size);
+    fprintf(file, "};\n");
+
+    return ferror(file) == 0;
+}
+
+#    endif  // NSL_PHASH_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(PHASH)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(PHASH)
+#    ifndef NSL_PHASH_STRIP_PREFIX_GUARD_
+#        define NSL_PHASH_STRIP_PREFIX_GUARD_
+
+#        define PHASH_NOT_FOUND NSL_PHASH_NOT_FOUND
+#        define PerfectHash     NSL_PerfectHash
+#        define PHASH_GENERATOR NSL_PHASH_GENERATOR
+#        define phash_find      nsl_phash_find
+#        define phash_build     nsl_phash_build
+#        define phash_free      nsl_phash_free
+#        define phash_write     nsl_phash_write
+
+#    endif  // NSL_PHASH_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(PHASH)
@@ -0,0 +1,867 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * A pretty printer in the style of Wadler's "A prettier printer" that streams
+ * its output to an `NSL_StreamWriter`. Instead of building a document and
+ * laying it out afterwards, the caller emits text, breaks and groups as it
+ * walks its data, and the printer writes each of them as soon as its layout
+ * is known.
+ *
+ * A group is printed on one line if it fits in the rest of the line, in which
+ * case its breaks are printed as their flat text (a space for
+ * `nsl_pretty_line`). Otherwise every break directly in the group starts a new
+ * line, indented by the indentation of the group. Nested groups are decided
+ * separately, so inner groups that fit stay on one line.
+ *
+ * Deciding a group only needs the text that follows it up to its end or up to
+ * the end of the line, whichever comes first, so that is all the printer
+ * holds on to: while a group is undecided, everything after it is queued, and
+ * as soon as the queue is wider than the rest of the line, the group is
+ * broken and printed. Groups, indents and empty breaks take no width, so the
+ * group is also broken once more than `NSL_PRETTY_LOOKAHEAD` tokens are
+ * queued. Memory use is bounded by the width of a line, that many tokens and
+ * the depth of nesting rather than the size of the output, and dumping a
+ * container with millions of elements never materializes more than a line of
+ * it.
+ *
+ * `nsl_pretty` prints a value of any basic type, chosen with `_Generic`, so
+ * the call is resolved at compile time. Other types are added by defining
+ * `NSL_PRETTY_USER_TYPES`, and `nsl_pretty_array` prints an array of any type
+ * that `nsl_pretty` can print.
+ *
+ * Widths are counted in bytes, and text should not contain newlines; use
+ * `nsl_pretty_hardline` instead.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/pretty.h"
+ *
+ * typedef struct Point {
+ *     int x, y;
+ * } Point;
+ *
+ * void pretty_point(NSL_Pretty *printer, Point point) {
+ *     nsl_pretty_begin(printer);
+ *     nsl_pretty(printer, "{x = ");
+ *     nsl_pretty(printer, point.x);
+ *     nsl_pretty(printer, ",");
+ *     nsl_pretty_line(printer);
+ *     nsl_pretty(printer, "y = ");
+ *     nsl_pretty(printer, point.y);
+ *     nsl_pretty(printer, "}");
+ *     nsl_pretty_end(printer);
+ * }
+ *
+ * #define NSL_PRETTY_USER_TYPES Point: pretty_point,
+ *
+ * int main() {
+ *     NSL_StreamWriter out;
+ *     nsl_stream_writer_init(&out, 1, 0);
+ *     NSL_Pretty printer;
+ *     nsl_pretty_init(&printer, &out, 40);
+ *
+ *     Point points[] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+ *     // [
+ *     //     {x = 1, y = 2},
+ *     //     ...
+ *     // ]
+ *     nsl_pretty_array(&printer, points, 4);
+ *     nsl_pretty_hardline(&printer);
+ *
+ *     nsl_pretty_free(&printer);
+ *     nsl_stream_writer_free(&out);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_PRETTY_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_PRETTY_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_PRETTY_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ * - `NSL_PRETTY_WIDTH`: The width of a line when none is given to
+ *   `nsl_pretty_init`. Defaults to 80.
+ * - `NSL_PRETTY_INDENT`: The indentation of the elements of
+ *   `nsl_pretty_array`. Defaults to 4.
+ * - `NSL_PRETTY_LOOKAHEAD`: The most tokens that are queued while a group is
+ *   undecided. Defaults to 1024.
+ * - `NSL_PRETTY_USER_TYPES`: Extra associations of `nsl_pretty`, each as
+ *   `type: function,` where `function` takes an `NSL_Pretty *` and a value of
+ *   `type`. It can also be redefined with `#undef` after this file is
+ *   included, as long as that is before `nsl_pretty` is used.
+ */
+
+#ifndef NSL_PRETTY_H_
+#define NSL_PRETTY_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_PRETTY_VERSION_MAJOR 0
+#define NSL_PRETTY_VERSION_MINOR 1
+#define NSL_PRETTY_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+#include "nonstdlib/stream.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_PRETTY_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_PRETTY_DEF
+#    define NSL_PRETTY_DEF
+#endif  // NSL_PRETTY_DEF
+
+/*!
+ * `NSL_PRETTY_WIDTH` is the width of a line when `nsl_pretty_init` is given a
+ * width of 0.
+ */
+#ifndef NSL_PRETTY_WIDTH
+#    define NSL_PRETTY_WIDTH 80
+#endif  // NSL_PRETTY_WIDTH
+
+/*!
+ * `NSL_PRETTY_INDENT` is how far `nsl_pretty_array` indents its elements when
+ * they do not fit on one line.
+ */
+#ifndef NSL_PRETTY_INDENT
+#    define NSL_PRETTY_INDENT 4
+#endif  // NSL_PRETTY_INDENT
+
+/*!
+ * `NSL_PRETTY_LOOKAHEAD` is the most tokens that are queued while a group is
+ * undecided, after which the group is broken even if it could still fit.
+ */
+#ifndef NSL_PRETTY_LOOKAHEAD
+#    define NSL_PRETTY_LOOKAHEAD 1024
+#endif  // NSL_PRETTY_LOOKAHEAD
+
+/*!
+ * `NSL_PRETTY_USER_TYPES` adds associations to the `_Generic` of
+ * `nsl_pretty`. By default, it is empty.
+ */
+#ifndef NSL_PRETTY_USER_TYPES
+#    define NSL_PRETTY_USER_TYPES
+#endif  // NSL_PRETTY_USER_TYPES
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+typedef struct NSL__PrettyToken NSL__PrettyToken;
+typedef struct NSL__PrettyFrame NSL__PrettyFrame;
+
+/*!
+ * A pretty printer.
+ */
+typedef struct NSL_Pretty {
+    //! The writer that the output is written to.
+    NSL_StreamWriter *out;
+    //! The width that lines are kept within where possible.
+    size_t width;
+    //! The column of the next byte that is written.
+    size_t column;
+    //! Private: The tokens that wait for the group at their head to be
+    //! decided. `token_base` is the number of tokens that have been removed
+    //! from the start of the array since it was last empty.
+    NSL__PrettyToken *tokens;
+    size_t            token_head;
+    size_t            token_tail;
+    size_t            token_capacity;
+    size_t            token_base;
+    //! Private: The bytes of the text in `tokens`.
+    char  *text;
+    size_t text_head;
+    size_t text_tail;
+    size_t text_capacity;
+    //! Private: The width of everything queued in `tokens` if it were flat.
+    size_t total;
+    //! Private: The groups in `tokens` that have not ended, from outermost
+    //! to innermost, as indices that include `token_base`.
+    size_t *open;
+    size_t  open_head;
+    size_t  open_tail;
+    size_t  open_capacity;
+    //! Private: The groups that have been decided and not ended.
+    NSL__PrettyFrame *frames;
+    size_t            frame_count;
+    size_t            frame_capacity;
+} NSL_Pretty;
+
+/*!
+ * Initializes a pretty printer.
+ *
+ * # Parameters
+ * - `printer`: The printer to initialize.
+ * - `out`: The writer to write to.
+ * - `width`: The width of a line, or 0 for `NSL_PRETTY_WIDTH`.
+ *
+ * # Requires
+ * - `out` is initialized, and stays so for as long as `printer` is used.
+ *
+ * # Modifies
+ * - `printer`: It is initialized.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_init(NSL_Pretty *printer, NSL_StreamWriter *out, size_t width);
+
+/*!
+ * Frees a pretty printer.
+ *
+ * # Parameters
+ * - `printer`: The printer to free.
+ *
+ * # Requires
+ * - `printer` is initialized, and every group that was begun has ended, so
+ *   that everything has been written to `out`.
+ *
+ * # Modifies
+ * - `printer`: It is no longer initialized.
+ */
+NSL_PRETTY_DEF void nsl_pretty_free(NSL_Pretty *printer);
+
+/*!
+ * Prints text.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ * - `text`: The text to print. It is copied if it has to be queued.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ * - `text` does not contain a newline.
+ *
+ * # Modifies
+ * - `printer`: The text is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_text(NSL_Pretty *printer, NSL_StringView text);
+
+/*!
+ * Prints a break, which is printed as `flat` if the group it is in fits on
+ * one line, and as a newline otherwise.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ * - `flat`: The text to print if the group is on one line.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ * - `flat` does not contain a newline.
+ *
+ * # Modifies
+ * - `printer`: The break is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_break(NSL_Pretty *printer, NSL_StringView flat);
+
+/*!
+ * Prints a break that is a space if its group fits on one line.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ *
+ * # Modifies
+ * - `printer`: The break is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_line(NSL_Pretty *printer);
+
+/*!
+ * Prints a break that is nothing if its group fits on one line.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ *
+ * # Modifies
+ * - `printer`: The break is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_softline(NSL_Pretty *printer);
+
+/*!
+ * Prints a newline, which breaks every group that contains it.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ *
+ * # Modifies
+ * - `printer`: The newline is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_hardline(NSL_Pretty *printer);
+
+/*!
+ * Begins a group, whose breaks are either all flat or all newlines. Its
+ * indentation starts as that of the group it is in.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ *
+ * # Modifies
+ * - `printer`: The group is begun.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_begin(NSL_Pretty *printer);
+
+/*!
+ * Ends the innermost group.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ *
+ * # Requires
+ * - `printer` is initialized, and a group has begun that has not ended.
+ *
+ * # Modifies
+ * - `printer`: The group is ended, and printed if it was waiting to be
+ *   decided.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_end(NSL_Pretty *printer);
+
+/*!
+ * Changes the indentation of the breaks that follow in the innermost group.
+ * It is undone when the group ends.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ * - `delta`: How many spaces to add to the indentation. Negative values
+ *   remove spaces.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ *
+ * # Modifies
+ * - `printer`: The indentation is changed.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_indent(NSL_Pretty *printer, int delta);
+
+/*!
+ * Prints a value as text. `nsl_pretty` picks the right one for a type.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ * - `value`: The value to print. Integers are printed in decimal, floating
+ *   point numbers with the fewest digits from 15 to 17 that read back as the
+ *   same value, and strings as they are.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ *
+ * # Modifies
+ * - `printer`: The text is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_PRETTY_DEF void nsl_pretty_i64(NSL_Pretty *printer, int64_t value);
+NSL_PRETTY_DEF void nsl_pretty_u64(NSL_Pretty *printer, uint64_t value);
+NSL_PRETTY_DEF void nsl_pretty_f64(NSL_Pretty *printer, double value);
+NSL_PRETTY_DEF void nsl_pretty_bool(NSL_Pretty *printer, bool value);
+NSL_PRETTY_DEF void nsl_pretty_char(NSL_Pretty *printer, char value);
+NSL_PRETTY_DEF void nsl_pretty_cstr(NSL_Pretty *printer, const char *value);
+
+/*!
+ * Prints a value with the function for its type, which is chosen at compile
+ * time.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ * - `value`: The value to print.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ * - `value` is an integer, a floating point number, a `bool`, a string, an
+ *   `NSL_StringView` or a type in `NSL_PRETTY_USER_TYPES`.
+ *
+ * # Modifies
+ * - `printer`: The value is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+#define nsl_pretty(printer, value)                                                                 \
+    _Generic((value),                                                                              \
+        NSL_PRETTY_USER_TYPES                                                                      \
+        bool: nsl_pretty_bool,                                                                     \
+        char: nsl_pretty_char,                                                                     \
+        signed char: nsl_pretty_i64,                                                               \
+        short: nsl_pretty_i64,                                                                     \
+        int: nsl_pretty_i64,                                                                       \
+        long: nsl_pretty_i64,                                                                      \
+        long long: nsl_pretty_i64,                                                                 \
+        unsigned char: nsl_pretty_u64,                                                             \
+        unsigned short: nsl_pretty_u64,                                                            \
+        unsigned int: nsl_pretty_u64,                                                              \
+        unsigned long: nsl_pretty_u64,                                                             \
+        unsigned long long: nsl_pretty_u64,                                                        \
+        float: nsl_pretty_f64,                                                                     \
+        double: nsl_pretty_f64,                                                                    \
+        char *: nsl_pretty_cstr,                                                                   \
+        const char *: nsl_pretty_cstr,                                                             \
+        NSL_StringView: nsl_pretty_text)((printer), (value))
+
+/*!
+ * Prints an array as `[a, b, c]` if it fits on one line, and with each
+ * element on its own line otherwise.
+ *
+ * # Parameters
+ * - `printer`: The printer to print with.
+ * - `items`: The array to print.
+ * - `count`: The number of elements in `items`.
+ *
+ * # Requires
+ * - `printer` is initialized.
+ * - The elements of `items` can be printed with `nsl_pretty`.
+ *
+ * # Modifies
+ * - `printer`: The array is printed or queued.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+#define nsl_pretty_array(printer, items, count)                                                    \
+    do {                                                                                           \
+        NSL_Pretty *nsl__pretty_printer = (printer);                                               \
+        size_t      nsl__pretty_count   = (count);                                                 \
+        nsl_pretty_begin(nsl__pretty_printer);                                                     \
+        nsl_pretty_char(nsl__pretty_printer, '[');                                                 \
+        nsl_pretty_indent(nsl__pretty_printer, NSL_PRETTY_INDENT);                                 \
+        nsl_pretty_softline(nsl__pretty_printer);                                                  \
+        for (size_t nsl__pretty_i = 0; nsl__pretty_i < nsl__pretty_count; nsl__pretty_i++) {       \
+            if (nsl__pretty_i > 0) {                                                               \
+                nsl_pretty_char(nsl__pretty_printer, ',');                                         \
+                nsl_pretty_line(nsl__pretty_printer);                                              \
+            }                                                                                      \
+            nsl_pretty(nsl__pretty_printer, (items)[nsl__pretty_i]);                               \
+        }                                                                                          \
+        nsl_pretty_indent(nsl__pretty_printer, -NSL_PRETTY_INDENT);                                \
+        nsl_pretty_softline(nsl__pretty_printer);                                                  \
+        nsl_pretty_char(nsl__pretty_printer, ']');                                                 \
+        nsl_pretty_end(nsl__pretty_printer);                                                       \
+    } while (0)
+
+#endif  // NSL_PRETTY_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(PRETTY)
+#    ifndef NSL_PRETTY_IMPLEMENTATION_GUARD_
+#        define NSL_PRETTY_IMPLEMENTATION_GUARD_
+
+#        include <inttypes.h>
+#        include <stdio.h>
+#        include <stdlib.h>
+#        include <string.h>
+
+typedef enum NSL__PrettyKind {
+    NSL__PRETTY_TEXT,
+    NSL__PRETTY_BREAK,
+    NSL__PRETTY_HARDLINE,
+    NSL__PRETTY_BEGIN,
+    NSL__PRETTY_END,
+    NSL__PRETTY_INDENT,
+} NSL__PrettyKind;
+
+// The width of a group that has not ended yet.
+#        define NSL__PRETTY_UNKNOWN SIZE_MAX
+
+struct NSL__PrettyToken {
+    NSL__PrettyKind kind;
+    //! The change of indentation of an indent.
+    int delta;
+    //! The number of bytes of text of a text or a break.
+    size_t length;
+    //! The value of `total` when a group began.
+    size_t start;
+    //! The width of a group if it were flat.
+    size_t width;
+};
+
+struct NSL__PrettyFrame {
+    bool      flat;
+    ptrdiff_t indent;
+};
+
+// Makes room for `count` more items at the tail of a queue, moving the items
+// to the start of the array if there is room for them there, and growing it
+// otherwise. Returns how many places the items moved back.
+static size_t nsl__pretty_reserve(void  **items,
+                                  size_t *head,
+                                  size_t *tail,
+                                  size_t *capacity,
+                                  size_t  count,
+                                  size_t  size) {
+    if (*capacity - *tail >= count) { return 0; }
+    size_t moved = *head;
+    size_t used  = *tail - *head;
+    if (moved > 0 && *capacity - used >= count && used <= *capacity / 2) {
+        memmove(*items, (char *)*items + moved * size, used * size);
+        *head = 0;
+        *tail = used;
+        return moved;
+    }
+    while (*capacity - *tail < count) {
+        *capacity = *capacity == 0 ? 64 : 2 * *capacity;
+    }
+    *items = nsl_realloc(*items, *capacity * size);
+    if (*items == nullptr) {
+        nsl_eprintf("[PRETTY] out of memory\n");
+        nsl_abort();
+    }
+    return 0;
+}
+
+static NSL__PrettyFrame *nsl__pretty_frame(NSL_Pretty *printer) {
+    return &printer->frames[printer->frame_count - 1];
+}
+
+static void nsl__pretty_newline(NSL_Pretty *printer) {
+    ptrdiff_t indent = nsl__pretty_frame(printer)->indent;
+    size_t    spaces = indent > 0 ? (size_t)indent : 0;
+    char     *line   = nsl_stream_reserve(printer->out, 1 + spaces);
+    line[0]          = '\n';
+    memset(line + 1, ' ', spaces);
+    nsl_stream_commit(printer->out, 1 + spaces);
+    printer->column = spaces;
+}
+
+// Prints a token whose layout is known. `text` is its text, if it has any.
+static void
+nsl__pretty_print(NSL_Pretty *printer, const NSL__PrettyToken *token, const char *text) {
+    switch (token->kind) {
+    case NSL__PRETTY_BREAK:
+        if (!nsl__pretty_frame(printer)->flat) {
+            nsl__pretty_newline(printer);
+            break;
+        }
+        [[fallthrough]];
+    case NSL__PRETTY_TEXT:
+        nsl_stream_write(printer->out, text, token->length);
+        printer->column += token->length;
+        break;
+    case NSL__PRETTY_HARDLINE: nsl__pretty_newline(printer); break;
+    case NSL__PRETTY_BEGIN: {
+        NSL__PrettyFrame parent    = *nsl__pretty_frame(printer);
+        size_t           remaining = printer->width > printer->column
+                                         ? printer->width - printer->column
+                                         : 0;
+        nsl__pretty_reserve((void **)&printer->frames,
+                            &(size_t){0},
+                            &printer->frame_count,
+                            &printer->frame_capacity,
+                            1,
+                            sizeof(NSL__PrettyFrame));
+        printer->frames[printer->frame_count++] = (NSL__PrettyFrame){
+            .flat   = parent.flat || token->width <= remaining,
+            .indent = parent.indent,
+        };
+        break;
+    }
+    case NSL__PRETTY_END: printer->frame_count--; break;
+    case NSL__PRETTY_INDENT: nsl__pretty_frame(printer)->indent += token->delta; break;
+    }
+}
+
+// Prints the tokens at the head of the queue until it reaches a group that
+// cannot be decided yet.
+static void nsl__pretty_advance(NSL_Pretty *printer) {
+    while (printer->token_head < printer->token_tail) {
+        NSL__PrettyToken *token = &printer->tokens[printer->token_head];
+        if (token->kind == NSL__PRETTY_BEGIN && token->width == NSL__PRETTY_UNKNOWN) {
+            // everything before the group has been printed, so the column is
+            // where it starts, and it is broken once the queue overflows
+            size_t remaining = printer->width > printer->column
+                                   ? printer->width - printer->column
+                                   : 0;
+            size_t queued    = printer->token_tail - printer->token_head;
+            if (printer->total - token->start <= remaining && queued <= NSL_PRETTY_LOOKAHEAD) {
+                return;
+            }
+            printer->open_head++;
+        }
+        nsl__pretty_print(printer, token, printer->text + printer->text_head);
+        printer->text_head += token->length;
+        printer->token_head++;
+    }
+    printer->token_head = printer->token_tail = printer->token_base = 0;
+    printer->text_head = printer->text_tail = 0;
+    printer->open_head = printer->open_tail = 0;
+    printer->total                          = 0;
+}
+
+static void nsl__pretty_emit(NSL_Pretty *printer, NSL__PrettyToken token, const char *text) {
+    // nothing is waiting, so only a group in a broken group has to wait
+    if (printer->token_head == printer->token_tail
+        && (token.kind != NSL__PRETTY_BEGIN || nsl__pretty_frame(printer)->flat)) {
+        nsl__pretty_print(printer, &token, text);
+        return;
+    }
+
+    switch (token.kind) {
+    case NSL__PRETTY_TEXT:
+    case NSL__PRETTY_BREAK: printer->total += token.length; break;
+    case NSL__PRETTY_HARDLINE: printer->total += printer->width + 1; break;
+    case NSL__PRETTY_BEGIN: {
+        token.start = printer->total;
+        token.width = NSL__PRETTY_UNKNOWN;
+        nsl__pretty_reserve((void **)&printer->open,
+                            &printer->open_head,
+                            &printer->open_tail,
+                            &printer->open_capacity,
+                            1,
+                            sizeof(size_t));
+        printer->open[printer->open_tail++] = printer->token_base + printer->token_tail;
+        break;
+    }
+    case NSL__PRETTY_END:
+        // if no group in the queue is open, the group that ends was printed
+        if (printer->open_head < printer->open_tail) {
+            size_t            index = printer->open[--printer->open_tail] - printer->token_base;
+            NSL__PrettyToken *begin = &printer->tokens[index];
+            begin->width            = printer->total - begin->start;
+        }
+        break;
+    case NSL__PRETTY_INDENT: break;
+    }
+
+    printer->token_base += nsl__pretty_reserve((void **)&printer->tokens,
+                                               &printer->token_head,
+                                               &printer->token_tail,
+                                               &printer->token_capacity,
+                                               1,
+                                               sizeof(NSL__PrettyToken));
+    printer->tokens[printer->token_tail++] = token;
+    if (token.length > 0) {
+        nsl__pretty_reserve((void **)&printer->text,
+                            &printer->text_head,
+                            &printer->text_tail,
+                            &printer->text_capacity,
+                            token.length,
+                            1);
+        memcpy(printer->text + printer->text_tail, text, token.length);
+        printer->text_tail += token.length;
+    }
+    nsl__pretty_advance(printer);
+}
+
+NSL_PRETTY_DEF void nsl_pretty_init(NSL_Pretty *printer, NSL_StreamWriter *out, size_t width) {
+    *printer = (NSL_Pretty){
+        .out   = out,
+        .width = width == 0 ? NSL_PRETTY_WIDTH : width,
+    };
+    // the outermost frame is broken, so that hard lines are newlines
+    nsl__pretty_reserve((void **)&printer->frames,
+                        &(size_t){0},
+                        &printer->frame_count,
+                        &printer->frame_capacity,
+                        1,
+                        sizeof(NSL__PrettyFrame));
+    printer->frames[printer->frame_count++] = (NSL__PrettyFrame){};
+}
+
+NSL_PRETTY_DEF void nsl_pretty_free(NSL_Pretty *printer) {
+    nsl_free(printer->tokens);
+    nsl_free(printer->text);
+    nsl_free(printer->open);
+    nsl_free(printer->frames);
+}
+
+NSL_PRETTY_DEF void nsl_pretty_text(NSL_Pretty *printer, NSL_StringView text) {
+    nsl__pretty_emit(
+        printer, (NSL__PrettyToken){.kind = NSL__PRETTY_TEXT, .length = text.length}, text.data);
+}
+
+NSL_PRETTY_DEF void nsl_pretty_break(NSL_Pretty *printer, NSL_StringView flat) {
+    nsl__pretty_emit(
+        printer, (NSL__PrettyToken){.kind = NSL__PRETTY_BREAK, .length = flat.length}, flat.data);
+}
+
+NSL_PRETTY_DEF void nsl_pretty_line(NSL_Pretty *printer) {
+    nsl_pretty_break(printer, (NSL_StringView){" ", 1});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_softline(NSL_Pretty *printer) {
+    nsl_pretty_break(printer, (NSL_StringView){"", 0});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_hardline(NSL_Pretty *printer) {
+    nsl__pretty_emit(printer, (NSL__PrettyToken){.kind = NSL__PRETTY_HARDLINE}, "");
+}
+
+NSL_PRETTY_DEF void nsl_pretty_begin(NSL_Pretty *printer) {
+    nsl__pretty_emit(printer, (NSL__PrettyToken){.kind = NSL__PRETTY_BEGIN}, "");
+}
+
+NSL_PRETTY_DEF void nsl_pretty_end(NSL_Pretty *printer) {
+    nsl__pretty_emit(printer, (NSL__PrettyToken){.kind = NSL__PRETTY_END}, "");
+}
+
+NSL_PRETTY_DEF void nsl_pretty_indent(NSL_Pretty *printer, int delta) {
+    nsl__pretty_emit(
+        printer, (NSL__PrettyToken){.kind = NSL__PRETTY_INDENT, .delta = delta}, "");
+}
+
+NSL_PRETTY_DEF void nsl_pretty_i64(NSL_Pretty *printer, int64_t value) {
+    char buffer[24];
+    int  length = snprintf(buffer, sizeof(buffer), "%" PRId64, value);
+    nsl_pretty_text(printer, (NSL_StringView){buffer, (size_t)length});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_u64(NSL_Pretty *printer, uint64_t value) {
+    char buffer[24];
+    int  length = snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+    nsl_pretty_text(printer, (NSL_StringView){buffer, (size_t)length});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_f64(NSL_Pretty *printer, double value) {
+    // every decimal with 15 digits reads back as itself, so a value that
+    // needs fewer is printed with them once the zeros are trimmed, and 17
+    // digits always read back
+    char buffer[32];
+    int  length = 0;
+    for (int digits = 15; digits <= 17; digits++) {
+        length = snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+        if (strtod(buffer, nullptr) == value) { break; }
+    }
+    nsl_pretty_text(printer, (NSL_StringView){buffer, (size_t)length});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_bool(NSL_Pretty *printer, bool value) {
+    nsl_pretty_text(printer, value ? (NSL_StringView){"true", 4} : (NSL_StringView){"false", 5});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_char(NSL_Pretty *printer, char value) {
+    nsl_pretty_text(printer, (NSL_StringView){&value, 1});
+}
+
+NSL_PRETTY_DEF void nsl_pretty_cstr(NSL_Pretty *printer, const char *value) {
+    nsl_pretty_text(printer, (NSL_StringView){value, strlen(value)});
+}
+
+#    endif  // NSL_PRETTY_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(PRETTY)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(PRETTY)
+#    ifndef NSL_PRETTY_STRIP_PREFIX_GUARD_
+#        define NSL_PRETTY_STRIP_PREFIX_GUARD_
+
+#        define Pretty          NSL_Pretty
+#        define pretty_init     nsl_pretty_init
+#        define pretty_free     nsl_pretty_free
+#        define pretty_text     nsl_pretty_text
+#        define pretty_break    nsl_pretty_break
+#        define pretty_line     nsl_pretty_line
+#        define pretty_softline nsl_pretty_softline
+#        define pretty_hardline nsl_pretty_hardline
+#        define pretty_begin    nsl_pretty_begin
+#        define pretty_end      nsl_pretty_end
+#        define pretty_indent   nsl_pretty_indent
+#        define pretty_i64      nsl_pretty_i64
+#        define pretty_u64      nsl_pretty_u64
+#        define pretty_f64      nsl_pretty_f64
+#        define pretty_bool     nsl_pretty_bool
+#        define pretty_char     nsl_pretty_char
+#        define pretty_cstr     nsl_pretty_cstr
+#        define pretty          nsl_pretty
+#        define pretty_array    nsl_pretty_array
+
+#    endif  // NSL_PRETTY_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(PRETTY)
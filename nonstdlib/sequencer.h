@@ -0,0 +1,827 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * A work-stealing task scheduler. A sequencer owns one thread per CPU, and
+ * each thread has its own Chase-Lev deque of tasks. A thread pushes and pops
+ * tasks at the bottom of its own deque without taking a lock, and when it
+ * runs out, it steals from the top of the deque of another thread. Threads
+ * with nothing to steal sleep until more tasks are scheduled.
+ *
+ * Tasks form graphs. `nsl_task_precede` makes one task wait for another, and
+ * each task counts the predecessors it is still waiting for. A task is
+ * scheduled once it has been submitted with `nsl_sequencer_submit` and the
+ * count reaches zero, on the deque of the thread that finished its last
+ * predecessor, where its data is most likely still in cache.
+ *
+ * `nsl_sequencer_parallel_for` splits a range of indices lazily. The thread
+ * running a range runs it one grain at a time, and before each grain splits
+ * off half of what is left for other threads only if its own deque is nearly
+ * empty, so the ranges that are stolen are large when every thread is busy
+ * and small when some are idle, down to the grain size.
+ *
+ * The thread that calls `nsl_sequencer_init` is one of the threads of the
+ * sequencer, and runs tasks while it waits in `nsl_sequencer_wait` or
+ * `nsl_sequencer_parallel_for`. Other threads may also submit and wait for
+ * tasks, which are then passed through a queue guarded by a mutex. Tasks may
+ * submit and wait for other tasks.
+ *
+ * This module needs `_POSIX_C_SOURCE` to be at least `200809L` before any
+ * header is included.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _POSIX_C_SOURCE 200809L
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/sequencer.h"
+ *
+ * void square(void *data, size_t begin, size_t end) {
+ *     double *values = data;
+ *     for (size_t i = begin; i < end; i++) { values[i] *= values[i]; }
+ * }
+ *
+ * int main() {
+ *     NSL_Sequencer sequencer;
+ *     if (!nsl_sequencer_init(&sequencer, nullptr)) { return 1; }
+ *
+ *     NSL_Task load, parse, check, save;
+ *     nsl_task_init(&load, load_file, &state);
+ *     nsl_task_init(&parse, parse_file, &state);
+ *     nsl_task_init(&check, check_file, &state);
+ *     nsl_task_init(&save, save_file, &state);
+ *     nsl_task_precede(&load, &parse);
+ *     nsl_task_precede(&load, &check);
+ *     nsl_task_precede(&parse, &save);
+ *     nsl_task_precede(&check, &save);
+ *     nsl_sequencer_submit(&sequencer, &load);
+ *     nsl_sequencer_submit(&sequencer, &parse);
+ *     nsl_sequencer_submit(&sequencer, &check);
+ *     nsl_sequencer_submit(&sequencer, &save);
+ *     nsl_sequencer_wait(&sequencer, &save);
+ *
+ *     nsl_sequencer_parallel_for(&sequencer, 0, state.count, 0, square, state.values);
+ *
+ *     nsl_task_free(&load);
+ *     nsl_task_free(&parse);
+ *     nsl_task_free(&check);
+ *     nsl_task_free(&save);
+ *     nsl_sequencer_free(&sequencer);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_SEQUENCER_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will
+ *   only include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_SEQUENCER_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_SEQUENCER_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ * - `NSL_SEQUENCER_DEQUE_CAPACITY`: The default number of tasks that fit in the
+ *   deque of each thread.
+ * - `NSL_SEQUENCER_SPINS`: How many times a thread looks for a task to steal
+ *   before it sleeps.
+ */
+
+#ifndef NSL_SEQUENCER_H_
+#define NSL_SEQUENCER_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_SEQUENCER_VERSION_MAJOR 0
+#define NSL_SEQUENCER_VERSION_MINOR 1
+#define NSL_SEQUENCER_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_SEQUENCER_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_SEQUENCER_DEF
+#    define NSL_SEQUENCER_DEF
+#endif  // NSL_SEQUENCER_DEF
+
+/*!
+ * `NSL_SEQUENCER_DEQUE_CAPACITY` is the default number of tasks that fit in
+ * the deque of each thread. A task scheduled while the deque is full is run
+ * immediately by the thread that scheduled it.
+ */
+#ifndef NSL_SEQUENCER_DEQUE_CAPACITY
+#    define NSL_SEQUENCER_DEQUE_CAPACITY 1024
+#endif  // NSL_SEQUENCER_DEQUE_CAPACITY
+
+/*!
+ * `NSL_SEQUENCER_SPINS` is how many times an idle thread tries to steal a task,
+ * yielding between attempts, before it sleeps.
+ */
+#ifndef NSL_SEQUENCER_SPINS
+#    define NSL_SEQUENCER_SPINS 64
+#endif  // NSL_SEQUENCER_SPINS
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * How a sequencer is set up. Fields that are zero use their defaults.
+ */
+typedef struct NSL_SequencerConfig {
+    //! The number of threads that run tasks, including the one that calls
+    //! `nsl_sequencer_init`. Defaults to the number of online CPUs.
+    size_t threads;
+    //! The number of tasks that fit in the deque of each thread, which is
+    //! rounded up to a power of two. Defaults to
+    //! `NSL_SEQUENCER_DEQUE_CAPACITY`.
+    size_t deque_capacity;
+} NSL_SequencerConfig;
+
+typedef struct NSL__SequencerState NSL__SequencerState;
+
+/*!
+ * A work-stealing task scheduler. This must be initialized with
+ * `nsl_sequencer_init` and freed with `nsl_sequencer_free`.
+ */
+typedef struct NSL_Sequencer {
+    //! The number of threads that run tasks.
+    size_t threads;
+    //! Private: the deques of the threads and the state they share.
+    NSL__SequencerState *state;
+} NSL_Sequencer;
+
+/*!
+ * A unit of work in a task graph. This must be initialized with
+ * `nsl_task_init`, and freed with `nsl_task_free` once it has finished.
+ */
+typedef struct NSL_Task NSL_Task;
+struct NSL_Task {
+    //! The function that is run, and the argument it is run with.
+    void (*fn)(void *data);
+    void *data;
+    //! Private: the number of predecessors that have not finished, plus one
+    //! until the task is submitted.
+    _Atomic size_t pending;
+    //! Private: whether the task and the scheduling of its successors have
+    //! finished.
+    _Atomic bool done;
+    //! Private: whether the task frees itself once it has run.
+    bool detached;
+    //! Private: the tasks that wait for this one.
+    NSL_Task **successors;
+    size_t     successor_count;
+    size_t     successor_capacity;
+    //! Private: the next task in the queue of tasks from other threads.
+    NSL_Task *next;
+};
+
+/*!
+ * Starts the threads of a sequencer. The calling thread becomes one of them.
+ *
+ * # Parameters
+ * - `sequencer`: The sequencer to initialize.
+ * - `config`: How the sequencer is set up, or `nullptr` for the defaults.
+ *
+ * # Requires
+ * - `sequencer` is not initialized.
+ *
+ * # Modifies
+ * - `sequencer`: It is initialized.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ *
+ * # Returns
+ * Whether the threads could be started. If not, `sequencer` is not
+ * initialized.
+ */
+NSL_SEQUENCER_DEF bool nsl_sequencer_init(NSL_Sequencer *sequencer,
+                                          const NSL_SequencerConfig *config);
+
+/*!
+ * Stops the threads of a sequencer and frees it.
+ *
+ * # Parameters
+ * - `sequencer`: The sequencer to free.
+ *
+ * # Requires
+ * - `sequencer` is initialized.
+ * - Every submitted task has finished.
+ * - This is called by the thread that called `nsl_sequencer_init`.
+ *
+ * # Modifies
+ * - `sequencer`: It is no longer initialized.
+ */
+NSL_SEQUENCER_DEF void nsl_sequencer_free(NSL_Sequencer *sequencer);
+
+/*!
+ * Initializes a task.
+ *
+ * # Parameters
+ * - `task`: The task to initialize.
+ * - `fn`: The function that is run.
+ * - `data`: The argument given to `fn`.
+ *
+ * # Modifies
+ * - `task`: It is initialized with no predecessors or successors.
+ */
+NSL_SEQUENCER_DEF void nsl_task_init(NSL_Task *task, void (*fn)(void *data), void *data);
+
+/*!
+ * Frees the memory held by a task, but not the task itself.
+ *
+ * # Parameters
+ * - `task`: The task to free.
+ *
+ * # Requires
+ * - `task` has either finished or never been submitted.
+ *
+ * # Modifies
+ * - `task`: It is no longer initialized.
+ */
+NSL_SEQUENCER_DEF void nsl_task_free(NSL_Task *task);
+
+/*!
+ * Makes one task wait for another to finish before it runs.
+ *
+ * # Parameters
+ * - `task`: The task that runs first.
+ * - `successor`: The task that runs after `task`.
+ *
+ * # Requires
+ * - Neither task has been submitted.
+ *
+ * # Modifies
+ * - `task`: `successor` is added to its successors.
+ * - `successor`: It waits for one more predecessor.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_SEQUENCER_DEF void nsl_task_precede(NSL_Task *task, NSL_Task *successor);
+
+/*!
+ * Submits a task to run once all of its predecessors have finished. The tasks
+ * of a graph may be submitted in any order.
+ *
+ * # Parameters
+ * - `sequencer`: The sequencer that runs the task.
+ * - `task`: The task to submit.
+ *
+ * # Requires
+ * - `task` has not been submitted since it was initialized.
+ *
+ * # Modifies
+ * - `task`: It is run, and its successors are released, at some later point.
+ */
+NSL_SEQUENCER_DEF void nsl_sequencer_submit(NSL_Sequencer *sequencer, NSL_Task *task);
+
+/*!
+ * Runs other tasks until a task has finished.
+ *
+ * # Parameters
+ * - `sequencer`: The sequencer that runs the task.
+ * - `task`: The task to wait for.
+ *
+ * # Requires
+ * - `task` has been submitted, or will be by another thread.
+ */
+NSL_SEQUENCER_DEF void nsl_sequencer_wait(NSL_Sequencer *sequencer, NSL_Task *task);
+
+/*!
+ * Runs `fn` over the range `[begin, end)`, split into chunks that run in
+ * parallel, and waits for all of them to finish.
+ *
+ * # Parameters
+ * - `sequencer`: The sequencer that runs the chunks.
+ * - `begin`: The first index.
+ * - `end`: One past the last index.
+ * - `grain`: The number of indices that `fn` is run over at a time, which is
+ *   also the smallest number that is split off for other threads. If zero,
+ *   the range is split into at most eight chunks per thread.
+ * - `fn`: The function that is run over each chunk, from `chunk_begin` up to
+ *   but not including `chunk_end`.
+ * - `data`: The first argument given to `fn`.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_SEQUENCER_DEF void nsl_sequencer_parallel_for(NSL_Sequencer *sequencer,
+                                                  size_t         begin,
+                                                  size_t         end,
+                                                  size_t         grain,
+                                                  void (*fn)(void *data, size_t chunk_begin,
+                                                             size_t chunk_end),
+                                                  void *data);
+
+#endif  // NSL_SEQUENCER_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(SEQUENCER)
+#    ifndef NSL_SEQUENCER_IMPLEMENTATION_GUARD_
+#        define NSL_SEQUENCER_IMPLEMENTATION_GUARD_
+
+#        include <stdatomic.h>
+#        include <stdint.h>
+#        include <stdlib.h>
+#        include <threads.h>
+#        include <unistd.h>
+
+// The indices of a deque are only ever incremented, and are reduced modulo the
+// capacity when the buffer is accessed. The padding keeps `top`, which thieves
+// write, and `bottom`, which only the owner writes, on separate cache lines.
+typedef struct NSL__SequencerWorker {
+    _Atomic int64_t      top;
+    char                 top_padding[64 - sizeof(int64_t)];
+    _Atomic int64_t      bottom;
+    char                 bottom_padding[64 - sizeof(int64_t)];
+    _Atomic(NSL_Task *) *buffer;
+    uint64_t             random;
+    NSL__SequencerState *state;
+    thrd_t               thread;
+} NSL__SequencerWorker;
+
+struct NSL__SequencerState {
+    NSL__SequencerWorker *workers;
+    size_t                count;
+    int64_t               mask;
+    // The number of tasks in all of the queues, which is briefly negative if a
+    // task is taken before its push is counted.
+    _Atomic int64_t queued;
+    _Atomic size_t  sleepers;
+    atomic_bool     stopping;
+    mtx_t           mutex;
+    cnd_t           wake;
+    // The tasks scheduled by threads that are not part of the sequencer.
+    _Atomic size_t injected;
+    mtx_t          inject_mutex;
+    NSL_Task      *inject_head;
+    NSL_Task      *inject_tail;
+};
+
+// A range of a parallel for loop, which is run as a detached task.
+typedef struct NSL__SequencerLoop {
+    NSL__SequencerState *state;
+    void (*fn)(void *data, size_t begin, size_t end);
+    void          *data;
+    size_t         grain;
+    _Atomic size_t remaining;
+} NSL__SequencerLoop;
+
+typedef struct NSL__SequencerRange {
+    NSL_Task            task;
+    NSL__SequencerLoop *loop;
+    size_t              begin;
+    size_t              end;
+} NSL__SequencerRange;
+
+static thread_local NSL__SequencerWorker *g_nsl__sequencer_worker;
+
+static void *nsl__sequencer_alloc(void *ptr, size_t size) {
+    ptr = nsl_realloc(ptr, size);
+    if (ptr == nullptr) {
+        nsl_eprintf("[SEQUENCER] out of memory\n");
+        abort();
+    }
+    return ptr;
+}
+
+// Returns the worker of the calling thread if it belongs to `state`.
+static NSL__SequencerWorker *nsl__sequencer_self(NSL__SequencerState *state) {
+    NSL__SequencerWorker *self = g_nsl__sequencer_worker;
+    return self != nullptr && self->state == state ? self : nullptr;
+}
+
+static bool nsl__sequencer_push(NSL__SequencerWorker *self, NSL_Task *task) {
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed);
+    int64_t top    = atomic_load_explicit(&self->top, memory_order_acquire);
+    if (bottom - top > self->state->mask) { return false; }
+    atomic_store_explicit(&self->buffer[bottom & self->state->mask], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+    return true;
+}
+
+static NSL_Task *nsl__sequencer_take(NSL__SequencerWorker *self) {
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&self->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&self->top, memory_order_relaxed);
+    if (top > bottom) {
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+        return nullptr;
+    }
+
+    NSL_Task *task =
+        atomic_load_explicit(&self->buffer[bottom & self->state->mask], memory_order_relaxed);
+    if (top == bottom) {
+        // The last task may be stolen at the same time, so it goes to whoever
+        // moves `top` first.
+        if (!atomic_compare_exchange_strong_explicit(
+                &self->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            task = nullptr;
+        }
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static NSL_Task *nsl__sequencer_steal(NSL__SequencerWorker *victim) {
+    int64_t top = atomic_load_explicit(&victim->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&victim->bottom, memory_order_acquire);
+    if (top >= bottom) { return nullptr; }
+
+    NSL_Task *task =
+        atomic_load_explicit(&victim->buffer[top & victim->state->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(
+            &victim->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+static void nsl__sequencer_execute(NSL__SequencerState *state, NSL_Task *task);
+
+static void nsl__sequencer_schedule(NSL__SequencerState *state, NSL_Task *task) {
+    NSL__SequencerWorker *self = nsl__sequencer_self(state);
+    if (self != nullptr) {
+        if (!nsl__sequencer_push(self, task)) {
+            nsl__sequencer_execute(state, task);
+            return;
+        }
+    } else {
+        task->next = nullptr;
+        mtx_lock(&state->inject_mutex);
+        if (state->inject_tail == nullptr) {
+            state->inject_head = task;
+        } else {
+            state->inject_tail->next = task;
+        }
+        state->inject_tail = task;
+        atomic_fetch_add_explicit(&state->injected, 1, memory_order_relaxed);
+        mtx_unlock(&state->inject_mutex);
+    }
+
+    // A sleeper counts itself before checking `queued`, and this counts the
+    // task before checking `sleepers`, so at least one of them sees the other.
+    atomic_fetch_add(&state->queued, 1);
+    if (atomic_load(&state->sleepers) > 0) {
+        mtx_lock(&state->mutex);
+        cnd_signal(&state->wake);
+        mtx_unlock(&state->mutex);
+    }
+}
+
+static void nsl__sequencer_release(NSL__SequencerState *state, NSL_Task *task) {
+    if (atomic_fetch_sub_explicit(&task->pending, 1, memory_order_acq_rel) == 1) {
+        nsl__sequencer_schedule(state, task);
+    }
+}
+
+static void nsl__sequencer_execute(NSL__SequencerState *state, NSL_Task *task) {
+    task->fn(task->data);
+    if (task->detached) {
+        nsl_free(task);
+        return;
+    }
+    for (size_t i = 0; i < task->successor_count; i++) {
+        nsl__sequencer_release(state, task->successors[i]);
+    }
+    // The task may be freed as soon as this is seen, so it is not touched after.
+    atomic_store_explicit(&task->done, true, memory_order_release);
+}
+
+// Returns a task from the deque of `self`, the queue of tasks from other
+// threads, or the deque of another thread, in that order.
+static NSL_Task *nsl__sequencer_find(NSL__SequencerState *state, NSL__SequencerWorker *self) {
+    NSL_Task *task = self != nullptr ? nsl__sequencer_take(self) : nullptr;
+
+    if (task == nullptr && atomic_load_explicit(&state->injected, memory_order_relaxed) > 0) {
+        mtx_lock(&state->inject_mutex);
+        task = state->inject_head;
+        if (task != nullptr) {
+            state->inject_head = task->next;
+            if (state->inject_head == nullptr) { state->inject_tail = nullptr; }
+            atomic_fetch_sub_explicit(&state->injected, 1, memory_order_relaxed);
+        }
+        mtx_unlock(&state->inject_mutex);
+    }
+
+    if (task == nullptr) {
+        size_t start = 0;
+        if (self != nullptr) {
+            self->random ^= self->random << 13;
+            self->random ^= self->random >> 7;
+            self->random ^= self->random << 17;
+            start         = (size_t)(self->random % state->count);
+        }
+        for (size_t i = 0; i < state->count && task == nullptr; i++) {
+            NSL__SequencerWorker *victim = &state->workers[(start + i) % state->count];
+            if (victim != self) { task = nsl__sequencer_steal(victim); }
+        }
+    }
+
+    if (task != nullptr) { atomic_fetch_sub(&state->queued, 1); }
+    return task;
+}
+
+static int nsl__sequencer_main(void *arg) {
+    NSL__SequencerWorker *self  = arg;
+    NSL__SequencerState  *state = self->state;
+    g_nsl__sequencer_worker     = self;
+
+    size_t spins = 0;
+    while (!atomic_load_explicit(&state->stopping, memory_order_acquire)) {
+        NSL_Task *task = nsl__sequencer_find(state, self);
+        if (task != nullptr) {
+            nsl__sequencer_execute(state, task);
+            spins = 0;
+        } else if (++spins < NSL_SEQUENCER_SPINS) {
+            thrd_yield();
+        } else {
+            mtx_lock(&state->mutex);
+            atomic_fetch_add(&state->sleepers, 1);
+            while (atomic_load(&state->queued) <= 0 && !atomic_load(&state->stopping)) {
+                cnd_wait(&state->wake, &state->mutex);
+            }
+            atomic_fetch_sub(&state->sleepers, 1);
+            mtx_unlock(&state->mutex);
+            spins = 0;
+        }
+    }
+    return 0;
+}
+
+NSL_SEQUENCER_DEF bool nsl_sequencer_init(NSL_Sequencer *sequencer,
+                                          const NSL_SequencerConfig *config) {
+    NSL_SequencerConfig result = config != nullptr ? *config : (NSL_SequencerConfig){};
+    if (result.threads == 0) {
+        long cpus      = sysconf(_SC_NPROCESSORS_ONLN);
+        result.threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (result.deque_capacity == 0) { result.deque_capacity = NSL_SEQUENCER_DEQUE_CAPACITY; }
+    size_t capacity = 1;
+    while (capacity < result.deque_capacity) {
+        capacity *= 2;
+    }
+
+    NSL__SequencerState *state = nsl__sequencer_alloc(nullptr, sizeof(*state));
+    *state                     = (NSL__SequencerState){
+                            .count = result.threads,
+                            .mask  = (int64_t)capacity - 1,
+    };
+    if (mtx_init(&state->mutex, mtx_plain) != thrd_success) {
+        nsl_free(state);
+        return false;
+    }
+    if (cnd_init(&state->wake) != thrd_success) {
+        mtx_destroy(&state->mutex);
+        nsl_free(state);
+        return false;
+    }
+    if (mtx_init(&state->inject_mutex, mtx_plain) != thrd_success) {
+        cnd_destroy(&state->wake);
+        mtx_destroy(&state->mutex);
+        nsl_free(state);
+        return false;
+    }
+
+    state->workers = nsl__sequencer_alloc(nullptr, state->count * sizeof(*state->workers));
+    for (size_t i = 0; i < state->count; i++) {
+        NSL__SequencerWorker *worker = &state->workers[i];
+        atomic_init(&worker->top, 0);
+        atomic_init(&worker->bottom, 0);
+        worker->buffer = nsl__sequencer_alloc(nullptr, capacity * sizeof(*worker->buffer));
+        worker->random = 0x9e3779b97f4a7c15 * (i + 1);
+        worker->state  = state;
+    }
+
+    sequencer->threads = state->count;
+    sequencer->state   = state;
+    g_nsl__sequencer_worker = &state->workers[0];
+    for (size_t i = 1; i < state->count; i++) {
+        if (thrd_create(&state->workers[i].thread, nsl__sequencer_main, &state->workers[i])
+            != thrd_success) {
+            state->count = i;
+            nsl_sequencer_free(sequencer);
+            return false;
+        }
+    }
+    return true;
+}
+
+NSL_SEQUENCER_DEF void nsl_sequencer_free(NSL_Sequencer *sequencer) {
+    NSL__SequencerState *state = sequencer->state;
+    mtx_lock(&state->mutex);
+    atomic_store_explicit(&state->stopping, true, memory_order_release);
+    cnd_broadcast(&state->wake);
+    mtx_unlock(&state->mutex);
+    for (size_t i = 1; i < state->count; i++) {
+        thrd_join(state->workers[i].thread, nullptr);
+    }
+
+    if (g_nsl__sequencer_worker == &state->workers[0]) { g_nsl__sequencer_worker = nullptr; }
+    for (size_t i = 0; i < sequencer->threads; i++) {
+        nsl_free(state->workers[i].buffer);
+    }
+    nsl_free(state->workers);
+    mtx_destroy(&state->inject_mutex);
+    cnd_destroy(&state->wake);
+    mtx_destroy(&state->mutex);
+    nsl_free(state);
+    sequencer->state = nullptr;
+}
+
+NSL_SEQUENCER_DEF void nsl_task_init(NSL_Task *task, void (*fn)(void *data), void *data) {
+    *task = (NSL_Task){.fn = fn, .data = data};
+    atomic_init(&task->pending, 1);
+    atomic_init(&task->done, false);
+}
+
+NSL_SEQUENCER_DEF void nsl_task_free(NSL_Task *task) {
+    nsl_free(task->successors);
+    task->successors         = nullptr;
+    task->successor_count    = 0;
+    task->successor_capacity = 0;
+}
+
+NSL_SEQUENCER_DEF void nsl_task_precede(NSL_Task *task, NSL_Task *successor) {
+    if (task->successor_count == task->successor_capacity) {
+        task->successor_capacity = task->successor_capacity == 0 ? 4 : 2 * task->successor_capacity;
+        task->successors         = nsl__sequencer_alloc(
+            task->successors, task->successor_capacity * sizeof(*task->successors));
+    }
+    task->successors[task->successor_count++] = successor;
+    atomic_fetch_add_explicit(&successor->pending, 1, memory_order_relaxed);
+}
+
+NSL_SEQUENCER_DEF void nsl_sequencer_submit(NSL_Sequencer *sequencer, NSL_Task *task) {
+    nsl__sequencer_release(sequencer->state, task);
+}
+
+NSL_SEQUENCER_DEF void nsl_sequencer_wait(NSL_Sequencer *sequencer, NSL_Task *task) {
+    NSL__SequencerState  *state = sequencer->state;
+    NSL__SequencerWorker *self  = nsl__sequencer_self(state);
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        NSL_Task *next = nsl__sequencer_find(state, self);
+        if (next != nullptr) {
+            nsl__sequencer_execute(state, next);
+        } else {
+            thrd_yield();
+        }
+    }
+}
+
+// Whether the calling thread should split off work for others, which is when
+// the queue that others would steal it from is nearly empty.
+static bool nsl__sequencer_hungry(NSL__SequencerState *state) {
+    NSL__SequencerWorker *self = nsl__sequencer_self(state);
+    if (self == nullptr) {
+        return atomic_load_explicit(&state->injected, memory_order_relaxed) < 2;
+    }
+    int64_t size = atomic_load_explicit(&self->bottom, memory_order_relaxed)
+                 - atomic_load_explicit(&self->top, memory_order_relaxed);
+    return size < 2;
+}
+
+// Runs a range one grain at a time. Before each grain, while others would
+// have nothing to steal, the upper half of what is left is split off.
+static void nsl__sequencer_range(void *data) {
+    NSL__SequencerRange *range = data;
+    NSL__SequencerLoop  *loop  = range->loop;
+    size_t               begin = range->begin;
+    size_t               end   = range->end;
+
+    while (begin < end) {
+        while (end - begin > loop->grain && nsl__sequencer_hungry(loop->state)) {
+            size_t               middle = begin + (end - begin) / 2;
+            NSL__SequencerRange *half   = nsl__sequencer_alloc(nullptr, sizeof(*half));
+            nsl_task_init(&half->task, nsl__sequencer_range, half);
+            half->task.detached = true;
+            half->loop          = loop;
+            half->begin         = middle;
+            half->end           = end;
+            atomic_store_explicit(&half->task.pending, 0, memory_order_relaxed);
+            nsl__sequencer_schedule(loop->state, &half->task);
+            end = middle;
+        }
+
+        size_t stop = end - begin > loop->grain ? begin + loop->grain : end;
+        loop->fn(loop->data, begin, stop);
+        atomic_fetch_sub_explicit(&loop->remaining, stop - begin, memory_order_release);
+        begin = stop;
+    }
+}
+
+NSL_SEQUENCER_DEF void nsl_sequencer_parallel_for(NSL_Sequencer *sequencer,
+                                                  size_t         begin,
+                                                  size_t         end,
+                                                  size_t         grain,
+                                                  void (*fn)(void *data, size_t chunk_begin,
+                                                             size_t chunk_end),
+                                                  void *data) {
+    if (begin >= end) { return; }
+    NSL__SequencerState *state = sequencer->state;
+    if (grain == 0) { grain = (end - begin) / (8 * state->count); }
+    if (grain == 0) { grain = 1; }
+
+    NSL__SequencerLoop loop = {.state = state, .fn = fn, .data = data, .grain = grain};
+    atomic_init(&loop.remaining, end - begin);
+    NSL__SequencerRange root = {.loop = &loop, .begin = begin, .end = end};
+    nsl__sequencer_range(&root);
+
+    NSL__SequencerWorker *self = nsl__sequencer_self(state);
+    while (atomic_load_explicit(&loop.remaining, memory_order_acquire) > 0) {
+        NSL_Task *next = nsl__sequencer_find(state, self);
+        if (next != nullptr) {
+            nsl__sequencer_execute(state, next);
+        } else {
+            thrd_yield();
+        }
+    }
+}
+
+#    endif  // NSL_SEQUENCER_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(SEQUENCER)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(SEQUENCER)
+#    ifndef NSL_SEQUENCER_STRIP_PREFIX_GUARD_
+#        define NSL_SEQUENCER_STRIP_PREFIX_GUARD_
+
+#        define SequencerConfig        NSL_SequencerConfig
+#        define Sequencer              NSL_Sequencer
+#        define Task                   NSL_Task
+#        define sequencer_init         nsl_sequencer_init
+#        define sequencer_free         nsl_sequencer_free
+#        define task_init              nsl_task_init
+#        define task_free              nsl_task_free
+#        define task_precede           nsl_task_precede
+#        define sequencer_submit       nsl_sequencer_submit
+#        define sequencer_wait         nsl_sequencer_wait
+#        define sequencer_parallel_for nsl_sequencer_parallel_for
+
+#    endif  // NSL_SEQUENCER_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(SEQUENCER)
@@ -0,0 +1,684 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * A compact binary format for snapshots and caches that are shared between
+ * processes. Values are written to an `NSL_StreamWriter` from
+ * `nonstdlib/stream.h` and read back from an `NSL_Deserializer`, which reads
+ * from memory, such as a file mapped with `nonstdlib/mmap.h`.
+ *
+ * The format has no tags or field names, so both sides must agree on the
+ * order of the values:
+ *
+ * - Unsigned integers are LEB128 varints: seven bits per byte, lowest first,
+ *   with the high bit set on every byte but the last. Values below 128 take a
+ *   single byte.
+ * - Signed integers are zigzag encoded first (0, -1, 1, -2, ... become 0, 1,
+ *   2, 3, ...), so that small negative values are small as well.
+ * - Floating point numbers are their 4 or 8 bytes in little endian order.
+ * - Byte strings are their length as a varint followed by the bytes. They are
+ *   read back as views into the input, without copying.
+ * - Arrays of fixed width integers or floats are copied as a whole, in little
+ *   endian order, so on little endian machines they are written and read with
+ *   a single `memcpy`. Their length is written separately.
+ *
+ * `NSL_SERIALIZE_DEFINE` generates a struct along with the functions that
+ * write and read it field by field, in the style of `NSL_ARGS_DEFINE`.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/serialize.h"
+ *
+ * NSL_SERIALIZE_DEFINE(Entry,
+ *                      entry,
+ *                      NSL_SERIALIZE_BYTES(key),
+ *                      NSL_SERIALIZE_U64(hits),
+ *                      NSL_SERIALIZE_F64(score))
+ *
+ * void save(NSL_StreamWriter *out, const Entry *entries, size_t count) {
+ *     nsl_serialize_u64(out, count);
+ *     for (size_t i = 0; i < count; i++) {
+ *         entry_serialize(out, &entries[i]);
+ *     }
+ * }
+ *
+ * bool load(NSL_StringView snapshot, Entry *entries, size_t capacity) {
+ *     NSL_Deserializer in = {.input = snapshot};
+ *     uint64_t         count;
+ *     if (!nsl_deserialize_u64(&in, &count) || count > capacity) { return false; }
+ *     for (size_t i = 0; i < count; i++) {
+ *         // entries[i].key points into `snapshot`
+ *         if (!entry_deserialize(&in, &entries[i])) { return false; }
+ *     }
+ *     return true;
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_SERIALIZE_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will
+ *   only include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_SERIALIZE_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_SERIALIZE_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ */
+
+#ifndef NSL_SERIALIZE_H_
+#define NSL_SERIALIZE_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_SERIALIZE_VERSION_MAJOR 0
+#define NSL_SERIALIZE_VERSION_MINOR 1
+#define NSL_SERIALIZE_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+#include "nonstdlib/stream.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_SERIALIZE_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_SERIALIZE_DEF
+#    define NSL_SERIALIZE_DEF
+#endif  // NSL_SERIALIZE_DEF
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * Reads values from memory. It can be initialized directly, as in
+ * `(NSL_Deserializer){.input = view}`.
+ */
+typedef struct NSL_Deserializer {
+    //! The bytes that are read.
+    NSL_StringView input;
+    //! The number of bytes that have been read.
+    size_t position;
+    //! Whether a read has failed because the input was truncated or malformed.
+    //! Every read fails once one has.
+    bool failed;
+} NSL_Deserializer;
+
+/*!
+ * Declares a field of `NSL_SERIALIZE_DEFINE` as a `uint64_t` that is written
+ * as a varint.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ */
+#define NSL_SERIALIZE_U64(name) (u64, name, , )
+
+/*!
+ * Declares a field of `NSL_SERIALIZE_DEFINE` as an `int64_t` that is written
+ * as a zigzag varint.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ */
+#define NSL_SERIALIZE_I64(name) (i64, name, , )
+
+/*!
+ * Declares a field of `NSL_SERIALIZE_DEFINE` as a `double`.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ */
+#define NSL_SERIALIZE_F64(name) (f64, name, , )
+
+/*!
+ * Declares a field of `NSL_SERIALIZE_DEFINE` as a `bool`, which is written as
+ * a single byte.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ */
+#define NSL_SERIALIZE_BOOL(name) (boolean, name, , )
+
+/*!
+ * Declares a field of `NSL_SERIALIZE_DEFINE` as an `NSL_StringView`, which is
+ * read back as a view into the input.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ */
+#define NSL_SERIALIZE_BYTES(name) (bytes, name, , )
+
+/*!
+ * Declares a field of `NSL_SERIALIZE_DEFINE` whose type is another struct
+ * generated by `NSL_SERIALIZE_DEFINE`.
+ *
+ * # Parameters
+ * - `name`: The name of the field.
+ * - `type`: The struct type of the field.
+ * - `prefix`: The prefix that `type` was defined with.
+ */
+#define NSL_SERIALIZE_STRUCT(name, type, prefix) (nested, name, type, prefix)
+
+/*!
+ * Defines a struct that can be serialized. This generates:
+ *
+ * - `type`, a struct with a field for each field that is given.
+ * - `void prefix_serialize(NSL_StreamWriter *out, const type *value)`, which
+ *   writes every field in order.
+ * - `bool prefix_deserialize(NSL_Deserializer *in, type *value)`, which reads
+ *   every field in order, and returns whether all of them could be read.
+ *
+ * The functions are `static`, so the struct can be defined in a header that
+ * is shared by the programs that write and read it.
+ *
+ * # Parameters
+ * - `type`: The name of the generated struct.
+ * - `prefix`: The prefix of the generated functions.
+ * - `...`: The fields, each declared with `NSL_SERIALIZE_U64`,
+ *   `NSL_SERIALIZE_I64`, `NSL_SERIALIZE_F64`, `NSL_SERIALIZE_BOOL`,
+ *   `NSL_SERIALIZE_BYTES` or `NSL_SERIALIZE_STRUCT`.
+ *
+ * # Requires
+ * - There is at least one field.
+ */
+#define NSL_SERIALIZE_DEFINE(type, prefix, ...)                                                    \
+    typedef struct type {                                                                          \
+        NSL_NSEP(;, NSL_FOREACH(NSL__SERIALIZE_FIELD, __VA_ARGS__));                               \
+    } type;                                                                                        \
+                                                                                                   \
+    [[maybe_unused]] static void NSL_CAT(prefix, _serialize)(NSL_StreamWriter *out,                \
+                                                             const type *value) {                  \
+        NSL_NSEP(, NSL_FOREACH(NSL__SERIALIZE_WRITE, __VA_ARGS__))                                 \
+    }                                                                                              \
+                                                                                                   \
+    [[maybe_unused]] static bool NSL_CAT(prefix, _deserialize)(NSL_Deserializer *in,               \
+                                                               type *value) {                      \
+        return NSL_NSEP(&&, NSL_FOREACH(NSL__SERIALIZE_READ, __VA_ARGS__));                        \
+    }
+
+/*!
+ * Writes an unsigned integer as a varint.
+ *
+ * # Parameters
+ * - `out`: The writer to write to.
+ * - `value`: The value to write.
+ *
+ * # Requires
+ * - `out` is initialized.
+ *
+ * # Modifies
+ * - `out`: Between 1 and 10 bytes are written to it.
+ */
+NSL_SERIALIZE_DEF void nsl_serialize_u64(NSL_StreamWriter *out, uint64_t value);
+
+/*!
+ * Writes a signed integer as a zigzag varint.
+ *
+ * # Parameters
+ * - `out`: The writer to write to.
+ * - `value`: The value to write.
+ *
+ * # Requires
+ * - `out` is initialized.
+ *
+ * # Modifies
+ * - `out`: Between 1 and 10 bytes are written to it.
+ */
+NSL_SERIALIZE_DEF void nsl_serialize_i64(NSL_StreamWriter *out, int64_t value);
+
+/*!
+ * Writes a `float` as 4 little endian bytes.
+ *
+ * # Parameters
+ * - `out`: The writer to write to.
+ * - `value`: The value to write.
+ *
+ * # Requires
+ * - `out` is initialized.
+ *
+ * # Modifies
+ * - `out`: 4 bytes are written to it.
+ */
+NSL_SERIALIZE_DEF void nsl_serialize_f32(NSL_StreamWriter *out, float value);
+
+/*!
+ * Writes a `double` as 8 little endian bytes.
+ *
+ * # Parameters
+ * - `out`: The writer to write to.
+ * - `value`: The value to write.
+ *
+ * # Requires
+ * - `out` is initialized.
+ *
+ * # Modifies
+ * - `out`: 8 bytes are written to it.
+ */
+NSL_SERIALIZE_DEF void nsl_serialize_f64(NSL_StreamWriter *out, double value);
+
+/*!
+ * Writes a byte string as its length followed by its bytes.
+ *
+ * # Parameters
+ * - `out`: The writer to write to.
+ * - `bytes`: The bytes to write.
+ *
+ * # Requires
+ * - `out` is initialized.
+ *
+ * # Modifies
+ * - `out`: The length and the bytes are written to it.
+ */
+NSL_SERIALIZE_DEF void nsl_serialize_bytes(NSL_StreamWriter *out, NSL_StringView bytes);
+
+/*!
+ * Writes an array of fixed width integers or floats in little endian order.
+ * The number of items is not written.
+ *
+ * # Parameters
+ * - `out`: The writer to write to.
+ * - `items`: The first item.
+ * - `count`: The number of items.
+ * - `size`: The size of each item in bytes.
+ *
+ * # Requires
+ * - `out` is initialized.
+ * - `size` is 1, 2, 4 or 8, and the items are integers or floats of that
+ *   size.
+ *
+ * # Modifies
+ * - `out`: `count * size` bytes are written to it.
+ */
+NSL_SERIALIZE_DEF void
+nsl_serialize_items(NSL_StreamWriter *out, const void *items, size_t count, size_t size);
+
+/*!
+ * Reads an unsigned integer written by `nsl_serialize_u64`.
+ *
+ * # Parameters
+ * - `in`: The input to read from.
+ * - `value`: Where the value is stored.
+ *
+ * # Modifies
+ * - `in`: It is moved past the value, or marked as failed.
+ * - `value`: It is set if the value could be read.
+ *
+ * # Returns
+ * Whether the value could be read.
+ */
+NSL_SERIALIZE_DEF bool nsl_deserialize_u64(NSL_Deserializer *in, uint64_t *value);
+
+/*!
+ * Reads a signed integer written by `nsl_serialize_i64`.
+ *
+ * # Parameters
+ * - `in`: The input to read from.
+ * - `value`: Where the value is stored.
+ *
+ * # Modifies
+ * - `in`: It is moved past the value, or marked as failed.
+ * - `value`: It is set if the value could be read.
+ *
+ * # Returns
+ * Whether the value could be read.
+ */
+NSL_SERIALIZE_DEF bool nsl_deserialize_i64(NSL_Deserializer *in, int64_t *value);
+
+/*!
+ * Reads a `float` written by `nsl_serialize_f32`.
+ *
+ * # Parameters
+ * - `in`: The input to read from.
+ * - `value`: Where the value is stored.
+ *
+ * # Modifies
+ * - `in`: It is moved past the value, or marked as failed.
+ * - `value`: It is set if the value could be read.
+ *
+ * # Returns
+ * Whether the value could be read.
+ */
+NSL_SERIALIZE_DEF bool nsl_deserialize_f32(NSL_Deserializer *in, float *value);
+
+/*!
+ * Reads a `double` written by `nsl_serialize_f64`.
+ *
+ * # Parameters
+ * - `in`: The input to read from.
+ * - `value`: Where the value is stored.
+ *
+ * # Modifies
+ * - `in`: It is moved past the value, or marked as failed.
+ * - `value`: It is set if the value could be read.
+ *
+ * # Returns
+ * Whether the value could be read.
+ */
+NSL_SERIALIZE_DEF bool nsl_deserialize_f64(NSL_Deserializer *in, double *value);
+
+/*!
+ * Reads a byte string written by `nsl_serialize_bytes`.
+ *
+ * # Parameters
+ * - `in`: The input to read from.
+ * - `bytes`: Where the view of the bytes is stored.
+ *
+ * # Modifies
+ * - `in`: It is moved past the bytes, or marked as failed.
+ * - `bytes`: It is set to a view into the input if the bytes could be read.
+ *
+ * # Returns
+ * Whether the bytes could be read.
+ */
+NSL_SERIALIZE_DEF bool nsl_deserialize_bytes(NSL_Deserializer *in, NSL_StringView *bytes);
+
+/*!
+ * Reads an array written by `nsl_serialize_items`.
+ *
+ * # Parameters
+ * - `in`: The input to read from.
+ * - `items`: Where the items are stored.
+ * - `count`: The number of items.
+ * - `size`: The size of each item in bytes.
+ *
+ * # Requires
+ * - `items` has room for `count` items.
+ * - `size` is the size that the items were written with.
+ *
+ * # Modifies
+ * - `in`: It is moved past the items, or marked as failed.
+ * - `items`: The items are stored in it if they could be read.
+ *
+ * # Returns
+ * Whether the items could be read.
+ */
+NSL_SERIALIZE_DEF bool
+nsl_deserialize_items(NSL_Deserializer *in, void *items, size_t count, size_t size);
+
+// A field is `(kind, name, type, prefix)`, where the last two are only used by
+// nested structs. `NSL__SERIALIZE_APPLY` unpacks the tuple into the arguments
+// of a macro.
+#define NSL__SERIALIZE_APPLY(macro, ...) macro(__VA_ARGS__)
+#define NSL__SERIALIZE_UNPACK(...)       __VA_ARGS__
+
+#define NSL__SERIALIZE_FIELD(field)                                                                \
+    NSL__SERIALIZE_APPLY(NSL__SERIALIZE_FIELD_, NSL__SERIALIZE_UNPACK field)
+#define NSL__SERIALIZE_FIELD_(kind, name, type, prefix)                                            \
+    NSL_CAT(NSL__SERIALIZE_TYPE_, kind)(type) name
+#define NSL__SERIALIZE_TYPE_u64(type)     uint64_t
+#define NSL__SERIALIZE_TYPE_i64(type)     int64_t
+#define NSL__SERIALIZE_TYPE_f64(type)     double
+#define NSL__SERIALIZE_TYPE_boolean(type) bool
+#define NSL__SERIALIZE_TYPE_bytes(type)   NSL_StringView
+#define NSL__SERIALIZE_TYPE_nested(type)  type
+
+#define NSL__SERIALIZE_WRITE(field)                                                                \
+    NSL__SERIALIZE_APPLY(NSL__SERIALIZE_WRITE_, NSL__SERIALIZE_UNPACK field)
+#define NSL__SERIALIZE_WRITE_(kind, name, type, prefix)                                            \
+    NSL_CAT(NSL__SERIALIZE_WRITE_, kind)(out, value->name, prefix);
+#define NSL__SERIALIZE_WRITE_u64(out, field, prefix)     nsl_serialize_u64(out, field)
+#define NSL__SERIALIZE_WRITE_i64(out, field, prefix)     nsl_serialize_i64(out, field)
+#define NSL__SERIALIZE_WRITE_f64(out, field, prefix)     nsl_serialize_f64(out, field)
+#define NSL__SERIALIZE_WRITE_boolean(out, field, prefix) nsl_serialize_u64(out, field)
+#define NSL__SERIALIZE_WRITE_bytes(out, field, prefix)   nsl_serialize_bytes(out, field)
+#define NSL__SERIALIZE_WRITE_nested(out, field, prefix)  NSL_CAT(prefix, _serialize)(out, &field)
+
+#define NSL__SERIALIZE_READ(field)                                                                 \
+    NSL__SERIALIZE_APPLY(NSL__SERIALIZE_READ_, NSL__SERIALIZE_UNPACK field)
+#define NSL__SERIALIZE_READ_(kind, name, type, prefix)                                             \
+    NSL_CAT(NSL__SERIALIZE_READ_, kind)(in, &value->name, prefix)
+#define NSL__SERIALIZE_READ_u64(in, field, prefix)     nsl_deserialize_u64(in, field)
+#define NSL__SERIALIZE_READ_i64(in, field, prefix)     nsl_deserialize_i64(in, field)
+#define NSL__SERIALIZE_READ_f64(in, field, prefix)     nsl_deserialize_f64(in, field)
+#define NSL__SERIALIZE_READ_boolean(in, field, prefix) nsl__deserialize_bool(in, field)
+#define NSL__SERIALIZE_READ_bytes(in, field, prefix)   nsl_deserialize_bytes(in, field)
+#define NSL__SERIALIZE_READ_nested(in, field, prefix)  NSL_CAT(prefix, _deserialize)(in, field)
+
+NSL_SERIALIZE_DEF bool nsl__deserialize_bool(NSL_Deserializer *in, bool *value);
+
+#endif  // NSL_SERIALIZE_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(SERIALIZE)
+#    ifndef NSL_SERIALIZE_IMPLEMENTATION_GUARD_
+#        define NSL_SERIALIZE_IMPLEMENTATION_GUARD_
+
+#        include <string.h>
+
+#        if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#            define NSL__SERIALIZE_BIG_ENDIAN 1
+#        else
+#            define NSL__SERIALIZE_BIG_ENDIAN 0
+#        endif
+
+// Reverses the bytes of each of `count` items of `size` bytes in place.
+static void nsl__serialize_swap(char *items, size_t count, size_t size) {
+    for (size_t i = 0; i < count; i++) {
+        char *item = items + i * size;
+        for (size_t j = 0; j < size / 2; j++) {
+            char byte          = item[j];
+            item[j]            = item[size - 1 - j];
+            item[size - 1 - j] = byte;
+        }
+    }
+}
+
+// Returns the next `length` bytes of `in` and moves past them, or marks `in`
+// as failed and returns `nullptr` if there are not that many.
+static const char *nsl__deserialize_take(NSL_Deserializer *in, size_t length) {
+    if (in->failed || in->input.length - in->position < length) {
+        in->failed = true;
+        return nullptr;
+    }
+    const char *bytes  = in->input.data + in->position;
+    in->position      += length;
+    return bytes;
+}
+
+NSL_SERIALIZE_DEF void nsl_serialize_u64(NSL_StreamWriter *out, uint64_t value) {
+    unsigned char *bytes  = (unsigned char *)nsl_stream_reserve(out, 10);
+    size_t         length = 0;
+    while (value >= 0x80) {
+        bytes[length++]   = (unsigned char)(value | 0x80);
+        value           >>= 7;
+    }
+    bytes[length++] = (unsigned char)value;
+    nsl_stream_commit(out, length);
+}
+
+NSL_SERIALIZE_DEF void nsl_serialize_i64(NSL_StreamWriter *out, int64_t value) {
+    nsl_serialize_u64(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+NSL_SERIALIZE_DEF void nsl_serialize_f32(NSL_StreamWriter *out, float value) {
+    nsl_serialize_items(out, &value, 1, sizeof(value));
+}
+
+NSL_SERIALIZE_DEF void nsl_serialize_f64(NSL_StreamWriter *out, double value) {
+    nsl_serialize_items(out, &value, 1, sizeof(value));
+}
+
+NSL_SERIALIZE_DEF void nsl_serialize_bytes(NSL_StreamWriter *out, NSL_StringView bytes) {
+    nsl_serialize_u64(out, bytes.length);
+    nsl_stream_write(out, bytes.data, bytes.length);
+}
+
+NSL_SERIALIZE_DEF void
+nsl_serialize_items(NSL_StreamWriter *out, const void *items, size_t count, size_t size) {
+    if (!NSL__SERIALIZE_BIG_ENDIAN || size == 1) {
+        nsl_stream_write(out, items, count * size);
+        return;
+    }
+    // a buffer's worth of items at a time, swapped in the writer's buffer
+    size_t per_chunk = out->capacity / size;
+    for (size_t done = 0; done < count;) {
+        size_t chunk = count - done < per_chunk ? count - done : per_chunk;
+        char  *room  = nsl_stream_reserve(out, chunk * size);
+        memcpy(room, (const char *)items + done * size, chunk * size);
+        nsl__serialize_swap(room, chunk, size);
+        nsl_stream_commit(out, chunk * size);
+        done += chunk;
+    }
+}
+
+NSL_SERIALIZE_DEF bool nsl_deserialize_u64(NSL_Deserializer *in, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        const unsigned char *byte = (const unsigned char *)nsl__deserialize_take(in, 1);
+        if (byte == nullptr) { return false; }
+        // the tenth byte only has room for the highest bit
+        if (shift == 63 && *byte > 1) { break; }
+        result |= (uint64_t)(*byte & 0x7f) << shift;
+        if (*byte < 0x80) {
+            *value = result;
+            return true;
+        }
+    }
+    in->failed = true;
+    return false;
+}
+
+NSL_SERIALIZE_DEF bool nsl_deserialize_i64(NSL_Deserializer *in, int64_t *value) {
+    uint64_t encoded;
+    if (!nsl_deserialize_u64(in, &encoded)) { return false; }
+    *value = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+    return true;
+}
+
+NSL_SERIALIZE_DEF bool nsl_deserialize_f32(NSL_Deserializer *in, float *value) {
+    return nsl_deserialize_items(in, value, 1, sizeof(*value));
+}
+
+NSL_SERIALIZE_DEF bool nsl_deserialize_f64(NSL_Deserializer *in, double *value) {
+    return nsl_deserialize_items(in, value, 1, sizeof(*value));
+}
+
+NSL_SERIALIZE_DEF bool nsl_deserialize_bytes(NSL_Deserializer *in, NSL_StringView *bytes) {
+    uint64_t length;
+    if (!nsl_deserialize_u64(in, &length)) { return false; }
+    if (length > SIZE_MAX) {
+        in->failed = true;
+        return false;
+    }
+    const char *data = nsl__deserialize_take(in, (size_t)length);
+    if (data == nullptr) { return false; }
+    *bytes = (NSL_StringView){data, (size_t)length};
+    return true;
+}
+
+NSL_SERIALIZE_DEF bool
+nsl_deserialize_items(NSL_Deserializer *in, void *items, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        in->failed = true;
+        return false;
+    }
+    const char *data = nsl__deserialize_take(in, count * size);
+    if (data == nullptr) { return false; }
+    memcpy(items, data, count * size);
+    if (NSL__SERIALIZE_BIG_ENDIAN) { nsl__serialize_swap(items, count, size); }
+    return true;
+}
+
+NSL_SERIALIZE_DEF bool nsl__deserialize_bool(NSL_Deserializer *in, bool *value) {
+    uint64_t encoded;
+    if (!nsl_deserialize_u64(in, &encoded)) { return false; }
+    if (encoded > 1) {
+        in->failed = true;
+        return false;
+    }
+    *value = encoded == 1;
+    return true;
+}
+
+#    endif  // NSL_SERIALIZE_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(SERIALIZE)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(SERIALIZE)
+#    ifndef NSL_SERIALIZE_STRIP_PREFIX_GUARD_
+#        define NSL_SERIALIZE_STRIP_PREFIX_GUARD_
+
+#        define Deserializer      NSL_Deserializer
+#        define SERIALIZE_U64     NSL_SERIALIZE_U64
+#        define SERIALIZE_I64     NSL_SERIALIZE_I64
+#        define SERIALIZE_F64     NSL_SERIALIZE_F64
+#        define SERIALIZE_BOOL    NSL_SERIALIZE_BOOL
+#        define SERIALIZE_BYTES   NSL_SERIALIZE_BYTES
+#        define SERIALIZE_STRUCT  NSL_SERIALIZE_STRUCT
+#        define SERIALIZE_DEFINE  NSL_SERIALIZE_DEFINE
+#        define serialize_u64     nsl_serialize_u64
+#        define serialize_i64     nsl_serialize_i64
+#        define serialize_f32     nsl_serialize_f32
+#        define serialize_f64     nsl_serialize_f64
+#        define serialize_bytes   nsl_serialize_bytes
+#        define serialize_items   nsl_serialize_items
+#        define deserialize_u64   nsl_deserialize_u64
+#        define deserialize_i64   nsl_deserialize_i64
+#        define deserialize_f32   nsl_deserialize_f32
+#        define deserialize_f64   nsl_deserialize_f64
+#        define deserialize_bytes nsl_deserialize_bytes
+#        define deserialize_items nsl_deserialize_items
+
+#    endif  // NSL_SERIALIZE_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(SERIALIZE)
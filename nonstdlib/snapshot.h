@@ -0,0 +1,567 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * Read-only hash tables that are stored in a file and queried where they lie,
+ * for lookup tables that are expensive to build but rarely change. A table is
+ * built once with `NSL_SnapshotBuilder` and written with `nsl_snapshot_write`.
+ * Opening it with `nsl_snapshot_open` maps the file and checks its header, so
+ * it is ready for lookups in constant time no matter how large it is, and
+ * every process that opens the same file shares its pages in the page cache.
+ *
+ * The file only holds offsets from its start, never addresses, so it can be
+ * mapped at any address, or queried from any other memory with
+ * `nsl_snapshot_view`. All integers are little endian. The file is laid out
+ * as:
+ *
+ * - A header of 40 bytes: the magic bytes `NSLSNAP` followed by a version
+ *   byte, then the size of the file, the number of slots, the number of
+ *   entries and the offset of the slots, each as a `uint64_t`.
+ * - The slots, a power of two of them, at most half of which are used. Each
+ *   is the hash of a key and the offset of its entry as two `uint64_t`, or
+ *   zeros if it is empty. Keys are placed by linear probing.
+ * - The entries, each aligned to 8 bytes: the length of the key and of the
+ *   value as two `uint32_t`, the value, then the key. Values start 8 bytes
+ *   into their entry, so they are aligned to 8 bytes as well, and values that
+ *   hold plain structs can be used in place.
+ *
+ * Offsets and lengths are checked when they are used, so a corrupt or
+ * truncated file cannot make a lookup read outside of it.
+ *
+ * This module is Linux only, and needs `_DEFAULT_SOURCE` (or `_GNU_SOURCE`)
+ * to be defined before any header is included, as `nonstdlib/mmap.h` does.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _DEFAULT_SOURCE
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/snapshot.h"
+ *
+ * void save(int fd) {
+ *     NSL_SnapshotBuilder builder;
+ *     nsl_snapshot_builder_init(&builder);
+ *     nsl_snapshot_add(&builder, (NSL_StringView){"alice", 5}, (NSL_StringView){"admin", 5});
+ *     nsl_snapshot_add(&builder, (NSL_StringView){"bob", 3}, (NSL_StringView){"guest", 5});
+ *
+ *     NSL_StreamWriter out;
+ *     nsl_stream_writer_init(&out, fd, 0);
+ *     nsl_snapshot_write(&builder, &out);
+ *     nsl_stream_writer_free(&out);
+ *     nsl_snapshot_builder_free(&builder);
+ * }
+ *
+ * int main() {
+ *     NSL_Snapshot snapshot;
+ *     if (!nsl_snapshot_open(&snapshot, "roles.snapshot")) { return 1; }
+ *     NSL_StringView role;
+ *     if (nsl_snapshot_get(&snapshot, (NSL_StringView){"alice", 5}, &role)) {
+ *         printf("alice is " NSL_SV_FMT "\n", NSL_SV_ARG(role));
+ *     }
+ *     nsl_snapshot_close(&snapshot);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_SNAPSHOT_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_SNAPSHOT_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only
+ *   strip prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_SNAPSHOT_DEF`: Can be defined to change the storage class or linkage
+ *   of the functions in this module (e.g. `static`).
+ */
+
+#ifndef NSL_SNAPSHOT_H_
+#define NSL_SNAPSHOT_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_SNAPSHOT_VERSION_MAJOR 0
+#define NSL_SNAPSHOT_VERSION_MINOR 1
+#define NSL_SNAPSHOT_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+#include "nonstdlib/mmap.h"
+#include "nonstdlib/stream.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_SNAPSHOT_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_SNAPSHOT_DEF
+#    define NSL_SNAPSHOT_DEF
+#endif  // NSL_SNAPSHOT_DEF
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+typedef struct NSL__SnapshotEntry NSL__SnapshotEntry;
+
+/*!
+ * Collects the entries of a table before it is written.
+ */
+typedef struct NSL_SnapshotBuilder {
+    //! The number of entries that have been added.
+    size_t count;
+    //! Private: The entries, which point into `data`.
+    NSL__SnapshotEntry *entries;
+    size_t              capacity;
+    //! Private: The keys and values of every entry.
+    char  *data;
+    size_t data_length;
+    size_t data_capacity;
+} NSL_SnapshotBuilder;
+
+/*!
+ * A table that has been written by `nsl_snapshot_write`.
+ */
+typedef struct NSL_Snapshot {
+    //! The bytes of the whole table.
+    NSL_StringView bytes;
+    //! The number of entries in the table.
+    uint64_t count;
+    //! Private: The number of slots minus one.
+    uint64_t slot_mask;
+    //! Private: The offset of the slots.
+    uint64_t slots;
+    //! Private: The file that `bytes` is mapped from, if it was opened with
+    //! `nsl_snapshot_open`.
+    NSL_MmapFile file;
+    bool         mapped;
+} NSL_Snapshot;
+
+/*!
+ * Initializes an empty builder.
+ *
+ * # Parameters
+ * - `builder`: The builder to initialize.
+ *
+ * # Modifies
+ * - `builder`: It is initialized.
+ */
+NSL_SNAPSHOT_DEF void nsl_snapshot_builder_init(NSL_SnapshotBuilder *builder);
+
+/*!
+ * Frees a builder.
+ *
+ * # Parameters
+ * - `builder`: The builder to free.
+ *
+ * # Requires
+ * - `builder` is initialized.
+ *
+ * # Modifies
+ * - `builder`: It is no longer initialized.
+ */
+NSL_SNAPSHOT_DEF void nsl_snapshot_builder_free(NSL_SnapshotBuilder *builder);
+
+/*!
+ * Adds an entry to a builder. The key and value are copied.
+ *
+ * # Parameters
+ * - `builder`: The builder to add to.
+ * - `key`: The key of the entry.
+ * - `value`: The value of the entry.
+ *
+ * # Requires
+ * - `builder` is initialized.
+ * - `key` has not been added to `builder` before.
+ * - `key` and `value` are shorter than 4 GiB.
+ *
+ * # Modifies
+ * - `builder`: The entry is added.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_SNAPSHOT_DEF void
+nsl_snapshot_add(NSL_SnapshotBuilder *builder, NSL_StringView key, NSL_StringView value);
+
+/*!
+ * Writes the table of every entry in a builder.
+ *
+ * # Parameters
+ * - `builder`: The builder to write.
+ * - `out`: The writer to write to.
+ *
+ * # Requires
+ * - `builder` is initialized.
+ * - `out` is initialized, and nothing has been written to its file since it
+ *   was created, so that the table starts the file.
+ *
+ * # Modifies
+ * - `out`: The table is written to it. It still has to be flushed.
+ *
+ * # Aborts
+ * - If memory cannot be allocated.
+ */
+NSL_SNAPSHOT_DEF void nsl_snapshot_write(const NSL_SnapshotBuilder *builder, NSL_StreamWriter *out);
+
+/*!
+ * Maps a file written by `nsl_snapshot_write`, and checks its header.
+ *
+ * # Parameters
+ * - `snapshot`: The table to initialize.
+ * - `path`: The path of the file.
+ *
+ * # Modifies
+ * - `snapshot`: It is initialized.
+ * - `errno`: It is set if the file could not be opened or mapped, and to
+ *   `EINVAL` if it is not a table.
+ *
+ * # Returns
+ * Whether the file is a table and could be mapped. If not, `snapshot` is not
+ * initialized.
+ */
+NSL_SNAPSHOT_DEF bool nsl_snapshot_open(NSL_Snapshot *snapshot, const char *path);
+
+/*!
+ * Uses a table that is already in memory, and checks its header.
+ *
+ * # Parameters
+ * - `snapshot`: The table to initialize.
+ * - `bytes`: The bytes of the table.
+ *
+ * # Requires
+ * - `bytes` stays valid for as long as `snapshot` is used.
+ *
+ * # Modifies
+ * - `snapshot`: It is initialized.
+ *
+ * # Returns
+ * Whether `bytes` is a table. If not, `snapshot` is not initialized.
+ */
+NSL_SNAPSHOT_DEF bool nsl_snapshot_view(NSL_Snapshot *snapshot, NSL_StringView bytes);
+
+/*!
+ * Unmaps a table if it was opened with `nsl_snapshot_open`.
+ *
+ * # Parameters
+ * - `snapshot`: The table to close.
+ *
+ * # Requires
+ * - `snapshot` is initialized.
+ *
+ * # Modifies
+ * - `snapshot`: It is no longer initialized, and every value from it is
+ *   invalid if it was mapped.
+ */
+NSL_SNAPSHOT_DEF void nsl_snapshot_close(NSL_Snapshot *snapshot);
+
+/*!
+ * Looks up the value of a key.
+ *
+ * # Parameters
+ * - `snapshot`: The table to search.
+ * - `key`: The key to look up.
+ * - `value`: Where the value is stored.
+ *
+ * # Requires
+ * - `snapshot` is initialized.
+ *
+ * # Modifies
+ * - `value`: It is set to a view of the value in the table if the key is
+ *   found.
+ *
+ * # Returns
+ * Whether the key is in the table. Entries that are out of the bounds of the
+ * table are treated as missing.
+ */
+NSL_SNAPSHOT_DEF bool
+nsl_snapshot_get(const NSL_Snapshot *snapshot, NSL_StringView key, NSL_StringView *value);
+
+#endif  // NSL_SNAPSHOT_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(SNAPSHOT)
+#    ifndef NSL_SNAPSHOT_IMPLEMENTATION_GUARD_
+#        define NSL_SNAPSHOT_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <string.h>
+
+#        define NSL__SNAPSHOT_MAGIC  "NSLSNAP\x01"
+#        define NSL__SNAPSHOT_HEADER 40
+
+struct NSL__SnapshotEntry {
+    uint64_t hash;
+    size_t   offset;
+    uint32_t key_length;
+    uint32_t value_length;
+};
+
+static void *nsl__snapshot_alloc(void *ptr, size_t size) {
+    ptr = nsl_realloc(ptr, size);
+    if (ptr == nullptr) {
+        nsl_eprintf("[SNAPSHOT] out of memory\n");
+        nsl_abort();
+    }
+    return ptr;
+}
+
+// The hash of `nonstdlib/phash.h`: 64-bit FNV-1a followed by the finalizer of
+// MurmurHash3. It is part of the file format, so it must never change.
+static uint64_t nsl__snapshot_hash(NSL_StringView key) {
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (size_t i = 0; i < key.length; i++) {
+        hash = (hash ^ (uint64_t)(unsigned char)key.data[i]) * 0x100000001b3u;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdu;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53u;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Little endian loads and stores, which compile to plain moves on little
+// endian machines.
+static uint64_t nsl__snapshot_load(const char *bytes, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= (uint64_t)(unsigned char)bytes[i] << (8 * i);
+    }
+    return value;
+}
+
+static void nsl__snapshot_store(char *bytes, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = (char)(value >> (8 * i));
+    }
+}
+
+static size_t nsl__snapshot_align(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+NSL_SNAPSHOT_DEF void nsl_snapshot_builder_init(NSL_SnapshotBuilder *builder) {
+    *builder = (NSL_SnapshotBuilder){};
+}
+
+NSL_SNAPSHOT_DEF void nsl_snapshot_builder_free(NSL_SnapshotBuilder *builder) {
+    nsl_free(builder->entries);
+    nsl_free(builder->data);
+}
+
+NSL_SNAPSHOT_DEF void
+nsl_snapshot_add(NSL_SnapshotBuilder *builder, NSL_StringView key, NSL_StringView value) {
+    if (builder->count == builder->capacity) {
+        builder->capacity = builder->capacity == 0 ? 64 : 2 * builder->capacity;
+        builder->entries  = nsl__snapshot_alloc(builder->entries,
+                                               builder->capacity * sizeof(NSL__SnapshotEntry));
+    }
+    size_t length = key.length + value.length;
+    if (builder->data_capacity - builder->data_length < length) {
+        builder->data_capacity = 2 * (builder->data_capacity + length);
+        builder->data          = nsl__snapshot_alloc(builder->data, builder->data_capacity);
+    }
+    char *data = builder->data + builder->data_length;
+    if (value.length > 0) { memcpy(data, value.data, value.length); }
+    if (key.length > 0) { memcpy(data + value.length, key.data, key.length); }
+    builder->entries[builder->count++] = (NSL__SnapshotEntry){
+        .hash         = nsl__snapshot_hash(key),
+        .offset       = builder->data_length,
+        .key_length   = (uint32_t)key.length,
+        .value_length = (uint32_t)value.length,
+    };
+    builder->data_length += length;
+}
+
+NSL_SNAPSHOT_DEF void
+nsl_snapshot_write(const NSL_SnapshotBuilder *builder, NSL_StreamWriter *out) {
+    uint64_t slot_count = 2;
+    while (slot_count < 2 * (uint64_t)builder->count) {
+        slot_count *= 2;
+    }
+    size_t slots_size = (size_t)slot_count * 16;
+    char  *slots      = nsl__snapshot_alloc(nullptr, slots_size);
+    memset(slots, 0, slots_size);
+
+    // entries follow the slots in the order they were added
+    uint64_t offset = NSL__SNAPSHOT_HEADER + slots_size;
+    for (size_t i = 0; i < builder->count; i++) {
+        const NSL__SnapshotEntry *entry = &builder->entries[i];
+        uint64_t                  slot  = entry->hash & (slot_count - 1);
+        while (nsl__snapshot_load(slots + slot * 16 + 8, 8) != 0) {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        nsl__snapshot_store(slots + slot * 16, entry->hash, 8);
+        nsl__snapshot_store(slots + slot * 16 + 8, offset, 8);
+        offset += 8 + nsl__snapshot_align((size_t)entry->key_length + entry->value_length);
+    }
+
+    char *header = nsl_stream_reserve(out, NSL__SNAPSHOT_HEADER);
+    memcpy(header, NSL__SNAPSHOT_MAGIC, 8);
+    nsl__snapshot_store(header + 8, offset, 8);
+    nsl__snapshot_store(header + 16, slot_count, 8);
+    nsl__snapshot_store(header + 24, builder->count, 8);
+    nsl__snapshot_store(header + 32, NSL__SNAPSHOT_HEADER, 8);
+    nsl_stream_commit(out, NSL__SNAPSHOT_HEADER);
+    nsl_stream_write(out, slots, slots_size);
+    nsl_free(slots);
+
+    static const char padding[8] = {};
+    for (size_t i = 0; i < builder->count; i++) {
+        const NSL__SnapshotEntry *entry  = &builder->entries[i];
+        size_t                    length = (size_t)entry->key_length + entry->value_length;
+        char                     *lengths = nsl_stream_reserve(out, 8);
+        nsl__snapshot_store(lengths, entry->key_length, 4);
+        nsl__snapshot_store(lengths + 4, entry->value_length, 4);
+        nsl_stream_commit(out, 8);
+        nsl_stream_write(out, builder->data + entry->offset, length);
+        nsl_stream_write(out, padding, nsl__snapshot_align(length) - length);
+    }
+}
+
+NSL_SNAPSHOT_DEF bool nsl_snapshot_view(NSL_Snapshot *snapshot, NSL_StringView bytes) {
+    if (bytes.length < NSL__SNAPSHOT_HEADER || memcmp(bytes.data, NSL__SNAPSHOT_MAGIC, 8) != 0) {
+        return false;
+    }
+    uint64_t size       = nsl__snapshot_load(bytes.data + 8, 8);
+    uint64_t slot_count = nsl__snapshot_load(bytes.data + 16, 8);
+    uint64_t count      = nsl__snapshot_load(bytes.data + 24, 8);
+    uint64_t slots      = nsl__snapshot_load(bytes.data + 32, 8);
+    bool     valid      = size == bytes.length && slot_count != 0
+                   && (slot_count & (slot_count - 1)) == 0 && count < slot_count
+                   && slots >= NSL__SNAPSHOT_HEADER && slots <= size
+                   && slot_count <= (size - slots) / 16;
+    if (!valid) { return false; }
+    *snapshot = (NSL_Snapshot){
+        .bytes     = bytes,
+        .count     = count,
+        .slot_mask = slot_count - 1,
+        .slots     = slots,
+    };
+    return true;
+}
+
+NSL_SNAPSHOT_DEF bool nsl_snapshot_open(NSL_Snapshot *snapshot, const char *path) {
+    // lookups go to random slots, so reading ahead would only waste memory
+    NSL_MmapFile file;
+    if (!nsl_mmap_open(&file, path, &(NSL_MmapConfig){.advice = NSL_MMAP_RANDOM})) {
+        return false;
+    }
+    if (!nsl_snapshot_view(snapshot, file.view)) {
+        nsl_mmap_close(&file);
+        errno = EINVAL;
+        return false;
+    }
+    snapshot->file   = file;
+    snapshot->mapped = true;
+    return true;
+}
+
+NSL_SNAPSHOT_DEF void nsl_snapshot_close(NSL_Snapshot *snapshot) {
+    if (snapshot->mapped) { nsl_mmap_close(&snapshot->file); }
+}
+
+NSL_SNAPSHOT_DEF bool
+nsl_snapshot_get(const NSL_Snapshot *snapshot, NSL_StringView key, NSL_StringView *value) {
+    const char *bytes = snapshot->bytes.data;
+    uint64_t    size  = snapshot->bytes.length;
+    uint64_t    hash  = nsl__snapshot_hash(key);
+    // at most every slot is probed, even if a corrupt table has no empty one
+    for (uint64_t probe = 0, slot = hash; probe <= snapshot->slot_mask; probe++, slot++) {
+        const char *entry  = bytes + snapshot->slots + (slot & snapshot->slot_mask) * 16;
+        uint64_t    offset = nsl__snapshot_load(entry + 8, 8);
+        if (offset == 0) { return false; }
+        if (nsl__snapshot_load(entry, 8) != hash || offset > size - 8) { continue; }
+
+        uint64_t key_length   = nsl__snapshot_load(bytes + offset, 4);
+        uint64_t value_length = nsl__snapshot_load(bytes + offset + 4, 4);
+        if (key_length != key.length || key_length + value_length > size - offset - 8) {
+            continue;
+        }
+        const char *data = bytes + offset + 8;
+        if (memcmp(data + value_length, key.data, key.length) == 0) {
+            *value = (NSL_StringView){data, (size_t)value_length};
+            return true;
+        }
+    }
+    return false;
+}
+
+#    endif  // NSL_SNAPSHOT_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(SNAPSHOT)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(SNAPSHOT)
+#    ifndef NSL_SNAPSHOT_STRIP_PREFIX_GUARD_
+#        define NSL_SNAPSHOT_STRIP_PREFIX_GUARD_
+
+#        define SnapshotBuilder       NSL_SnapshotBuilder
+#        define Snapshot              NSL_Snapshot
+#        define snapshot_builder_init nsl_snapshot_builder_init
+#        define snapshot_builder_free nsl_snapshot_builder_free
+#        define snapshot_add          nsl_snapshot_add
+#        define snapshot_write        nsl_snapshot_write
+#        define snapshot_open         nsl_snapshot_open
+#        define snapshot_view         nsl_snapshot_view
+#        define snapshot_close        nsl_snapshot_close
+#        define snapshot_get          nsl_snapshot_get
+
+#    endif  // NSL_SNAPSHOT_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(SNAPSHOT)
@@ -0,0 +1,716 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * Buffered reading and writing of file descriptors, for pipes, sockets and
+ * other streams that cannot be mapped with `nonstdlib/mmap.h`. Both sides use
+ * a single large buffer that is aligned to a page, so that the kernel can copy
+ * whole pages in and out of it.
+ *
+ * `NSL_StreamReader` gives direct access to its buffer: `nsl_stream_peek`
+ * returns a view of at least the requested number of bytes, reading more
+ * only if too few are buffered, and `nsl_stream_consume` releases them once
+ * they have been parsed. `nsl_stream_read` copies bytes out instead, and
+ * reads that are larger than the buffer fill the caller's memory and the
+ * buffer with a single `readv`.
+ *
+ * `NSL_StreamWriter` collects small writes in its buffer until it is full.
+ * Bytes can be formatted or encoded straight into the buffer with
+ * `nsl_stream_writef` or `nsl_stream_reserve`, and writes that are larger
+ * than the buffer are sent together with the buffered bytes by a single
+ * `writev`, without being copied.
+ *
+ * All writes go through `nsl_stream_writev`, which can be redefined to send
+ * them somewhere else, such as a socket library or a test harness. The fd
+ * sink of `nonstdlib/log.h` writes through it as well.
+ *
+ * # Example
+ *
+ * ```c
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/stream.h"
+ *
+ * int main() {
+ *     NSL_StreamReader in;
+ *     NSL_StreamWriter out;
+ *     nsl_stream_reader_init(&in, 0, 0);
+ *     nsl_stream_writer_init(&out, 1, 0);
+ *
+ *     // copies records of a 4 byte length followed by that many bytes
+ *     while (true) {
+ *         NSL_StringView header = nsl_stream_peek(&in, 4);
+ *         if (header.length < 4) { break; }
+ *         uint32_t length;
+ *         memcpy(&length, header.data, 4);
+ *         nsl_stream_consume(&in, 4);
+ *         nsl_stream_writef(&out, "record of %u bytes\n", length);
+ *         // ...
+ *     }
+ *
+ *     nsl_stream_writer_free(&out);
+ *     nsl_stream_reader_free(&in);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_STREAM_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_STREAM_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_STREAM_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_STREAM_BUFFER_SIZE`: The default size of a buffer in bytes.
+ * - `nsl_stream_readv`: Can be defined to redirect the reads of every reader.
+ * - `nsl_stream_writev`: Can be defined to redirect the writes of every
+ *   writer.
+ */
+
+#ifndef NSL_STREAM_H_
+#define NSL_STREAM_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_STREAM_VERSION_MAJOR 0
+#define NSL_STREAM_VERSION_MINOR 1
+#define NSL_STREAM_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_STREAM_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_STREAM_DEF
+#    define NSL_STREAM_DEF
+#endif  // NSL_STREAM_DEF
+
+/*!
+ * `NSL_STREAM_BUFFER_SIZE` is the size of a buffer, in bytes, if it is not
+ * given when the reader or writer is initialized.
+ */
+#ifndef NSL_STREAM_BUFFER_SIZE
+#    define NSL_STREAM_BUFFER_SIZE (1 << 16)
+#endif  // NSL_STREAM_BUFFER_SIZE
+
+/*!
+ * `nsl_stream_readv` can optionally be defined by the user to redirect the
+ * reads of every reader. By default, it is `readv`.
+ *
+ * NOTE: The overriding function does not need to be declared prior to any
+ * includes or even in the same translation unit, as the function will be
+ * forward declared using `extern`.
+ *
+ * # Requires
+ * - The macro evaluation has the type
+ *   `ssize_t (*)(int, const struct iovec *, int)`.
+ * - The behavior of `nsl_stream_readv` must match the behavior of `readv`.
+ */
+#if defined(nsl_stream_readv)
+extern ssize_t nsl_stream_readv(int fd, const struct iovec *iov, int count);
+#else
+#    define nsl_stream_readv readv
+#endif  // defined(nsl_stream_readv)
+nsl_assert_is_of_type(nsl_stream_readv,
+                      ssize_t (*)(int, const struct iovec *, int),
+                      "'nsl_stream_readv' is of wrong type");
+
+/*!
+ * `nsl_stream_writev` can optionally be defined by the user to redirect the
+ * writes of every writer, and of the fd sink of `nonstdlib/log.h`. By
+ * default, it is `writev`.
+ *
+ * NOTE: The overriding function does not need to be declared prior to any
+ * includes or even in the same translation unit, as the function will be
+ * forward declared using `extern`.
+ *
+ * # Requires
+ * - The macro evaluation has the type
+ *   `ssize_t (*)(int, const struct iovec *, int)`.
+ * - The behavior of `nsl_stream_writev` must match the behavior of `writev`.
+ */
+#if defined(nsl_stream_writev)
+extern ssize_t nsl_stream_writev(int fd, const struct iovec *iov, int count);
+#else
+#    define nsl_stream_writev writev
+#endif  // defined(nsl_stream_writev)
+nsl_assert_is_of_type(nsl_stream_writev,
+                      ssize_t (*)(int, const struct iovec *, int),
+                      "'nsl_stream_writev' is of wrong type");
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * Reads a file descriptor through a buffer.
+ */
+typedef struct NSL_StreamReader {
+    //! The file descriptor that is read.
+    int fd;
+    //! Whether the end of the stream has been read.
+    bool eof;
+    //! The `errno` of the first read that failed, or zero. No more reads are
+    //! made once one has failed.
+    int error;
+    //! Private: The buffer, the allocation it is aligned within, and its size.
+    char  *buffer;
+    void  *allocation;
+    size_t capacity;
+    //! Private: The buffered bytes are `buffer[start..end)`.
+    size_t start;
+    size_t end;
+} NSL_StreamReader;
+
+/*!
+ * Writes to a file descriptor through a buffer.
+ */
+typedef struct NSL_StreamWriter {
+    //! The file descriptor that is written.
+    int fd;
+    //! The `errno` of the first write that failed, or zero. Everything that
+    //! is written after a write has failed is discarded.
+    int error;
+    //! Private: The buffer, the allocation it is aligned within, and its size.
+    char  *buffer;
+    void  *allocation;
+    size_t capacity;
+    //! Private: The number of buffered bytes.
+    size_t length;
+} NSL_StreamWriter;
+
+/*!
+ * Initializes a reader.
+ *
+ * # Parameters
+ * - `reader`: The reader to initialize.
+ * - `fd`: The file descriptor to read.
+ * - `capacity`: The size of the buffer in bytes, which is rounded up to a
+ *   multiple of the page size, or zero for `NSL_STREAM_BUFFER_SIZE`.
+ *
+ * # Requires
+ * - `fd` is blocking.
+ *
+ * # Modifies
+ * - `reader`: It is initialized.
+ *
+ * # Aborts
+ * - If the buffer cannot be allocated.
+ */
+NSL_STREAM_DEF void nsl_stream_reader_init(NSL_StreamReader *reader, int fd, size_t capacity);
+
+/*!
+ * Frees a reader. The file descriptor is not closed.
+ *
+ * # Parameters
+ * - `reader`: The reader to free.
+ *
+ * # Requires
+ * - `reader` is initialized.
+ *
+ * # Modifies
+ * - `reader`: It is no longer initialized, and every view into it is invalid.
+ */
+NSL_STREAM_DEF void nsl_stream_reader_free(NSL_StreamReader *reader);
+
+/*!
+ * Returns a view of the buffered bytes, after reading until at least `min`
+ * bytes are buffered.
+ *
+ * # Parameters
+ * - `reader`: The reader to peek into.
+ * - `min`: The number of bytes that are needed.
+ *
+ * # Requires
+ * - `reader` is initialized.
+ * - `min` is at most the size of the buffer.
+ *
+ * # Modifies
+ * - `reader`: More bytes may be read into the buffer, which invalidates
+ *   views returned by earlier calls.
+ *
+ * # Returns
+ * All of the buffered bytes. The view is shorter than `min` only at the end
+ * of the stream or after an error.
+ */
+NSL_STREAM_DEF NSL_StringView nsl_stream_peek(NSL_StreamReader *reader, size_t min);
+
+/*!
+ * Releases bytes at the front of the buffer.
+ *
+ * # Parameters
+ * - `reader`: The reader the bytes are released from.
+ * - `count`: The number of bytes to release.
+ *
+ * # Requires
+ * - `reader` is initialized.
+ * - `count` is at most the length of the last view returned by
+ *   `nsl_stream_peek`.
+ *
+ * # Modifies
+ * - `reader`: The bytes are no longer buffered.
+ */
+NSL_STREAM_DEF void nsl_stream_consume(NSL_StreamReader *reader, size_t count);
+
+/*!
+ * Copies bytes out of a reader.
+ *
+ * # Parameters
+ * - `reader`: The reader to read from.
+ * - `data`: Where the bytes are copied to.
+ * - `length`: The number of bytes to read.
+ *
+ * # Requires
+ * - `reader` is initialized.
+ * - `data` has room for `length` bytes.
+ *
+ * # Modifies
+ * - `reader`: The bytes are consumed.
+ * - `data`: The bytes are copied into it.
+ *
+ * # Returns
+ * The number of bytes that were copied, which is less than `length` only at
+ * the end of the stream or after an error.
+ */
+NSL_STREAM_DEF size_t nsl_stream_read(NSL_StreamReader *reader, void *data, size_t length);
+
+/*!
+ * Initializes a writer.
+ *
+ * # Parameters
+ * - `writer`: The writer to initialize.
+ * - `fd`: The file descriptor to write.
+ * - `capacity`: The size of the buffer in bytes, which is rounded up to a
+ *   multiple of the page size, or zero for `NSL_STREAM_BUFFER_SIZE`.
+ *
+ * # Requires
+ * - `fd` is blocking.
+ *
+ * # Modifies
+ * - `writer`: It is initialized.
+ *
+ * # Aborts
+ * - If the buffer cannot be allocated.
+ */
+NSL_STREAM_DEF void nsl_stream_writer_init(NSL_StreamWriter *writer, int fd, size_t capacity);
+
+/*!
+ * Flushes and frees a writer. The file descriptor is not closed.
+ *
+ * # Parameters
+ * - `writer`: The writer to free.
+ *
+ * # Requires
+ * - `writer` is initialized.
+ *
+ * # Modifies
+ * - `writer`: It is no longer initialized.
+ *
+ * # Returns
+ * Whether everything that was written to the writer reached the file
+ * descriptor.
+ */
+NSL_STREAM_DEF bool nsl_stream_writer_free(NSL_StreamWriter *writer);
+
+/*!
+ * Writes bytes to a writer.
+ *
+ * # Parameters
+ * - `writer`: The writer to write to.
+ * - `data`: The bytes to write.
+ * - `length`: The number of bytes to write.
+ *
+ * # Requires
+ * - `writer` is initialized.
+ *
+ * # Modifies
+ * - `writer`: The bytes are buffered, or written together with the buffered
+ *   bytes if they do not fit.
+ */
+NSL_STREAM_DEF void nsl_stream_write(NSL_StreamWriter *writer, const void *data, size_t length);
+
+/*!
+ * Formats a string straight into the buffer of a writer, as with `printf`.
+ *
+ * # Parameters
+ * - `writer`: The writer to write to.
+ * - `fmt`: The format string.
+ * - `...`: The arguments to the format string.
+ *
+ * # Requires
+ * - `writer` is initialized.
+ *
+ * # Modifies
+ * - `writer`: The formatted string is buffered, or written if it is longer
+ *   than the buffer.
+ *
+ * # Aborts
+ * - If the string is longer than the buffer and cannot be allocated.
+ */
+[[gnu::format(printf, 2, 3)]]
+NSL_STREAM_DEF void nsl_stream_writef(NSL_StreamWriter *writer, const char *fmt, ...);
+
+/*!
+ * Returns room for `length` bytes in the buffer of a writer, flushing it if
+ * there is not enough. The bytes are written once they are committed with
+ * `nsl_stream_commit`.
+ *
+ * # Parameters
+ * - `writer`: The writer to reserve room in.
+ * - `length`: The number of bytes to reserve.
+ *
+ * # Requires
+ * - `writer` is initialized.
+ * - `length` is at most the size of the buffer.
+ *
+ * # Modifies
+ * - `writer`: It may be flushed.
+ *
+ * # Returns
+ * The address of the room in the buffer.
+ */
+NSL_STREAM_DEF char *nsl_stream_reserve(NSL_StreamWriter *writer, size_t length);
+
+/*!
+ * Appends the first `length` bytes of the room returned by the last call to
+ * `nsl_stream_reserve` to the buffered bytes.
+ *
+ * # Parameters
+ * - `writer`: The writer to commit to.
+ * - `length`: The number of bytes that were stored.
+ *
+ * # Requires
+ * - `length` is at most the length given to `nsl_stream_reserve`, and
+ *   nothing else has been written since.
+ *
+ * # Modifies
+ * - `writer`: The bytes are buffered.
+ */
+NSL_STREAM_DEF void nsl_stream_commit(NSL_StreamWriter *writer, size_t length);
+
+/*!
+ * Writes the buffered bytes of a writer to its file descriptor.
+ *
+ * # Parameters
+ * - `writer`: The writer to flush.
+ *
+ * # Requires
+ * - `writer` is initialized.
+ *
+ * # Modifies
+ * - `writer`: Nothing is buffered.
+ *
+ * # Returns
+ * Whether no write has failed.
+ */
+NSL_STREAM_DEF bool nsl_stream_flush(NSL_StreamWriter *writer);
+
+/*!
+ * Writes all of `count` buffers to a file descriptor with
+ * `nsl_stream_writev`, retrying partial and interrupted writes.
+ *
+ * # Parameters
+ * - `fd`: The file descriptor to write to.
+ * - `iov`: The buffers to write.
+ * - `count`: The number of buffers.
+ *
+ * # Modifies
+ * - `iov`: The buffers are advanced past the bytes that were written.
+ * - `errno`: It is set if a write fails.
+ *
+ * # Returns
+ * Whether all of the bytes were written.
+ */
+NSL_STREAM_DEF bool nsl_stream_writev_all(int fd, struct iovec *iov, int count);
+
+#endif  // NSL_STREAM_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(STREAM)
+#    ifndef NSL_STREAM_IMPLEMENTATION_GUARD_
+#        define NSL_STREAM_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <stdarg.h>
+#        include <stdio.h>
+#        include <string.h>
+#        include <unistd.h>
+
+// Allocates a buffer of at least `*capacity` bytes that starts at a page
+// boundary, and rounds `*capacity` up to whole pages.
+static char *nsl__stream_alloc(size_t *capacity, void **allocation) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    if (*capacity == 0) { *capacity = NSL_STREAM_BUFFER_SIZE; }
+    *capacity   = (*capacity + page - 1) / page * page;
+    *allocation = nsl_malloc(*capacity + page - 1);
+    if (*allocation == nullptr) {
+        nsl_eprintf("[STREAM] out of memory\n");
+        nsl_abort();
+    }
+    uintptr_t address = ((uintptr_t)*allocation + page - 1) / page * page;
+    return (char *)*allocation + (address - (uintptr_t)*allocation);
+}
+
+// Reads once with `iov`, recording the end of the stream or an error. The
+// last buffer of `iov` is the free space at the end of the reader's buffer.
+static size_t nsl__stream_fill(NSL_StreamReader *reader, struct iovec *iov, int count) {
+    if (reader->eof || reader->error != 0) { return 0; }
+    ssize_t got;
+    do {
+        got = nsl_stream_readv(reader->fd, iov, count);
+    } while (got < 0 && errno == EINTR);
+    if (got < 0) { reader->error = errno; }
+    if (got == 0) { reader->eof = true; }
+    return got < 0 ? 0 : (size_t)got;
+}
+
+NSL_STREAM_DEF void nsl_stream_reader_init(NSL_StreamReader *reader, int fd, size_t capacity) {
+    *reader        = (NSL_StreamReader){.fd = fd, .capacity = capacity};
+    reader->buffer = nsl__stream_alloc(&reader->capacity, &reader->allocation);
+}
+
+NSL_STREAM_DEF void nsl_stream_reader_free(NSL_StreamReader *reader) {
+    nsl_free(reader->allocation);
+}
+
+NSL_STREAM_DEF NSL_StringView nsl_stream_peek(NSL_StreamReader *reader, size_t min) {
+    while (reader->end - reader->start < min && !reader->eof && reader->error == 0) {
+        if (reader->capacity - reader->start < min) {
+            memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+            reader->end   -= reader->start;
+            reader->start  = 0;
+        }
+        struct iovec space = {reader->buffer + reader->end, reader->capacity - reader->end};
+        reader->end       += nsl__stream_fill(reader, &space, 1);
+    }
+    return (NSL_StringView){reader->buffer + reader->start, reader->end - reader->start};
+}
+
+NSL_STREAM_DEF void nsl_stream_consume(NSL_StreamReader *reader, size_t count) {
+    reader->start += count;
+    if (reader->start == reader->end) {
+        reader->start = 0;
+        reader->end   = 0;
+    }
+}
+
+NSL_STREAM_DEF size_t nsl_stream_read(NSL_StreamReader *reader, void *data, size_t length) {
+    size_t copied = reader->end - reader->start;
+    if (copied >= length) {
+        memcpy(data, reader->buffer + reader->start, length);
+        nsl_stream_consume(reader, length);
+        return length;
+    }
+    memcpy(data, reader->buffer + reader->start, copied);
+    nsl_stream_consume(reader, copied);
+
+    // the rest goes straight into `data`, and whatever follows it refills
+    // the buffer in the same call
+    while (copied < length && !reader->eof && reader->error == 0) {
+        struct iovec iov[2] = {
+            {(char *)data + copied, length - copied},
+            {reader->buffer, reader->capacity},
+        };
+        size_t got = nsl__stream_fill(reader, iov, 2);
+        if (got > length - copied) {
+            reader->end = got - (length - copied);
+            got         = length - copied;
+        }
+        copied += got;
+    }
+    return copied;
+}
+
+NSL_STREAM_DEF void nsl_stream_writer_init(NSL_StreamWriter *writer, int fd, size_t capacity) {
+    *writer        = (NSL_StreamWriter){.fd = fd, .capacity = capacity};
+    writer->buffer = nsl__stream_alloc(&writer->capacity, &writer->allocation);
+}
+
+NSL_STREAM_DEF bool nsl_stream_writer_free(NSL_StreamWriter *writer) {
+    bool flushed = nsl_stream_flush(writer);
+    nsl_free(writer->allocation);
+    return flushed;
+}
+
+// Writes the buffered bytes followed by `length` bytes of `data`.
+static void nsl__stream_send(NSL_StreamWriter *writer, const void *data, size_t length) {
+    struct iovec iov[2] = {{writer->buffer, writer->length}, {(void *)data, length}};
+    if (writer->error == 0 && !nsl_stream_writev_all(writer->fd, iov, 2)) {
+        writer->error = errno;
+    }
+    writer->length = 0;
+}
+
+NSL_STREAM_DEF void nsl_stream_write(NSL_StreamWriter *writer, const void *data, size_t length) {
+    if (length <= writer->capacity - writer->length) {
+        memcpy(writer->buffer + writer->length, data, length);
+        writer->length += length;
+    } else if (length >= writer->capacity) {
+        nsl__stream_send(writer, data, length);
+    } else {
+        // fill the buffer up, so that every write but the last is a full one
+        size_t fits = writer->capacity - writer->length;
+        memcpy(writer->buffer + writer->length, data, fits);
+        writer->length = writer->capacity;
+        nsl__stream_send(writer, nullptr, 0);
+        memcpy(writer->buffer, (const char *)data + fits, length - fits);
+        writer->length = length - fits;
+    }
+}
+
+NSL_STREAM_DEF void nsl_stream_writef(NSL_StreamWriter *writer, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t  room   = writer->capacity - writer->length;
+    int     length = vsnprintf(writer->buffer + writer->length, room, fmt, args);
+    va_end(args);
+    if (length < 0) { return; }
+    if ((size_t)length < room) {
+        writer->length += (size_t)length;
+        return;
+    }
+
+    // `vsnprintf` needs room for a null byte that is not written
+    va_start(args, fmt);
+    if ((size_t)length < writer->capacity) {
+        nsl__stream_send(writer, nullptr, 0);
+        vsnprintf(writer->buffer, writer->capacity, fmt, args);
+        writer->length = (size_t)length;
+    } else {
+        char *string = nsl_malloc((size_t)length + 1);
+        if (string == nullptr) {
+            nsl_eprintf("[STREAM] out of memory\n");
+            nsl_abort();
+        }
+        vsnprintf(string, (size_t)length + 1, fmt, args);
+        nsl__stream_send(writer, string, (size_t)length);
+        nsl_free(string);
+    }
+    va_end(args);
+}
+
+NSL_STREAM_DEF char *nsl_stream_reserve(NSL_StreamWriter *writer, size_t length) {
+    if (length > writer->capacity - writer->length) { nsl__stream_send(writer, nullptr, 0); }
+    return writer->buffer + writer->length;
+}
+
+NSL_STREAM_DEF void nsl_stream_commit(NSL_StreamWriter *writer, size_t length) {
+    writer->length += length;
+}
+
+NSL_STREAM_DEF bool nsl_stream_flush(NSL_StreamWriter *writer) {
+    if (writer->length > 0) { nsl__stream_send(writer, nullptr, 0); }
+    return writer->error == 0;
+}
+
+NSL_STREAM_DEF bool nsl_stream_writev_all(int fd, struct iovec *iov, int count) {
+    while (count > 0 && iov->iov_len == 0) {
+        iov++;
+        count--;
+    }
+    while (count > 0) {
+        ssize_t written = nsl_stream_writev(fd, iov, count);
+        if (written < 0 && errno == EINTR) { continue; }
+        if (written < 0) { return false; }
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return true;
+}
+
+#    endif  // NSL_STREAM_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(STREAM)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(STREAM)
+#    ifndef NSL_STREAM_STRIP_PREFIX_GUARD_
+#        define NSL_STREAM_STRIP_PREFIX_GUARD_
+
+#        define StreamReader       NSL_StreamReader
+#        define StreamWriter       NSL_StreamWriter
+#        define stream_reader_init nsl_stream_reader_init
+#        define stream_reader_free nsl_stream_reader_free
+#        define stream_peek        nsl_stream_peek
+#        define stream_consume     nsl_stream_consume
+#        define stream_read        nsl_stream_read
+#        define stream_writer_init nsl_stream_writer_init
+#        define stream_writer_free nsl_stream_writer_free
+#        define stream_write       nsl_stream_write
+#        define stream_writef      nsl_stream_writef
+#        define stream_reserve     nsl_stream_reserve
+#        define stream_commit      nsl_stream_commit
+#        define stream_flush       nsl_stream_flush
+#        define stream_writev_all  nsl_stream_writev_all
+
+#    endif  // NSL_STREAM_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(STREAM)
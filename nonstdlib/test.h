@@ -0,0 +1,665 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/*!
+ * A unit test framework. Tests are registered with `nsl_test`, any number per
+ * file, and run by `nsl_test_run`. By default every test runs in its own
+ * forked process, with as many running at once as there are CPUs. A test that
+ * fails an assertion, crashes, exits early or hangs is reported without
+ * stopping the other tests, and a test cannot affect the state seen by another.
+ * The output of a test is captured and only shown if it fails.
+ *
+ * The wall time of every test is reported. The times can be saved to a
+ * baseline file, and tests that become slower than their baseline by more
+ * than a threshold are flagged as slow.
+ *
+ * `nsl_test_main` reads the options from the command line and runs the tests,
+ * so that every test program accepts the same ones.
+ *
+ * This module needs `_POSIX_C_SOURCE` to be at least `200809L` before any
+ * header is included.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _POSIX_C_SOURCE 200809L
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/test.h"
+ *
+ * #include <assert.h>
+ *
+ * nsl_test(addition) {
+ *     assert(1 + 1 == 2);
+ * }
+ *
+ * nsl_test(subtraction) {
+ *     assert(2 - 1 == 1);
+ * }
+ *
+ * int main(int argc, char **argv) {
+ *     return nsl_test_main(argc, argv);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_TEST_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_TEST_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_TEST_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ * - `NSL_TEST_MIN_REGRESSION_NS`: How much slower than its baseline a test
+ *   must be, in nanoseconds, before it can be flagged as slow.
+ */
+
+#ifndef NSL_TEST_H_
+#define NSL_TEST_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_TEST_VERSION_MAJOR 0
+#define NSL_TEST_VERSION_MINOR 1
+#define NSL_TEST_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_TEST_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_TEST_DEF
+#    define NSL_TEST_DEF
+#endif  // NSL_TEST_DEF
+
+/*!
+ * `NSL_TEST_MIN_REGRESSION_NS` is how much slower than its baseline a test must
+ * be, in nanoseconds, before it can be flagged as slow. This keeps the noise in
+ * the times of short tests from being reported. Defaults to one millisecond.
+ */
+#ifndef NSL_TEST_MIN_REGRESSION_NS
+#    define NSL_TEST_MIN_REGRESSION_NS 1000000
+#endif  // NSL_TEST_MIN_REGRESSION_NS
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * How tests are run. Fields that are zero use their defaults.
+ */
+typedef struct NSL_TestConfig {
+    //! The most tests run at once. Defaults to the number of online CPUs.
+    size_t jobs;
+    //! How long a test may run before it is killed, in milliseconds. Defaults
+    //! to 10000.
+    double timeout_ms;
+    //! If not `nullptr`, only tests whose name contains it are run.
+    const char *filter;
+    //! Whether the tests run one at a time in this process instead. A failing
+    //! test then stops the run, which is useful under a debugger.
+    bool no_fork;
+    //! Whether the output of passing tests is shown as well.
+    bool verbose;
+    //! If not `nullptr`, the file that the times are compared against.
+    const char *baseline;
+    //! If not `nullptr`, the file that the times of passing tests are saved
+    //! to, in the format read from `baseline`.
+    const char *save_baseline;
+    //! How much slower than its baseline a test may become before it is
+    //! flagged, as a fraction of the baseline. Defaults to 0.25.
+    double threshold;
+    //! Whether slow tests count as failures.
+    bool fail_slow;
+} NSL_TestConfig;
+
+/*!
+ * The outcome of `nsl_test_run`.
+ */
+typedef struct NSL_TestSummary {
+    //! The number of tests that passed, including slow ones unless
+    //! `fail_slow` is set.
+    size_t passed;
+    //! The number of tests that failed.
+    size_t failed;
+    //! The number of passing tests that were slower than their baseline.
+    size_t slow;
+    //! The wall time of the whole run in nanoseconds.
+    uint64_t wall_ns;
+    //! The sum of the wall times of the tests in nanoseconds.
+    uint64_t total_ns;
+} NSL_TestSummary;
+
+/*!
+ * Defines and registers a test. This is followed by the body of the test, as
+ * for a function. A test fails if it aborts (e.g. through `assert`), crashes,
+ * exits or times out.
+ *
+ * # Parameters
+ * - `name`: The name of the test. This must be a unique identifier.
+ *
+ * # Example
+ *
+ * ```c
+ * nsl_test(addition) {
+ *     assert(1 + 1 == 2);
+ * }
+ * ```
+ */
+#define nsl_test(name)                                                                             \
+    static void name(void);                                                                        \
+    [[gnu::constructor]] static void NSL_CAT(nsl__test_register_, name)(void) {                    \
+        static NSL__Test nsl__test_ = {#name, __FILE__, __LINE__, name, nullptr};                  \
+        nsl__test_register(&nsl__test_);                                                           \
+    }                                                                                              \
+    static void name(void)
+
+/*!
+ * Runs the registered tests, writing a line for each test as it finishes and
+ * a summary at the end.
+ *
+ * # Parameters
+ * - `config`: How the tests are run, or `nullptr` to use the defaults.
+ * - `file`: Where the results are written.
+ *
+ * # Aborts
+ * - A process or pipe could not be created.
+ *
+ * # Returns
+ * The number of tests that passed, failed and were slow, and the times.
+ */
+NSL_TEST_DEF NSL_TestSummary nsl_test_run(const NSL_TestConfig *config, FILE *file);
+
+/*!
+ * Reads the test options from the command line. The options are `--jobs=N`,
+ * `--timeout=MS`, `--filter=TEXT`, `--no-fork`, `--verbose`,
+ * `--baseline=FILE`, `--save-baseline=FILE`, `--threshold=FRACTION` and
+ * `--fail-slow`. An error is printed using `nsl_eprintf` for anything else.
+ *
+ * # Parameters
+ * - `config`: The configuration to update.
+ * - `argc`: The number of arguments.
+ * - `argv`: The arguments, starting with the name of the program.
+ *
+ * # Modifies
+ * - `config`: Updated with the options that were given.
+ *
+ * # Returns
+ * `true` if every option was understood, `false` otherwise.
+ */
+NSL_TEST_DEF bool nsl_test_parse_args(NSL_TestConfig *config, int argc, char **argv);
+
+/*!
+ * Reads the options from the command line and runs the registered tests,
+ * writing the results to `stdout`.
+ *
+ * # Parameters
+ * - `argc`: The number of arguments.
+ * - `argv`: The arguments, starting with the name of the program.
+ *
+ * # Returns
+ * The exit status for the program: 0 if every test passed, 1 otherwise.
+ */
+NSL_TEST_DEF int nsl_test_main(int argc, char **argv);
+
+// The static description of a test. Tests are kept in a list in the order
+// they were registered.
+typedef struct NSL__Test NSL__Test;
+struct NSL__Test {
+    const char *name;
+    const char *file;
+    int         line;
+    void (*fn)(void);
+    NSL__Test *next;
+};
+
+NSL_TEST_DEF void nsl__test_register(NSL__Test *test);
+
+#endif  // NSL_TEST_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(TEST)
+#    ifndef NSL_TEST_IMPLEMENTATION_GUARD_
+#        define NSL_TEST_IMPLEMENTATION_GUARD_
+
+#        include <errno.h>
+#        include <poll.h>
+#        include <signal.h>
+#        include <stdlib.h>
+#        include <string.h>
+#        include <sys/wait.h>
+#        include <time.h>
+#        include <unistd.h>
+
+// Registration happens in constructors, before `main`, so it is never
+// concurrent.
+static NSL__Test  *nsl__test_head = nullptr;
+static NSL__Test **nsl__test_tail = &nsl__test_head;
+
+NSL_TEST_DEF void nsl__test_register(NSL__Test *test) {
+    *nsl__test_tail = test;
+    nsl__test_tail  = &test->next;
+}
+
+static uint64_t nsl__test_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+// The state of one test while it runs and once it has finished.
+typedef struct NSL__TestRun {
+    NSL__Test *test;
+    pid_t      pid;
+    // The read ends of the pipes for the output of the test, and for its time
+    // once it has returned. `-1` when closed.
+    int      output_fd;
+    int      time_fd;
+    uint64_t start_ns;
+    uint64_t time_ns;
+    uint64_t baseline_ns;
+    bool     timed_out;
+    bool     passed;
+    char    *output;
+    size_t   length;
+    size_t   capacity;
+} NSL__TestRun;
+
+static void nsl__test_start(NSL__TestRun *run) {
+    int output[2];
+    int time[2];
+    if (pipe(output) != 0 || pipe(time) != 0) {
+        nsl_eprintf("[TEST] could not create a pipe: %s\n", strerror(errno));
+        abort();
+    }
+    run->start_ns = nsl__test_now();
+    run->pid      = fork();
+    if (run->pid < 0) {
+        nsl_eprintf("[TEST] could not fork: %s\n", strerror(errno));
+        abort();
+    }
+    if (run->pid == 0) {
+        close(output[0]);
+        close(time[0]);
+        dup2(output[1], STDOUT_FILENO);
+        dup2(output[1], STDERR_FILENO);
+        close(output[1]);
+        // Nothing is buffered, so the output up to a crash is kept.
+        setvbuf(stdout, nullptr, _IONBF, 0);
+
+        uint64_t start = nsl__test_now();
+        run->test->fn();
+        uint64_t elapsed = nsl__test_now() - start;
+        fflush(stdout);
+        fflush(stderr);
+        // `_exit` skips the handlers and buffers inherited from the parent.
+        _exit(write(time[1], &elapsed, sizeof(elapsed)) == sizeof(elapsed) ? 0 : 1);
+    }
+    close(output[1]);
+    close(time[1]);
+    run->output_fd = output[0];
+    run->time_fd   = time[0];
+}
+
+// Appends whatever output is available, returning `false` at the end of it.
+static bool nsl__test_read(NSL__TestRun *run) {
+    if (run->capacity - run->length < 4096) {
+        run->capacity = run->capacity == 0 ? 4096 : 2 * run->capacity;
+        run->output   = nsl_realloc(run->output, run->capacity);
+        if (run->output == nullptr) {
+            nsl_eprintf("[TEST] out of memory\n");
+            abort();
+        }
+    }
+    ssize_t count = read(run->output_fd, run->output + run->length, run->capacity - run->length);
+    if (count < 0 && errno == EINTR) { return true; }
+    if (count <= 0) { return false; }
+    run->length += (size_t)count;
+    return true;
+}
+
+// Writes the result of a finished test, returning whether it passed.
+static bool nsl__test_report(const NSL_TestConfig *config,
+                             FILE                 *file,
+                             NSL__TestRun         *run,
+                             int                   status,
+                             NSL_TestSummary      *summary) {
+    uint64_t time_ns  = 0;
+    bool     returned = read(run->time_fd, &time_ns, sizeof(time_ns)) == sizeof(time_ns);
+    close(run->time_fd);
+
+    char reason[128] = "";
+    if (run->timed_out) {
+        snprintf(reason, sizeof(reason), "timed out after %.0f ms", config->timeout_ms);
+    } else if (WIFSIGNALED(status)) {
+        int signal = WTERMSIG(status);
+        snprintf(reason, sizeof(reason), "killed by signal %d (%s)", signal, strsignal(signal));
+    } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !returned) {
+        snprintf(reason, sizeof(reason), "exited with status %d", WEXITSTATUS(status));
+    }
+    bool passed  = reason[0] == '\0';
+    run->passed  = passed;
+    run->time_ns = passed ? time_ns : nsl__test_now() - run->start_ns;
+    summary->total_ns += run->time_ns;
+
+    bool slow = passed && run->baseline_ns > 0
+             && run->time_ns > run->baseline_ns + NSL_TEST_MIN_REGRESSION_NS
+             && (double)run->time_ns > (1.0 + config->threshold) * (double)run->baseline_ns;
+    double ms = (double)run->time_ns / 1e6;
+    if (!passed) {
+        const NSL__Test *test = run->test;
+        fprintf(file, "[FAIL] %s (%s:%d) %s\n", test->name, test->file, test->line, reason);
+    } else if (slow) {
+        fprintf(file,
+                "[SLOW] %s %.3f ms, baseline %.3f ms (%+.0f%%)\n",
+                run->test->name,
+                ms,
+                (double)run->baseline_ns / 1e6,
+                100.0 * ((double)run->time_ns / (double)run->baseline_ns - 1.0));
+    } else {
+        fprintf(file, "[PASS] %s %.3f ms\n", run->test->name, ms);
+    }
+    if ((!passed || config->verbose) && run->length > 0) {
+        fwrite(run->output, 1, run->length, file);
+        if (run->output[run->length - 1] != '\n') { fputc('\n', file); }
+    }
+    fflush(file);
+
+    nsl_free(run->output);
+    run->output = nullptr;
+    bool failed      = !passed || (slow && config->fail_slow);
+    summary->passed += !failed;
+    summary->failed += failed;
+    summary->slow   += slow;
+    return !failed;
+}
+
+// Runs the tests in forked processes, at most `config->jobs` at once.
+static void nsl__test_run_forked(const NSL_TestConfig *config,
+                                 FILE                 *file,
+                                 NSL__TestRun         *runs,
+                                 size_t                count,
+                                 NSL_TestSummary      *summary) {
+    NSL__TestRun **running = nsl_malloc(config->jobs * sizeof(*running));
+    struct pollfd *fds     = nsl_malloc(config->jobs * sizeof(*fds));
+    if (running == nullptr || fds == nullptr) {
+        nsl_eprintf("[TEST] out of memory\n");
+        abort();
+    }
+    fflush(file);
+    fflush(stdout);
+    fflush(stderr);
+
+    size_t next   = 0;
+    size_t active = 0;
+    while (next < count || active > 0) {
+        while (active < config->jobs && next < count) {
+            nsl__test_start(&runs[next]);
+            running[active++] = &runs[next++];
+        }
+
+        // Wake up in time for the earliest deadline.
+        uint64_t now     = nsl__test_now();
+        uint64_t timeout = (uint64_t)(config->timeout_ms * 1e6);
+        uint64_t wait_ns = UINT64_MAX;
+        for (size_t i = 0; i < active; i++) {
+            fds[i] = (struct pollfd){.fd = running[i]->output_fd, .events = POLLIN};
+            uint64_t deadline = running[i]->start_ns + timeout;
+            if (!running[i]->timed_out) {
+                uint64_t left = deadline > now ? deadline - now : 0;
+                if (left < wait_ns) { wait_ns = left; }
+            }
+        }
+        int wait_ms = wait_ns == UINT64_MAX ? -1 : (int)(wait_ns / 1000000) + 1;
+        if (poll(fds, active, wait_ms) < 0 && errno != EINTR) {
+            nsl_eprintf("[TEST] could not poll: %s\n", strerror(errno));
+            abort();
+        }
+
+        now = nsl__test_now();
+        for (size_t i = 0; i < active;) {
+            NSL__TestRun *run = running[i];
+            if (!run->timed_out && now - run->start_ns >= timeout) {
+                kill(run->pid, SIGKILL);
+                run->timed_out = true;
+            }
+            if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0 || nsl__test_read(run)) {
+                i++;
+                continue;
+            }
+
+            // The output is closed once the test has exited.
+            int status = 0;
+            while (waitpid(run->pid, &status, 0) < 0 && errno == EINTR) {}
+            close(run->output_fd);
+            nsl__test_report(config, file, run, status, summary);
+            running[i] = running[--active];
+            fds[i]     = fds[active];
+        }
+    }
+    nsl_free(running);
+    nsl_free(fds);
+}
+
+// Runs the tests one after the other in this process.
+static void nsl__test_run_in_process(const NSL_TestConfig *config,
+                                     FILE                 *file,
+                                     NSL__TestRun         *runs,
+                                     size_t                count,
+                                     NSL_TestSummary      *summary) {
+    (void)config;
+    for (size_t i = 0; i < count; i++) {
+        NSL__TestRun *run = &runs[i];
+        fprintf(file, "[RUN ] %s\n", run->test->name);
+        fflush(file);
+        run->start_ns = nsl__test_now();
+        run->test->fn();
+        run->time_ns       = nsl__test_now() - run->start_ns;
+        run->passed        = true;
+        summary->total_ns += run->time_ns;
+        summary->passed++;
+        fprintf(file, "[PASS] %s %.3f ms\n", run->test->name, (double)run->time_ns / 1e6);
+    }
+}
+
+// Sets the baseline of every test named in `path`, which has one line of
+// `name nanoseconds` per test.
+static void nsl__test_load_baseline(const char *path, NSL__TestRun *runs, size_t count) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        nsl_eprintf("[TEST] could not open baseline %s: %s\n", path, strerror(errno));
+        return;
+    }
+    char               name[256];
+    unsigned long long time_ns;
+    while (fscanf(file, "%255s %llu", name, &time_ns) == 2) {
+        for (size_t i = 0; i < count; i++) {
+            if (strcmp(runs[i].test->name, name) == 0) { runs[i].baseline_ns = time_ns; }
+        }
+    }
+    fclose(file);
+}
+
+static void nsl__test_save_baseline(const char *path, const NSL__TestRun *runs, size_t count) {
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        nsl_eprintf("[TEST] could not write baseline %s: %s\n", path, strerror(errno));
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (runs[i].passed) {
+            fprintf(file, "%s %llu\n", runs[i].test->name, (unsigned long long)runs[i].time_ns);
+        }
+    }
+    fclose(file);
+}
+
+NSL_TEST_DEF NSL_TestSummary nsl_test_run(const NSL_TestConfig *config, FILE *file) {
+    NSL_TestConfig c = config == nullptr ? (NSL_TestConfig){} : *config;
+    if (c.jobs == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        c.jobs    = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (c.timeout_ms <= 0) { c.timeout_ms = 10000; }
+    if (c.threshold <= 0) { c.threshold = 0.25; }
+
+    size_t count = 0;
+    for (NSL__Test *test = nsl__test_head; test != nullptr; test = test->next) {
+        count += c.filter == nullptr || strstr(test->name, c.filter) != nullptr;
+    }
+    NSL__TestRun *runs = nsl_malloc((count == 0 ? 1 : count) * sizeof(*runs));
+    if (runs == nullptr) {
+        nsl_eprintf("[TEST] out of memory\n");
+        abort();
+    }
+    size_t index = 0;
+    for (NSL__Test *test = nsl__test_head; test != nullptr; test = test->next) {
+        if (c.filter == nullptr || strstr(test->name, c.filter) != nullptr) {
+            runs[index++] = (NSL__TestRun){.test = test, .output_fd = -1, .time_fd = -1};
+        }
+    }
+    if (c.baseline != nullptr) { nsl__test_load_baseline(c.baseline, runs, count); }
+
+    NSL_TestSummary summary = {};
+    uint64_t        start   = nsl__test_now();
+    if (c.no_fork) {
+        nsl__test_run_in_process(&c, file, runs, count, &summary);
+    } else {
+        nsl__test_run_forked(&c, file, runs, count, &summary);
+    }
+    summary.wall_ns = nsl__test_now() - start;
+
+    if (c.save_baseline != nullptr) { nsl__test_save_baseline(c.save_baseline, runs, count); }
+    nsl_free(runs);
+
+    fprintf(file,
+            "%zu passed, %zu failed, %zu slow in %.3f ms (%.3f ms of tests on %zu jobs)\n",
+            summary.passed,
+            summary.failed,
+            summary.slow,
+            (double)summary.wall_ns / 1e6,
+            (double)summary.total_ns / 1e6,
+            c.no_fork ? 1 : c.jobs);
+    return summary;
+}
+
+NSL_TEST_DEF bool nsl_test_parse_args(NSL_TestConfig *config, int argc, char **argv) {
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        char       *end = nullptr;
+        if (strncmp(arg, "--jobs=", 7) == 0) {
+            config->jobs = (size_t)strtoull(arg + 7, &end, 10);
+        } else if (strncmp(arg, "--timeout=", 10) == 0) {
+            config->timeout_ms = strtod(arg + 10, &end);
+        } else if (strncmp(arg, "--filter=", 9) == 0) {
+            config->filter = arg + 9;
+        } else if (strcmp(arg, "--no-fork") == 0) {
+            config->no_fork = true;
+        } else if (strcmp(arg, "--verbose") == 0) {
+            config->verbose = true;
+        } else if (strncmp(arg, "--baseline=", 11) == 0) {
+            config->baseline = arg + 11;
+        } else if (strncmp(arg, "--save-baseline=", 16) == 0) {
+            config->save_baseline = arg + 16;
+        } else if (strncmp(arg, "--threshold=", 12) == 0) {
+            config->threshold = strtod(arg + 12, &end);
+        } else if (strcmp(arg, "--fail-slow") == 0) {
+            config->fail_slow = true;
+        } else {
+            end = (char *)arg;
+        }
+        if (end != nullptr && *end != '\0') {
+            nsl_eprintf("[TEST] unknown or invalid option: %s\n", arg);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+NSL_TEST_DEF int nsl_test_main(int argc, char **argv) {
+    NSL_TestConfig config = {};
+    if (!nsl_test_parse_args(&config, argc, argv)) { return 1; }
+    return nsl_test_run(&config, stdout).failed == 0 ? 0 : 1;
+}
+
+#    endif  // NSL_TEST_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(TEST)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(TEST)
+#    ifndef NSL_TEST_STRIP_PREFIX_GUARD_
+#        define NSL_TEST_STRIP_PREFIX_GUARD_
+
+#        define TestConfig      NSL_TestConfig
+#        define TestSummary     NSL_TestSummary
+#        define test            nsl_test
+#        define test_run        nsl_test_run
+#        define test_parse_args nsl_test_parse_args
+#        define test_main       nsl_test_main
+
+#    endif  // NSL_TEST_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(TEST)
@@ -0,0 +1,599 @@
+/**************************************************************************/
+/* The MIT License (MIT)                                                  */
+/*                                                                        */
+/* Copyright (c) 2025 Jacob Long                                          */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+/*!
+ * A hierarchical timer wheel, for keeping millions of timeouts of which few
+ * ever fire. Time is counted in ticks, such as milliseconds. The wheel has
+ * eleven levels of 64 slots. A slot of the first level holds the timers that
+ * expire on one tick, a slot of the second level those that expire within
+ * one span of 64 ticks, and so on, so that the levels cover every 64-bit
+ * deadline. A timer is put on the level of the highest bit in which its
+ * deadline differs from the current tick, so starting and cancelling a timer
+ * take constant time.
+ *
+ * When the current tick reaches the start of the span of a slot of a higher
+ * level, its timers are moved down to lower levels. A timer is moved at most
+ * once per level, and most timeouts are cancelled or restarted long before
+ * they reach the first level. Each level keeps a bitmap of the slots that
+ * hold timers, so `nsl_timer_wheel_advance` skips straight to the next tick
+ * on which something happens, however far the wheel moves. Every timer that
+ * expires on the same tick is taken from its slot at once, and their
+ * functions are called in a batch.
+ *
+ * Timers are intrusive: an `NSL_Timer` is a member of the struct it times,
+ * such as a connection, which can have several of them. The wheel never
+ * allocates. The function of a timer finds the struct that holds it with
+ * `offsetof`.
+ *
+ * `nsl_timer_wheel_attach` makes a coroutine scheduler from
+ * `nonstdlib/coroutine.h` drive a wheel whose ticks are milliseconds of
+ * `nsl_timer_now_ms`. A coroutine that is started on the scheduler sleeps on
+ * a `timerfd` until the next tick on which something happens, and
+ * `nsl_timer_await` parks a coroutine until a timer expires. To time out a
+ * coroutine that waits for a file descriptor, the function of a timer can
+ * `shutdown` the socket, which wakes it. A wheel is not thread safe; give
+ * each scheduler, such as one in each task of a `nonstdlib/sequencer.h`
+ * sequencer, a wheel of its own.
+ *
+ * This module is Linux only, and needs `_POSIX_C_SOURCE` to be at least
+ * `200809L` before any header is included.
+ *
+ * # Example
+ *
+ * ```c
+ * #define _POSIX_C_SOURCE 200809L
+ * #define NSL_IMPLEMENTATION
+ * #include "nonstdlib/timer.h"
+ *
+ * typedef struct Connection {
+ *     int       fd;
+ *     NSL_Timer idle;
+ * } Connection;
+ *
+ * void close_idle(NSL_Timer *timer) {
+ *     Connection *connection = (Connection *)((char *)timer - offsetof(Connection, idle));
+ *     close(connection->fd);
+ * }
+ *
+ * // restarts the idle timeout of a connection whenever it receives data
+ * void on_data(NSL_TimerWheel *wheel, Connection *connection) {
+ *     nsl_timer_start(wheel, &connection->idle, wheel->now + 30000, close_idle);
+ * }
+ *
+ * int main() {
+ *     NSL_TimerWheel wheel;
+ *     nsl_timer_wheel_init(&wheel, nsl_timer_now_ms());
+ *     while (serving) {
+ *         poll_connections(&wheel);
+ *         nsl_timer_wheel_advance(&wheel, nsl_timer_now_ms());
+ *     }
+ *     nsl_timer_wheel_free(&wheel);
+ * }
+ * ```
+ *
+ * # Macro Flags
+ *
+ * - `NSL_IMPLEMENTATION`: Defining this macro before this file is included
+ *   will include the implementation of the entire library.
+ * - `NSL_TIMER_IMPLEMENTATION`: Same as `NSL_IMPLEMENTATION`, but will only
+ *   include the implementation for this module.
+ * - `NSL_STRIP_PREFIX`: Defining this macro before this file is included will
+ *   cause public facing utilities to have the `NSL_`/`nsl_` prefix stripped
+ *   from their name.
+ * - `NSL_TIMER_STRIP_PREFIX`: Same as `NSL_STRIP_PREFIX`, but will only strip
+ *   prefixes for things in this module and not in the entire library.
+ *
+ * # Redefinable Macros
+ *
+ * - `NSL_TIMER_DEF`: Can be defined to change the storage class or linkage of
+ *   the functions in this module (e.g. `static`).
+ */
+
+#ifndef NSL_TIMER_H_
+#define NSL_TIMER_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               VERSION MACROS                               */
+/*                                                                            */
+/******************************************************************************/
+
+#define NSL_TIMER_VERSION_MAJOR 0
+#define NSL_TIMER_VERSION_MINOR 1
+#define NSL_TIMER_VERSION_PATCH 0
+
+/******************************************************************************/
+/*                                                                            */
+/*                                  INCLUDES                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include "nonstdlib/common.h"
+#include "nonstdlib/coroutine.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/*                                                                            */
+/*                           USER-DEFINABLE MACROS                            */
+/*                                                                            */
+/******************************************************************************/
+
+/*!
+ * `NSL_TIMER_DEF` is placed in front of every function declaration and
+ * definition in this module. By default, it is empty, giving the functions
+ * external linkage.
+ */
+#ifndef NSL_TIMER_DEF
+#    define NSL_TIMER_DEF
+#endif  // NSL_TIMER_DEF
+
+/******************************************************************************/
+/*                                                                            */
+/*                                DECLARATIONS                                */
+/*                                                                            */
+/******************************************************************************/
+
+// Each level has 64 slots, one for each value of 6 bits of a deadline, and
+// 11 levels cover all 64 bits.
+#define NSL__TIMER_BITS   6
+#define NSL__TIMER_SLOTS  64
+#define NSL__TIMER_LEVELS 11
+
+typedef struct NSL_Timer NSL_Timer;
+
+/*!
+ * The function that is called when a timer expires. It may start and cancel
+ * timers, including the one that expired, but not advance the wheel.
+ */
+typedef void NSL_TimerFn(NSL_Timer *timer);
+
+/*!
+ * A timer. This is meant to be a member of the struct that it times, and
+ * must be zero initialized before it is first started.
+ */
+struct NSL_Timer {
+    //! The tick on which the timer expires, if it is pending.
+    uint64_t deadline;
+    //! The function that is called when the timer expires.
+    NSL_TimerFn *fn;
+    //! Private: the next timer in the same slot, and the pointer that points
+    //! to this timer, or `nullptr` if the timer is not pending.
+    NSL_Timer  *next;
+    NSL_Timer **link;
+    //! Private: the index of the slot that holds the timer.
+    uint32_t slot;
+    //! Private: the coroutine that `nsl_timer_await` wakes.
+    NSL_Coroutine *waiter;
+};
+
+/*!
+ * A timer wheel. This must be initialized with `nsl_timer_wheel_init` and
+ * freed with `nsl_timer_wheel_free`.
+ */
+typedef struct NSL_TimerWheel {
+    //! The current tick.
+    uint64_t now;
+    //! The number of pending timers.
+    size_t count;
+    //! Private: the timers of each slot, and a bitmap of the slots of each
+    //! level that hold any.
+    NSL_Timer *slots[NSL__TIMER_LEVELS * NSL__TIMER_SLOTS];
+    uint64_t   occupied[NSL__TIMER_LEVELS];
+    //! Private: the scheduler that drives the wheel, the coroutine that
+    //! advances it, the `timerfd` that it sleeps on, and the tick that the
+    //! `timerfd` is set to.
+    NSL_CoroutineScheduler *scheduler;
+    NSL_Coroutine           driver;
+    bool                    driving;
+    int                     fd;
+    uint64_t                armed;
+} NSL_TimerWheel;
+
+/*!
+ * Parks a coroutine until a timer expires.
+ *
+ * # Parameters
+ * - `co`: The `NSL_Coroutine *` that the body was called with.
+ * - `wheel`: The `NSL_TimerWheel *` to start the timer on.
+ * - `timer`: The `NSL_Timer *` to start.
+ * - `deadline`: The tick on which the coroutine is woken.
+ *
+ * # Requires
+ * - `wheel` is attached to the scheduler of `co`.
+ * - `timer` is not cancelled before it expires.
+ */
+#define nsl_timer_await(co, wheel, timer, deadline)                                                \
+    do {                                                                                           \
+        (timer)->waiter = (co);                                                                    \
+        nsl_timer_start(wheel, timer, deadline, nsl__timer_wake);                                  \
+        nsl_coroutine_park(co);                                                                    \
+    } while (0)
+
+/*!
+ * Initializes a wheel with no timers.
+ *
+ * # Parameters
+ * - `wheel`: The wheel to initialize.
+ * - `now`: The current tick.
+ *
+ * # Modifies
+ * - `wheel`: It is initialized.
+ */
+NSL_TIMER_DEF void nsl_timer_wheel_init(NSL_TimerWheel *wheel, uint64_t now);
+
+/*!
+ * Frees a wheel. Pending timers are abandoned, and never expire.
+ *
+ * # Parameters
+ * - `wheel`: The wheel to free.
+ *
+ * # Requires
+ * - `wheel` is initialized.
+ * - If `wheel` is attached to a scheduler, the scheduler has finished running.
+ *
+ * # Modifies
+ * - `wheel`: It is no longer initialized.
+ */
+NSL_TIMER_DEF void nsl_timer_wheel_free(NSL_TimerWheel *wheel);
+
+/*!
+ * Starts a timer, or restarts it with a new deadline if it is pending.
+ *
+ * # Parameters
+ * - `wheel`: The wheel.
+ * - `timer`: The timer.
+ * - `deadline`: The tick on which the timer expires. A deadline that is not
+ *   after the current tick expires on the next tick.
+ * - `fn`: The function that is called when the timer expires.
+ *
+ * # Requires
+ * - `timer` is zero initialized, or has been started on `wheel`.
+ *
+ * # Modifies
+ * - `timer`: It is pending until it expires or is cancelled.
+ * - `wheel`: It holds `timer`.
+ */
+NSL_TIMER_DEF void
+nsl_timer_start(NSL_TimerWheel *wheel, NSL_Timer *timer, uint64_t deadline, NSL_TimerFn *fn);
+
+/*!
+ * Cancels a timer.
+ *
+ * # Parameters
+ * - `wheel`: The wheel.
+ * - `timer`: The timer.
+ *
+ * # Requires
+ * - `timer` is zero initialized, or has been started on `wheel`.
+ *
+ * # Modifies
+ * - `timer`: It is no longer pending.
+ * - `wheel`: It no longer holds `timer`.
+ *
+ * # Returns
+ * Whether the timer was pending.
+ */
+NSL_TIMER_DEF bool nsl_timer_cancel(NSL_TimerWheel *wheel, NSL_Timer *timer);
+
+/*!
+ * Returns whether a timer is pending, which is from when it is started until
+ * it expires or is cancelled.
+ *
+ * # Parameters
+ * - `timer`: The timer.
+ */
+static inline bool nsl_timer_is_pending(const NSL_Timer *timer) {
+    return timer->link != nullptr;
+}
+
+/*!
+ * Moves a wheel forward to a tick, and calls the function of every timer
+ * that expires on or before it, in the order of their deadlines. While the
+ * function of a timer is called, `wheel->now` is its deadline.
+ *
+ * # Parameters
+ * - `wheel`: The wheel.
+ * - `now`: The tick to move to. A tick before the current tick does nothing.
+ *
+ * # Modifies
+ * - `wheel`: Its timers that expire are removed, and it is at `now`.
+ *
+ * # Returns
+ * The number of timers that expired.
+ */
+NSL_TIMER_DEF size_t nsl_timer_wheel_advance(NSL_TimerWheel *wheel, uint64_t now);
+
+/*!
+ * Returns the next tick on which the wheel has something to do, which is no
+ * later than the earliest deadline of its timers. A loop that advances the
+ * wheel can sleep until then.
+ *
+ * # Parameters
+ * - `wheel`: The wheel.
+ *
+ * # Returns
+ * The tick, or `UINT64_MAX` if no timer is pending.
+ */
+NSL_TIMER_DEF uint64_t nsl_timer_wheel_next(const NSL_TimerWheel *wheel);
+
+/*!
+ * Makes a scheduler advance a wheel, whose ticks are then milliseconds of
+ * `nsl_timer_now_ms`. Whenever a timer is pending, a coroutine on the
+ * scheduler sleeps on a `timerfd` until the next tick on which the wheel has
+ * something to do, and then advances it to the current time.
+ *
+ * # Parameters
+ * - `wheel`: The wheel.
+ * - `scheduler`: The scheduler.
+ *
+ * # Requires
+ * - `wheel` is not attached to a scheduler.
+ * - `wheel` was initialized with a tick of `nsl_timer_now_ms`.
+ *
+ * # Modifies
+ * - `wheel`: It is advanced by the scheduler.
+ *
+ * # Returns
+ * Whether the `timerfd` could be created. If not, `wheel` is not attached.
+ */
+NSL_TIMER_DEF bool
+nsl_timer_wheel_attach(NSL_TimerWheel *wheel, NSL_CoroutineScheduler *scheduler);
+
+/*!
+ * Returns the time of `CLOCK_MONOTONIC` in milliseconds.
+ */
+NSL_TIMER_DEF uint64_t nsl_timer_now_ms(void);
+
+NSL_TIMER_DEF void nsl__timer_wake(NSL_Timer *timer);
+
+#endif  // NSL_TIMER_H_
+
+/******************************************************************************/
+/*                                                                            */
+/*                               IMPLEMENTATION                               */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_INCLUDE_IMPLEMENTATION(TIMER)
+#    ifndef NSL_TIMER_IMPLEMENTATION_GUARD_
+#        define NSL_TIMER_IMPLEMENTATION_GUARD_
+
+#        include <sys/timerfd.h>
+#        include <time.h>
+#        include <unistd.h>
+
+// Marks a timer that has been taken from its slot to expire.
+#        define NSL__TIMER_EXPIRING UINT32_MAX
+
+static void nsl__timer_push(NSL_Timer **head, NSL_Timer *timer) {
+    timer->next = *head;
+    timer->link = head;
+    if (*head != nullptr) { (*head)->link = &timer->next; }
+    *head = timer;
+}
+
+// Puts a timer on the level of the highest bit in which its deadline differs
+// from the current tick. Every pending timer is in a slot after the current
+// one of its level, which `nsl_timer_wheel_next` relies on.
+static void nsl__timer_insert(NSL_TimerWheel *wheel, NSL_Timer *timer) {
+    int      high  = 63 - __builtin_clzll(timer->deadline ^ wheel->now);
+    unsigned level = (unsigned)high / NSL__TIMER_BITS;
+    unsigned slot  = (unsigned)(timer->deadline >> (level * NSL__TIMER_BITS)) % NSL__TIMER_SLOTS;
+    timer->slot    = level * NSL__TIMER_SLOTS + slot;
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+    nsl__timer_push(&wheel->slots[timer->slot], timer);
+}
+
+// Empties a slot, and returns its timers as a list.
+static NSL_Timer *nsl__timer_take(NSL_TimerWheel *wheel, unsigned level, unsigned slot) {
+    NSL_Timer *head = wheel->slots[level * NSL__TIMER_SLOTS + slot];
+    wheel->slots[level * NSL__TIMER_SLOTS + slot] = nullptr;
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+    return head;
+}
+
+static void nsl__timer_arm(NSL_TimerWheel *wheel) {
+    uint64_t          next  = nsl_timer_wheel_next(wheel);
+    struct itimerspec value = {
+        .it_value = {.tv_sec = (time_t)(next / 1000), .tv_nsec = (long)(next % 1000) * 1000000},
+    };
+    // a time of zero would disarm the `timerfd` instead
+    if (next == 0) { value.it_value.tv_nsec = 1; }
+    wheel->armed = next;
+    timerfd_settime(wheel->fd, TFD_TIMER_ABSTIME, &value, nullptr);
+}
+
+static NSL_CoroutineStatus nsl__timer_driver(NSL_Coroutine *co) {
+    NSL_TimerWheel *wheel = (NSL_TimerWheel *)((char *)co - offsetof(NSL_TimerWheel, driver));
+    nsl_coroutine_begin(co);
+    while (wheel->count > 0) {
+        nsl__timer_arm(wheel);
+        nsl_coroutine_await_fd(co, wheel->fd, EPOLLIN);
+        uint64_t expirations;
+        // the `timerfd` is non-blocking, and only needs to be read to reset it
+        if (read(wheel->fd, &expirations, sizeof(expirations)) < 0) {}
+        nsl_timer_wheel_advance(wheel, nsl_timer_now_ms());
+    }
+    wheel->driving = false;
+    nsl_coroutine_end(co);
+}
+
+NSL_TIMER_DEF void nsl_timer_wheel_init(NSL_TimerWheel *wheel, uint64_t now) {
+    *wheel     = (NSL_TimerWheel){};
+    wheel->now = now;
+    wheel->fd  = -1;
+}
+
+NSL_TIMER_DEF void nsl_timer_wheel_free(NSL_TimerWheel *wheel) {
+    if (wheel->fd >= 0) { close(wheel->fd); }
+    *wheel = (NSL_TimerWheel){.fd = -1};
+}
+
+NSL_TIMER_DEF void
+nsl_timer_start(NSL_TimerWheel *wheel, NSL_Timer *timer, uint64_t deadline, NSL_TimerFn *fn) {
+    nsl_timer_cancel(wheel, timer);
+    timer->deadline = deadline > wheel->now ? deadline : wheel->now + 1;
+    timer->fn       = fn;
+    nsl__timer_insert(wheel, timer);
+    wheel->count++;
+
+    if (wheel->scheduler == nullptr) { return; }
+    if (!wheel->driving) {
+        wheel->driving = true;
+        nsl_coroutine_spawn(wheel->scheduler, &wheel->driver, nsl__timer_driver);
+    } else if (timer->deadline < wheel->armed) {
+        nsl__timer_arm(wheel);
+    }
+}
+
+NSL_TIMER_DEF bool nsl_timer_cancel(NSL_TimerWheel *wheel, NSL_Timer *timer) {
+    if (timer->link == nullptr) { return false; }
+    *timer->link = timer->next;
+    if (timer->next != nullptr) { timer->next->link = timer->link; }
+    timer->link = nullptr;
+    wheel->count--;
+
+    // a timer that is about to expire was already taken from its slot
+    if (timer->slot != NSL__TIMER_EXPIRING && wheel->slots[timer->slot] == nullptr) {
+        wheel->occupied[timer->slot / NSL__TIMER_SLOTS] &=
+            ~((uint64_t)1 << timer->slot % NSL__TIMER_SLOTS);
+    }
+    return true;
+}
+
+NSL_TIMER_DEF uint64_t nsl_timer_wheel_next(const NSL_TimerWheel *wheel) {
+    uint64_t next = UINT64_MAX;
+    for (unsigned level = 0; level < NSL__TIMER_LEVELS; level++) {
+        if (wheel->occupied[level] == 0) { continue; }
+        // the start of the span of the first slot that holds timers, which is
+        // after the current slot of the level
+        unsigned shift = level * NSL__TIMER_BITS;
+        unsigned above = shift + NSL__TIMER_BITS;
+        uint64_t start = above >= 64 ? 0 : wheel->now >> above << above;
+        start         += (uint64_t)__builtin_ctzll(wheel->occupied[level]) << shift;
+        if (start < next) { next = start; }
+    }
+    return next;
+}
+
+NSL_TIMER_DEF size_t nsl_timer_wheel_advance(NSL_TimerWheel *wheel, uint64_t now) {
+    size_t expired = 0;
+    while (wheel->count > 0) {
+        uint64_t next = nsl_timer_wheel_next(wheel);
+        if (next > now) { break; }
+        wheel->now = next;
+
+        // Move the timers of the slots whose span starts on this tick down,
+        // from the highest level, and collect those that expire on it.
+        NSL_Timer *expiring = nullptr;
+        for (unsigned level = NSL__TIMER_LEVELS; level-- > 1;) {
+            unsigned shift = level * NSL__TIMER_BITS;
+            if ((next & (((uint64_t)1 << shift) - 1)) != 0) { continue; }
+            unsigned slot = (unsigned)(next >> shift) % NSL__TIMER_SLOTS;
+            if ((wheel->occupied[level] >> slot & 1) == 0) { continue; }
+            NSL_Timer *timer = nsl__timer_take(wheel, level, slot);
+            while (timer != nullptr) {
+                NSL_Timer *following = timer->next;
+                if (timer->deadline == next) {
+                    timer->slot = NSL__TIMER_EXPIRING;
+                    nsl__timer_push(&expiring, timer);
+                } else {
+                    nsl__timer_insert(wheel, timer);
+                }
+                timer = following;
+            }
+        }
+        unsigned slot = (unsigned)next % NSL__TIMER_SLOTS;
+        if ((wheel->occupied[0] >> slot & 1) != 0) {
+            NSL_Timer *timer = nsl__timer_take(wheel, 0, slot);
+            while (timer != nullptr) {
+                NSL_Timer *following = timer->next;
+                timer->slot          = NSL__TIMER_EXPIRING;
+                nsl__timer_push(&expiring, timer);
+                timer = following;
+            }
+        }
+
+        // A function may cancel a timer that has not been called yet, which
+        // unlinks it from this list.
+        while (expiring != nullptr) {
+            NSL_Timer *timer = expiring;
+            nsl_timer_cancel(wheel, timer);
+            timer->fn(timer);
+            expired++;
+        }
+    }
+    wheel->now = now > wheel->now ? now : wheel->now;
+    return expired;
+}
+
+NSL_TIMER_DEF bool
+nsl_timer_wheel_attach(NSL_TimerWheel *wheel, NSL_CoroutineScheduler *scheduler) {
+    wheel->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (wheel->fd < 0) { return false; }
+    wheel->scheduler = scheduler;
+    return true;
+}
+
+NSL_TIMER_DEF uint64_t nsl_timer_now_ms(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000 + (uint64_t)time.tv_nsec / 1000000;
+}
+
+NSL_TIMER_DEF void nsl__timer_wake(NSL_Timer *timer) {
+    nsl_coroutine_wake(timer->waiter);
+}
+
+#    endif  // NSL_TIMER_IMPLEMENTATION_GUARD_
+#endif      // NSL_SHOULD_INCLUDE_IMPLEMENTATION(TIMER)
+
+/******************************************************************************/
+/*                                                                            */
+/*                                STRIP PREFIX                                */
+/*                                                                            */
+/******************************************************************************/
+
+#if NSL_SHOULD_STRIP_PREFIX(TIMER)
+#    ifndef NSL_TIMER_STRIP_PREFIX_GUARD_
+#        define NSL_TIMER_STRIP_PREFIX_GUARD_
+
+#        define Timer               NSL_Timer
+#        define TimerFn             NSL_TimerFn
+#        define TimerWheel          NSL_TimerWheel
+#        define timer_await         nsl_timer_await
+#        define timer_wheel_init    nsl_timer_wheel_init
+#        define timer_wheel_free    nsl_timer_wheel_free
+#        define timer_start         nsl_timer_start
+#        define timer_cancel        nsl_timer_cancel
+#        define timer_is_pending    nsl_timer_is_pending
+#        define timer_wheel_advance nsl_timer_wheel_advance
+#        define timer_wheel_next    nsl_timer_wheel_next
+#        define timer_wheel_attach  nsl_timer_wheel_attach
+#        define timer_now_ms        nsl_timer_now_ms
+
+#    endif  // NSL_TIMER_STRIP_PREFIX_GUARD_
+#endif      // NSL_SHOULD_STRIP_PREFIX(TIMER)
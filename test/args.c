@@ -0,0 +1,137 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/args.h"
+
+#include <assert.h>
+#include <string.h>
+
+NSL_ARGS_DEFINE(Args,
+                args,
+                NSL_ARGS_FLAG(verbose, v, "verbose", "Print each step."),
+                NSL_ARGS_FLAG(quiet, q, "quiet", "Print nothing."),
+                NSL_ARGS_INT(jobs, j, "jobs", 4, "The number of jobs."),
+                NSL_ARGS_DOUBLE(scale, , "scale", 1.5, "The scale of the output."),
+                NSL_ARGS_STRING(output, o, "output", "a.out", "Where the output is written."))
+
+#define ARGC(argv) ((int)(sizeof(argv) / sizeof(*(argv))))
+
+void test_defaults(void) {
+    Args  args;
+    char *argv[] = {(char[]){"program"}};
+    assert(args_parse(&args, ARGC(argv), argv) == NSL_ARGS_OK);
+    assert(!args.verbose);
+    assert(!args.quiet);
+    assert(args.jobs == 4);
+    assert(args.scale == 1.5);
+    assert(strcmp(args.output, "a.out") == 0);
+    assert(args.argc == 0);
+}
+
+void test_long(void) {
+    Args  args;
+    char *argv[] = {
+        (char[]){"program"},
+        (char[]){"--verbose"},
+        (char[]){"--jobs=0x10"},
+        (char[]){"--scale"},
+        (char[]){"-2.5"},
+        (char[]){"--output="},
+    };
+    assert(args_parse(&args, ARGC(argv), argv) == NSL_ARGS_OK);
+    assert(args.verbose);
+    assert(!args.quiet);
+    assert(args.jobs == 16);
+    assert(args.scale == -2.5);
+    assert(strcmp(args.output, "") == 0);
+}
+
+void test_short(void) {
+    Args  args;
+    char *argv[] = {
+        (char[]){"program"},
+        (char[]){"-vqj8"},
+        (char[]){"-o"},
+        (char[]){"out"},
+    };
+    assert(args_parse(&args, ARGC(argv), argv) == NSL_ARGS_OK);
+    assert(args.verbose);
+    assert(args.quiet);
+    assert(args.jobs == 8);
+    assert(strcmp(args.output, "out") == 0);
+}
+
+void test_positional(void) {
+    // positional arguments are moved to the front, in order, and string values
+    // still point at the original arguments
+    Args  args;
+    char *output = (char[]){"out"};
+    char *argv[] = {
+        (char[]){"program"},
+        (char[]){"first"},
+        (char[]){"-o"},
+        output,
+        (char[]){"-"},
+        (char[]){"-v"},
+        (char[]){"--"},
+        (char[]){"--quiet"},
+        (char[]){"-j"},
+    };
+    assert(args_parse(&args, ARGC(argv), argv) == NSL_ARGS_OK);
+    assert(args.output == output);
+    assert(args.verbose);
+    assert(!args.quiet);
+    assert(args.argc == 4);
+    assert(args.argv == argv + 1);
+    assert(strcmp(args.argv[0], "first") == 0);
+    assert(strcmp(args.argv[1], "-") == 0);
+    assert(strcmp(args.argv[2], "--quiet") == 0);
+    assert(strcmp(args.argv[3], "-j") == 0);
+}
+
+void test_errors(void) {
+    Args  args;
+    char *unknown[] = {(char[]){"program"}, (char[]){"--unknown-option"}};
+    assert(args_parse(&args, ARGC(unknown), unknown) == NSL_ARGS_ERROR);
+    char *unknown_short[] = {(char[]){"program"}, (char[]){"-vx"}};
+    assert(args_parse(&args, ARGC(unknown_short), unknown_short) == NSL_ARGS_ERROR);
+    char *prefix[] = {(char[]){"program"}, (char[]){"--verb"}};
+    assert(args_parse(&args, ARGC(prefix), prefix) == NSL_ARGS_ERROR);
+    char *missing[] = {(char[]){"program"}, (char[]){"--jobs"}};
+    assert(args_parse(&args, ARGC(missing), missing) == NSL_ARGS_ERROR);
+    char *invalid[] = {(char[]){"program"}, (char[]){"--jobs=all-of-them"}};
+    assert(args_parse(&args, ARGC(invalid), invalid) == NSL_ARGS_ERROR);
+    char *range[] = {(char[]){"program"}, (char[]){"--jobs=99999999999999999999"}};
+    assert(args_parse(&args, ARGC(range), range) == NSL_ARGS_ERROR);
+    char *flag_value[] = {(char[]){"program"}, (char[]){"--verbose=yes-please"}};
+    assert(args_parse(&args, ARGC(flag_value), flag_value) == NSL_ARGS_ERROR);
+}
+
+void test_help(void) {
+    Args  args;
+    char *help[] = {(char[]){"program"}, (char[]){"-vh"}, (char[]){"--unknown-option"}};
+    assert(args_parse(&args, ARGC(help), help) == NSL_ARGS_HELP);
+    char *long_help[] = {(char[]){"program"}, (char[]){"--help"}};
+    assert(args_parse(&args, ARGC(long_help), long_help) == NSL_ARGS_HELP);
+
+    char  buffer[1024] = {0};
+    FILE *file         = fmemopen(buffer, sizeof(buffer), "w");
+    args_help(file, "program");
+    fclose(file);
+    assert(strncmp(buffer, "usage: program [options] [arguments]\n", 37) == 0);
+    assert(strstr(buffer, "\n  -v, --verbose\n        Print each step.\n") != nullptr);
+    assert(strstr(buffer, "\n  -j, --jobs=INT\n        The number of jobs. (default: 4)\n") !=
+           nullptr);
+    assert(strstr(buffer, "\n      --scale=NUMBER\n") != nullptr);
+    assert(strstr(buffer, "(default: \"a.out\")\n") != nullptr);
+    assert(strstr(buffer, "\n  -h, --help\n") != nullptr);
+}
+
+int main() {
+    test_defaults();
+    test_long();
+    test_short();
+    test_positional();
+    test_errors();
+    test_help();
+}
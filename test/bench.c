@@ -0,0 +1,132 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bench.h"
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+
+// Kept short so that the test runs quickly.
+static const NSL_BenchConfig CONFIG = {.min_time_ms = 20, .warmup_ms = 5, .samples = 10};
+
+void bench_sum(NSL_Bench *bench) {
+    int *values = bench->arg;
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        int sum = 0;
+        for (int j = 0; j < 64; j++) {
+            sum += values[j];
+        }
+        nsl_bench_do_not_optimize(sum);
+    }
+}
+
+void bench_paused_sleep(NSL_Bench *bench) {
+    for (uint64_t i = 0; i < bench->iterations; i++) {
+        nsl_bench_pause(bench);
+        nanosleep(&(struct timespec){.tv_nsec = 100000}, nullptr);
+        nsl_bench_resume(bench);
+        nsl_bench_clobber_memory();
+    }
+}
+
+void test_run(void) {
+    static int      values[64];
+    NSL_BenchResult result;
+    assert(nsl_bench_run(&CONFIG, "sum", bench_sum, values, &result));
+    assert(strcmp(result.name, "sum") == 0);
+    assert(result.samples == 10);
+    assert(result.iterations > 1);
+    assert(result.min_ns > 0);
+    assert(result.min_ns <= result.median_ns);
+    assert(result.median_ns <= result.p99_ns);
+    assert(result.stddev_ns >= 0);
+
+    // one sample should take about `min_time_ms / samples`, which is 2ms,
+    // with a margin that leaves room for a busy machine
+    double sample_ms = result.mean_ns * (double)result.iterations / 1e6;
+    assert(sample_ms >= 0.2 && sample_ms < 1000.0);
+}
+
+void test_pause(void) {
+    // the sleeps are excluded, so an iteration takes far less than 100us
+    NSL_BenchResult result;
+    assert(nsl_bench_run(&CONFIG, "paused", bench_paused_sleep, nullptr, &result));
+    assert(result.median_ns < 50000);
+}
+
+void test_filter(void) {
+    NSL_BenchConfig config = CONFIG;
+    config.filter          = "other";
+    NSL_BenchResult result = {};
+    assert(!nsl_bench_run(&config, "sum", bench_sum, nullptr, &result));
+    assert(result.name == nullptr);
+}
+
+void test_write(void) {
+    NSL_BenchResult results[] = {
+        {.name = "a", .iterations = 10, .samples = 3, .median_ns = 1.5},
+        {.name = "b", .iterations = 20, .samples = 3, .median_ns = 2.5},
+    };
+    size_t count = sizeof(results) / sizeof(*results);
+
+    char  buffer[1024] = {0};
+    FILE *file         = fmemopen(buffer, sizeof(buffer), "w");
+    nsl_bench_write(file, NSL_BENCH_FORMAT_CSV, results, count);
+    fclose(file);
+    assert(strncmp(buffer, "name,iterations,samples,median_ns,", 34) == 0);
+    assert(strstr(buffer, "\n\"a\",10,3,1.500,") != nullptr);
+    assert(strstr(buffer, "\n\"b\",20,3,2.500,") != nullptr);
+
+    memset(buffer, 0, sizeof(buffer));
+    file = fmemopen(buffer, sizeof(buffer), "w");
+    nsl_bench_write(file, NSL_BENCH_FORMAT_JSON, results, count);
+    fclose(file);
+    assert(buffer[0] == '[');
+    assert(strstr(buffer, "{\"name\": \"a\", \"iterations\": 10, \"samples\": 3, \"median_ns\": 1.500")
+           != nullptr);
+    assert(strstr(buffer, "},\n  {\"name\": \"b\"") != nullptr);
+    assert(strcmp(buffer + strlen(buffer) - 4, "}\n]\n") == 0);
+
+    // names are quoted the way each format needs
+    NSL_BenchResult odd = {.name = "say \"hi\", \\n", .iterations = 1, .samples = 1};
+    memset(buffer, 0, sizeof(buffer));
+    file = fmemopen(buffer, sizeof(buffer), "w");
+    nsl_bench_write(file, NSL_BENCH_FORMAT_CSV, &odd, 1);
+    fclose(file);
+    assert(strstr(buffer, "\n\"say \"\"hi\"\", \\n\",1,1,") != nullptr);
+    memset(buffer, 0, sizeof(buffer));
+    file = fmemopen(buffer, sizeof(buffer), "w");
+    nsl_bench_write(file, NSL_BENCH_FORMAT_JSON, &odd, 1);
+    fclose(file);
+    assert(strstr(buffer, "{\"name\": \"say \\\"hi\\\", \\\\n\", \"iterations\": 1,") != nullptr);
+}
+
+void test_parse_args(void) {
+    NSL_BenchConfig config = {};
+    char *argv[] = {
+        (char[]){"bench"},
+        (char[]){"--json"},
+        (char[]){"--cpu=2"},
+        (char[]){"--samples=7"},
+        (char[]){"--min-time=1.5"},
+        (char[]){"--filter=x"},
+    };
+    assert(nsl_bench_parse_args(&config, (int)(sizeof(argv) / sizeof(*argv)), argv));
+    assert(config.format == NSL_BENCH_FORMAT_JSON);
+    assert(config.pin && config.cpu == 2);
+    assert(config.samples == 7);
+    assert(config.min_time_ms == 1.5);
+    assert(strcmp(config.filter, "x") == 0);
+
+    char *bad[] = {(char[]){"bench"}, (char[]){"--samples=seven"}};
+    assert(!nsl_bench_parse_args(&config, (int)(sizeof(bad) / sizeof(*bad)), bad));
+}
+
+int main() {
+    test_run();
+    test_pause();
+    test_filter();
+    test_write();
+    test_parse_args();
+}
@@ -0,0 +1,156 @@
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/bitset.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+// Not a multiple of 64 or of 256, so that every loop has a tail.
+#define LENGTH (64 * 1000 + 37)
+
+static bool expected[LENGTH];
+static bool other_expected[LENGTH];
+
+// Fills `set` and `bits` with the same random bits, each set with a chance of
+// `percent` in 100.
+void randomize(NSL_BitSet *set, bool *bits, int percent) {
+    nsl_bitset_fill(set, false);
+    for (size_t i = 0; i < set->length; i++) {
+        bits[i] = rand() % 100 < percent;
+        if (bits[i]) { nsl_bitset_set(set, i); }
+    }
+}
+
+void check(const NSL_BitSet *set, const bool *bits) {
+    size_t count = 0;
+    for (size_t i = 0; i < set->length; i++) {
+        assert(nsl_bitset_get(set, i) == bits[i]);
+        count += bits[i];
+    }
+    assert(nsl_bitset_count(set) == count);
+    // the bits past the end stay clear
+    if (set->length % 64 != 0) { assert(set->words[set->length / 64] >> (set->length % 64) == 0); }
+}
+
+void test_bits(void) {
+    NSL_BitSet set;
+    nsl_bitset_init(&set, LENGTH);
+    assert(nsl_bitset_count(&set) == 0);
+    assert(nsl_bitset_next(&set, 0) == LENGTH);
+
+    nsl_bitset_set(&set, 0);
+    nsl_bitset_set(&set, 63);
+    nsl_bitset_set(&set, 64);
+    nsl_bitset_set(&set, LENGTH - 1);
+    assert(nsl_bitset_get(&set, 63) && nsl_bitset_get(&set, 64) && !nsl_bitset_get(&set, 65));
+    nsl_bitset_clear(&set, 63);
+    assert(!nsl_bitset_get(&set, 63) && nsl_bitset_count(&set) == 3);
+
+    nsl_bitset_fill(&set, true);
+    assert(nsl_bitset_count(&set) == LENGTH);
+    nsl_bitset_not(&set);
+    assert(nsl_bitset_count(&set) == 0);
+    nsl_bitset_not(&set);
+    assert(nsl_bitset_count(&set) == LENGTH);
+
+    // shrinking clears the bits past the new end, growing adds clear bits
+    nsl_bitset_resize(&set, 100);
+    assert(nsl_bitset_count(&set) == 100);
+    nsl_bitset_resize(&set, 1000);
+    assert(nsl_bitset_count(&set) == 100 && !nsl_bitset_get(&set, 100));
+    nsl_bitset_resize(&set, 0);
+    assert(nsl_bitset_count(&set) == 0 && nsl_bitset_next(&set, 0) == 0);
+    nsl_bitset_free(&set);
+}
+
+void test_combine(void) {
+    NSL_BitSet set, other;
+    nsl_bitset_init(&set, LENGTH);
+    nsl_bitset_init(&other, LENGTH);
+    randomize(&other, other_expected, 50);
+
+    randomize(&set, expected, 50);
+    nsl_bitset_and(&set, &other);
+    for (size_t i = 0; i < LENGTH; i++) {
+        expected[i] = expected[i] && other_expected[i];
+    }
+    check(&set, expected);
+
+    randomize(&set, expected, 50);
+    nsl_bitset_or(&set, &other);
+    for (size_t i = 0; i < LENGTH; i++) {
+        expected[i] = expected[i] || other_expected[i];
+    }
+    check(&set, expected);
+
+    randomize(&set, expected, 50);
+    nsl_bitset_xor(&set, &other);
+    for (size_t i = 0; i < LENGTH; i++) {
+        expected[i] = expected[i] != other_expected[i];
+    }
+    check(&set, expected);
+
+    randomize(&set, expected, 50);
+    nsl_bitset_andnot(&set, &other);
+    for (size_t i = 0; i < LENGTH; i++) {
+        expected[i] = expected[i] && !other_expected[i];
+    }
+    check(&set, expected);
+
+    nsl_bitset_free(&set);
+    nsl_bitset_free(&other);
+}
+
+void test_next(void) {
+    NSL_BitSet set;
+    nsl_bitset_init(&set, LENGTH);
+    const int percents[] = {0, 1, 50, 100};
+    for (size_t p = 0; p < nsl_carrlen(percents); p++) {
+        randomize(&set, expected, percents[p]);
+        size_t i = nsl_bitset_next(&set, 0);
+        for (size_t j = 0; j < LENGTH; j++) {
+            if (!expected[j]) { continue; }
+            assert(i == j);
+            i = nsl_bitset_next(&set, i + 1);
+        }
+        assert(i == LENGTH);
+    }
+    assert(nsl_bitset_next(&set, LENGTH + 10) == LENGTH);
+    nsl_bitset_free(&set);
+}
+
+void test_rank_select(void) {
+    NSL_BitSet set;
+    nsl_bitset_init(&set, LENGTH);
+    const int percents[] = {0, 1, 50, 100};
+    for (size_t p = 0; p < nsl_carrlen(percents); p++) {
+        randomize(&set, expected, percents[p]);
+        nsl_bitset_build_index(&set);
+        size_t rank = 0;
+        for (size_t i = 0; i < LENGTH; i++) {
+            assert(nsl_bitset_rank(&set, i) == rank);
+            if (expected[i]) {
+                assert(nsl_bitset_select(&set, rank) == i);
+                rank++;
+            }
+        }
+        assert(nsl_bitset_rank(&set, LENGTH) == rank);
+        assert(nsl_bitset_select(&set, rank) == LENGTH);
+        assert(nsl_bitset_select(&set, rank + 5000) == LENGTH);
+    }
+
+    // a single set bit past many empty blocks
+    nsl_bitset_fill(&set, false);
+    nsl_bitset_set(&set, LENGTH - 1);
+    nsl_bitset_build_index(&set);
+    assert(nsl_bitset_select(&set, 0) == LENGTH - 1);
+    assert(nsl_bitset_rank(&set, LENGTH - 1) == 0 && nsl_bitset_rank(&set, LENGTH) == 1);
+    nsl_bitset_free(&set);
+}
+
+int main() {
+    srand(1);
+    test_bits();
+    test_combine();
+    test_next();
+    test_rank_select();
+}
@@ -0,0 +1,173 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/build.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static char dir[] = "/tmp/nsl-build-XXXXXX";
+
+// Returns `name` inside the temporary directory. The result is overwritten by
+// the next call.
+const char *path(const char *name) {
+    static char paths[8][256];
+    static int  next = 0;
+    char       *result = paths[next++ % 8];
+    snprintf(result, sizeof(paths[0]), "%s/%s", dir, name);
+    return result;
+}
+
+void write_file(const char *name, const char *text) {
+    FILE *file = fopen(path(name), "w");
+    assert(file != nullptr);
+    fputs(text, file);
+    fclose(file);
+}
+
+// Compiles both units and returns how many ran.
+size_t compile(const char *define) {
+    char include[300];
+    snprintf(include, sizeof(include), "-I%s", dir);
+    const char *flags[] = {include, define, nullptr};
+
+    NSL_Build build;
+    nsl_build_init(&build, &(NSL_BuildConfig){.cache = path("cache")});
+    nsl_build_compile(&build, "cc", flags, path("a.c"), path("a.o"));
+    nsl_build_compile(&build, "cc", flags, path("b.c"), path("b.o"));
+    assert(nsl_build_wait(&build));
+    assert(build.ran + build.skipped == 2);
+    size_t ran = build.ran;
+    nsl_build_free(&build);
+    return ran;
+}
+
+void test_incremental(void) {
+    write_file("common.h", "#define VALUE 1\n");
+    write_file("only_b.h", "#define OTHER 2\n");
+    write_file("a.c", "#include \"common.h\"\nint a(void) { return VALUE; }\n");
+    write_file("b.c",
+               "#include \"common.h\"\n#include \"only_b.h\"\nint b(void) { return OTHER; }\n");
+
+    assert(compile("-DX") == 2);
+    assert(access(path("a.o"), F_OK) == 0);
+    assert(access(path("b.o.d"), F_OK) == 0);
+    assert(compile("-DX") == 0);
+
+    // a header rebuilds the units that include it, and writing the same
+    // contents again does not count as a change
+    write_file("only_b.h", "#define OTHER 3\n");
+    assert(compile("-DX") == 1);
+    write_file("only_b.h", "#define OTHER 3\n");
+    assert(compile("-DX") == 0);
+    write_file("common.h", "#define VALUE 2\n");
+    assert(compile("-DX") == 2);
+
+    // so do the flags, and a missing output
+    assert(compile("-DY") == 2);
+    unlink(path("a.o"));
+    assert(compile("-DY") == 1);
+}
+
+void test_link_and_failure(void) {
+    write_file("main.c", "int a(void);\nint b(void);\nint main(void) { return a() + b() - 5; }\n");
+    write_file("bad.c", "this does not compile\n");
+
+    NSL_Build build;
+    nsl_build_init(&build, &(NSL_BuildConfig){.cache = path("cache"), .jobs = 2});
+    nsl_build_compile(&build, "cc", nullptr, path("main.c"), path("main.o"));
+    assert(nsl_build_wait(&build));
+
+    // jobs with explicit inputs are skipped in the same way
+    const char *inputs[] = {path("main.o"), path("a.o"), path("b.o")};
+    char        output[256];
+    snprintf(output, sizeof(output), "%s", path("app"));
+    const char *argv[] = {"cc", inputs[0], inputs[1], inputs[2], "-o", output, nullptr};
+    nsl_build_command(&build, argv, output, inputs, 3, nullptr);
+    assert(nsl_build_wait(&build));
+    assert(build.ran == 2);
+    assert(system(output) == 0);
+    nsl_build_command(&build, argv, output, inputs, 3, nullptr);
+    assert(nsl_build_wait(&build));
+    assert(build.ran == 2 && build.skipped == 1);
+
+    nsl_build_compile(&build, "cc", nullptr, path("bad.c"), path("bad.o"));
+    assert(!nsl_build_wait(&build));
+    assert(build.failed == 1);
+    const char *missing[] = {"nsl-build-missing-command", nullptr};
+    nsl_build_command(&build, missing, path("missing"), nullptr, 0, nullptr);
+    assert(!nsl_build_wait(&build));
+    assert(build.failed == 2);
+
+    char  buffer[4096] = {0};
+    FILE *file         = fmemopen(buffer, sizeof(buffer), "w");
+    nsl_build_report(&build, file, 10);
+    fclose(file);
+    assert(strncmp(buffer, "3 ran, 1 skipped, 2 failed", 26) == 0);
+    assert(strstr(buffer, "main.o\n") != nullptr);
+    nsl_build_free(&build);
+}
+
+void test_report_headers(void) {
+    char include[300];
+    snprintf(include, sizeof(include), "-I%s", dir);
+    const char *flags[] = {include, nullptr};
+
+    NSL_Build build;
+    nsl_build_init(&build, nullptr);
+    nsl_build_compile(&build, "cc", flags, path("a.c"), path("a.o"));
+    nsl_build_compile(&build, "cc", flags, path("b.c"), path("b.o"));
+    assert(nsl_build_wait(&build));
+    assert(build.ran == 2);
+
+    char  buffer[4096] = {0};
+    FILE *file         = fmemopen(buffer, sizeof(buffer), "w");
+    nsl_build_report(&build, file, 10);
+    fclose(file);
+    // common.h is charged for both units, so it comes first
+    char *headers = strstr(buffer, "headers");
+    assert(headers != nullptr);
+    char *common = strstr(headers, "common.h");
+    char *only_b = strstr(headers, "only_b.h");
+    assert(common != nullptr && only_b != nullptr && common < only_b);
+    assert(strstr(headers, "   2 units  ") != nullptr);
+    nsl_build_free(&build);
+}
+
+void test_parse_depfile(void) {
+    char text[] = "out\\ dir/a.o: src/a.c \\\n"
+                  "  include/with\\ space.h include/hash\\#.h \\\r\n"
+                  " include/dollar$$.h\n"
+                  "include/with\\ space.h:\n";
+    const char *deps[8];
+    assert(nsl_build_parse_depfile(text, deps, 8) == 4);
+    assert(strcmp(deps[0], "src/a.c") == 0);
+    assert(strcmp(deps[1], "include/with space.h") == 0);
+    assert(strcmp(deps[2], "include/hash#.h") == 0);
+    assert(strcmp(deps[3], "include/dollar$.h") == 0);
+
+    // the count is returned even if the paths do not fit
+    char short_text[] = "a.o: a.c b.h c.h";
+    assert(nsl_build_parse_depfile(short_text, deps, 1) == 3);
+    assert(strcmp(deps[0], "a.c") == 0);
+
+    char empty[] = "a.o:\n";
+    assert(nsl_build_parse_depfile(empty, deps, 8) == 0);
+}
+
+int main() {
+    assert(mkdtemp(dir) != nullptr);
+    test_parse_depfile();
+    test_incremental();
+    test_link_and_failure();
+    test_report_headers();
+
+    const char *files[] = {"cache", "common.h", "only_b.h", "a.c", "b.c", "main.c", "bad.c",
+                           "a.o", "a.o.d", "b.o", "b.o.d", "main.o", "main.o.d", "bad.o.d", "app"};
+    for (size_t i = 0; i < sizeof(files) / sizeof(*files); i++) {
+        unlink(path(files[i]));
+    }
+    assert(rmdir(dir) == 0);
+}
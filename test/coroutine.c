@@ -0,0 +1,185 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/coroutine.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static NSL_CoroutineScheduler scheduler;
+
+static char   trace[64];
+static size_t trace_length;
+
+typedef struct Counter {
+    NSL_Coroutine co;
+    char          name;
+    int           i;
+} Counter;
+
+NSL_CoroutineStatus count(NSL_Coroutine *co) {
+    Counter *counter = (Counter *)co;
+    nsl_coroutine_begin(co);
+    for (counter->i = 0; counter->i < 3; counter->i++) {
+        trace[trace_length++] = counter->name;
+        trace[trace_length++] = (char)('0' + counter->i);
+        nsl_coroutine_yield(co);
+    }
+    nsl_coroutine_end(co);
+}
+
+void test_yield(void) {
+    Counter a = {.name = 'a'};
+    Counter b = {.name = 'b'};
+    nsl_coroutine_spawn(&scheduler, &a.co, count);
+    nsl_coroutine_spawn(&scheduler, &b.co, count);
+    assert(scheduler.live == 2);
+    nsl_coroutine_scheduler_run(&scheduler);
+    assert(scheduler.live == 0);
+    assert(a.co.done && b.co.done);
+    assert(strncmp(trace, "a0b0a1b1a2b2", trace_length) == 0);
+}
+
+typedef struct Reader {
+    NSL_Coroutine co;
+    int           fd;
+    char          buffer[64];
+    size_t        length;
+} Reader;
+
+NSL_CoroutineStatus reader(NSL_Coroutine *co) {
+    Reader *reader = (Reader *)co;
+    nsl_coroutine_begin(co);
+    while (true) {
+        nsl_coroutine_await_fd(co, reader->fd, EPOLLIN);
+        assert(co->revents & (EPOLLIN | EPOLLHUP));
+        ssize_t got = read(reader->fd, reader->buffer + reader->length, 8);
+        if (got <= 0) { break; }
+        reader->length += (size_t)got;
+    }
+    nsl_coroutine_end(co);
+}
+
+typedef struct Writer {
+    NSL_Coroutine co;
+    int           fd;
+    int           i;
+} Writer;
+
+NSL_CoroutineStatus writer(NSL_Coroutine *co) {
+    Writer *writer = (Writer *)co;
+    nsl_coroutine_begin(co);
+    for (writer->i = 0; writer->i < 4; writer->i++) {
+        // the reader has to park between writes, since nothing is readable
+        nsl_coroutine_yield(co);
+        nsl_coroutine_yield(co);
+        assert(write(writer->fd, "chunk", 5) == 5);
+    }
+    close(writer->fd);
+    nsl_coroutine_end(co);
+}
+
+void test_await_fd(void) {
+    int fds[2];
+    assert(pipe(fds) == 0);
+    Reader r = {.fd = fds[0]};
+    Writer w = {.fd = fds[1]};
+    nsl_coroutine_spawn(&scheduler, &r.co, reader);
+    nsl_coroutine_spawn(&scheduler, &w.co, writer);
+
+    // the reader is parked in epoll, not spinning in the ready queue
+    nsl_coroutine_scheduler_poll(&scheduler, 0);
+    assert(scheduler.waiting == 1);
+
+    nsl_coroutine_scheduler_run(&scheduler);
+    assert(r.co.done && w.co.done);
+    assert(r.length == 20);
+    assert(memcmp(r.buffer, "chunkchunkchunkchunk", 20) == 0);
+    close(fds[0]);
+}
+
+void test_regular_file(void) {
+    // epoll cannot watch regular files, which are always ready
+    char path[] = "/tmp/nsl-coroutine-XXXXXX";
+    int  fd     = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, "file", 4) == 4);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    Reader r = {.fd = fd};
+    nsl_coroutine_spawn(&scheduler, &r.co, reader);
+    nsl_coroutine_scheduler_run(&scheduler);
+    assert(r.co.done);
+    assert(r.length == 4);
+    close(fd);
+    unlink(path);
+}
+
+typedef struct Parent {
+    NSL_Coroutine co;
+    Counter       child;
+    size_t        trace_at_join;
+} Parent;
+
+NSL_CoroutineStatus parent(NSL_Coroutine *co) {
+    Parent *parent = (Parent *)co;
+    nsl_coroutine_begin(co);
+    parent->child.name = 'c';
+    nsl_coroutine_spawn(co->scheduler, &parent->child.co, count);
+    nsl_coroutine_join(co, &parent->child.co);
+    parent->trace_at_join = trace_length;
+    // joining a finished coroutine does not park
+    nsl_coroutine_join(co, &parent->child.co);
+    nsl_coroutine_end(co);
+}
+
+void test_join(void) {
+    trace_length = 0;
+    Parent p     = {};
+    nsl_coroutine_spawn(&scheduler, &p.co, parent);
+    nsl_coroutine_scheduler_run(&scheduler);
+    assert(p.co.done);
+    assert(p.trace_at_join == 6);
+}
+
+#define MANY 10000
+
+typedef struct Spinner {
+    NSL_Coroutine co;
+    int           i;
+} Spinner;
+
+static size_t spins;
+
+NSL_CoroutineStatus spinner(NSL_Coroutine *co) {
+    Spinner *spinner = (Spinner *)co;
+    nsl_coroutine_begin(co);
+    for (spinner->i = 0; spinner->i < 10; spinner->i++) {
+        spins++;
+        nsl_coroutine_yield(co);
+    }
+    nsl_coroutine_end(co);
+}
+
+void test_many(void) {
+    Spinner *spinners = calloc(MANY, sizeof(*spinners));
+    for (size_t i = 0; i < MANY; i++) {
+        nsl_coroutine_spawn(&scheduler, &spinners[i].co, spinner);
+    }
+    nsl_coroutine_scheduler_run(&scheduler);
+    assert(spins == 10 * MANY);
+    assert(scheduler.live == 0);
+    free(spinners);
+}
+
+int main() {
+    assert(nsl_coroutine_scheduler_init(&scheduler));
+    test_yield();
+    test_await_fd();
+    test_regular_file();
+    test_join();
+    test_many();
+    nsl_coroutine_scheduler_free(&scheduler);
+}
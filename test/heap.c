@@ -0,0 +1,199 @@
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/heap.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define COUNT 10000
+
+#define less(a, b)    ((a) < (b))
+#define greater(a, b) ((a) > (b))
+
+NSL_HEAP_DEFINE(IntHeap, int_heap, int, less)
+NSL_HEAP_DEFINE(BinaryHeap, binary_heap, int, less, 2)
+NSL_HEAP_DEFINE(TernaryMaxHeap, ternary_max_heap, int, greater, 3)
+
+typedef struct Task {
+    const char *name;
+    int         priority;
+} Task;
+
+bool task_less(Task a, Task b) {
+    return a.priority < b.priority;
+}
+
+NSL_HEAP_DEFINE(TaskHeap, task_heap, Task, task_less)
+NSL_INDEXED_HEAP_DEFINE(Frontier, frontier, int, less)
+NSL_INDEXED_HEAP_DEFINE(BinaryFrontier, binary_frontier, int, less, 2)
+
+static int values[COUNT];
+static int sorted[COUNT];
+
+int compare_ints(const void *a, const void *b) {
+    return (*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b);
+}
+
+void randomize(void) {
+    for (size_t i = 0; i < COUNT; i++) {
+        values[i] = rand() % (COUNT / 2);
+    }
+    memcpy(sorted, values, sizeof(values));
+    qsort(sorted, COUNT, sizeof(int), compare_ints);
+}
+
+void test_push_pop(void) {
+    randomize();
+
+    IntHeap heap;
+    int_heap_init(&heap);
+    for (size_t i = 0; i < COUNT; i++) {
+        int_heap_push(&heap, values[i]);
+    }
+    assert(heap.count == COUNT && int_heap_peek(&heap) == sorted[0]);
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(int_heap_pop(&heap) == sorted[i]);
+    }
+    assert(heap.count == 0);
+    int_heap_free(&heap);
+
+    BinaryHeap binary;
+    binary_heap_init(&binary);
+    for (size_t i = 0; i < COUNT; i++) {
+        binary_heap_push(&binary, values[i]);
+    }
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(binary_heap_pop(&binary) == sorted[i]);
+    }
+    binary_heap_free(&binary);
+
+    TernaryMaxHeap max;
+    ternary_max_heap_init(&max);
+    for (size_t i = 0; i < COUNT; i++) {
+        ternary_max_heap_push(&max, values[i]);
+    }
+    for (size_t i = COUNT; i-- > 0;) {
+        assert(ternary_max_heap_pop(&max) == sorted[i]);
+    }
+    ternary_max_heap_free(&max);
+
+    TaskHeap tasks;
+    task_heap_init(&tasks);
+    task_heap_push(&tasks, (Task){"write", 2});
+    task_heap_push(&tasks, (Task){"read", 1});
+    task_heap_push(&tasks, (Task){"close", 3});
+    assert(strcmp(task_heap_pop(&tasks).name, "read") == 0);
+    assert(strcmp(task_heap_pop(&tasks).name, "write") == 0);
+    assert(strcmp(task_heap_pop(&tasks).name, "close") == 0);
+    task_heap_free(&tasks);
+}
+
+void test_heapify(void) {
+    randomize();
+
+    // into an empty heap, then fewer items than there are in the heap, then
+    // more, which take different paths
+    IntHeap heap;
+    int_heap_init(&heap);
+    int_heap_heapify(&heap, values, COUNT / 2);
+    int_heap_heapify(&heap, values + COUNT / 2, COUNT / 10);
+    int_heap_heapify(&heap, values + COUNT / 2 + COUNT / 10, COUNT / 2 - COUNT / 10);
+    int_heap_heapify(&heap, values, 0);
+    assert(heap.count == COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(int_heap_pop(&heap) == sorted[i]);
+    }
+    int_heap_heapify(&heap, values, 1);
+    assert(heap.count == 1 && int_heap_pop(&heap) == values[0]);
+    int_heap_free(&heap);
+}
+
+void test_indexed(void) {
+    randomize();
+
+    Frontier heap;
+    frontier_init(&heap);
+    assert(!frontier_contains(&heap, 0) && !frontier_contains(&heap, COUNT));
+    for (size_t i = 0; i < COUNT; i++) {
+        frontier_push(&heap, i, values[i]);
+    }
+    assert(frontier_contains(&heap, COUNT - 1) && !frontier_contains(&heap, COUNT));
+
+    // move items both ways, and remove every tenth
+    for (size_t i = 0; i < COUNT; i++) {
+        values[i] += i % 2 == 0 ? -(rand() % 100) : rand() % 100;
+        frontier_update(&heap, i, values[i]);
+    }
+    for (size_t i = 0; i < COUNT; i += 10) {
+        frontier_remove(&heap, i);
+        assert(!frontier_contains(&heap, i));
+    }
+
+    int    last   = INT32_MIN;
+    size_t popped = 0;
+    while (heap.count > 0) {
+        assert(frontier_peek(&heap) == heap.items[0].item);
+        size_t id;
+        int    value = frontier_pop(&heap, &id);
+        assert(value >= last && value == values[id] && id % 10 != 0);
+        assert(!frontier_contains(&heap, id));
+        last = value;
+        popped++;
+    }
+    assert(popped == COUNT - COUNT / 10);
+
+    // ids can be pushed again after they are popped
+    frontier_push(&heap, 5, 1);
+    frontier_push(&heap, 3, 2);
+    frontier_update(&heap, 3, 0);
+    frontier_remove(&heap, 5);
+    assert(heap.count == 1 && frontier_pop(&heap, nullptr) == 0);
+    frontier_free(&heap);
+}
+
+// Dijkstra's algorithm on a grid where moving right costs 1 and moving down
+// costs 2, whose shortest paths are known.
+#define SIDE 50
+
+void test_dijkstra(void) {
+    BinaryFrontier heap;
+    binary_frontier_init(&heap);
+    static int distances[SIDE * SIDE];
+    for (size_t v = 0; v < SIDE * SIDE; v++) {
+        distances[v] = INT32_MAX;
+    }
+    distances[0] = 0;
+    binary_frontier_push(&heap, 0, 0);
+    while (heap.count > 0) {
+        size_t v;
+        int    distance = binary_frontier_pop(&heap, &v);
+        assert(distance == distances[v]);
+        // an edge back to `v` itself stands in for a missing neighbour
+        size_t right      = v % SIDE + 1 < SIDE ? v + 1 : v;
+        size_t down       = v + SIDE < SIDE * SIDE ? v + SIDE : v;
+        size_t targets[2] = {right, down};
+        int    weights[2] = {1, 2};
+        for (size_t e = 0; e < 2; e++) {
+            size_t w       = targets[e];
+            int    through = distance + weights[e];
+            if (through >= distances[w]) { continue; }
+            if (binary_frontier_contains(&heap, w)) {
+                binary_frontier_update(&heap, w, through);
+            } else {
+                binary_frontier_push(&heap, w, through);
+            }
+            distances[w] = through;
+        }
+    }
+    for (size_t v = 0; v < SIDE * SIDE; v++) {
+        assert(distances[v] == (int)(v % SIDE + 2 * (v / SIDE)));
+    }
+    binary_frontier_free(&heap);
+}
+
+int main() {
+    srand(1);
+    test_push_pop();
+    test_heapify();
+    test_indexed();
+    test_dijkstra();
+}
@@ -0,0 +1,157 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/instrument.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+// This file is also compiled with `NSL_INSTRUMENT_DISABLE` defined, in which
+// case nothing should be recorded and no arguments should be evaluated.
+#if defined(NSL_INSTRUMENT_DISABLE)
+#    define ENABLED false
+#else
+#    define ENABLED true
+#endif
+
+static NSL_InstrStats stats[NSL_INSTRUMENT_MAX_SITES];
+
+// Returns the statistics of the call site named `name`, or `nullptr` if it has
+// not been reached.
+const NSL_InstrStats *find(const char *name) {
+    size_t count = nsl_instr_collect(stats, sizeof(stats) / sizeof(*stats));
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(stats[i].name, name) == 0) { return &stats[i]; }
+    }
+    return nullptr;
+}
+
+static int evaluated = 0;
+
+int side_effect(void) {
+    return ++evaluated;
+}
+
+void test_counter(void) {
+    for (int i = 0; i < 10; i++) {
+        nsl_instr_count("hits", 2);
+    }
+    nsl_instr_count("evaluated", side_effect());
+
+    const NSL_InstrStats *hits = find("hits");
+    if (!ENABLED) {
+        assert(hits == nullptr);
+        assert(evaluated == 0);
+        return;
+    }
+    assert(hits != nullptr);
+    assert(hits->kind == NSL_INSTR_COUNTER);
+    assert(strcmp(hits->file, __FILE__) == 0);
+    assert(hits->count == 10);
+    assert(hits->sum == 20);
+    assert(evaluated == 1);
+}
+
+void test_histogram(void) {
+    for (int i = 0; i < 1000; i++) {
+        nsl_instr_record("values", i);
+    }
+
+    const NSL_InstrStats *values = find("values");
+    if (!ENABLED) {
+        assert(values == nullptr);
+        return;
+    }
+    assert(values != nullptr);
+    assert(values->kind == NSL_INSTR_HISTOGRAM);
+    assert(values->count == 1000);
+    assert(values->sum == 999 * 1000 / 2);
+    assert(values->min == 0);
+    assert(values->max == 999);
+
+    // percentiles are the upper bound of their bucket, which is at most 25% off
+    uint64_t p50 = nsl_instr_percentile(values, 50);
+    uint64_t p99 = nsl_instr_percentile(values, 99);
+    assert(p50 >= 499 && p50 <= 499 * 5 / 4);
+    assert(p99 >= 989 && p99 <= 999);
+    assert(nsl_instr_percentile(values, 0) == 0);
+    assert(nsl_instr_percentile(values, 100) == 999);
+}
+
+void sleep_timed(void) {
+    nsl_instr_scope("sleep");
+    nanosleep(&(struct timespec){.tv_nsec = 1000000}, nullptr);
+}
+
+void test_timer(void) {
+    for (int i = 0; i < 5; i++) {
+        sleep_timed();
+    }
+
+    const NSL_InstrStats *sleep = find("sleep");
+    if (!ENABLED) {
+        assert(sleep == nullptr);
+        return;
+    }
+    assert(sleep != nullptr);
+    assert(sleep->kind == NSL_INSTR_TIMER);
+    assert(sleep->count == 5);
+    assert(nsl_instr_ticks_to_ns(sleep->min) >= 0.9e6);
+    assert(nsl_instr_ticks_to_ns(sleep->sum) >= 4.5e6);
+}
+
+#define THREADS 4
+#define COUNTS  1000
+
+int count_in_thread(void *) {
+    for (int i = 0; i < COUNTS; i++) {
+        nsl_instr_count("threads", 1);
+        nsl_instr_record("thread values", i);
+    }
+    return 0;
+}
+
+void test_threads(void) {
+    thrd_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        assert(thrd_create(&threads[i], count_in_thread, nullptr) == thrd_success);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        thrd_join(threads[i], nullptr);
+    }
+
+    // the statistics of threads that have exited are still combined
+    const NSL_InstrStats *counts = find("threads");
+    const NSL_InstrStats *values = find("thread values");
+    if (!ENABLED) {
+        assert(counts == nullptr && values == nullptr);
+        return;
+    }
+    assert(counts != nullptr && values != nullptr);
+    assert(counts->sum == THREADS * COUNTS);
+    assert(values->count == THREADS * COUNTS);
+    assert(values->max == COUNTS - 1);
+}
+
+void test_report(void) {
+    char  buffer[1 << 14] = {0};
+    FILE *file            = fmemopen(buffer, sizeof(buffer), "w");
+    assert(file != nullptr);
+    nsl_instr_report(file);
+    fclose(file);
+
+    assert(strncmp(buffer, "name", 4) == 0);
+    assert((strstr(buffer, "\nhits ") != nullptr) == ENABLED);
+    assert((strstr(buffer, "\nsleep ") != nullptr) == ENABLED);
+}
+
+int main() {
+    test_counter();
+    test_histogram();
+    test_timer();
+    test_threads();
+    test_report();
+}
@@ -0,0 +1,274 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/io.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static char dir[] = "/tmp/nsl-io-XXXXXX";
+
+#define FILE_COUNT 100
+
+// Returns the path of the file at `index` in the temporary directory.
+const char *path(size_t index) {
+    static char paths[FILE_COUNT][64];
+    snprintf(paths[index], sizeof(paths[0]), "%s/%zu", dir, index);
+    return paths[index];
+}
+
+void test_files(NSL_IoConfig config) {
+    NSL_Io io;
+    assert(nsl_io_init(&io, &config));
+    if (config.fallback) { assert(!io.uring); }
+
+    // more requests than fit in the ring at once
+    static NSL_IoRequest requests[FILE_COUNT];
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        nsl_io_open(&io, &requests[i], path(i), O_WRONLY | O_CREAT | O_TRUNC);
+    }
+    assert(io.pending > 0);
+    nsl_io_wait_all(&io);
+    assert(io.pending == 0);
+
+    static char texts[FILE_COUNT][16];
+    int         fds[FILE_COUNT];
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        assert(requests[i].done && requests[i].result >= 0);
+        fds[i] = (int)requests[i].result;
+        snprintf(texts[i], sizeof(texts[0]), "file %zu", i);
+        nsl_io_write(&io, &requests[i], fds[i], texts[i], strlen(texts[i]), 0);
+    }
+    nsl_io_wait_all(&io);
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        assert(requests[i].result == (int64_t)strlen(texts[i]));
+        nsl_io_close(&io, &requests[i], fds[i]);
+    }
+    nsl_io_wait_all(&io);
+
+    // reads into registered buffers, one slot of a single allocation each
+    char        *slots  = malloc(FILE_COUNT * 16);
+    struct iovec buffer = {slots, FILE_COUNT * 16};
+    assert(nsl_io_register_buffers(&io, &buffer, 1));
+    // one index is kept for requests that do not use a registered buffer
+    static struct iovec too_many[UINT16_MAX + 1];
+    assert(!nsl_io_register_buffers(&io, too_many, UINT16_MAX + 1));
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        fds[i] = open(path(i), O_RDONLY);
+        assert(fds[i] >= 0);
+        nsl_io_read_fixed(&io, &requests[i], fds[i], 0, slots + i * 16, 16, 0);
+    }
+    nsl_io_wait_all(&io);
+    for (size_t i = 0; i < FILE_COUNT; i++) {
+        assert(requests[i].result == (int64_t)strlen(texts[i]));
+        assert(memcmp(slots + i * 16, texts[i], strlen(texts[i])) == 0);
+        close(fds[i]);
+        unlink(path(i));
+    }
+    free(slots);
+
+    // errors are results, not failures of the queue
+    NSL_IoRequest missing;
+    nsl_io_open(&io, &missing, path(0), O_RDONLY);
+    nsl_io_wait_all(&io);
+    assert(missing.done && missing.result == -ENOENT);
+
+    nsl_io_free(&io);
+}
+
+void test_shared_fd(NSL_IoConfig config) {
+    NSL_Io io;
+    assert(nsl_io_init(&io, &config));
+
+    // two reads and a write wait on the same socket, the write because the
+    // socket is full
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+    static char fill[4096];
+    size_t      filled = 0;
+    ssize_t     written;
+    while ((written = write(fds[0], fill, sizeof(fill))) > 0) {
+        filled += (size_t)written;
+    }
+    NSL_IoRequest first, second, write_request;
+    char          a, b;
+    nsl_io_read(&io, &first, fds[0], &a, 1, -1);
+    nsl_io_read(&io, &second, fds[0], &b, 1, -1);
+    nsl_io_write(&io, &write_request, fds[0], "!", 1, -1);
+    nsl_io_submit(&io);
+    assert(io.pending == 3);
+
+    assert(write(fds[1], "ab", 2) == 2);
+    static char drain[4096];
+    while (filled > 0) {
+        ssize_t length = read(fds[1], drain, sizeof(drain));
+        assert(length > 0);
+        filled -= (size_t)length;
+    }
+    nsl_io_wait_all(&io);
+    // io_uring may run the reads in either order
+    assert(first.result == 1 && second.result == 1);
+    assert((a == 'a' && b == 'b') || (a == 'b' && b == 'a'));
+    assert(write_request.result == 1);
+    assert(read(fds[1], drain, sizeof(drain)) == 1 && drain[0] == '!');
+    close(fds[0]);
+    close(fds[1]);
+
+    nsl_io_free(&io);
+}
+
+typedef struct Echo {
+    NSL_Coroutine co;
+    NSL_Io       *io;
+    int           in;
+    int           out;
+    NSL_IoRequest request;
+    char          buffer[64];
+    size_t        total;
+} Echo;
+
+// Copies everything from `in` to `out` until `in` is closed.
+NSL_CoroutineStatus echo(NSL_Coroutine *co) {
+    Echo *echo = (Echo *)co;
+    nsl_coroutine_begin(co);
+    while (true) {
+        nsl_io_read(echo->io, &echo->request, echo->in, echo->buffer, sizeof(echo->buffer), -1);
+        nsl_io_await(co, echo->io, &echo->request);
+        if (echo->request.result <= 0) { break; }
+        nsl_io_write(echo->io,
+                     &echo->request,
+                     echo->out,
+                     echo->buffer,
+                     (size_t)echo->request.result,
+                     -1);
+        nsl_io_await(co, echo->io, &echo->request);
+        assert(echo->request.result > 0);
+        echo->total += (size_t)echo->request.result;
+    }
+    close(echo->out);
+    nsl_coroutine_end(co);
+}
+
+typedef struct Source {
+    NSL_Coroutine co;
+    int           fd;
+    int           i;
+} Source;
+
+NSL_CoroutineStatus source(NSL_Coroutine *co) {
+    Source *source = (Source *)co;
+    nsl_coroutine_begin(co);
+    for (source->i = 0; source->i < 10; source->i++) {
+        assert(write(source->fd, "0123456789", 10) == 10);
+        nsl_coroutine_yield(co);
+    }
+    close(source->fd);
+    nsl_coroutine_end(co);
+}
+
+void test_coroutines(NSL_IoConfig config) {
+    NSL_Io io;
+    assert(nsl_io_init(&io, &config));
+    NSL_CoroutineScheduler scheduler;
+    assert(nsl_coroutine_scheduler_init(&scheduler));
+
+    // a chain of pipes: source -> echo -> echo -> check. The pipes are
+    // non-blocking so that the fallback has to wait for them in epoll.
+    int first[2], second[2], third[2];
+    assert(pipe2(first, O_NONBLOCK) == 0);
+    assert(pipe2(second, O_NONBLOCK) == 0);
+    assert(pipe2(third, O_NONBLOCK) == 0);
+    Source s = {.fd = first[1]};
+    Echo   a = {.io = &io, .in = first[0], .out = second[1]};
+    Echo   b = {.io = &io, .in = second[0], .out = third[1]};
+    nsl_coroutine_spawn(&scheduler, &a.co, echo);
+    nsl_coroutine_spawn(&scheduler, &b.co, echo);
+    nsl_coroutine_spawn(&scheduler, &s.co, source);
+    nsl_coroutine_scheduler_run(&scheduler);
+
+    assert(s.co.done && a.co.done && b.co.done);
+    assert(a.total == 100);
+    assert(b.total == 100);
+    char    result[128];
+    ssize_t length = read(third[0], result, sizeof(result));
+    assert(length == 100);
+    assert(memcmp(result, "0123456789", 10) == 0);
+    close(first[0]);
+    close(second[0]);
+    close(third[0]);
+
+    nsl_coroutine_scheduler_free(&scheduler);
+    nsl_io_free(&io);
+}
+
+typedef struct Late {
+    NSL_Coroutine co;
+    NSL_Io       *io;
+    int           fd;
+    int           i;
+    NSL_IoRequest request;
+    char          buffer[16];
+} Late;
+
+NSL_CoroutineStatus late_reader(NSL_Coroutine *co) {
+    Late *late = (Late *)co;
+    nsl_coroutine_begin(co);
+    nsl_io_read(late->io, &late->request, late->fd, late->buffer, sizeof(late->buffer), -1);
+    nsl_io_await(co, late->io, &late->request);
+    nsl_coroutine_end(co);
+}
+
+// Waits for the poller to park before queueing a request.
+NSL_CoroutineStatus late_writer(NSL_Coroutine *co) {
+    Late *late = (Late *)co;
+    nsl_coroutine_begin(co);
+    for (late->i = 0; late->i < 3; late->i++) {
+        nsl_coroutine_yield(co);
+    }
+    nsl_io_write(late->io, &late->request, late->fd, "late", 4, -1);
+    nsl_io_await(co, late->io, &late->request);
+    nsl_coroutine_end(co);
+}
+
+void test_late_request(NSL_IoConfig config) {
+    NSL_Io io;
+    assert(nsl_io_init(&io, &config));
+    NSL_CoroutineScheduler scheduler;
+    assert(nsl_coroutine_scheduler_init(&scheduler));
+
+    int fds[2];
+    assert(pipe2(fds, O_NONBLOCK) == 0);
+    Late reader = {.io = &io, .fd = fds[0]};
+    Late writer = {.io = &io, .fd = fds[1]};
+    nsl_coroutine_spawn(&scheduler, &reader.co, late_reader);
+    nsl_coroutine_spawn(&scheduler, &writer.co, late_writer);
+    nsl_coroutine_scheduler_run(&scheduler);
+
+    assert(reader.co.done && writer.co.done);
+    assert(writer.request.result == 4);
+    assert(reader.request.result == 4);
+    assert(memcmp(reader.buffer, "late", 4) == 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    nsl_coroutine_scheduler_free(&scheduler);
+    nsl_io_free(&io);
+}
+
+int main() {
+    assert(mkdtemp(dir) != nullptr);
+    test_files((NSL_IoConfig){.entries = 8});
+    test_files((NSL_IoConfig){.entries = 8, .fallback = true});
+    test_shared_fd((NSL_IoConfig){});
+    test_shared_fd((NSL_IoConfig){.fallback = true});
+    test_coroutines((NSL_IoConfig){});
+    test_coroutines((NSL_IoConfig){.fallback = true});
+    test_late_request((NSL_IoConfig){});
+    test_late_request((NSL_IoConfig){.fallback = true});
+    assert(rmdir(dir) == 0);
+}
@@ -0,0 +1,238 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define nsl_eprintf       capture_eprintf
+#define NSL_LOG_MIN_LEVEL NSL_LOG_LEVEL_DEBUG
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/log.h"
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <threads.h>
+
+// Everything written with `nsl_eprintf` is captured here. The flusher writes
+// from its own thread, so the buffer is guarded by a mutex.
+static char   captured[1 << 16];
+static size_t captured_length;
+static mtx_t  captured_mutex;
+
+int capture_eprintf(const char *restrict fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    mtx_lock(&captured_mutex);
+    int result = vsnprintf(captured + captured_length, sizeof(captured) - captured_length, fmt, ap);
+    captured_length += (size_t)result;
+    mtx_unlock(&captured_mutex);
+    va_end(ap);
+    return result;
+}
+
+void reset_captured(void) {
+    mtx_lock(&captured_mutex);
+    captured[0]     = '\0';
+    captured_length = 0;
+    mtx_unlock(&captured_mutex);
+}
+
+int count_lines(const char *text) {
+    int lines = 0;
+    for (; *text != '\0'; text++) {
+        lines += *text == '\n';
+    }
+    return lines;
+}
+
+static int evaluated = 0;
+
+int side_effect(void) {
+    return ++evaluated;
+}
+
+void test_synchronous(void) {
+    reset_captured();
+    nsl_log_info("hello %d", 1);
+    nsl_log_error("%s", "world");
+    assert(strcmp(captured, "[INFO] hello 1\n[ERROR] world\n") == 0);
+
+    // messages are truncated to `NSL_LOG_MAX_MESSAGE` including the newline
+    reset_captured();
+    char long_message[2 * NSL_LOG_MAX_MESSAGE];
+    memset(long_message, 'x', sizeof(long_message) - 1);
+    long_message[sizeof(long_message) - 1] = '\0';
+    nsl_log_warn("%s", long_message);
+    assert(captured_length == NSL_LOG_MAX_MESSAGE);
+    assert(strncmp(captured, "[WARN] xxx", 10) == 0);
+    assert(captured[NSL_LOG_MAX_MESSAGE - 1] == '\n');
+}
+
+void test_compile_time_filter(void) {
+    reset_captured();
+    evaluated = 0;
+    nsl_log_trace("%d", side_effect());
+    nsl_log(NSL_LOG_LEVEL_TRACE, "%d", side_effect());
+    assert(evaluated == 0);
+    assert(captured_length == 0);
+
+    nsl_log_debug("%d", side_effect());
+    nsl_log(NSL_LOG_LEVEL_DEBUG, "%d", side_effect());
+    assert(evaluated == 2);
+    assert(strcmp(captured, "[DEBUG] 1\n[DEBUG] 2\n") == 0);
+}
+
+void test_invalid_config(void) {
+    assert(!nsl_log_start(&(NSL_LogConfig){.buffer_size = 100000}));
+    assert(!nsl_log_start(&(NSL_LogConfig){.buffer_size = 1024}));
+}
+
+void test_eprintf_sink(void) {
+    reset_captured();
+    assert(nsl_log_start(nullptr));
+    nsl_log_info("first");
+    nsl_log_warn("second %s", "message");
+    nsl_log_flush();
+    assert(strcmp(captured, "[INFO] first\n[WARN] second message\n") == 0);
+
+    nsl_log_info("third");
+    nsl_log_stop();
+    assert(strcmp(captured, "[INFO] first\n[WARN] second message\n[INFO] third\n") == 0);
+
+    // after stopping, messages are written synchronously again
+    nsl_log_info("fourth");
+    assert(count_lines(captured) == 4);
+}
+
+#define THREADS  4
+#define MESSAGES 2000
+
+int log_messages(void *arg) {
+    int thread = *(int *)arg;
+    for (int i = 0; i < MESSAGES; i++) {
+        nsl_log_info("thread %d message %d", thread, i);
+    }
+    return 0;
+}
+
+void test_fd_sink_threads(void) {
+    FILE *file = tmpfile();
+    assert(file != nullptr);
+    assert(nsl_log_start(&(NSL_LogConfig){
+        .sink        = NSL_LOG_SINK_FD,
+        .fd          = fileno(file),
+        .buffer_size = 1 << 20,
+    }));
+
+    thrd_t threads[THREADS];
+    int    ids[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        ids[i] = i;
+        assert(thrd_create(&threads[i], log_messages, &ids[i]) == thrd_success);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        thrd_join(threads[i], nullptr);
+    }
+    nsl_log_stop();
+
+    // every message is written, and each thread's messages are in order
+    rewind(file);
+    int  next[THREADS] = {0};
+    char line[128];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        int thread, message;
+        assert(sscanf(line, "[INFO] thread %d message %d\n", &thread, &message) == 2);
+        assert(thread >= 0 && thread < THREADS);
+        assert(message == next[thread]);
+        next[thread]++;
+    }
+    for (int i = 0; i < THREADS; i++) {
+        assert(next[i] == MESSAGES);
+    }
+    fclose(file);
+}
+
+void test_dropped(void) {
+    reset_captured();
+    assert(nsl_log_start(&(NSL_LogConfig){
+        .buffer_size       = 4096,
+        .flush_interval_ms = 1000000,
+    }));
+
+    // the flusher only runs once before sleeping, so the buffer fills up
+    for (int i = 0; i < 1000; i++) {
+        nsl_log_info("message %d", i);
+    }
+    nsl_log_stop();
+
+    const char *dropped = strstr(captured, "[WARN] dropped ");
+    assert(dropped != nullptr);
+    int count = 0;
+    assert(sscanf(dropped, "[WARN] dropped %d messages", &count) == 1);
+    assert(count > 0);
+    assert(count + count_lines(captured) - 1 == 1000);
+}
+
+void test_deferred_synchronous(void) {
+    reset_captured();
+    nsl_log_deferred(NSL_LOG_LEVEL_INFO, "no arguments");
+    nsl_log_deferred(NSL_LOG_LEVEL_INFO, "%d%% %ld %llu %zu", -1, 2L, 3ULL, (size_t)4);
+    nsl_log_deferred(NSL_LOG_LEVEL_WARN, "[%5.2f] [%-3s] [%c]", 3.14159, "ab", 'x');
+    nsl_log_deferred(NSL_LOG_LEVEL_ERROR, "%hhx %u %s", (unsigned char)255, 7u, (char *)nullptr);
+    assert(strcmp(captured,
+                  "[INFO] no arguments\n"
+                  "[INFO] -1% 2 3 4\n"
+                  "[WARN] [ 3.14] [ab ] [x]\n"
+                  "[ERROR] ff 7 (null)\n")
+           == 0);
+
+    reset_captured();
+    int  value = 0;
+    char expected[64];
+    snprintf(expected, sizeof(expected), "[DEBUG] %p\n", (void *)&value);
+    nsl_log_deferred(NSL_LOG_LEVEL_DEBUG, "%p", (void *)&value);
+    assert(strcmp(captured, expected) == 0);
+
+    // filtered messages do not evaluate their arguments
+    reset_captured();
+    evaluated = 0;
+    nsl_log_deferred(NSL_LOG_LEVEL_TRACE, "%d", side_effect());
+    assert(evaluated == 0);
+    assert(captured_length == 0);
+}
+
+void test_deferred_buffered(void) {
+    reset_captured();
+    assert(nsl_log_start(&(NSL_LogConfig){.flush_interval_ms = 1000000}));
+
+    // strings are copied when logged, so later changes are not seen
+    char name[] = "before";
+    nsl_log_deferred(NSL_LOG_LEVEL_INFO, "%s %d", name, 1);
+    strcpy(name, "after");
+    nsl_log_info("text %s", name);
+    nsl_log_deferred(NSL_LOG_LEVEL_INFO, "%s %.1f", name, 2.0);
+    nsl_log_flush();
+    assert(strcmp(captured, "[INFO] before 1\n[INFO] text after\n[INFO] after 2.0\n") == 0);
+
+    // long strings are truncated like formatted messages
+    reset_captured();
+    char long_message[2 * NSL_LOG_MAX_MESSAGE];
+    memset(long_message, 'x', sizeof(long_message) - 1);
+    long_message[sizeof(long_message) - 1] = '\0';
+    nsl_log_deferred(NSL_LOG_LEVEL_WARN, "%s %s", long_message, long_message);
+    nsl_log_stop();
+    assert(captured_length == NSL_LOG_MAX_MESSAGE);
+    assert(strncmp(captured, "[WARN] xxx", 10) == 0);
+    assert(captured[NSL_LOG_MAX_MESSAGE - 1] == '\n');
+}
+
+int main() {
+    mtx_init(&captured_mutex, mtx_plain);
+    test_synchronous();
+    test_compile_time_filter();
+    test_invalid_config();
+    test_eprintf_sink();
+    test_fd_sink_threads();
+    test_dropped();
+    test_deferred_synchronous();
+    test_deferred_buffered();
+    mtx_destroy(&captured_mutex);
+}
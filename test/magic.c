@@ -1,13 +1,33 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "nonstdlib/magic.h"
 
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// The command used to preprocess the generated inputs in
+// `test_preprocess_time`. The makefile passes its own compiler.
+#ifndef TEST_CPP
+#    define TEST_CPP "gcc -std=c23 -I. -E"
+#endif
+
+#define STR(x)  STR_(x)
+#define STR_(x) #x
+
+// clang-format off
+#define ARGS_16   0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+#define ARGS_128  ARGS_16, ARGS_16, ARGS_16, ARGS_16, ARGS_16, ARGS_16, ARGS_16, ARGS_16
+#define ARGS_1024 ARGS_128, ARGS_128, ARGS_128, ARGS_128, ARGS_128, ARGS_128, ARGS_128, ARGS_128
+// clang-format on
 
 void test_nargs(void) {
     assert(NSL_NARGS(1, 2, 3) == 3);
     assert(NSL_NARGS(a, b, c, e, f, g, h, i, j, k) == 10);
     assert(NSL_NARGS() == 0);
-    // this goes over the argument limit for NARGS, so it should return the
-    // 128th argument, which is '1'
+    // this goes over the limit of the sliding window, so it is counted
+    // recursively instead
     // clang-format off
     assert(NSL_NARGS('0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
                      '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
@@ -21,7 +41,7 @@ void test_nargs(void) {
                      '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
                      '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
                      '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
-                     '0', '0', '0', '0', '0', '0', '0', '1') == '1');
+                     '0', '0', '0', '0', '0', '0', '0', '1') == 128);
     // clang-format on
 }
 
@@ -151,6 +171,70 @@ void test_foreach(void) {
 #undef TIMES_10
 }
 
+void test_foreach_i(void) {
+    // should evaluate to nothing
+    NSL_FOREACH_I(f)
+
+#define DESIGNATE(i, x) [i] = x
+    int result[] = {NSL_FOREACH_I(DESIGNATE, 10, 20, 30, 40)};
+    assert(sizeof(result) / sizeof(*result) == 4);
+    for (int i = 0; i < 4; i++) {
+        assert(result[i] == (i + 1) * 10);
+    }
+
+    int large[] = {NSL_FOREACH_I(DESIGNATE, ARGS_128, ARGS_128)};
+    assert(sizeof(large) / sizeof(*large) == 256);
+    for (int i = 0; i < 256; i++) {
+        assert(large[i] == i % 16);
+    }
+#undef DESIGNATE
+
+#define PASTE(i, x) #x #i
+    const char *pasted[] = {NSL_FOREACH_I(PASTE, a, b, c)};
+    assert(strcmp(pasted[0], "a0") == 0);
+    assert(strcmp(pasted[1], "b1") == 0);
+    assert(strcmp(pasted[2], "c2") == 0);
+#undef PASTE
+}
+
+void test_fold(void) {
+    assert(NSL_FOLD(f, 42) == 42);
+
+#define ADD(a, b) (a + b)
+#define SUB(a, b) (a - b)
+    assert(NSL_FOLD(ADD, 0, 1, 2, 3, 4) == 10);
+    assert(NSL_FOLD(SUB, 0, 1, 2, 3) == -6);
+    assert(NSL_FOLD(ADD, 0, ARGS_128) == 960);
+#undef SUB
+#undef ADD
+
+#define PLUS(a, b) a + b
+    assert(NSL_FOLD(PLUS, 0, ARGS_1024) == 7680);
+#undef PLUS
+}
+
+void test_range(void) {
+    // should evaluate to nothing
+    NSL_RANGE(0)
+
+    int small[] = {NSL_RANGE(3)};
+    assert(sizeof(small) / sizeof(*small) == 3);
+    assert(small[0] == 0 && small[1] == 1 && small[2] == 2);
+
+    int large[] = {NSL_RANGE(256)};
+    assert(sizeof(large) / sizeof(*large) == 256);
+    for (int i = 0; i < 256; i++) {
+        assert(large[i] == i);
+    }
+
+#define SQUARE(x) (x * x)
+    int squares[] = {NSL_FOREACH(SQUARE, NSL_RANGE(200))};
+    for (int i = 0; i < 200; i++) {
+        assert(squares[i] == i * i);
+    }
+#undef SQUARE
+}
+
 void test_forall_rest(void) {
     // should evaluate to nothing
     NSL_FORALL_REST(f)
@@ -173,6 +257,82 @@ void test_forall_init(void) {
     }
 }
 
+void test_large_args(void) {
+    assert(NSL_NARGS(ARGS_128) == 128);
+    assert(NSL_NARGS(ARGS_128, 1) == 129);
+    assert(NSL_NARGS(ARGS_1024) == 1024);
+    assert(NSL_NARGS(ARGS_1024, ARGS_1024, ARGS_1024, ARGS_1024) == 4096);
+
+    assert(NSL_ARG_TAIL(ARGS_1024, 7) == 7);
+    assert(NSL_NSEP(+, ARGS_1024) == 64 * 120);
+    assert(sizeof(STR(NSL_NCAT(x, ARGS_1024))) == 1 + 64 * 22 + 1);
+    assert(sizeof(STR(NSL_NCAT_SEP(_, x, ARGS_1024))) == 1 + 64 * 38 + 1);
+
+    int init[] = {NSL_ARG_INIT(ARGS_1024, 7)};
+    assert(sizeof(init) / sizeof(*init) == 1024);
+    for (unsigned long i = 0; i < sizeof(init) / sizeof(*init); i++) {
+        assert(init[i] == (int)(i % 16));
+    }
+
+    int reverse[] = {NSL_ARG_REVERSE(ARGS_1024)};
+    assert(sizeof(reverse) / sizeof(*reverse) == 1024);
+    for (unsigned long i = 0; i < sizeof(reverse) / sizeof(*reverse); i++) {
+        assert(reverse[i] == (int)(15 - (i % 16)));
+    }
+
+#define TIMES_10(x) (x * 10)
+    int foreach[] = {NSL_FOREACH(TIMES_10, ARGS_1024)};
+    assert(sizeof(foreach) / sizeof(*foreach) == 1024);
+    for (unsigned long i = 0; i < sizeof(foreach) / sizeof(*foreach); i++) {
+        assert(foreach[i] == (int)((i % 16) * 10));
+    }
+#undef TIMES_10
+
+    int forall_rest[] = {NSL_FORALL_REST(NSL_NARGS, ARGS_128, 0, 0)};
+    assert(sizeof(forall_rest) / sizeof(*forall_rest) == 130);
+    for (unsigned long i = 0; i < sizeof(forall_rest) / sizeof(*forall_rest); i++) {
+        assert(forall_rest[i] == (int)(130 - i));
+    }
+
+    int forall_init[] = {NSL_FORALL_INIT(NSL_NARGS, ARGS_128, 0, 0)};
+    assert(sizeof(forall_init) / sizeof(*forall_init) == 130);
+    for (unsigned long i = 0; i < sizeof(forall_init) / sizeof(*forall_init); i++) {
+        assert(forall_init[i] == (int)(130 - i));
+    }
+}
+
+// Pipes `macro` called with `nargs` arguments through the preprocessor and
+// returns how long it took in milliseconds.
+double preprocess_time(const char *macro, int nargs) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    FILE *cpp = popen(TEST_CPP " -x c - -o /dev/null", "w");
+    assert(cpp != nullptr);
+    fprintf(cpp, "#include \"nonstdlib/magic.h\"\n#define F(x) (x)\n%s", macro);
+    for (int i = 0; i < nargs; i++) {
+        fprintf(cpp, "%sa%d", i == 0 ? "" : ", ", i);
+    }
+    fprintf(cpp, ")\n");
+    assert(pclose(cpp) == 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start.tv_sec) * 1e3 + (double)(end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+void test_preprocess_time(void) {
+    const char *macros[] = {"NSL_NARGS(", "NSL_NCAT(", "NSL_ARG_REVERSE(", "NSL_FOREACH(F, "};
+    int         nargs[]  = {16, 128, 1024};
+    for (unsigned long i = 0; i < sizeof(macros) / sizeof(*macros); i++) {
+        for (unsigned long j = 0; j < sizeof(nargs) / sizeof(*nargs); j++) {
+            double ms = preprocess_time(macros[i], nargs[j]);
+            printf("%5d args: %8.2fms - %s...)\n", nargs[j], ms, macros[i]);
+            // generous bound, the point is to catch expansion that blows up
+            assert(ms < 5000.0);
+        }
+    }
+}
+
 int main() {
     test_nargs();
     test_cat();
@@ -187,6 +347,11 @@ int main() {
     test_arg_init();
     test_arg_reverse();
     test_foreach();
+    test_foreach_i();
+    test_fold();
+    test_range();
     test_forall_rest();
     test_forall_init();
+    test_large_args();
+    test_preprocess_time();
 }
@@ -0,0 +1,185 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_MEMTRACK_ENABLE
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/log.h"
+#include "nonstdlib/memtrack.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+static NSL_MemtrackStats stats[NSL_MEMTRACK_MAX_SITES];
+
+// Returns the statistics of the call site at `file` and `line`, or `nullptr`
+// if it has not allocated.
+const NSL_MemtrackStats *find(const char *file, int line) {
+    size_t count = nsl_memtrack_collect(stats, sizeof(stats) / sizeof(*stats));
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].line == line && strcmp(stats[i].file, file) == 0) { return &stats[i]; }
+    }
+    return nullptr;
+}
+
+void test_call_site(void) {
+    uint64_t live = nsl_memtrack_live_bytes();
+    void    *ptrs[10];
+    int      line = __LINE__ + 2;
+    for (int i = 0; i < 10; i++) {
+        ptrs[i] = nsl_malloc(100);
+        assert(ptrs[i] != nullptr);
+        memset(ptrs[i], 0xab, 100);
+    }
+    assert(nsl_memtrack_live_bytes() == live + 1000);
+    for (int i = 0; i < 5; i++) {
+        nsl_free(ptrs[i]);
+    }
+
+    const NSL_MemtrackStats *site = find(__FILE__, line);
+    assert(site != nullptr);
+    assert(site->allocations == 10);
+    assert(site->frees == 5);
+    assert(site->bytes == 1000);
+    assert(site->freed_bytes == 500);
+    assert(site->peak_bytes == 1000);
+    assert(nsl_memtrack_live_bytes() == live + 500);
+    assert(nsl_memtrack_peak_bytes() >= live + 1000);
+
+    for (int i = 5; i < 10; i++) {
+        nsl_free(ptrs[i]);
+    }
+    nsl_free(nullptr);
+    assert(nsl_memtrack_live_bytes() == live);
+}
+
+void test_realloc(void) {
+    int   first = __LINE__ + 1;
+    char *ptr   = nsl_realloc(nullptr, 16);
+    strcpy(ptr, "preserved");
+    int second = __LINE__ + 1;
+    ptr        = nsl_realloc(ptr, 1 << 20);
+    assert(strcmp(ptr, "preserved") == 0);
+
+    // a reallocation frees the old allocation and allocates at the new site
+    const NSL_MemtrackStats *old = find(__FILE__, first);
+    assert(old != nullptr && old->allocations == 1 && old->frees == 1);
+    const NSL_MemtrackStats *new = find(__FILE__, second);
+    assert(new != nullptr && new->allocations == 1 && new->frees == 0);
+    assert(new->bytes == 1 << 20);
+    nsl_free(ptr);
+}
+
+void test_lifetime(void) {
+    int   line = __LINE__ + 1;
+    void *ptr  = nsl_malloc(1);
+    nanosleep(&(struct timespec){.tv_nsec = 2000000}, nullptr);
+    nsl_free(ptr);
+
+    // 2ms is more than 2^20ns, so it falls in bucket 21 or later
+    const NSL_MemtrackStats *site = find(__FILE__, line);
+    assert(site != nullptr && site->frees == 1);
+    for (int i = 0; i < 21; i++) {
+        assert(site->lifetimes[i] == 0);
+    }
+}
+
+#define THREADS 4
+
+static void *shared[THREADS];
+static int   thread_line;
+
+int allocate_in_thread(void *arg) {
+    int index     = *(int *)arg;
+    thread_line   = __LINE__ + 1;
+    shared[index] = nsl_malloc(64);
+    return 0;
+}
+
+void test_threads(void) {
+    thrd_t threads[THREADS];
+    int    ids[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        ids[i] = i;
+        assert(thrd_create(&threads[i], allocate_in_thread, &ids[i]) == thrd_success);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        thrd_join(threads[i], nullptr);
+    }
+
+    // memory allocated by one thread can be freed by another
+    for (int i = 0; i < THREADS; i++) {
+        nsl_free(shared[i]);
+    }
+    const NSL_MemtrackStats *site = find(__FILE__, thread_line);
+    assert(site != nullptr);
+    assert(site->allocations == THREADS);
+    assert(site->frees == THREADS);
+    assert(site->bytes == THREADS * 64);
+}
+
+void test_library(void) {
+    // allocations made by other modules are attributed to their own call sites
+    uint64_t live = nsl_memtrack_live_bytes();
+    FILE    *sink = tmpfile();
+    assert(sink != nullptr);
+    assert(nsl_log_start(&(NSL_LogConfig){.sink = NSL_LOG_SINK_FD, .fd = fileno(sink)}));
+    nsl_log_info("allocates a buffer");
+    nsl_log_stop();
+    fclose(sink);
+    assert(nsl_memtrack_live_bytes() == live);
+
+    size_t count = nsl_memtrack_collect(stats, sizeof(stats) / sizeof(*stats));
+    bool   found = false;
+    for (size_t i = 0; i < count; i++) {
+        if (strstr(stats[i].file, "nonstdlib/log.h") != nullptr) {
+            assert(stats[i].allocations == stats[i].frees);
+            found = true;
+        }
+    }
+    assert(found);
+}
+
+void test_report(void) {
+    char  buffer[1 << 14] = {0};
+    FILE *file            = fmemopen(buffer, sizeof(buffer), "w");
+    assert(file != nullptr);
+    nsl_memtrack_report(file);
+    fclose(file);
+
+    // the largest allocation is reported first
+    char location[64];
+    snprintf(location, sizeof(location), "%s:", __FILE__);
+    assert(strncmp(buffer, "live: ", 6) == 0);
+    assert(strstr(buffer, location) != nullptr);
+    assert(strstr(strchr(strchr(buffer, '\n') + 1, '\n') + 1, "1048576") != nullptr);
+}
+
+void test_overflow(void) {
+    const NSL_MemtrackStats *other  = find("(other)", 0);
+    uint64_t                 before = other != nullptr ? other->allocations : 0;
+
+    // more call sites than fit in the table, most of them past the limit
+    int free_sites = NSL_MEMTRACK_MAX_SITES - (int)atomic_load(&g_nsl__memtrack.count);
+    for (int line = 1; line <= 3 * NSL_MEMTRACK_MAX_SITES; line++) {
+        nsl_memtrack_free(nsl_memtrack_malloc(1, "overflow.c", line));
+    }
+    other = find("(other)", 0);
+    assert(other != nullptr && other->allocations > before);
+
+    // the first call site past the limit is found without taking the mutex
+    mtx_lock(&g_nsl__memtrack.mutex);
+    assert(nsl__memtrack_site("overflow.c", free_sites + 1) == 0);
+    mtx_unlock(&g_nsl__memtrack.mutex);
+}
+
+int main() {
+    test_call_site();
+    test_realloc();
+    test_lifetime();
+    test_threads();
+    test_library();
+    test_report();
+    test_overflow();
+}
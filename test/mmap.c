@@ -0,0 +1,140 @@
+#define _DEFAULT_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/mmap.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static char path[] = "/tmp/nsl-mmap-XXXXXX";
+
+// Replaces the contents of the test file.
+void write_file(const char *data, size_t length) {
+    FILE *file = fopen(path, "wb");
+    assert(file != nullptr);
+    assert(fwrite(data, 1, length, file) == length);
+    assert(fclose(file) == 0);
+}
+
+bool equals(NSL_StringView view, const char *text) {
+    return view.length == strlen(text) && memcmp(view.data, text, view.length) == 0;
+}
+
+void test_whole_file(void) {
+    write_file("first\n\nthird\nlast", 17);
+    NSL_MmapFile file;
+    assert(nsl_mmap_open(&file, path, nullptr));
+    assert(file.size == 17);
+    assert(equals(file.view, "first\n\nthird\nlast"));
+
+    NSL_StringView line;
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, "first"));
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, ""));
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, "third"));
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, "last"));
+    assert(!nsl_mmap_next_line(&file, &line));
+
+    assert(nsl_mmap_seek(&file, 7));
+    assert(file.offset == 7);
+    assert(equals(file.view, "third\nlast"));
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, "third"));
+    assert(nsl_mmap_seek(&file, 0));
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, "first"));
+    assert(nsl_mmap_seek(&file, 17));
+    assert(!nsl_mmap_next_line(&file, &line));
+    nsl_mmap_close(&file);
+
+    // a trailing newline does not make an empty last line
+    write_file("one\n", 4);
+    assert(nsl_mmap_open(&file, path, nullptr));
+    assert(nsl_mmap_next_line(&file, &line) && equals(line, "one"));
+    assert(!nsl_mmap_next_line(&file, &line));
+    nsl_mmap_close(&file);
+}
+
+void test_empty_and_missing(void) {
+    write_file("", 0);
+    NSL_MmapFile file;
+    assert(nsl_mmap_open(&file, path, nullptr));
+    assert(file.size == 0 && file.view.length == 0);
+    NSL_StringView line;
+    assert(!nsl_mmap_next_line(&file, &line));
+    nsl_mmap_close(&file);
+
+    errno = 0;
+    assert(!nsl_mmap_open(&file, "/tmp/nsl-mmap-does-not-exist", nullptr));
+    assert(errno == ENOENT);
+}
+
+void test_windows(unsigned advice) {
+    // lines of every length up to a few pages, so that lines end and start on
+    // both sides of every window boundary, and some are longer than a window
+    size_t page   = (size_t)sysconf(_SC_PAGESIZE);
+    size_t count  = 3 * page / 7;
+    size_t length = 0;
+    char  *data   = malloc(count * (count + 1) / 2 * 7 + count);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < i * 7; j++) {
+            data[length++] = (char)('a' + (i + j) % 26);
+        }
+        data[length++] = '\n';
+    }
+    write_file(data, length);
+
+    NSL_MmapFile file;
+    assert(nsl_mmap_open(&file, path, &(NSL_MmapConfig){.window = page, .advice = advice}));
+    assert(file.view.length == page);
+    NSL_StringView line;
+    size_t         offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        assert(nsl_mmap_next_line(&file, &line));
+        assert(line.length == i * 7);
+        assert(memcmp(line.data, data + offset, line.length) == 0);
+        offset += line.length + 1;
+    }
+    assert(!nsl_mmap_next_line(&file, &line));
+
+    // seeking to an offset that is not page aligned
+    assert(nsl_mmap_seek(&file, page + 3));
+    assert(file.offset == page + 3);
+    assert(file.view.length > 0 && file.view.data[0] == data[page + 3]);
+    assert(nsl_mmap_seek(&file, length));
+    assert(file.view.length == 0);
+    nsl_mmap_close(&file);
+    free(data);
+}
+
+void test_find_newline(void) {
+    char data[300];
+    memset(data, 'x', sizeof(data));
+    assert(nsl_mmap_find_newline(data, sizeof(data)) == nullptr);
+    assert(nsl_mmap_find_newline(data, 0) == nullptr);
+    // every position in and around the vector loops, from unaligned starts
+    for (size_t start = 0; start < 8; start++) {
+        for (size_t i = start; i < sizeof(data); i++) {
+            data[i] = '\n';
+            if (i + 1 < sizeof(data)) { data[i + 1] = '\n'; }
+            assert(nsl_mmap_find_newline(data + start, sizeof(data) - start) == data + i);
+            assert(nsl_mmap_find_newline(data + start, i - start) == nullptr);
+            data[i] = 'x';
+            if (i + 1 < sizeof(data)) { data[i + 1] = 'x'; }
+        }
+    }
+}
+
+int main() {
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    test_whole_file();
+    test_empty_and_missing();
+    test_windows(NSL_MMAP_NORMAL);
+    test_windows(NSL_MMAP_SEQUENTIAL | NSL_MMAP_WILLNEED);
+    test_windows(NSL_MMAP_RANDOM);
+    test_find_newline();
+    assert(unlink(path) == 0);
+}
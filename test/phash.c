@@ -0,0 +1,123 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/phash.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+// A keyword set the size of a typical protocol parser: C23 keywords, directives,
+// HTTP methods and headers, and SQL keywords.
+#define KEYWORDS                                                                                   \
+    "alignas", "alignof", "auto", "bool", "break", "case", "char", "const", "constexpr",           \
+    "continue", "default", "do", "double", "else", "enum", "extern", "false", "float", "for",      \
+    "goto", "if", "inline", "int", "long", "nullptr", "register", "restrict", "return", "short",   \
+    "signed", "sizeof", "static", "static_assert", "struct", "switch", "thread_local", "true",     \
+    "typedef", "typeof", "typeof_unqual", "union", "unsigned", "void", "volatile", "while",        \
+    "_Atomic", "_BitInt", "_Complex", "_Decimal128", "_Decimal32", "_Decimal64", "_Generic",       \
+    "_Imaginary", "_Noreturn", "#define", "#elif", "#elifdef", "#elifndef", "#else", "#embed",     \
+    "#endif", "#error", "#if", "#ifdef", "#ifndef", "#include", "#line", "#pragma", "#undef",      \
+    "#warning", "__has_c_attribute", "__has_embed", "__has_include", "__VA_ARGS__", "__VA_OPT__",  \
+    "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "Accept",      \
+    "Accept-Charset", "Accept-Encoding", "Accept-Language", "Accept-Ranges", "Age", "Allow",       \
+    "Authorization", "Cache-Control", "Connection", "Content-Disposition", "Content-Encoding",     \
+    "Content-Language", "Content-Length", "Content-Location", "Content-Range", "Content-Type",     \
+    "Cookie", "Date", "ETag", "Expect", "Expires", "Forwarded", "From", "Host", "If-Match",        \
+    "If-Modified-Since", "If-None-Match", "If-Range", "If-Unmodified-Since", "Keep-Alive",         \
+    "Last-Modified", "Link", "Location", "Max-Forwards", "Origin", "Pragma",                       \
+    "Proxy-Authorization", "Range", "Referer", "Retry-After", "Server", "Set-Cookie", "TE",        \
+    "Trailer", "Transfer-Encoding", "Upgrade", "User-Agent", "Vary", "Via", "WWW-Authenticate",    \
+    "ADD", "ALL", "ALTER", "AND", "ANY", "AS", "ASC", "BETWEEN", "BY", "CASCADE", "CHECK",         \
+    "COLUMN", "COMMIT", "CONSTRAINT", "CREATE", "CROSS", "DATABASE", "DESC", "DISTINCT", "DROP",   \
+    "END", "EXCEPT", "EXISTS", "FOREIGN", "FULL", "GROUP", "HAVING", "IN", "INDEX", "INNER",       \
+    "INSERT", "INTERSECT", "INTO", "IS", "JOIN", "KEY", "LEFT", "LIKE", "LIMIT", "NOT", "NULL",    \
+    "OFFSET", "ON", "OR", "ORDER", "OUTER", "PRIMARY", "REFERENCES", "RIGHT", "ROLLBACK",          \
+    "SELECT", "SET", "TABLE", "TRUNCATE", "UNION", "UNIQUE", "UPDATE", "VALUES", "VIEW", "WHERE"
+
+// The makefile first builds this file with `PHASH_GENERATE` defined, and runs it
+// to generate `phash_keywords.h` from the keywords above. The tests are then
+// built against the generated tables.
+#ifdef PHASH_GENERATE
+
+NSL_PHASH_GENERATOR(keywords, KEYWORDS)
+
+#else
+
+#    include "phash_keywords.h"
+
+void test_generated(void) {
+    const char *expected[] = {KEYWORDS};
+    assert(keywords.count == sizeof(expected) / sizeof(*expected));
+    for (size_t i = 0; i < sizeof(expected) / sizeof(*expected); i++) {
+        assert(nsl_phash_find(&keywords, expected[i], strlen(expected[i])) == i);
+        assert(strcmp(keywords.keys[i], expected[i]) == 0);
+    }
+
+    assert(nsl_phash_find(&keywords, "", 0) == NSL_PHASH_NOT_FOUND);
+    assert(nsl_phash_find(&keywords, "GE", 2) == NSL_PHASH_NOT_FOUND);
+    assert(nsl_phash_find(&keywords, "GETS", 4) == NSL_PHASH_NOT_FOUND);
+    assert(nsl_phash_find(&keywords, "get", 3) == NSL_PHASH_NOT_FOUND);
+    assert(nsl_phash_find(&keywords, "GET", 3) == 75);
+
+    // keys do not need to be null terminated
+    const char *request = "POST /index.html HTTP/1.1";
+    assert(nsl_phash_find(&keywords, request, 4) == 77);
+}
+
+void test_build(void) {
+    static char storage[2000][16];
+    static const char *keys[2000];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(storage[i], sizeof(*storage), "key%d", i);
+        keys[i] = storage[i];
+    }
+
+    NSL_PerfectHash ph;
+    assert(nsl_phash_build(&ph, keys, 2000));
+    assert(ph.count == 2000 && ph.size >= 2000);
+    for (size_t i = 0; i < 2000; i++) {
+        assert(nsl_phash_find(&ph, keys[i], strlen(keys[i])) == i);
+    }
+    assert(nsl_phash_find(&ph, "key2000", 7) == NSL_PHASH_NOT_FOUND);
+    assert(nsl_phash_find(&ph, "key-1", 5) == NSL_PHASH_NOT_FOUND);
+    nsl_phash_free(&ph);
+
+    const char *single[] = {"only"};
+    assert(nsl_phash_build(&ph, single, 1));
+    assert(nsl_phash_find(&ph, "only", 4) == 0);
+    assert(nsl_phash_find(&ph, "one", 3) == NSL_PHASH_NOT_FOUND);
+    nsl_phash_free(&ph);
+
+    const char *duplicates[] = {"a", "b", "a"};
+    assert(!nsl_phash_build(&ph, duplicates, 3));
+    assert(!nsl_phash_build(&ph, duplicates, 0));
+}
+
+void test_write(void) {
+    const char *keys[] = {"plain", "quote\"", "back\\slash", "new\nline", "\x7f"};
+    NSL_PerfectHash ph;
+    assert(nsl_phash_build(&ph, keys, sizeof(keys) / sizeof(*keys)));
+
+    char   buffer[4096];
+    FILE  *file = fmemopen(buffer, sizeof(buffer), "w");
+    assert(file != nullptr);
+    assert(nsl_phash_write(file, "escaped", &ph));
+    fclose(file);
+    nsl_phash_free(&ph);
+
+    assert(strstr(buffer, "static const NSL_PerfectHash escaped = {") != nullptr);
+    assert(strstr(buffer, "\"quote\\\"\",\n") != nullptr);
+    assert(strstr(buffer, "\"back\\\\slash\",\n") != nullptr);
+    assert(strstr(buffer, "\"new\\012line\",\n") != nullptr);
+    assert(strstr(buffer, "\"\\177\",\n") != nullptr);
+    assert(strstr(buffer, ".count   = 5,\n") != nullptr);
+}
+
+int main() {
+    test_generated();
+    test_build();
+    test_write();
+}
+
+#endif  // PHASH_GENERATE
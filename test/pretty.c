@@ -0,0 +1,188 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/pretty.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct Point {
+    int x, y;
+} Point;
+
+void pretty_point(NSL_Pretty *printer, Point point);
+
+// is only expanded where `nsl_pretty` is used
+#undef NSL_PRETTY_USER_TYPES
+#define NSL_PRETTY_USER_TYPES Point: pretty_point,
+
+// The output only grows, and each test reads what was added since the last
+// time it looked.
+static FILE            *file;
+static NSL_StreamWriter out;
+static off_t            taken;
+static char             written[1 << 22];
+
+// Flushes `out`, and returns what was written since the last call as a string.
+const char *take_written(void) {
+    assert(nsl_stream_flush(&out));
+    off_t end = lseek(fileno(file), 0, SEEK_END);
+    assert(end >= taken && end - taken < (off_t)sizeof(written));
+    ssize_t length = pread(fileno(file), written, (size_t)(end - taken), taken);
+    assert(length == end - taken);
+    written[length] = '\0';
+    taken           = end;
+    return written;
+}
+
+void pretty_point(NSL_Pretty *printer, Point point) {
+    nsl_pretty_begin(printer);
+    nsl_pretty(printer, "{x = ");
+    nsl_pretty(printer, point.x);
+    nsl_pretty(printer, ",");
+    nsl_pretty_line(printer);
+    nsl_pretty(printer, "y = ");
+    nsl_pretty(printer, point.y);
+    nsl_pretty(printer, "}");
+    nsl_pretty_end(printer);
+}
+
+void test_groups(void) {
+    NSL_Pretty printer;
+    nsl_pretty_init(&printer, &out, 20);
+
+    // fits
+    int small[] = {1, 2, 3};
+    nsl_pretty_array(&printer, small, 3);
+    assert(strcmp(take_written(), "[1, 2, 3]") == 0);
+
+    // exactly the width still fits, one more does not
+    nsl_pretty_hardline(&printer);
+    int exact[] = {1000, 2000, 300, 4};
+    nsl_pretty_array(&printer, exact, 4);
+    nsl_pretty_hardline(&printer);
+    int over[] = {1000, 2000, 300, 40};
+    nsl_pretty_array(&printer, over, 4);
+    assert(strcmp(take_written(),
+                  "\n"
+                  "[1000, 2000, 300, 4]\n"
+                  "[\n"
+                  "    1000,\n"
+                  "    2000,\n"
+                  "    300,\n"
+                  "    40\n"
+                  "]")
+           == 0);
+
+    // the outer group breaks, the inner ones still fit
+    nsl_pretty_hardline(&printer);
+    Point points[] = {{1, 2}, {3, 4}, {-5, 6}};
+    nsl_pretty_array(&printer, points, 3);
+    assert(strcmp(take_written(),
+                  "\n"
+                  "[\n"
+                  "    {x = 1, y = 2},\n"
+                  "    {x = 3, y = 4},\n"
+                  "    {x = -5, y = 6}\n"
+                  "]")
+           == 0);
+
+    // an inner group that does not fit in what is left of the line breaks too
+    nsl_pretty_hardline(&printer);
+    nsl_pretty(&printer, "point: ");
+    nsl_pretty_indent(&printer, 2);
+    pretty_point(&printer, (Point){123456, 7890});
+    nsl_pretty_indent(&printer, -2);
+    assert(strcmp(take_written(),
+                  "\n"
+                  "point: {x = 123456,\n"
+                  "  y = 7890}")
+           == 0);
+
+    // a hard line breaks every group around it
+    nsl_pretty_hardline(&printer);
+    nsl_pretty_begin(&printer);
+    nsl_pretty(&printer, "a");
+    nsl_pretty_line(&printer);
+    nsl_pretty(&printer, "b");
+    nsl_pretty_hardline(&printer);
+    nsl_pretty(&printer, "c");
+    nsl_pretty_end(&printer);
+    assert(strcmp(take_written(), "\na\nb\nc") == 0);
+    nsl_pretty_free(&printer);
+}
+
+void test_types(void) {
+    NSL_Pretty printer;
+    nsl_pretty_init(&printer, &out, 0);
+    assert(printer.width == NSL_PRETTY_WIDTH);
+    nsl_pretty(&printer, (signed char)-1);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, (unsigned short)65535);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, INT64_MIN);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, UINT64_MAX);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, 0.1);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, 1.0f / 3.0f);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, 1.0 / 3.0);
+    nsl_pretty(&printer, " ");
+    nsl_pretty(&printer, true);
+    nsl_pretty(&printer, " ");
+    NSL_StringView view = {"view", 4};
+    nsl_pretty(&printer, view);
+    assert(strcmp(take_written(),
+                  "-1 65535 -9223372036854775808 18446744073709551615 0.1 "
+                  "0.3333333432674408 0.3333333333333333 true view")
+           == 0);
+    nsl_pretty_free(&printer);
+}
+
+void test_bounded(void) {
+    NSL_Pretty printer;
+    nsl_pretty_init(&printer, &out, 80);
+    // nothing is held back longer than it takes to fill a line
+    static uint32_t values[100000];
+    for (size_t i = 0; i < nsl_carrlen(values); i++) {
+        values[i] = (uint32_t)i;
+    }
+    nsl_pretty_array(&printer, values, nsl_carrlen(values));
+    assert(printer.token_head == printer.token_tail);
+    assert(printer.token_capacity <= 256 && printer.text_capacity <= 256);
+
+    const char *text  = take_written();
+    size_t      lines = 0;
+    for (const char *c = text; *c != '\0'; c++) {
+        lines += *c == '\n';
+    }
+    assert(lines == nsl_carrlen(values) + 1);
+    assert(strncmp(text, "[\n    0,\n    1,\n", 16) == 0);
+
+    // groups take no width, so only the number of tokens bounds them
+    nsl_pretty_begin(&printer);
+    for (size_t i = 0; i < 100000; i++) {
+        nsl_pretty_begin(&printer);
+        nsl_pretty_end(&printer);
+    }
+    nsl_pretty_end(&printer);
+    assert(printer.token_head == printer.token_tail);
+    assert(printer.token_capacity <= 4 * NSL_PRETTY_LOOKAHEAD);
+    assert(strcmp(take_written(), "") == 0);
+    nsl_pretty_free(&printer);
+}
+
+int main() {
+    file = tmpfile();
+    assert(file != nullptr);
+    nsl_stream_writer_init(&out, fileno(file), 0);
+    test_groups();
+    test_types();
+    test_bounded();
+    assert(nsl_stream_writer_free(&out));
+    fclose(file);
+}
@@ -0,0 +1,232 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/sequencer.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <threads.h>
+
+static NSL_Sequencer sequencer;
+
+// Records the order that tasks finish in.
+static _Atomic size_t clock_now;
+
+typedef struct Step {
+    size_t finished;
+} Step;
+
+void step(void *data) {
+    Step *record     = data;
+    record->finished = atomic_fetch_add(&clock_now, 1);
+}
+
+void test_graph(void) {
+    // a diamond, submitted in reverse
+    Step     steps[4] = {};
+    NSL_Task tasks[4];
+    for (size_t i = 0; i < 4; i++) {
+        nsl_task_init(&tasks[i], step, &steps[i]);
+    }
+    nsl_task_precede(&tasks[0], &tasks[1]);
+    nsl_task_precede(&tasks[0], &tasks[2]);
+    nsl_task_precede(&tasks[1], &tasks[3]);
+    nsl_task_precede(&tasks[2], &tasks[3]);
+    for (size_t i = 4; i-- > 0;) {
+        nsl_sequencer_submit(&sequencer, &tasks[i]);
+    }
+    nsl_sequencer_wait(&sequencer, &tasks[3]);
+
+    assert(steps[0].finished < steps[1].finished);
+    assert(steps[0].finished < steps[2].finished);
+    assert(steps[1].finished < steps[3].finished);
+    assert(steps[2].finished < steps[3].finished);
+    for (size_t i = 0; i < 4; i++) {
+        nsl_task_free(&tasks[i]);
+    }
+}
+
+#define CHAIN 1000
+
+void test_chain(void) {
+    Step     *steps = calloc(CHAIN, sizeof(*steps));
+    NSL_Task *tasks = malloc(CHAIN * sizeof(*tasks));
+    for (size_t i = 0; i < CHAIN; i++) {
+        nsl_task_init(&tasks[i], step, &steps[i]);
+        if (i > 0) { nsl_task_precede(&tasks[i - 1], &tasks[i]); }
+    }
+    for (size_t i = 0; i < CHAIN; i++) {
+        nsl_sequencer_submit(&sequencer, &tasks[i]);
+    }
+    nsl_sequencer_wait(&sequencer, &tasks[CHAIN - 1]);
+    for (size_t i = 1; i < CHAIN; i++) {
+        assert(steps[i - 1].finished < steps[i].finished);
+    }
+    for (size_t i = 0; i < CHAIN; i++) {
+        nsl_task_free(&tasks[i]);
+    }
+    free(tasks);
+    free(steps);
+}
+
+static _Atomic size_t counter;
+
+void increment(void *) {
+    atomic_fetch_add(&counter, 1);
+}
+
+#define FAN 10000
+
+void test_fan_out(void) {
+    // far more tasks than fit in a deque, all released by one task
+    NSL_Task *tasks = malloc((FAN + 2) * sizeof(*tasks));
+    atomic_store(&counter, 0);
+    for (size_t i = 0; i < FAN + 2; i++) {
+        nsl_task_init(&tasks[i], increment, nullptr);
+    }
+    for (size_t i = 1; i <= FAN; i++) {
+        nsl_task_precede(&tasks[0], &tasks[i]);
+        nsl_task_precede(&tasks[i], &tasks[FAN + 1]);
+    }
+    for (size_t i = 0; i < FAN + 2; i++) {
+        nsl_sequencer_submit(&sequencer, &tasks[i]);
+    }
+    nsl_sequencer_wait(&sequencer, &tasks[FAN + 1]);
+    assert(atomic_load(&counter) == FAN + 2);
+    for (size_t i = 0; i < FAN + 2; i++) {
+        nsl_task_free(&tasks[i]);
+    }
+    free(tasks);
+}
+
+void mark(void *data, size_t begin, size_t end) {
+    _Atomic unsigned char *visits = data;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&visits[i], 1);
+    }
+}
+
+void check_visits(size_t begin, size_t end, size_t grain) {
+    _Atomic unsigned char *visits = calloc(end + 1, sizeof(*visits));
+    nsl_sequencer_parallel_for(&sequencer, begin, end, grain, mark, (void *)visits);
+    for (size_t i = 0; i <= end; i++) {
+        assert(atomic_load(&visits[i]) == (i >= begin && i < end));
+    }
+    free((void *)visits);
+}
+
+void test_parallel_for(void) {
+    check_visits(0, 1000000, 0);
+    check_visits(3, 1000, 1);
+    check_visits(5, 6, 0);
+    check_visits(7, 7, 0);
+}
+
+void check_chunk(void *data, size_t begin, size_t end) {
+    // chunks are split off lazily, but never run as more than a grain
+    assert(end - begin <= 64);
+    atomic_fetch_add((_Atomic size_t *)data, end - begin);
+}
+
+void test_parallel_for_grain(void) {
+    _Atomic size_t total = 0;
+    nsl_sequencer_parallel_for(&sequencer, 0, 100000, 64, check_chunk, (void *)&total);
+    assert(atomic_load(&total) == 100000);
+}
+
+static _Atomic size_t threads_seen;
+
+void record_thread(void *, size_t begin, size_t end) {
+    // slow enough that idle threads take part
+    struct timespec delay = {.tv_nsec = 100000};
+    for (size_t i = begin; i < end; i++) {
+        thrd_sleep(&delay, nullptr);
+    }
+    static thread_local bool seen;
+    if (!seen) {
+        seen = true;
+        atomic_fetch_add(&threads_seen, 1);
+    }
+}
+
+void test_parallel_for_spreads(void) {
+    if (sequencer.threads < 2) { return; }
+    nsl_sequencer_parallel_for(&sequencer, 0, 1000, 1, record_thread, nullptr);
+    assert(atomic_load(&threads_seen) >= 2);
+}
+
+void nested(void *data) {
+    check_visits(0, 10000, 16);
+    increment(data);
+}
+
+void test_nested(void) {
+    // tasks that wait for loops while other tasks wait for them
+    atomic_store(&counter, 0);
+    NSL_Task tasks[8];
+    for (size_t i = 0; i < 8; i++) {
+        nsl_task_init(&tasks[i], nested, nullptr);
+        nsl_sequencer_submit(&sequencer, &tasks[i]);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        nsl_sequencer_wait(&sequencer, &tasks[i]);
+        nsl_task_free(&tasks[i]);
+    }
+    assert(atomic_load(&counter) == 8);
+}
+
+int submit_from_thread(void *arg) {
+    NSL_Task *task = arg;
+    nsl_sequencer_submit(&sequencer, task);
+    nsl_sequencer_wait(&sequencer, task);
+    check_visits(0, 5000, 0);
+    return 0;
+}
+
+void test_other_thread(void) {
+    atomic_store(&counter, 0);
+    NSL_Task task;
+    nsl_task_init(&task, increment, nullptr);
+    thrd_t thread;
+    assert(thrd_create(&thread, submit_from_thread, &task) == thrd_success);
+    thrd_join(thread, nullptr);
+    assert(atomic_load(&counter) == 1);
+    nsl_task_free(&task);
+}
+
+void test_single_thread(void) {
+    // with no other threads, waiting runs every task, and a full deque runs
+    // tasks as they are scheduled
+    NSL_Sequencer single;
+    assert(nsl_sequencer_init(&single, &(NSL_SequencerConfig){.threads = 1, .deque_capacity = 2}));
+    assert(single.threads == 1);
+    atomic_store(&counter, 0);
+    NSL_Task tasks[10];
+    for (size_t i = 0; i < 10; i++) {
+        nsl_task_init(&tasks[i], increment, nullptr);
+        nsl_sequencer_submit(&single, &tasks[i]);
+    }
+    for (size_t i = 0; i < 10; i++) {
+        nsl_sequencer_wait(&single, &tasks[i]);
+        nsl_task_free(&tasks[i]);
+    }
+    assert(atomic_load(&counter) == 10);
+    nsl_sequencer_free(&single);
+}
+
+int main() {
+    test_single_thread();
+
+    assert(nsl_sequencer_init(&sequencer, &(NSL_SequencerConfig){.threads = 4}));
+    assert(sequencer.threads == 4);
+    test_graph();
+    test_chain();
+    test_fan_out();
+    test_parallel_for();
+    test_parallel_for_grain();
+    test_parallel_for_spreads();
+    test_nested();
+    test_other_thread();
+    nsl_sequencer_free(&sequencer);
+}
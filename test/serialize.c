@@ -0,0 +1,188 @@
+#define _GNU_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/serialize.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+// `out` writes into a pipe that holds all that a test writes at once, and
+// whose other end does not block once it has been emptied.
+static int              pipe_fds[2];
+static NSL_StreamWriter out;
+static char             written[1 << 20];
+
+// Flushes everything written to `out` so far, and returns it as a view.
+NSL_StringView take_written(void) {
+    assert(nsl_stream_flush(&out));
+    size_t  length = 0;
+    ssize_t got;
+    while ((got = read(pipe_fds[0], written + length, sizeof(written) - length)) > 0) {
+        length += (size_t)got;
+    }
+    assert(got < 0 && errno == EAGAIN);
+    return (NSL_StringView){written, length};
+}
+
+void test_varints(void) {
+    // 300 is the example in every description of LEB128
+    nsl_serialize_u64(&out, 300);
+    NSL_StringView bytes = take_written();
+    assert(bytes.length == 2 && memcmp(bytes.data, "\xac\x02", 2) == 0);
+
+    const uint64_t unsigned_values[] = {0, 1, 127, 128, 16383, 16384, UINT32_MAX, UINT64_MAX};
+    const int64_t  signed_values[]   = {0, -1, 1, -64, 64, INT64_MIN, INT64_MAX};
+    for (size_t i = 0; i < nsl_carrlen(unsigned_values); i++) {
+        nsl_serialize_u64(&out, unsigned_values[i]);
+    }
+    for (size_t i = 0; i < nsl_carrlen(signed_values); i++) {
+        nsl_serialize_i64(&out, signed_values[i]);
+    }
+    bytes = take_written();
+    // 1 + 1 + 1 + 2 + 2 + 3 + 5 + 10 bytes, then 1 + 1 + 1 + 1 + 2 + 10 + 10
+    assert(bytes.length == 25 + 26);
+
+    NSL_Deserializer in = {.input = bytes};
+    for (size_t i = 0; i < nsl_carrlen(unsigned_values); i++) {
+        uint64_t value;
+        assert(nsl_deserialize_u64(&in, &value) && value == unsigned_values[i]);
+    }
+    for (size_t i = 0; i < nsl_carrlen(signed_values); i++) {
+        int64_t value;
+        assert(nsl_deserialize_i64(&in, &value) && value == signed_values[i]);
+    }
+    assert(in.position == bytes.length && !in.failed);
+}
+
+void test_malformed(void) {
+    uint64_t value;
+
+    // truncated in the middle of a varint
+    NSL_Deserializer in = {.input = {"\x80\x80", 2}};
+    assert(!nsl_deserialize_u64(&in, &value) && in.failed);
+    // once failed, every read fails
+    in = (NSL_Deserializer){.input = {"\x80", 1}};
+    assert(!nsl_deserialize_u64(&in, &value));
+    in.input = (NSL_StringView){"\x01", 1};
+    in.position = 0;
+    assert(!nsl_deserialize_u64(&in, &value));
+
+    // more than 64 bits
+    in = (NSL_Deserializer){.input = {"\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02", 10}};
+    assert(!nsl_deserialize_u64(&in, &value) && in.failed);
+    in = (NSL_Deserializer){.input = {"\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 11}};
+    assert(!nsl_deserialize_u64(&in, &value) && in.failed);
+
+    // a length past the end of the input
+    NSL_StringView bytes;
+    in = (NSL_Deserializer){.input = {"\x05" "abc", 4}};
+    assert(!nsl_deserialize_bytes(&in, &bytes) && in.failed);
+}
+
+void test_fixed(void) {
+    nsl_serialize_f64(&out, 1.0);
+    nsl_serialize_f32(&out, -2.5f);
+    nsl_serialize_bytes(&out, (NSL_StringView){"hello", 5});
+    nsl_serialize_bytes(&out, (NSL_StringView){"", 0});
+    NSL_StringView bytes = take_written();
+    // little endian, whatever the machine
+    assert(memcmp(bytes.data, "\x00\x00\x00\x00\x00\x00\xf0\x3f", 8) == 0);
+    assert(memcmp(bytes.data + 8, "\x00\x00\x20\xc0", 4) == 0);
+    assert(memcmp(bytes.data + 12, "\x05hello\x00", 7) == 0);
+
+    NSL_Deserializer in = {.input = bytes};
+    double           f64;
+    float            f32;
+    NSL_StringView   hello, empty;
+    assert(nsl_deserialize_f64(&in, &f64) && f64 == 1.0);
+    assert(nsl_deserialize_f32(&in, &f32) && f32 == -2.5f);
+    assert(nsl_deserialize_bytes(&in, &hello));
+    assert(hello.data == bytes.data + 13 && hello.length == 5);
+    assert(nsl_deserialize_bytes(&in, &empty) && empty.length == 0);
+    assert(in.position == bytes.length);
+}
+
+void test_items(void) {
+    // larger than the writer's buffer, so it goes out in a single write
+    static uint32_t values[50000];
+    for (size_t i = 0; i < nsl_carrlen(values); i++) {
+        values[i] = (uint32_t)(i * 2654435761u);
+    }
+    nsl_serialize_u64(&out, nsl_carrlen(values));
+    nsl_serialize_items(&out, values, nsl_carrlen(values), sizeof(values[0]));
+    uint16_t shorts[] = {0x0102, 0xfffe};
+    nsl_serialize_items(&out, shorts, 2, sizeof(shorts[0]));
+    NSL_StringView bytes = take_written();
+    assert(memcmp(bytes.data + bytes.length - 4, "\x02\x01\xfe\xff", 4) == 0);
+
+    static uint32_t  copy[50000];
+    NSL_Deserializer in = {.input = bytes};
+    uint64_t         count;
+    assert(nsl_deserialize_u64(&in, &count) && count == nsl_carrlen(copy));
+    assert(nsl_deserialize_items(&in, copy, count, sizeof(copy[0])));
+    assert(memcmp(copy, values, sizeof(values)) == 0);
+    uint16_t shorts_copy[2];
+    assert(nsl_deserialize_items(&in, shorts_copy, 2, sizeof(shorts_copy[0])));
+    assert(shorts_copy[0] == 0x0102 && shorts_copy[1] == 0xfffe);
+    assert(!nsl_deserialize_items(&in, shorts_copy, 1, sizeof(shorts_copy[0])));
+}
+
+NSL_SERIALIZE_DEFINE(Point, point, NSL_SERIALIZE_I64(x), NSL_SERIALIZE_I64(y))
+
+NSL_SERIALIZE_DEFINE(Entry,
+                     entry,
+                     NSL_SERIALIZE_BYTES(key),
+                     NSL_SERIALIZE_U64(hits),
+                     NSL_SERIALIZE_F64(score),
+                     NSL_SERIALIZE_BOOL(pinned),
+                     NSL_SERIALIZE_STRUCT(at, Point, point))
+
+void test_define(void) {
+    Entry entries[] = {
+        {{"alpha", 5}, 7, 0.5, true, {-3, 4}},
+        {{"", 0}, 0, -1e300, false, {INT64_MIN, INT64_MAX}},
+        {{"gamma", 5}, UINT64_MAX, 3.25, true, {0, 0}},
+    };
+    for (size_t i = 0; i < nsl_carrlen(entries); i++) {
+        entry_serialize(&out, &entries[i]);
+    }
+    NSL_StringView bytes = take_written();
+    // the first entry: 1 + 5 + 1 + 8 + 1 + 1 + 1
+    assert(bytes.length > 18 && bytes.data[0] == 5);
+
+    NSL_Deserializer in = {.input = bytes};
+    for (size_t i = 0; i < nsl_carrlen(entries); i++) {
+        Entry entry;
+        assert(entry_deserialize(&in, &entry));
+        assert(entry.key.length == entries[i].key.length);
+        assert(memcmp(entry.key.data, entries[i].key.data, entry.key.length) == 0);
+        assert(entry.hits == entries[i].hits);
+        assert(entry.score == entries[i].score);
+        assert(entry.pinned == entries[i].pinned);
+        assert(entry.at.x == entries[i].at.x && entry.at.y == entries[i].at.y);
+    }
+    Entry entry;
+    assert(!entry_deserialize(&in, &entry));
+
+    // a bool that is neither 0 nor 1 is malformed
+    in = (NSL_Deserializer){.input = {"\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x02\x00\x00", 13}};
+    assert(!entry_deserialize(&in, &entry) && in.failed);
+}
+
+int main() {
+    assert(pipe(pipe_fds) == 0);
+    assert(fcntl(pipe_fds[1], F_SETPIPE_SZ, 1 << 20) >= 1 << 20);
+    assert(fcntl(pipe_fds[0], F_SETFL, O_NONBLOCK) == 0);
+    nsl_stream_writer_init(&out, pipe_fds[1], 0);
+    test_varints();
+    test_malformed();
+    test_fixed();
+    test_items();
+    test_define();
+    assert(nsl_stream_writer_free(&out));
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
@@ -0,0 +1,154 @@
+#define _DEFAULT_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/snapshot.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ENTRY_COUNT 10000
+
+static char path[] = "/tmp/nsl-snapshot-XXXXXX";
+
+// Writes the table of `builder` to the test file.
+void write_snapshot(const NSL_SnapshotBuilder *builder) {
+    FILE *file = fopen(path, "wb");
+    assert(file != nullptr);
+    NSL_StreamWriter out;
+    nsl_stream_writer_init(&out, fileno(file), 0);
+    nsl_snapshot_write(builder, &out);
+    assert(nsl_stream_writer_free(&out));
+    assert(fclose(file) == 0);
+}
+
+// Reads the whole test file into `buffer`.
+size_t read_snapshot(char *buffer, size_t capacity) {
+    FILE *file = fopen(path, "rb");
+    assert(file != nullptr);
+    size_t length = fread(buffer, 1, capacity, file);
+    assert(fclose(file) == 0);
+    return length;
+}
+
+void test_lookup(void) {
+    NSL_SnapshotBuilder builder;
+    nsl_snapshot_builder_init(&builder);
+    char key[32], value[32];
+    for (int i = 0; i < ENTRY_COUNT; i++) {
+        int key_length   = snprintf(key, sizeof(key), "key:%d", i);
+        int value_length = snprintf(value, sizeof(value), "value:%d", i * 7);
+        nsl_snapshot_add(&builder,
+                         (NSL_StringView){key, (size_t)key_length},
+                         (NSL_StringView){value, (size_t)value_length});
+    }
+    // an empty key and an empty value are entries like any other
+    nsl_snapshot_add(&builder, (NSL_StringView){"", 0}, (NSL_StringView){"empty", 5});
+    nsl_snapshot_add(&builder, (NSL_StringView){"nothing", 7}, (NSL_StringView){"", 0});
+    assert(builder.count == ENTRY_COUNT + 2);
+    write_snapshot(&builder);
+    nsl_snapshot_builder_free(&builder);
+
+    NSL_Snapshot snapshot;
+    assert(nsl_snapshot_open(&snapshot, path));
+    assert(snapshot.count == ENTRY_COUNT + 2);
+    for (int i = 0; i < ENTRY_COUNT; i++) {
+        int            key_length   = snprintf(key, sizeof(key), "key:%d", i);
+        int            value_length = snprintf(value, sizeof(value), "value:%d", i * 7);
+        NSL_StringView found;
+        assert(nsl_snapshot_get(&snapshot, (NSL_StringView){key, (size_t)key_length}, &found));
+        assert(found.length == (size_t)value_length);
+        assert(memcmp(found.data, value, found.length) == 0);
+        // values point into the mapping, and are aligned for use in place
+        assert(found.data > snapshot.bytes.data);
+        assert(found.data < snapshot.bytes.data + snapshot.bytes.length);
+        assert((found.data - snapshot.bytes.data) % 8 == 0);
+    }
+    NSL_StringView found;
+    assert(nsl_snapshot_get(&snapshot, (NSL_StringView){"", 0}, &found) && found.length == 5);
+    assert(nsl_snapshot_get(&snapshot, (NSL_StringView){"nothing", 7}, &found));
+    assert(found.length == 0);
+    assert(!nsl_snapshot_get(&snapshot, (NSL_StringView){"key:10000", 9}, &found));
+    assert(!nsl_snapshot_get(&snapshot, (NSL_StringView){"key:1", 4}, &found));
+    nsl_snapshot_close(&snapshot);
+}
+
+void test_relocation(void) {
+    NSL_SnapshotBuilder builder;
+    nsl_snapshot_builder_init(&builder);
+    nsl_snapshot_add(&builder, (NSL_StringView){"alpha", 5}, (NSL_StringView){"1", 1});
+    nsl_snapshot_add(&builder, (NSL_StringView){"beta", 4}, (NSL_StringView){"22", 2});
+    write_snapshot(&builder);
+    nsl_snapshot_builder_free(&builder);
+
+    // the table works from any address, even an unaligned one
+    static char buffer[4096 + 1];
+    size_t      length = read_snapshot(buffer + 1, sizeof(buffer) - 1);
+    assert(length % 8 == 0);
+    NSL_Snapshot snapshot;
+    assert(nsl_snapshot_view(&snapshot, (NSL_StringView){buffer + 1, length}));
+    NSL_StringView found;
+    assert(nsl_snapshot_get(&snapshot, (NSL_StringView){"beta", 4}, &found));
+    assert(found.data > buffer && found.length == 2 && memcmp(found.data, "22", 2) == 0);
+    assert(!nsl_snapshot_get(&snapshot, (NSL_StringView){"gamma", 5}, &found));
+    nsl_snapshot_close(&snapshot);
+
+    // an empty table still answers lookups
+    nsl_snapshot_builder_init(&builder);
+    write_snapshot(&builder);
+    nsl_snapshot_builder_free(&builder);
+    assert(nsl_snapshot_open(&snapshot, path));
+    assert(snapshot.count == 0);
+    assert(!nsl_snapshot_get(&snapshot, (NSL_StringView){"alpha", 5}, &found));
+    nsl_snapshot_close(&snapshot);
+}
+
+void test_corrupt(void) {
+    NSL_SnapshotBuilder builder;
+    nsl_snapshot_builder_init(&builder);
+    nsl_snapshot_add(&builder, (NSL_StringView){"alpha", 5}, (NSL_StringView){"1", 1});
+    write_snapshot(&builder);
+    nsl_snapshot_builder_free(&builder);
+
+    static char  buffer[4096];
+    size_t       length = read_snapshot(buffer, sizeof(buffer));
+    NSL_Snapshot snapshot;
+    assert(nsl_snapshot_view(&snapshot, (NSL_StringView){buffer, length}));
+
+    // truncated files and other formats are rejected when they are opened
+    assert(!nsl_snapshot_view(&snapshot, (NSL_StringView){buffer, length - 8}));
+    assert(!nsl_snapshot_view(&snapshot, (NSL_StringView){buffer, 16}));
+    buffer[7] = 2;
+    assert(!nsl_snapshot_view(&snapshot, (NSL_StringView){buffer, length}));
+    buffer[7]  = 1;
+    buffer[16] = 3;
+    assert(!nsl_snapshot_view(&snapshot, (NSL_StringView){buffer, length}));
+    buffer[16] = 2;
+
+    errno = 0;
+    FILE *file = fopen(path, "wb");
+    assert(file != nullptr && fwrite(buffer, 1, 16, file) == 16 && fclose(file) == 0);
+    assert(!nsl_snapshot_open(&snapshot, path) && errno == EINVAL);
+
+    // an entry whose offset points past the end is treated as missing
+    assert(nsl_snapshot_view(&snapshot, (NSL_StringView){buffer, length}));
+    for (size_t slot = 0; slot < 2; slot++) {
+        char *offset = buffer + 40 + slot * 16 + 8;
+        if (offset[0] != 0) { offset[1] = 0x7f; }
+    }
+    NSL_StringView found;
+    assert(!nsl_snapshot_get(&snapshot, (NSL_StringView){"alpha", 5}, &found));
+}
+
+int main() {
+    int fd = mkstemp(path);
+    assert(fd != -1);
+    assert(close(fd) == 0);
+    test_lookup();
+    test_relocation();
+    test_corrupt();
+    assert(unlink(path) == 0);
+}
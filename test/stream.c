@@ -0,0 +1,173 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define nsl_stream_readv  counting_readv
+#define nsl_stream_writev counting_writev
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/stream.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static size_t reads;
+static size_t writes;
+
+ssize_t counting_readv(int fd, const struct iovec *iov, int count) {
+    reads++;
+    return readv(fd, iov, count);
+}
+
+ssize_t counting_writev(int fd, const struct iovec *iov, int count) {
+    writes++;
+    return writev(fd, iov, count);
+}
+
+static char   contents[1 << 16];
+static size_t contents_length;
+
+// Moves the contents of the file behind `fd` into `contents`.
+void take_contents(int fd) {
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    ssize_t got = read(fd, contents, sizeof(contents));
+    assert(got >= 0);
+    contents_length = (size_t)got;
+    assert(ftruncate(fd, 0) == 0);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+}
+
+void test_writer(int fd) {
+    size_t           page = (size_t)sysconf(_SC_PAGESIZE);
+    NSL_StreamWriter writer;
+    nsl_stream_writer_init(&writer, fd, 1);
+    assert(writer.capacity == page);
+    assert((uintptr_t)writer.buffer % page == 0);
+
+    // small writes only reach the file when the buffer is full
+    writes = 0;
+    for (size_t i = 0; i < 1000; i++) {
+        nsl_stream_write(&writer, "0123456789", 10);
+    }
+    assert(writes == 10000 / page);
+    assert(nsl_stream_flush(&writer));
+    assert(writes == 10000 / page + 1);
+    take_contents(fd);
+    assert(contents_length == 10000);
+    for (size_t i = 0; i < 1000; i++) {
+        assert(memcmp(contents + i * 10, "0123456789", 10) == 0);
+    }
+
+    // a write larger than the buffer goes out with the buffered bytes at once
+    static char large[3 * 4096 + 5];
+    memset(large, 'L', sizeof(large));
+    writes = 0;
+    nsl_stream_write(&writer, "abc", 3);
+    nsl_stream_write(&writer, large, sizeof(large));
+    assert(writes == 1);
+    assert(nsl_stream_flush(&writer));
+    assert(writes == 1);
+    take_contents(fd);
+    assert(contents_length == 3 + sizeof(large));
+    assert(memcmp(contents, "abcLLL", 6) == 0);
+
+    // formatting that fits, that needs a flush, and that exceeds the buffer
+    nsl_stream_writef(&writer, "%d-%s|", 42, "x");
+    memset(large, 'F', page - 4);
+    large[page - 4] = '\0';
+    nsl_stream_writef(&writer, "%s|", large);
+    memset(large, 'G', 2 * page);
+    large[2 * page] = '\0';
+    nsl_stream_writef(&writer, "%s", large);
+    assert(nsl_stream_flush(&writer));
+    take_contents(fd);
+    assert(contents_length == 5 + (page - 3) + 2 * page);
+    assert(memcmp(contents, "42-x|FF", 7) == 0);
+    assert(contents[5 + page - 4] == '|');
+    assert(contents[contents_length - 1] == 'G');
+
+    // encoding straight into the buffer
+    char *room = nsl_stream_reserve(&writer, 16);
+    memcpy(room, "reserved", 8);
+    nsl_stream_commit(&writer, 8);
+    assert(nsl_stream_writer_free(&writer));
+    take_contents(fd);
+    assert(contents_length == 8 && memcmp(contents, "reserved", 8) == 0);
+}
+
+void test_reader(int fd) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < sizeof(contents); i++) {
+        contents[i] = (char)(i * 7);
+    }
+    assert(write(fd, contents, sizeof(contents)) == sizeof(contents));
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+
+    NSL_StreamReader reader;
+    nsl_stream_reader_init(&reader, fd, page);
+    reads = 0;
+    NSL_StringView view = nsl_stream_peek(&reader, 4);
+    assert(view.length == page);
+    assert(memcmp(view.data, contents, page) == 0);
+    assert(reads == 1);
+
+    // a peek past the end of the buffer moves the unread bytes to the front
+    nsl_stream_consume(&reader, page - 2);
+    view = nsl_stream_peek(&reader, 10);
+    assert(view.length == page);
+    assert(memcmp(view.data, contents + page - 2, page) == 0);
+    assert(reads == 2);
+    nsl_stream_consume(&reader, 10);
+
+    // a large read fills the destination and the buffer with one call
+    static char copy[5 * 4096];
+    size_t      at = page + 8;
+    reads          = 0;
+    assert(nsl_stream_read(&reader, copy, 3 * page) == 3 * page);
+    assert(memcmp(copy, contents + at, 3 * page) == 0);
+    assert(reads == 1);
+    at += 3 * page;
+    assert(nsl_stream_read(&reader, copy, 16) == 16);
+    assert(memcmp(copy, contents + at, 16) == 0);
+    assert(reads == 1);
+    at += 16;
+
+    // the end of the stream
+    size_t left = sizeof(contents) - at;
+    while (left > 0) {
+        size_t length = left < sizeof(copy) ? left : sizeof(copy);
+        assert(nsl_stream_read(&reader, copy, length) == length);
+        assert(memcmp(copy, contents + at, length) == 0);
+        at   += length;
+        left -= length;
+    }
+    assert(nsl_stream_read(&reader, copy, 1) == 0);
+    assert(reader.eof && reader.error == 0);
+    assert(nsl_stream_peek(&reader, 1).length == 0);
+    nsl_stream_reader_free(&reader);
+}
+
+void test_errors(void) {
+    NSL_StreamReader reader;
+    nsl_stream_reader_init(&reader, -1, 0);
+    assert(nsl_stream_peek(&reader, 1).length == 0);
+    assert(reader.error == EBADF && !reader.eof);
+    nsl_stream_reader_free(&reader);
+
+    NSL_StreamWriter writer;
+    nsl_stream_writer_init(&writer, -1, 0);
+    nsl_stream_write(&writer, "lost", 4);
+    assert(!nsl_stream_flush(&writer));
+    assert(writer.error == EBADF);
+    assert(!nsl_stream_writer_free(&writer));
+}
+
+int main() {
+    FILE *file = tmpfile();
+    assert(file != nullptr);
+    test_writer(fileno(file));
+    test_reader(fileno(file));
+    test_errors();
+    fclose(file);
+}
@@ -0,0 +1,220 @@
+#define _DEFAULT_SOURCE
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/test.h"
+
+#include <assert.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+static int global = 0;
+
+nsl_test(pass_basic) {
+    assert(1 + 1 == 2);
+}
+
+nsl_test(pass_output) {
+    printf("output of a passing test\n");
+}
+
+nsl_test(pass_isolated) {
+    global = 1;
+}
+
+nsl_test(fail_abort) {
+    printf("output of a failing test\n");
+    abort();
+}
+
+nsl_test(fail_crash) {
+    raise(SIGSEGV);
+}
+
+nsl_test(fail_exit_early) {
+    exit(0);
+}
+
+nsl_test(fail_exit_status) {
+    exit(3);
+}
+
+nsl_test(hang) {
+    nanosleep(&(struct timespec){.tv_sec = 10}, nullptr);
+}
+
+// Shared with the processes that run the tests, to count how many of them
+// sleep at once.
+static struct {
+    _Atomic int running;
+    _Atomic int most;
+} *sleepers;
+
+void sleep_counted(void) {
+    int running = atomic_fetch_add(&sleepers->running, 1) + 1;
+    int most    = atomic_load(&sleepers->most);
+    while (running > most && !atomic_compare_exchange_weak(&sleepers->most, &most, running)) {}
+    nanosleep(&(struct timespec){.tv_nsec = 20000000}, nullptr);
+    atomic_fetch_sub(&sleepers->running, 1);
+}
+
+#define SLEEP_TEST(name)                                                                           \
+    nsl_test(name) {                                                                               \
+        sleep_counted();                                                                           \
+    }
+
+SLEEP_TEST(sleep_a)
+SLEEP_TEST(sleep_b)
+SLEEP_TEST(sleep_c)
+SLEEP_TEST(sleep_d)
+
+// Runs the tests matching `filter`, leaving their output in `buffer`.
+NSL_TestSummary run(NSL_TestConfig config, const char *filter, char *buffer, size_t size) {
+    memset(buffer, 0, size);
+    FILE *file    = fmemopen(buffer, size, "w");
+    config.filter = filter;
+    assert(file != nullptr);
+    NSL_TestSummary summary = nsl_test_run(&config, file);
+    fclose(file);
+    return summary;
+}
+
+void test_pass(void) {
+    char            buffer[4096];
+    NSL_TestSummary summary = run((NSL_TestConfig){}, "pass_", buffer, sizeof(buffer));
+    assert(summary.passed == 3);
+    assert(summary.failed == 0);
+    assert(strstr(buffer, "[PASS] pass_basic ") != nullptr);
+    assert(strstr(buffer, "[PASS] pass_output ") != nullptr);
+    assert(strstr(buffer, "3 passed, 0 failed, 0 slow") != nullptr);
+
+    // passing output is only shown when verbose, and each test has its own
+    // process
+    assert(strstr(buffer, "output of a passing test") == nullptr);
+    assert(global == 0);
+    run((NSL_TestConfig){.verbose = true}, "pass_output", buffer, sizeof(buffer));
+    assert(strstr(buffer, "output of a passing test") != nullptr);
+}
+
+void test_fail(void) {
+    char            buffer[4096];
+    NSL_TestSummary summary = run((NSL_TestConfig){.jobs = 2}, "fail_", buffer, sizeof(buffer));
+    assert(summary.passed == 0);
+    assert(summary.failed == 4);
+    assert(strstr(buffer, "[FAIL] fail_abort (" __FILE__ ":") != nullptr);
+    assert(strstr(buffer, "output of a failing test") != nullptr);
+    assert(strstr(buffer, "[FAIL] fail_exit_early") != nullptr);
+    assert(strstr(buffer, "[FAIL] fail_exit_status") != nullptr);
+    assert(strstr(buffer, "exited with status 3") != nullptr);
+}
+
+void test_timeout(void) {
+    char            buffer[4096];
+    NSL_TestConfig  config  = {.timeout_ms = 100};
+    NSL_TestSummary summary = run(config, "hang", buffer, sizeof(buffer));
+    assert(summary.failed == 1);
+    assert(summary.wall_ns < 5000000000);
+    assert(strstr(buffer, "timed out after 100 ms") != nullptr);
+}
+
+void test_parallel(void) {
+    // the sleeping tests overlap, however long the machine takes to start them
+    char            buffer[4096];
+    NSL_TestConfig  config  = {.jobs = 4};
+    NSL_TestSummary summary = run(config, "sleep_", buffer, sizeof(buffer));
+    assert(summary.passed == 4);
+    assert(summary.total_ns >= 80000000);
+    assert(atomic_load(&sleepers->most) > 1);
+    assert(strstr(buffer, "on 4 jobs") != nullptr);
+
+    config.jobs = 1;
+    atomic_store(&sleepers->most, 0);
+    summary = run(config, "sleep_", buffer, sizeof(buffer));
+    assert(atomic_load(&sleepers->most) == 1);
+    assert(summary.wall_ns >= 80000000);
+}
+
+void test_baseline(void) {
+    char path[] = "/tmp/nsl-test-XXXXXX";
+    int  fd     = mkstemp(path);
+    assert(fd >= 0);
+    const char *lines = "sleep_a 1000000\npass_basic 1\n";
+    assert(write(fd, lines, strlen(lines)) == (ssize_t)strlen(lines));
+    close(fd);
+
+    // 20ms is much slower than the 1ms baseline, but 1ns is too little to flag
+    char            buffer[4096];
+    NSL_TestConfig  config  = {.baseline = path};
+    NSL_TestSummary summary = run(config, "sleep_a", buffer, sizeof(buffer));
+    assert(summary.passed == 1);
+    assert(summary.slow == 1);
+    assert(strstr(buffer, "[SLOW] sleep_a ") != nullptr);
+    summary = run(config, "pass_basic", buffer, sizeof(buffer));
+    assert(summary.passed == 1);
+    assert(summary.slow == 0);
+
+    config.fail_slow = true;
+    summary          = run(config, "sleep_a", buffer, sizeof(buffer));
+    assert(summary.passed == 0);
+    assert(summary.failed == 1);
+
+    // the saved times only contain passing tests
+    config = (NSL_TestConfig){.save_baseline = path};
+    run(config, "_", buffer, sizeof(buffer));
+    FILE *file = fopen(path, "r");
+    assert(file != nullptr);
+    size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+    buffer[length] = '\0';
+    fclose(file);
+    unlink(path);
+    assert(strncmp(buffer, "pass_basic ", 11) == 0);
+    assert(strstr(buffer, "\nsleep_d ") != nullptr);
+    assert(strstr(buffer, "fail_") == nullptr);
+}
+
+void test_parse_args(void) {
+    NSL_TestConfig config = {};
+    char *argv[] = {
+        (char[]){"test"},
+        (char[]){"--jobs=3"},
+        (char[]){"--timeout=50"},
+        (char[]){"--filter=x"},
+        (char[]){"--no-fork"},
+        (char[]){"--baseline=a"},
+        (char[]){"--save-baseline=b"},
+        (char[]){"--threshold=0.5"},
+        (char[]){"--fail-slow"},
+    };
+    assert(nsl_test_parse_args(&config, (int)(sizeof(argv) / sizeof(*argv)), argv));
+    assert(config.jobs == 3);
+    assert(config.timeout_ms == 50);
+    assert(strcmp(config.filter, "x") == 0);
+    assert(config.no_fork);
+    assert(strcmp(config.baseline, "a") == 0);
+    assert(strcmp(config.save_baseline, "b") == 0);
+    assert(config.threshold == 0.5);
+    assert(config.fail_slow);
+
+    char *bad[] = {(char[]){"test"}, (char[]){"--jobs=all-of-them"}};
+    assert(!nsl_test_parse_args(&config, (int)(sizeof(bad) / sizeof(*bad)), bad));
+}
+
+int main() {
+    sleepers = mmap(nullptr,
+                    sizeof(*sleepers),
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_ANONYMOUS,
+                    -1,
+                    0);
+    assert(sleepers != MAP_FAILED);
+    test_pass();
+    test_fail();
+    test_timeout();
+    test_parallel();
+    test_baseline();
+    test_parse_args();
+}
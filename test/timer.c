@@ -0,0 +1,194 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define NSL_IMPLEMENTATION
+#include "nonstdlib/timer.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 20000
+
+typedef struct Item {
+    NSL_Timer timer;
+    uint64_t  fired;
+    size_t    times;
+} Item;
+
+static NSL_TimerWheel wheel;
+static Item           items[COUNT];
+static uint64_t       last_fired;
+
+void record(NSL_Timer *timer) {
+    Item *item = (Item *)((char *)timer - offsetof(Item, timer));
+    assert(wheel.now == timer->deadline && !nsl_timer_is_pending(timer));
+    assert(wheel.now >= last_fired);
+    last_fired  = wheel.now;
+    item->fired = wheel.now;
+    item->times++;
+}
+
+uint64_t random_u64(void) {
+    return (uint64_t)rand() << 62 ^ (uint64_t)rand() << 31 ^ (uint64_t)rand();
+}
+
+// Deadlines from the next tick to far beyond it, so that every level is used.
+uint64_t random_delay(void) {
+    return random_u64() >> (rand() % 64);
+}
+
+void test_expire(void) {
+    const uint64_t start = (uint64_t)1 << 40;
+    nsl_timer_wheel_init(&wheel, start);
+    assert(nsl_timer_wheel_next(&wheel) == UINT64_MAX);
+    memset(items, 0, sizeof(items));
+    last_fired = 0;
+
+    for (size_t i = 0; i < COUNT; i++) {
+        uint64_t delay = random_delay();
+        uint64_t deadline = delay > UINT64_MAX - start ? UINT64_MAX : start + delay;
+        nsl_timer_start(&wheel, &items[i].timer, deadline, record);
+    }
+    assert(wheel.count == COUNT);
+
+    // steps that stop short of the next tick on which the wheel has something
+    // to do, and steps that go past it
+    size_t   expired = 0;
+    uint64_t now     = start;
+    while (wheel.count > 0) {
+        uint64_t next = nsl_timer_wheel_next(&wheel);
+        assert(next > wheel.now);
+        uint64_t gap  = next - now;
+        uint64_t step = gap / 2 + random_u64() % (gap == UINT64_MAX ? gap : gap + 1);
+        now           = step > UINT64_MAX - now ? UINT64_MAX : now + step;
+        expired      += nsl_timer_wheel_advance(&wheel, now);
+        assert(wheel.now == now);
+        for (size_t i = 0; i < COUNT; i += 997) {
+            assert((items[i].timer.deadline <= now) == (items[i].times == 1));
+        }
+    }
+    assert(expired == COUNT && wheel.count == 0);
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(items[i].times == 1 && items[i].fired == items[i].timer.deadline);
+    }
+
+    // moving back does nothing, and a deadline that has passed expires next
+    nsl_timer_wheel_init(&wheel, 1000);
+    assert(nsl_timer_wheel_advance(&wheel, 10) == 0 && wheel.now == 1000);
+    items[0] = (Item){};
+    nsl_timer_start(&wheel, &items[0].timer, 3, record);
+    assert(items[0].timer.deadline == 1001 && nsl_timer_wheel_next(&wheel) == 1001);
+    last_fired = 0;
+    assert(nsl_timer_wheel_advance(&wheel, 1001) == 1 && items[0].fired == 1001);
+    nsl_timer_wheel_free(&wheel);
+}
+
+void test_cancel(void) {
+    nsl_timer_wheel_init(&wheel, 0);
+    memset(items, 0, sizeof(items));
+    last_fired = 0;
+
+    assert(!nsl_timer_cancel(&wheel, &items[0].timer));
+    for (size_t i = 0; i < COUNT; i++) {
+        nsl_timer_start(&wheel, &items[i].timer, 1 + random_delay() % 1000000, record);
+        assert(nsl_timer_is_pending(&items[i].timer));
+    }
+    // cancel every third, and restart every other with a later deadline
+    for (size_t i = 0; i < COUNT; i += 3) {
+        assert(nsl_timer_cancel(&wheel, &items[i].timer));
+        assert(!nsl_timer_is_pending(&items[i].timer));
+        assert(!nsl_timer_cancel(&wheel, &items[i].timer));
+    }
+    for (size_t i = 1; i < COUNT; i += 2) {
+        nsl_timer_start(&wheel, &items[i].timer, items[i].timer.deadline + 5000, record);
+    }
+    // the odd ones that were cancelled are pending again
+    assert(wheel.count == COUNT - (COUNT + 5) / 6);
+
+    nsl_timer_wheel_advance(&wheel, 2000000);
+    assert(wheel.count == 0 && nsl_timer_wheel_next(&wheel) == UINT64_MAX);
+    for (size_t i = 0; i < COUNT; i++) {
+        assert(items[i].times == (i % 6 == 0 ? 0 : 1));
+    }
+    nsl_timer_wheel_free(&wheel);
+}
+
+// A timer that restarts itself every 7 ticks until it has fired 10 times, and
+// a pair of timers on the same tick, where the first to fire cancels the
+// other.
+void periodic(NSL_Timer *timer) {
+    record(timer);
+    Item *item = (Item *)((char *)timer - offsetof(Item, timer));
+    if (item->times < 10) { nsl_timer_start(&wheel, timer, wheel.now + 7, periodic); }
+}
+
+void cancel_pair(NSL_Timer *timer) {
+    record(timer);
+    Item *item = (Item *)((char *)timer - offsetof(Item, timer));
+    assert(nsl_timer_cancel(&wheel, item == &items[1] ? &items[2].timer : &items[1].timer));
+}
+
+void test_callbacks(void) {
+    nsl_timer_wheel_init(&wheel, 5);
+    memset(items, 0, sizeof(items));
+    last_fired = 0;
+    nsl_timer_start(&wheel, &items[0].timer, 10, periodic);
+    nsl_timer_start(&wheel, &items[1].timer, 4096, cancel_pair);
+    nsl_timer_start(&wheel, &items[2].timer, 4096, cancel_pair);
+
+    assert(nsl_timer_wheel_advance(&wheel, 1000000) == 11);
+    assert(items[0].times == 10 && items[0].fired == 10 + 9 * 7);
+    assert(items[1].times + items[2].times == 1);
+    assert(wheel.count == 0);
+    nsl_timer_wheel_free(&wheel);
+}
+
+typedef struct Sleeper {
+    NSL_Coroutine co;
+    NSL_Timer     timer;
+    uint64_t      delay;
+    uint64_t      woken;
+} Sleeper;
+
+static NSL_TimerWheel coroutine_wheel;
+static char           order[4];
+static size_t         order_length;
+
+NSL_CoroutineStatus sleeper(NSL_Coroutine *co) {
+    Sleeper *sleeper = (Sleeper *)co;
+    nsl_coroutine_begin(co);
+    nsl_timer_await(co, &coroutine_wheel, &sleeper->timer, nsl_timer_now_ms() + sleeper->delay);
+    sleeper->woken        = nsl_timer_now_ms();
+    order[order_length++] = (char)('0' + sleeper->delay / 10);
+    nsl_coroutine_end(co);
+}
+
+void test_coroutines(void) {
+    NSL_CoroutineScheduler scheduler;
+    assert(nsl_coroutine_scheduler_init(&scheduler));
+    nsl_timer_wheel_init(&coroutine_wheel, nsl_timer_now_ms());
+    assert(nsl_timer_wheel_attach(&coroutine_wheel, &scheduler));
+
+    uint64_t start      = nsl_timer_now_ms();
+    Sleeper  sleepers[] = {{.delay = 30}, {.delay = 10}, {.delay = 20}};
+    for (size_t i = 0; i < nsl_carrlen(sleepers); i++) {
+        nsl_coroutine_spawn(&scheduler, &sleepers[i].co, sleeper);
+    }
+    nsl_coroutine_scheduler_run(&scheduler);
+
+    assert(strcmp(order, "123") == 0);
+    for (size_t i = 0; i < nsl_carrlen(sleepers); i++) {
+        assert(sleepers[i].woken >= start + sleepers[i].delay);
+    }
+    assert(coroutine_wheel.count == 0);
+    nsl_timer_wheel_free(&coroutine_wheel);
+    nsl_coroutine_scheduler_free(&scheduler);
+}
+
+int main() {
+    srand(1);
+    test_expire();
+    test_cancel();
+    test_callbacks();
+    test_coroutines();
+}